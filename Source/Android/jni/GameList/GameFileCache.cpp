@@ -60,11 +60,11 @@ JNIEXPORT jint JNICALL Java_org_dolphinemu_dolphinemu_model_GameFileCache_getSiz
 JNIEXPORT jobjectArray JNICALL
 Java_org_dolphinemu_dolphinemu_model_GameFileCache_getAllGames(JNIEnv* env, jobject obj)
 {
-  const UICommon::GameFileCache* ptr = GetPointer(env, obj);
+  UICommon::GameFileCache* ptr = GetPointer(env, obj);
   const jobjectArray array =
       env->NewObjectArray(static_cast<jsize>(ptr->GetSize()), IDCache::GetGameFileClass(), nullptr);
   jsize i = 0;
-  GetPointer(env, obj)->ForEach([env, array, &i](const auto& game_file) {
+  ptr->ForEach([env, array, &i](const auto& game_file) {
     jobject j_game_file = GameFileToJava(env, game_file);
     env->SetObjectArrayElement(array, i++, j_game_file);
     env->DeleteLocalRef(j_game_file);
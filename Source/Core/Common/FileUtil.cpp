@@ -52,11 +52,17 @@
 #include <unistd.h>
 #endif
 
+#if defined(__linux__)
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#endif
+
 #if defined(__APPLE__)
 #include <CoreFoundation/CFBundle.h>
 #include <CoreFoundation/CFString.h>
 #include <CoreFoundation/CFURL.h>
 #include <mach-o/dyld.h>
+#include <sys/clonefile.h>
 #include <sys/param.h>
 #endif
 
@@ -403,6 +409,34 @@ bool CopyRegularFile(std::string_view source_path, std::string_view destination_
   return copied;
 }
 
+bool CloneRegularFile(std::string_view source_path, std::string_view destination_path)
+{
+  DEBUG_LOG_FMT(COMMON, "{}: {} --> {}", __func__, source_path, destination_path);
+
+#if defined(__linux__) && defined(FICLONE)
+  const int source_fd = open(std::string(source_path).c_str(), O_RDONLY | O_CLOEXEC);
+  if (source_fd != -1)
+  {
+    const int destination_fd =
+        open(std::string(destination_path).c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    const bool cloned = destination_fd != -1 && ioctl(destination_fd, FICLONE, source_fd) == 0;
+    if (destination_fd != -1)
+      close(destination_fd);
+    close(source_fd);
+    if (cloned)
+      return true;
+  }
+#elif defined(__APPLE__)
+  // clonefile() refuses to overwrite existing files.
+  Delete(std::string(destination_path), IfAbsentBehavior::NoConsoleWarning);
+  if (clonefile(std::string(source_path).c_str(), std::string(destination_path).c_str(), 0) == 0)
+    return true;
+#endif
+
+  // Cloning is not supported by this host filesystem (or the files are on different devices).
+  return CopyRegularFile(source_path, destination_path);
+}
+
 // Returns the size of a file (or returns 0 if the path isn't a file that exists)
 u64 GetSize(const std::string& path)
 {
@@ -948,6 +982,8 @@ static void RebuildUserDirectories(unsigned int dir_index)
         s_user_paths[D_MEMORYWATCHER_IDX] + MEMORYWATCHER_LOCATIONS;
     s_user_paths[F_MEMORYWATCHERSOCKET_IDX] =
         s_user_paths[D_MEMORYWATCHER_IDX] + MEMORYWATCHER_SOCKET;
+    s_user_paths[F_MEMORYWATCHERSHAREDMEMORY_IDX] =
+        s_user_paths[D_MEMORYWATCHER_IDX] + MEMORYWATCHER_SHARED_MEMORY;
 
     s_user_paths[D_GBAUSER_IDX] = s_user_paths[D_USER_IDX] + GBA_USER_DIR DIR_SEP;
     s_user_paths[D_GBASAVES_IDX] = s_user_paths[D_GBAUSER_IDX] + GBASAVES_DIR DIR_SEP;
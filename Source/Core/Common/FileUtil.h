@@ -87,6 +87,7 @@ enum
   F_GCSRAM_IDX,
   F_MEMORYWATCHERLOCATIONS_IDX,
   F_MEMORYWATCHERSOCKET_IDX,
+  F_MEMORYWATCHERSHAREDMEMORY_IDX,
   F_WIISDCARDIMAGE_IDX,
   F_DUALSHOCKUDPCLIENTCONFIG_IDX,
   F_FREELOOKCONFIG_IDX,
@@ -183,6 +184,10 @@ bool RenameSync(const std::string& srcFilename, const std::string& destFilename)
 // If a file already exists at destination_path it is overwritten. Returns true on success.
 bool CopyRegularFile(std::string_view source_path, std::string_view destination_path);
 
+// Same as CopyRegularFile, but shares the data of the two files (until either is modified) if the
+// host filesystem supports that, e.g. reflinks on Btrfs/XFS or clones on APFS.
+bool CloneRegularFile(std::string_view source_path, std::string_view destination_path);
+
 // creates an empty file filename, returns true on success
 bool CreateEmptyFile(const std::string& filename);
 
@@ -102,6 +102,14 @@ public:
   ///
   void UnmapFromMemoryRegion(void* view, size_t size);
 
+  ///
+  /// Get the smallest size (and alignment) with which MapInMemoryRegion() can map a section of the
+  /// memory segment. This is the host page size on most platforms, but can be larger.
+  ///
+  /// @return Mapping granularity in bytes.
+  ///
+  size_t GetMappingGranularity() const;
+
 private:
 #ifdef _WIN32
   WindowsMemoryRegion* EnsureSplitRegionForMapping(void* address, size_t size);
@@ -29,6 +29,7 @@
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
 #include "Common/StringUtil.h"
+#include "Common/ZoneProfiler.h"
 
 namespace Common
 {
@@ -114,6 +115,9 @@ void SetCurrentThreadName(const char* name)
 {
   SetCurrentThreadNameViaException(name);
   SetCurrentThreadNameViaApi(name);
+#ifdef USE_ZONE_PROFILING
+  ZoneProfiler::SetCurrentThreadName(name);
+#endif
 }
 
 #else  // !WIN32, so must be POSIX threads
@@ -184,6 +188,9 @@ void SetCurrentThreadName(const char* name)
   // API.
   __itt_thread_set_name(name);
 #endif
+#ifdef USE_ZONE_PROFILING
+  ZoneProfiler::SetCurrentThreadName(name);
+#endif
 }
 
 std::tuple<void*, size_t> GetCurrentThreadStack()
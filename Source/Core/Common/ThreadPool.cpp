@@ -0,0 +1,104 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/ThreadPool.h"
+
+#include "Common/Thread.h"
+
+namespace Common
+{
+void ThreadPool::Reset(std::string_view name, size_t num_workers)
+{
+  Shutdown();
+
+  std::lock_guard lg(m_lock);
+  m_name = name;
+  m_shutdown = false;
+  m_workers.reserve(num_workers);
+  // Thread index 0 belongs to the thread calling ParallelFor. The workers only pick up work which
+  // is submitted after this point, even if they start running later than the next ParallelFor.
+  for (size_t i = 0; i < num_workers; ++i)
+    m_workers.emplace_back(&ThreadPool::WorkerLoop, this, i + 1, m_generation);
+}
+
+void ThreadPool::Shutdown()
+{
+  {
+    std::lock_guard lg(m_lock);
+    if (m_workers.empty())
+      return;
+
+    m_shutdown = true;
+    m_work_cond_var.notify_all();
+  }
+
+  for (std::thread& worker : m_workers)
+    worker.join();
+  m_workers.clear();
+}
+
+void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t, size_t)>& function)
+{
+  if (count == 0)
+    return;
+
+  if (m_workers.empty() || count == 1)
+  {
+    for (size_t i = 0; i < count; ++i)
+      function(i, 0);
+    return;
+  }
+
+  {
+    std::lock_guard lg(m_lock);
+    m_function = &function;
+    m_count = count;
+    m_next_index.store(0, std::memory_order_relaxed);
+    m_busy_workers = m_workers.size();
+    ++m_generation;
+    m_work_cond_var.notify_all();
+  }
+
+  RunWorkItems(0);
+
+  std::unique_lock lg(m_lock);
+  m_done_cond_var.wait(lg, [&] { return m_busy_workers == 0; });
+  m_function = nullptr;
+}
+
+void ThreadPool::WorkerLoop(size_t thread_index, u64 last_generation)
+{
+  {
+    std::lock_guard lg(m_lock);
+    Common::SetCurrentThreadName(m_name.c_str());
+  }
+
+  while (true)
+  {
+    {
+      std::unique_lock lg(m_lock);
+      m_work_cond_var.wait(lg, [&] { return m_shutdown || m_generation != last_generation; });
+      if (m_shutdown)
+        return;
+      last_generation = m_generation;
+    }
+
+    RunWorkItems(thread_index);
+
+    std::lock_guard lg(m_lock);
+    if (--m_busy_workers == 0)
+      m_done_cond_var.notify_one();
+  }
+}
+
+void ThreadPool::RunWorkItems(size_t thread_index)
+{
+  while (true)
+  {
+    const size_t index = m_next_index.fetch_add(1, std::memory_order_relaxed);
+    if (index >= m_count)
+      return;
+    (*m_function)(index, thread_index);
+  }
+}
+}  // namespace Common
@@ -0,0 +1,71 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// A fixed set of worker threads for splitting data-parallel work into independent items.
+// The thread which submits the work takes part in processing it, so a pool without any workers
+// simply runs everything on the calling thread.
+
+namespace Common
+{
+class ThreadPool
+{
+public:
+  ThreadPool() = default;
+  ThreadPool(std::string_view name, size_t num_workers) { Reset(name, num_workers); }
+  ~ThreadPool() { Shutdown(); }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ThreadPool(ThreadPool&&) = delete;
+  ThreadPool& operator=(ThreadPool&&) = delete;
+
+  // Stops the current workers (if any) and starts num_workers new ones.
+  void Reset(std::string_view name, size_t num_workers);
+
+  // Blocks until all workers have exited.
+  void Shutdown();
+
+  // Number of threads which can run work items at the same time, including the calling thread.
+  size_t GetThreadCount() const { return m_workers.size() + 1; }
+
+  // Calls function(index, thread_index) for every index in [0, count), and returns once all of
+  // those calls have returned. The order in which the indices are processed is unspecified.
+  //
+  // thread_index is in [0, GetThreadCount()) and no two concurrent calls share it, so it can be
+  // used to pick per-thread scratch data without any locking.
+  //
+  // Must not be called from multiple threads at the same time.
+  void ParallelFor(size_t count, const std::function<void(size_t, size_t)>& function);
+
+private:
+  void WorkerLoop(size_t thread_index, u64 last_generation);
+  void RunWorkItems(size_t thread_index);
+
+  std::string m_name;
+  std::vector<std::thread> m_workers;
+
+  std::mutex m_lock;
+  std::condition_variable m_work_cond_var;
+  std::condition_variable m_done_cond_var;
+  const std::function<void(size_t, size_t)>* m_function = nullptr;
+  size_t m_count = 0;
+  std::atomic<size_t> m_next_index = 0;
+  size_t m_busy_workers = 0;
+  u64 m_generation = 0;
+  bool m_shutdown = false;
+};
+}  // namespace Common
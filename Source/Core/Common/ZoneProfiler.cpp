@@ -0,0 +1,245 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/ZoneProfiler.h"
+
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+
+namespace Common::ZoneProfiler
+{
+namespace
+{
+// 6 MiB per thread which records zones, allocated on the first zone of that thread. Once it's
+// full, the oldest zones are overwritten, so the trace holds the last few seconds of each thread.
+constexpr u64 EVENTS_PER_THREAD = 1 << 18;
+
+// Flush the JSON to the file once this much text has been formatted
+constexpr size_t WRITE_CHUNK_SIZE = 1 << 20;
+
+// The fields are atomic as an event can be overwritten while the trace is written. Relaxed
+// accesses compile to plain loads and stores.
+struct Event
+{
+  std::atomic<const char*> name;
+  std::atomic<u64> start;
+  std::atomic<u64> end;
+};
+
+// Only the owning thread writes events. Each recording is a new session, and a thread starts over
+// once it sees that the session changed, so the buffers never have to be reset from outside.
+//
+// events is a ring buffer, zone i of the session goes to events[i % EVENTS_PER_THREAD]. started is
+// increased before an event is overwritten and count after it was written, so the trace can tell
+// which of the events it read were overwritten in the meantime.
+struct ThreadBuffer
+{
+  u32 id = 0;
+  // Guarded by s_lock
+  std::string name;
+
+  std::unique_ptr<Event[]> events;
+  std::atomic<u32> session = 0;
+  std::atomic<u64> started = 0;
+  std::atomic<u64> count = 0;
+};
+
+// Guards everything except the contents of the thread buffers
+std::mutex s_lock;
+// Buffers are kept when their thread exits so that its zones still end up in the trace
+std::vector<std::unique_ptr<ThreadBuffer>> s_buffers;
+std::atomic<u32> s_session = 0;
+File::IOFile s_file;
+u64 s_start_time = 0;
+
+ThreadBuffer& GetThreadBuffer()
+{
+  thread_local ThreadBuffer* buffer = nullptr;
+  if (!buffer) [[unlikely]]
+  {
+    std::lock_guard lk(s_lock);
+    buffer = s_buffers.emplace_back(std::make_unique<ThreadBuffer>()).get();
+    buffer->id = static_cast<u32>(s_buffers.size());
+  }
+  return *buffer;
+}
+
+void AppendEscaped(std::string* out, std::string_view str)
+{
+  for (const char c : str)
+  {
+    if (c == '"' || c == '\\')
+    {
+      out->push_back('\\');
+      out->push_back(c);
+    }
+    else if (static_cast<unsigned char>(c) < 0x20)
+    {
+      fmt::format_to(std::back_inserter(*out), "\\u{:04x}", c);
+    }
+    else
+    {
+      out->push_back(c);
+    }
+  }
+}
+
+// Writes the trace in the Chrome trace event format. Zones are complete ("X") events with
+// timestamps in microseconds, thread names are metadata ("M") events. The number of zones which
+// were overwritten is put in otherData, which trace viewers show along with the trace.
+bool WriteTrace(u32 session)
+{
+  std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  bool first = true;
+  bool write_failed = false;
+  const auto next_event = [&] {
+    if (!first)
+      json += ",\n";
+    first = false;
+  };
+  const auto flush = [&](size_t threshold) {
+    if (json.size() < threshold)
+      return;
+    write_failed |= !s_file.WriteString(json);
+    json.clear();
+  };
+
+  u64 dropped = 0;
+  for (const std::unique_ptr<ThreadBuffer>& buffer : s_buffers)
+  {
+    if (!buffer->name.empty())
+    {
+      next_event();
+      fmt::format_to(std::back_inserter(json),
+                     "{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},"
+                     "\"args\":{{\"name\":\"",
+                     buffer->id);
+      AppendEscaped(&json, buffer->name);
+      json += "\"}}";
+    }
+
+    if (buffer->session.load(std::memory_order_acquire) != session)
+      continue;
+
+    // Zones which are still being recorded by other threads are past the count and get ignored
+    const u64 count = buffer->count.load(std::memory_order_acquire);
+    const u64 first = count > EVENTS_PER_THREAD ? count - EVENTS_PER_THREAD : 0;
+    dropped += first;
+    for (u64 i = first; i < count; ++i)
+    {
+      const Event& slot = buffer->events[i % EVENTS_PER_THREAD];
+      const char* const name = slot.name.load(std::memory_order_relaxed);
+      const u64 start = slot.start.load(std::memory_order_relaxed);
+      const u64 end = slot.end.load(std::memory_order_relaxed);
+
+      // The thread may have kept recording zones, overwriting this one while it was read
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (buffer->started.load(std::memory_order_relaxed) - i > EVENTS_PER_THREAD)
+      {
+        ++dropped;
+        continue;
+      }
+
+      // Zones which began before recording was started
+      if (start < s_start_time)
+        continue;
+
+      next_event();
+      json += "{\"name\":\"";
+      AppendEscaped(&json, name);
+      fmt::format_to(std::back_inserter(json),
+                     "\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                     buffer->id, (start - s_start_time) / 1000.0, (end - start) / 1000.0);
+      flush(WRITE_CHUNK_SIZE);
+    }
+  }
+
+  fmt::format_to(std::back_inserter(json), "\n],\"otherData\":{{\"droppedZones\":{}}}}}\n",
+                 dropped);
+  flush(0);
+
+  if (dropped != 0)
+  {
+    WARN_LOG_FMT(COMMON, "Zone trace is missing the {} oldest zones as thread buffers were full",
+                 dropped);
+  }
+
+  return !write_failed;
+}
+}  // namespace
+
+bool StartRecording(const std::string& path)
+{
+  std::lock_guard lk(s_lock);
+  if (IsRecording())
+    return false;
+
+  if (!s_file.Open(path, "wb"))
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to create zone trace {}", path);
+    return false;
+  }
+
+  s_start_time = GetTimestamp();
+  s_session.fetch_add(1, std::memory_order_release);
+  detail::s_recording.store(true, std::memory_order_relaxed);
+
+  INFO_LOG_FMT(COMMON, "Started recording zone trace {}", path);
+  return true;
+}
+
+bool StopRecording()
+{
+  std::lock_guard lk(s_lock);
+  if (!IsRecording())
+    return false;
+
+  detail::s_recording.store(false, std::memory_order_relaxed);
+
+  const bool success = WriteTrace(s_session.load(std::memory_order_relaxed));
+  s_file.Close();
+
+  INFO_LOG_FMT(COMMON, "Stopped recording zone trace");
+  return success;
+}
+
+void SetCurrentThreadName(const char* name)
+{
+  ThreadBuffer& buffer = GetThreadBuffer();
+  std::lock_guard lk(s_lock);
+  buffer.name = name;
+}
+
+void RecordZone(const char* name, u64 start, u64 end)
+{
+  ThreadBuffer& buffer = GetThreadBuffer();
+
+  const u32 session = s_session.load(std::memory_order_acquire);
+  if (buffer.session.load(std::memory_order_relaxed) != session) [[unlikely]]
+  {
+    if (!buffer.events)
+      buffer.events = std::make_unique<Event[]>(EVENTS_PER_THREAD);
+    buffer.started.store(0, std::memory_order_relaxed);
+    buffer.count.store(0, std::memory_order_relaxed);
+    buffer.session.store(session, std::memory_order_release);
+  }
+
+  const u64 index = buffer.count.load(std::memory_order_relaxed);
+  buffer.started.store(index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  Event& slot = buffer.events[index % EVENTS_PER_THREAD];
+  slot.name.store(name, std::memory_order_relaxed);
+  slot.start.store(start, std::memory_order_relaxed);
+  slot.end.store(end, std::memory_order_relaxed);
+  buffer.count.store(index + 1, std::memory_order_release);
+}
+}  // namespace Common::ZoneProfiler
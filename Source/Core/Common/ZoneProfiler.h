@@ -0,0 +1,85 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+// Records the time spent in named zones on every thread into a timeline, which is written as a
+// Chrome trace event file that chrome://tracing and Perfetto can open. Unlike Common::Profiler,
+// this shows what all threads were doing at the same time, e.g. during a stutter.
+//
+// Zones are only compiled in when building with USE_ZONE_PROFILING. Each thread records into its
+// own ring buffer without locking, which keeps its newest zones once it's full, and zones cost a
+// single relaxed load while nothing is being recorded.
+namespace Common::ZoneProfiler
+{
+namespace detail
+{
+inline std::atomic_bool s_recording = false;
+}
+
+// Starts recording zones. The trace is written to path when recording is stopped.
+bool StartRecording(const std::string& path);
+// Stops recording and writes the trace. Returns false if writing failed.
+bool StopRecording();
+inline bool IsRecording()
+{
+  return detail::s_recording.load(std::memory_order_relaxed);
+}
+
+// Names the calling thread in traces
+void SetCurrentThreadName(const char* name);
+
+inline u64 GetTimestamp()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// name must stay valid until the trace is written, so it should be a string literal
+void RecordZone(const char* name, u64 start, u64 end);
+
+class Zone
+{
+public:
+  explicit Zone(const char* name)
+  {
+    if (IsRecording()) [[unlikely]]
+    {
+      m_name = name;
+      m_start = GetTimestamp();
+    }
+  }
+
+  ~Zone()
+  {
+    if (m_name) [[unlikely]]
+      RecordZone(m_name, m_start, GetTimestamp());
+  }
+
+  Zone(const Zone&) = delete;
+  Zone(Zone&&) = delete;
+  Zone& operator=(const Zone&) = delete;
+  Zone& operator=(Zone&&) = delete;
+
+private:
+  const char* m_name = nullptr;
+  u64 m_start = 0;
+};
+}  // namespace Common::ZoneProfiler
+
+#ifdef USE_ZONE_PROFILING
+#define PROFILE_ZONE_CONCAT_(a, b) a##b
+#define PROFILE_ZONE_CONCAT(a, b) PROFILE_ZONE_CONCAT_(a, b)
+// Records the time until the end of the enclosing scope
+#define PROFILE_ZONE(name)                                                                         \
+  const Common::ZoneProfiler::Zone PROFILE_ZONE_CONCAT(profile_zone_, __LINE__)(name)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#endif
@@ -3,10 +3,15 @@
 
 #include "Core/CheatSearch.h"
 
+#include <algorithm>
+#include <bit>
+#include <cstring>
 #include <functional>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <variant>
 #include <vector>
@@ -15,6 +20,12 @@
 #include "Common/Assert.h"
 #include "Common/BitUtils.h"
 #include "Common/StringUtil.h"
+#include "Common/Swap.h"
+#include "Common/ThreadPool.h"
+
+#if defined(_M_X86_64)
+#include "Common/Intrinsics.h"
+#endif
 
 #include "Core/Core.h"
 #include "Core/HW/Memmap.h"
@@ -197,134 +208,720 @@ TryReadValueFromEmulatedMemory(const Core::CPUThreadGuard& guard, u32 addr,
 {
   return PowerPC::MMU::HostTryReadF64(guard, addr, space);
 }
-}  // namespace
 
+// Returns a bitmask of which of the 64 consecutive values at data are equal to value. value has to
+// be in the same byte order as data.
 template <typename T>
-Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>
-Cheats::NewSearch(const Core::CPUThreadGuard& guard,
-                  const std::vector<Cheats::MemoryRange>& memory_ranges,
-                  PowerPC::RequestedAddressSpace address_space, bool aligned,
-                  const std::function<bool(const T& value)>& validator)
+u64 FindEqualValues(const u8* data, T value)
 {
-  const u32 data_size = sizeof(T);
-  std::vector<Cheats::SearchResult<T>> results;
-  Cheats::SearchErrorCode error_code = Cheats::SearchErrorCode::Success;
-  Core::RunAsCPUThread([&] {
-    const Core::State core_state = Core::GetState();
-    if (core_state != Core::State::Running && core_state != Core::State::Paused)
+  static_assert(std::is_unsigned_v<T>);
+
+  u64 mask = 0;
+#if defined(_M_X86_64)
+  const auto load = [data](size_t offset) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+  };
+
+  if constexpr (sizeof(T) == 1)
+  {
+    const __m128i needle = _mm_set1_epi8(static_cast<char>(value));
+    for (size_t i = 0; i < 4; ++i)
     {
-      error_code = Cheats::SearchErrorCode::NoEmulationActive;
-      return;
+      const __m128i equal = _mm_cmpeq_epi8(load(i * 16), needle);
+      mask |= u64(u16(_mm_movemask_epi8(equal))) << (i * 16);
     }
+  }
+  else if constexpr (sizeof(T) == 2)
+  {
+    const __m128i needle = _mm_set1_epi16(static_cast<short>(value));
+    for (size_t i = 0; i < 4; ++i)
+    {
+      const __m128i equal_0 = _mm_cmpeq_epi16(load(i * 32), needle);
+      const __m128i equal_1 = _mm_cmpeq_epi16(load(i * 32 + 16), needle);
+      const __m128i equal = _mm_packs_epi16(equal_0, equal_1);
+      mask |= u64(u16(_mm_movemask_epi8(equal))) << (i * 16);
+    }
+  }
+  else if constexpr (sizeof(T) == 4)
+  {
+    const __m128i needle = _mm_set1_epi32(static_cast<int>(value));
+    for (size_t i = 0; i < 4; ++i)
+    {
+      const __m128i equal_0 = _mm_cmpeq_epi32(load(i * 64), needle);
+      const __m128i equal_1 = _mm_cmpeq_epi32(load(i * 64 + 16), needle);
+      const __m128i equal_2 = _mm_cmpeq_epi32(load(i * 64 + 32), needle);
+      const __m128i equal_3 = _mm_cmpeq_epi32(load(i * 64 + 48), needle);
+      const __m128i equal = _mm_packs_epi16(_mm_packs_epi32(equal_0, equal_1),
+                                            _mm_packs_epi32(equal_2, equal_3));
+      mask |= u64(u16(_mm_movemask_epi8(equal))) << (i * 16);
+    }
+  }
+  else
+  {
+    const __m128i needle = _mm_set1_epi64x(static_cast<long long>(value));
+    for (size_t i = 0; i < 32; ++i)
+    {
+      // Both 32-bit halves have to match.
+      __m128i equal = _mm_cmpeq_epi32(load(i * 16), needle);
+      equal = _mm_and_si128(equal, _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1)));
+      mask |= u64(_mm_movemask_pd(_mm_castsi128_pd(equal))) << (i * 2);
+    }
+  }
+#else
+  for (size_t i = 0; i < 64; ++i)
+  {
+    T current;
+    std::memcpy(&current, data + i * sizeof(T), sizeof(T));
+    mask |= u64(current == value) << i;
+  }
+#endif
+  return mask;
+}
+
+template <typename T>
+T LoadBigEndianValue(const u8* data)
+{
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  return Common::FromBigEndian(value);
+}
+
+bool IsValid(Cheats::SearchResultValueState state)
+{
+  return state == Cheats::SearchResultValueState::ValueFromPhysicalMemory ||
+         state == Cheats::SearchResultValueState::ValueFromVirtualMemory;
+}
+
+struct AcceptAll
+{
+  template <typename T>
+  bool operator()(const T&, const T&) const
+  {
+    return true;
+  }
+};
+
+// Calls function with a comparison object for the given filter, so that the comparison can be
+// inlined into the search loops.
+template <typename T, typename Function>
+bool DispatchFilter(const Cheats::SearchFilter<T>& filter, Function function)
+{
+  if (filter.m_filter_type == Cheats::FilterType::DoNotFilter)
+  {
+    function(AcceptAll());
+    return true;
+  }
+
+  switch (filter.m_compare_type)
+  {
+  case Cheats::CompareType::Equal:
+    function(std::equal_to<T>());
+    return true;
+  case Cheats::CompareType::NotEqual:
+    function(std::not_equal_to<T>());
+    return true;
+  case Cheats::CompareType::Less:
+    function(std::less<T>());
+    return true;
+  case Cheats::CompareType::LessOrEqual:
+    function(std::less_equal<T>());
+    return true;
+  case Cheats::CompareType::Greater:
+    function(std::greater<T>());
+    return true;
+  case Cheats::CompareType::GreaterOrEqual:
+    function(std::greater_equal<T>());
+    return true;
+  default:
+    DEBUG_ASSERT(false);
+    return false;
+  }
+}
+
+// Emulated memory, accessed through the MMU.
+class EmulatedMemory
+{
+public:
+  EmulatedMemory(const Core::CPUThreadGuard& guard, PowerPC::RequestedAddressSpace address_space)
+      : m_guard(guard), m_address_space(address_space)
+  {
+  }
+
+  bool IsTranslated() const
+  {
+    return m_address_space == PowerPC::RequestedAddressSpace::Virtual ||
+           (m_address_space == PowerPC::RequestedAddressSpace::Effective &&
+            m_guard.GetSystem().GetPPCState().msr.DR);
+  }
+
+  // Returns nullptr if the page has to be read through Read.
+  const u8* GetPagePointer(u32 page_address) const
+  {
+    return PowerPC::MMU::HostGetRAMPagePointer(m_guard, page_address, m_address_space);
+  }
+
+  bool IsPageAccessible(u32 page_address) const
+  {
+    return PowerPC::MMU::HostIsRAMAddress(m_guard, page_address, m_address_space);
+  }
+
+  template <typename T>
+  std::optional<PowerPC::ReadResult<T>> Read(u32 address) const
+  {
+    return TryReadValueFromEmulatedMemory<T>(m_guard, address, m_address_space);
+  }
+
+private:
+  const Core::CPUThreadGuard& m_guard;
+  PowerPC::RequestedAddressSpace m_address_space;
+};
+
+// A copy of memory in a host buffer. Only pages which are entirely in the buffer can be accessed
+// directly, so that both ways of reading values get used.
+class BufferMemory
+{
+public:
+  BufferMemory(std::span<const u8> buffer, u32 base_address)
+      : m_buffer(buffer), m_base_address(base_address)
+  {
+  }
 
-    auto& system = Core::System::GetInstance();
-    auto& ppc_state = system.GetPPCState();
-    if (address_space == PowerPC::RequestedAddressSpace::Virtual && !ppc_state.msr.DR)
+  bool IsTranslated() const { return false; }
+
+  const u8* GetPagePointer(u32 page_address) const
+  {
+    if (page_address < m_base_address ||
+        u64(page_address - m_base_address) + Cheats::SearchResults<u8>::PAGE_SIZE >
+            m_buffer.size())
     {
-      error_code = Cheats::SearchErrorCode::VirtualAddressesCurrentlyNotAccessible;
-      return;
+      return nullptr;
     }
+    return m_buffer.data() + (page_address - m_base_address);
+  }
+
+  bool IsPageAccessible(u32 page_address) const
+  {
+    return u64(page_address) + Cheats::SearchResults<u8>::PAGE_SIZE > m_base_address &&
+           page_address < u64(m_base_address) + m_buffer.size();
+  }
+
+  template <typename T>
+  std::optional<PowerPC::ReadResult<T>> Read(u32 address) const
+  {
+    if (address < m_base_address || u64(address - m_base_address) + sizeof(T) > m_buffer.size())
+      return std::nullopt;
+    const u8* const data = m_buffer.data() + (address - m_base_address);
+    return PowerPC::ReadResult<T>(false, LoadBigEndianValue<T>(data));
+  }
+
+private:
+  std::span<const u8> m_buffer;
+  u32 m_base_address;
+};
+
+// The candidates of a search within one page, and the results found for them.
+template <typename T>
+struct PageSearch
+{
+  using Page = typename Cheats::SearchResults<T>::Page;
+
+  u32 address;
+  // nullptr if the page has to be read through the MMU.
+  const u8* host_pointer;
+  // Set if reads from the page fail.
+  bool inaccessible;
+  std::array<u64, Cheats::SearchResults<T>::PAGE_MASK_WORDS> candidates;
+  // nullptr for a new search.
+  const Page* previous;
+  Page result;
+};
+
+template <typename T, typename Memory>
+class PageSearcher
+{
+public:
+  PageSearcher(const Memory& memory, u32 stride, const Cheats::SearchFilter<T>& filter)
+      : m_memory(memory), m_stride(stride), m_filter(filter)
+  {
+    m_host_state = memory.IsTranslated() ? Cheats::SearchResultValueState::ValueFromVirtualMemory :
+                                           Cheats::SearchResultValueState::ValueFromPhysicalMemory;
 
-    for (const Cheats::MemoryRange& range : memory_ranges)
+    // Values starting this close to the end of a page continue in the next page, which might not
+    // be contiguous in host memory.
+    m_first_straddling_bit = (Cheats::SearchResults<T>::PAGE_SIZE - sizeof(T)) / stride + 1;
+  }
+
+  void ResolvePage(PageSearch<T>* page) const
+  {
+    page->host_pointer = m_memory.GetPagePointer(page->address);
+    page->inaccessible = !page->host_pointer && !m_memory.IsPageAccessible(page->address);
+    page->result.m_address = page->address;
+    page->result.m_state = m_host_state;
+  }
+
+  // Processes the candidates that can be read directly from host memory. Can be called for
+  // different pages concurrently.
+  template <typename Compare>
+  void SearchHostMemory(PageSearch<T>* page, Compare compare) const
+  {
+    if (!page->host_pointer)
+      return;
+
+    const bool use_find_equal_values = CanUseFindEqualValues(*page, compare);
+    size_t previous_index = 0;
+    for (size_t word = 0; word < page->candidates.size(); ++word)
     {
-      if (range.m_length < data_size)
+      const size_t word_previous_index = previous_index;
+      if (page->previous)
+        previous_index += std::popcount(page->previous->m_mask[word]);
+
+      u64 candidates = page->candidates[word];
+      if (!candidates)
         continue;
 
-      const u32 increment_per_loop = aligned ? data_size : 1;
-      const u32 start_address = aligned ? Common::AlignUp(range.m_start, data_size) : range.m_start;
-      const u64 aligned_length = range.m_length - (start_address - range.m_start);
+      const size_t first_bit = word * 64;
+      if (first_bit + 64 > m_first_straddling_bit)
+        candidates &= GetNonStraddlingMask(first_bit);
 
-      if (aligned_length < data_size)
-        continue;
+      if constexpr (std::is_integral_v<T>)
+      {
+        if (use_find_equal_values)
+        {
+          using U = std::make_unsigned_t<T>;
+          const U needle = Common::FromBigEndian(Common::BitCast<U>(m_filter.m_value));
+          u64 matches = FindEqualValues<U>(page->host_pointer + first_bit * sizeof(T), needle);
+          if constexpr (std::is_same_v<Compare, std::not_equal_to<T>>)
+            matches = ~matches;
+          candidates &= matches;
+
+          // The values of the results are known without reading them.
+          if constexpr (std::is_same_v<Compare, std::equal_to<T>>)
+          {
+            page->result.m_mask[word] = candidates;
+            page->result.m_values.insert(page->result.m_values.end(), std::popcount(candidates),
+                                         m_filter.m_value);
+            continue;
+          }
+        }
+      }
+
+      u64 results = 0;
+      for (u64 remaining = candidates; remaining; remaining &= remaining - 1)
+      {
+        const size_t bit = std::countr_zero(remaining);
+        const T value = LoadBigEndianValue<T>(page->host_pointer + (first_bit + bit) * m_stride);
+        const size_t index =
+            page->previous ?
+                word_previous_index +
+                    std::popcount(page->previous->m_mask[word] & ((u64(1) << bit) - 1)) :
+                0;
+        if (Keep(page->previous, index, value, compare))
+        {
+          results |= u64(1) << bit;
+          page->result.m_values.push_back(value);
+        }
+      }
+      page->result.m_mask[word] = results;
+    }
+  }
 
-      const u64 length = aligned_length - (data_size - 1);
-      for (u64 i = 0; i < length; i += increment_per_loop)
+  // Processes the candidates that have to be read through the MMU. Must be called on the CPU thread
+  // after SearchHostMemory, in page order.
+  template <typename Compare>
+  void SearchEmulatedMemory(PageSearch<T>* page, Compare compare) const
+  {
+    size_t previous_index = 0;
+    for (size_t word = 0; word < page->candidates.size(); ++word)
+    {
+      u64 candidates = page->candidates[word];
+      const size_t first_bit = word * 64;
+      const u64 previous_mask = page->previous ? page->previous->m_mask[word] : 0;
+      if (page->host_pointer)
       {
-        const u32 addr = start_address + i;
-        const auto current_value = TryReadValueFromEmulatedMemory<T>(guard, addr, address_space);
-        if (!current_value)
+        if (first_bit + 64 <= m_first_straddling_bit)
+        {
+          previous_index += std::popcount(previous_mask);
           continue;
+        }
+        candidates &= ~GetNonStraddlingMask(first_bit);
+      }
+
+      for (u64 remaining = candidates; remaining; remaining &= remaining - 1)
+      {
+        const size_t bit = std::countr_zero(remaining);
+        const size_t index = previous_index + std::popcount(previous_mask & ((u64(1) << bit) - 1));
+        const u32 address = page->address + static_cast<u32>(first_bit + bit) * m_stride;
 
-        if (validator(current_value->value))
+        std::optional<PowerPC::ReadResult<T>> value;
+        if (!page->inaccessible)
+          value = m_memory.template Read<T>(address);
+
+        if (!value)
+        {
+          // Inaccessible results are dropped by a new search, but kept by a next search.
+          if (page->previous)
+            AddResult(page, word, bit, T{}, Cheats::SearchResultValueState::AddressNotAccessible);
+          continue;
+        }
+
+        if (Keep(page->previous, index, value->value, compare))
         {
-          auto& r = results.emplace_back();
-          r.m_value = current_value->value;
-          r.m_value_state = current_value->translated ?
-                                Cheats::SearchResultValueState::ValueFromVirtualMemory :
-                                Cheats::SearchResultValueState::ValueFromPhysicalMemory;
-          r.m_address = addr;
+          AddResult(page, word, bit, value->value,
+                    value->translated ? Cheats::SearchResultValueState::ValueFromVirtualMemory :
+                                        Cheats::SearchResultValueState::ValueFromPhysicalMemory);
         }
       }
+
+      previous_index += std::popcount(previous_mask);
     }
-  });
-  if (error_code == Cheats::SearchErrorCode::Success)
-    return results;
-  return error_code;
-}
+  }
 
-template <typename T>
-Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>
-Cheats::NextSearch(const Core::CPUThreadGuard& guard,
-                   const std::vector<Cheats::SearchResult<T>>& previous_results,
-                   PowerPC::RequestedAddressSpace address_space,
-                   const std::function<bool(const T& new_value, const T& old_value)>& validator)
-{
-  std::vector<Cheats::SearchResult<T>> results;
-  Cheats::SearchErrorCode error_code = Cheats::SearchErrorCode::Success;
-  Core::RunAsCPUThread([&] {
-    const Core::State core_state = Core::GetState();
-    if (core_state != Core::State::Running && core_state != Core::State::Paused)
+private:
+  // previous_index is the index of the result in the previous page, if there is one.
+  template <typename Compare>
+  bool Keep(const typename PageSearch<T>::Page* previous, size_t previous_index, const T& value,
+            Compare compare) const
+  {
+    // Results whose value was previously inaccessible are always kept, to avoid getting stuck in
+    // that state.
+    if (previous && !IsValid(previous->GetState(previous_index)))
+      return true;
+
+    if (m_filter.m_filter_type == Cheats::FilterType::CompareAgainstSpecificValue)
+      return compare(value, m_filter.m_value);
+    return compare(value, previous ? previous->m_values[previous_index] : value);
+  }
+
+  template <typename Compare>
+  bool CanUseFindEqualValues(const PageSearch<T>& page, Compare) const
+  {
+    if constexpr (std::is_integral_v<T> && (std::is_same_v<Compare, std::equal_to<T>> ||
+                                            std::is_same_v<Compare, std::not_equal_to<T>>))
     {
-      error_code = Cheats::SearchErrorCode::NoEmulationActive;
-      return;
+      return m_filter.m_filter_type == Cheats::FilterType::CompareAgainstSpecificValue &&
+             m_stride == sizeof(T) &&
+             (!page.previous ||
+              (page.previous->m_states.empty() && IsValid(page.previous->m_state)));
     }
+    else
+    {
+      return false;
+    }
+  }
 
-    auto& system = Core::System::GetInstance();
-    auto& ppc_state = system.GetPPCState();
-    if (address_space == PowerPC::RequestedAddressSpace::Virtual && !ppc_state.msr.DR)
+  u64 GetNonStraddlingMask(size_t first_bit) const
+  {
+    if (first_bit >= m_first_straddling_bit)
+      return 0;
+    return (u64(1) << (m_first_straddling_bit - first_bit)) - 1;
+  }
+
+  void AddResult(PageSearch<T>* page, size_t word, size_t bit, T value,
+                 Cheats::SearchResultValueState state) const
+  {
+    typename PageSearch<T>::Page& result = page->result;
+    if (state != result.m_state && result.m_states.empty())
     {
-      error_code = Cheats::SearchErrorCode::VirtualAddressesCurrentlyNotAccessible;
-      return;
+      // The first result of a page decides the state that all of its results share
+      if (result.m_values.empty())
+        result.m_state = state;
+      else
+        result.m_states.assign(result.m_values.size(), result.m_state);
     }
+    if (!result.m_states.empty())
+      result.m_states.push_back(state);
+
+    result.m_mask[word] |= u64(1) << bit;
+    result.m_values.push_back(value);
+  }
+
+  const Memory& m_memory;
+  u32 m_stride;
+  const Cheats::SearchFilter<T>& m_filter;
+  Cheats::SearchResultValueState m_host_state;
+  size_t m_first_straddling_bit;
+};
+
+template <typename T, typename Memory>
+void RunPageSearches(const Memory& memory, std::vector<PageSearch<T>>* pages, u32 stride,
+                     const Cheats::SearchFilter<T>& filter)
+{
+  const PageSearcher<T, Memory> searcher(memory, stride, filter);
+  for (PageSearch<T>& page : *pages)
+    searcher.ResolvePage(&page);
+
+  // Only spin up threads if there is enough work to make up for it.
+  constexpr size_t MIN_PAGES_PER_THREAD = 256;
+  const size_t thread_count =
+      std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u),
+                       pages->size() / MIN_PAGES_PER_THREAD + 1);
+  Common::ThreadPool thread_pool("Cheat Search", thread_count - 1);
+
+  DispatchFilter(filter, [&](auto compare) {
+    // Hand out pages in batches so that workers don't contend on the work counter too much.
+    constexpr size_t PAGES_PER_BATCH = 16;
+    thread_pool.ParallelFor((pages->size() + PAGES_PER_BATCH - 1) / PAGES_PER_BATCH,
+                            [&](size_t batch, size_t) {
+                              const size_t end =
+                                  std::min((batch + 1) * PAGES_PER_BATCH, pages->size());
+                              for (size_t i = batch * PAGES_PER_BATCH; i < end; ++i)
+                                searcher.SearchHostMemory(&(*pages)[i], compare);
+                            });
+
+    for (PageSearch<T>& page : *pages)
+      searcher.SearchEmulatedMemory(&page, compare);
+  });
+}
+
+template <typename T, typename Memory>
+Cheats::SearchResults<T> SearchNewPages(const Memory& memory,
+                                        const std::vector<Cheats::MemoryRange>& memory_ranges,
+                                        bool aligned, const Cheats::SearchFilter<T>& filter)
+{
+  constexpr u32 page_size = Cheats::SearchResults<T>::PAGE_SIZE;
+  const u32 data_size = sizeof(T);
+  const u32 stride = aligned ? data_size : 1;
+
+  std::vector<PageSearch<T>> pages;
+  for (const Cheats::MemoryRange& range : memory_ranges)
+  {
+    if (range.m_length < data_size)
+      continue;
+
+    const u32 start_address = aligned ? Common::AlignUp(range.m_start, data_size) : range.m_start;
+    const u64 aligned_length = range.m_length - (start_address - range.m_start);
+
+    if (aligned_length < data_size)
+      continue;
 
-    for (const auto& previous_result : previous_results)
+    // Addresses of the first and last value in the range.
+    const u64 first = start_address;
+    const u64 last = first + Common::AlignDown(aligned_length - data_size, stride);
+    for (u64 page_address = Common::AlignDown(first, page_size); page_address <= last;
+         page_address += page_size)
     {
-      const u32 addr = previous_result.m_address;
-      const auto current_value = TryReadValueFromEmulatedMemory<T>(guard, addr, address_space);
-      if (!current_value)
+      PageSearch<T>& page = pages.emplace_back();
+      page.address = static_cast<u32>(page_address);
+      page.previous = nullptr;
+      page.candidates = {};
+
+      const u64 first_bit = (std::max(first, page_address) - page_address) / stride;
+      const u64 last_bit = (std::min(last, page_address + page_size - 1) - page_address) / stride;
+      for (u64 word = first_bit / 64; word <= last_bit / 64; ++word)
       {
-        auto& r = results.emplace_back();
-        r.m_address = addr;
-        r.m_value_state = Cheats::SearchResultValueState::AddressNotAccessible;
-        continue;
+        u64 mask = ~u64(0);
+        if (word == first_bit / 64)
+          mask &= ~u64(0) << (first_bit % 64);
+        if (word == last_bit / 64)
+          mask &= ~u64(0) >> (63 - last_bit % 64);
+        page.candidates[word] = mask;
       }
+    }
+  }
+
+  RunPageSearches(memory, &pages, stride, filter);
+
+  Cheats::SearchResults<T> results(aligned);
+  for (PageSearch<T>& page : pages)
+    results.AddPage(std::move(page.result));
+  return results;
+}
+
+template <typename T, typename Memory>
+Cheats::SearchResults<T> SearchPreviousPages(const Memory& memory,
+                                             const Cheats::SearchResults<T>& previous_results,
+                                             const Cheats::SearchFilter<T>& filter)
+{
+  std::vector<PageSearch<T>> pages(previous_results.GetPages().size());
+  for (size_t i = 0; i < pages.size(); ++i)
+  {
+    const auto& previous = previous_results.GetPages()[i];
+    pages[i].address = previous.m_address;
+    pages[i].previous = &previous;
+    pages[i].candidates = previous.m_mask;
+  }
+
+  RunPageSearches(memory, &pages, previous_results.GetStride(), filter);
+
+  Cheats::SearchResults<T> results(previous_results.IsAligned());
+  for (PageSearch<T>& page : pages)
+    results.AddPage(std::move(page.result));
+  return results;
+}
+
+Cheats::SearchErrorCode CheckSearchPreconditions(PowerPC::RequestedAddressSpace address_space)
+{
+  const Core::State core_state = Core::GetState();
+  if (core_state != Core::State::Running && core_state != Core::State::Paused)
+    return Cheats::SearchErrorCode::NoEmulationActive;
+
+  auto& system = Core::System::GetInstance();
+  auto& ppc_state = system.GetPPCState();
+  if (address_space == PowerPC::RequestedAddressSpace::Virtual && !ppc_state.msr.DR)
+    return Cheats::SearchErrorCode::VirtualAddressesCurrentlyNotAccessible;
+
+  return Cheats::SearchErrorCode::Success;
+}
+}  // namespace
+
+template <typename T>
+size_t Cheats::SearchResults<T>::GetValidValueCount() const
+{
+  size_t count = 0;
+  for (const Page& page : m_pages)
+  {
+    if (page.m_states.empty())
+      count += IsValid(page.m_state) ? page.m_values.size() : 0;
+    else
+      count += std::count_if(page.m_states.begin(), page.m_states.end(), IsValid);
+  }
+  return count;
+}
 
-      // if the previous state was invalid we always update the value to avoid getting stuck in an
-      // invalid state
-      if (!previous_result.IsValueValid() ||
-          validator(current_value->value, previous_result.m_value))
+template <typename T>
+Cheats::SearchResult<T> Cheats::SearchResults<T>::Get(size_t index) const
+{
+  const size_t page_index =
+      std::upper_bound(m_first_index.begin(), m_first_index.end(), index) - m_first_index.begin() -
+      1;
+  const Page& page = m_pages[page_index];
+  const size_t value_index = index - m_first_index[page_index];
+
+  size_t remaining = value_index;
+  size_t word = 0;
+  while (remaining >= static_cast<size_t>(std::popcount(page.m_mask[word])))
+    remaining -= std::popcount(page.m_mask[word++]);
+  u64 mask = page.m_mask[word];
+  for (; remaining; --remaining)
+    mask &= mask - 1;
+  const size_t bit = word * 64 + std::countr_zero(mask);
+
+  SearchResult<T> result;
+  result.m_value = page.m_values[value_index];
+  result.m_value_state = page.GetState(value_index);
+  result.m_address = page.m_address + static_cast<u32>(bit) * GetStride();
+  return result;
+}
+
+template <typename T>
+Cheats::SearchResults<T> Cheats::SearchResults<T>::Select(std::vector<size_t> indices) const
+{
+  std::sort(indices.begin(), indices.end());
+  indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+  SearchResults<T> selection(m_aligned);
+  auto next_index = indices.begin();
+  for (size_t page_index = 0; page_index < m_pages.size() && next_index != indices.end();
+       ++page_index)
+  {
+    const Page& page = m_pages[page_index];
+    const size_t first_index = m_first_index[page_index];
+    if (*next_index >= first_index + page.m_values.size())
+      continue;
+
+    Page selected_page;
+    selected_page.m_address = page.m_address;
+    selected_page.m_state = page.m_state;
+    size_t value_index = 0;
+    for (size_t word = 0; word < page.m_mask.size(); ++word)
+    {
+      for (u64 mask = page.m_mask[word]; mask; mask &= mask - 1, ++value_index)
       {
-        auto& r = results.emplace_back();
-        r.m_value = current_value->value;
-        r.m_value_state = current_value->translated ?
-                              Cheats::SearchResultValueState::ValueFromVirtualMemory :
-                              Cheats::SearchResultValueState::ValueFromPhysicalMemory;
-        r.m_address = addr;
+        if (next_index == indices.end() || *next_index != first_index + value_index)
+          continue;
+
+        ++next_index;
+        selected_page.m_mask[word] |= mask & ~(mask - 1);
+        selected_page.m_values.push_back(page.m_values[value_index]);
+        if (!page.m_states.empty())
+          selected_page.m_states.push_back(page.m_states[value_index]);
       }
     }
+    selection.AddPage(std::move(selected_page));
+  }
+  return selection;
+}
+
+template <typename T>
+void Cheats::SearchResults<T>::AddPage(Page page)
+{
+  if (page.m_values.empty())
+    return;
+
+  m_first_index.push_back(m_count);
+  m_count += page.m_values.size();
+  m_pages.push_back(std::move(page));
+}
+
+template <typename T>
+Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<T>>
+Cheats::NewSearch(const Core::CPUThreadGuard& guard,
+                  const std::vector<Cheats::MemoryRange>& memory_ranges,
+                  PowerPC::RequestedAddressSpace address_space, bool aligned,
+                  const Cheats::SearchFilter<T>& filter)
+{
+  if (filter.m_filter_type == Cheats::FilterType::CompareAgainstLastValue)
+    return Cheats::SearchErrorCode::InvalidParameters;
+
+  Cheats::SearchResults<T> results(aligned);
+  Cheats::SearchErrorCode error_code = Cheats::SearchErrorCode::Success;
+  Core::RunAsCPUThread([&] {
+    error_code = CheckSearchPreconditions(address_space);
+    if (error_code != Cheats::SearchErrorCode::Success)
+      return;
+
+    results = SearchNewPages(EmulatedMemory(guard, address_space), memory_ranges, aligned, filter);
   });
   if (error_code == Cheats::SearchErrorCode::Success)
     return results;
   return error_code;
 }
 
+template <typename T>
+Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<T>>
+Cheats::NextSearch(const Core::CPUThreadGuard& guard,
+                   const Cheats::SearchResults<T>& previous_results,
+                   PowerPC::RequestedAddressSpace address_space,
+                   const Cheats::SearchFilter<T>& filter)
+{
+  Cheats::SearchResults<T> results(previous_results.IsAligned());
+  Cheats::SearchErrorCode error_code = Cheats::SearchErrorCode::Success;
+  Core::RunAsCPUThread([&] {
+    error_code = CheckSearchPreconditions(address_space);
+    if (error_code != Cheats::SearchErrorCode::Success)
+      return;
+
+    results = SearchPreviousPages(EmulatedMemory(guard, address_space), previous_results, filter);
+  });
+  if (error_code == Cheats::SearchErrorCode::Success)
+    return results;
+  return error_code;
+}
+
+template <typename T>
+Cheats::SearchResults<T> Cheats::NewSearchInBuffer(std::span<const u8> buffer, u32 base_address,
+                                                   const std::vector<MemoryRange>& memory_ranges,
+                                                   bool aligned, const SearchFilter<T>& filter)
+{
+  return SearchNewPages(BufferMemory(buffer, base_address), memory_ranges, aligned, filter);
+}
+
+template <typename T>
+Cheats::SearchResults<T> Cheats::NextSearchInBuffer(std::span<const u8> buffer, u32 base_address,
+                                                    const SearchResults<T>& previous_results,
+                                                    const SearchFilter<T>& filter)
+{
+  return SearchPreviousPages(BufferMemory(buffer, base_address), previous_results, filter);
+}
+
 Cheats::CheatSearchSessionBase::~CheatSearchSessionBase() = default;
 
 template <typename T>
 Cheats::CheatSearchSession<T>::CheatSearchSession(std::vector<MemoryRange> memory_ranges,
                                                   PowerPC::RequestedAddressSpace address_space,
                                                   bool aligned)
-    : m_memory_ranges(std::move(memory_ranges)), m_address_space(address_space), m_aligned(aligned)
+    : m_search_results(aligned), m_memory_ranges(std::move(memory_ranges)),
+      m_address_space(address_space), m_aligned(aligned)
 {
 }
 
@@ -390,101 +987,36 @@ template <typename T>
 void Cheats::CheatSearchSession<T>::ResetResults()
 {
   m_first_search_done = false;
-  m_search_results.clear();
-}
-
-template <typename T>
-static std::function<bool(const T& new_value)>
-MakeCompareFunctionForSpecificValue(Cheats::CompareType op, const T& old_value)
-{
-  switch (op)
-  {
-  case Cheats::CompareType::Equal:
-    return [&](const T& new_value) { return new_value == old_value; };
-  case Cheats::CompareType::NotEqual:
-    return [&](const T& new_value) { return new_value != old_value; };
-  case Cheats::CompareType::Less:
-    return [&](const T& new_value) { return new_value < old_value; };
-  case Cheats::CompareType::LessOrEqual:
-    return [&](const T& new_value) { return new_value <= old_value; };
-  case Cheats::CompareType::Greater:
-    return [&](const T& new_value) { return new_value > old_value; };
-  case Cheats::CompareType::GreaterOrEqual:
-    return [&](const T& new_value) { return new_value >= old_value; };
-  default:
-    DEBUG_ASSERT(false);
-    return nullptr;
-  }
-}
-
-template <typename T>
-static std::function<bool(const T& old_value, const T& new_value)>
-MakeCompareFunctionForLastValue(Cheats::CompareType op)
-{
-  switch (op)
-  {
-  case Cheats::CompareType::Equal:
-    return [](const T& new_value, const T& old_value) { return new_value == old_value; };
-  case Cheats::CompareType::NotEqual:
-    return [](const T& new_value, const T& old_value) { return new_value != old_value; };
-  case Cheats::CompareType::Less:
-    return [](const T& new_value, const T& old_value) { return new_value < old_value; };
-  case Cheats::CompareType::LessOrEqual:
-    return [](const T& new_value, const T& old_value) { return new_value <= old_value; };
-  case Cheats::CompareType::Greater:
-    return [](const T& new_value, const T& old_value) { return new_value > old_value; };
-  case Cheats::CompareType::GreaterOrEqual:
-    return [](const T& new_value, const T& old_value) { return new_value >= old_value; };
-  default:
-    DEBUG_ASSERT(false);
-    return nullptr;
-  }
+  m_search_results = SearchResults<T>(m_aligned);
 }
 
 template <typename T>
 Cheats::SearchErrorCode Cheats::CheatSearchSession<T>::RunSearch(const Core::CPUThreadGuard& guard)
 {
-  Common::Result<SearchErrorCode, std::vector<SearchResult<T>>> result =
-      Cheats::SearchErrorCode::InvalidParameters;
+  SearchFilter<T> filter;
+  filter.m_filter_type = m_filter_type;
+  filter.m_compare_type = m_compare_type;
   if (m_filter_type == FilterType::CompareAgainstSpecificValue)
   {
     if (!m_value)
       return Cheats::SearchErrorCode::InvalidParameters;
-
-    auto func = MakeCompareFunctionForSpecificValue<T>(m_compare_type, *m_value);
-    if (m_first_search_done)
-    {
-      result = Cheats::NextSearch<T>(
-          guard, m_search_results, m_address_space,
-          [&func](const T& new_value, const T& old_value) { return func(new_value); });
-    }
-    else
-    {
-      result = Cheats::NewSearch<T>(guard, m_memory_ranges, m_address_space, m_aligned, func);
-    }
+    filter.m_value = *m_value;
   }
   else if (m_filter_type == FilterType::CompareAgainstLastValue)
   {
     if (!m_first_search_done)
       return Cheats::SearchErrorCode::InvalidParameters;
-
-    result = Cheats::NextSearch<T>(guard, m_search_results, m_address_space,
-                                   MakeCompareFunctionForLastValue<T>(m_compare_type));
   }
-  else if (m_filter_type == FilterType::DoNotFilter)
+  else if (m_filter_type != FilterType::DoNotFilter)
   {
-    if (m_first_search_done)
-    {
-      result = Cheats::NextSearch<T>(guard, m_search_results, m_address_space,
-                                     [](const T& v1, const T& v2) { return true; });
-    }
-    else
-    {
-      result = Cheats::NewSearch<T>(guard, m_memory_ranges, m_address_space, m_aligned,
-                                    [](const T& v) { return true; });
-    }
+    return Cheats::SearchErrorCode::InvalidParameters;
   }
 
+  Common::Result<SearchErrorCode, SearchResults<T>> result =
+      m_first_search_done ?
+          Cheats::NextSearch<T>(guard, m_search_results, m_address_space, filter) :
+          Cheats::NewSearch<T>(guard, m_memory_ranges, m_address_space, m_aligned, filter);
+
   if (result.Succeeded())
   {
     m_search_results = std::move(*result);
@@ -540,64 +1072,58 @@ bool Cheats::CheatSearchSession<T>::IsFloatingType() const
 template <typename T>
 size_t Cheats::CheatSearchSession<T>::GetResultCount() const
 {
-  return m_search_results.size();
+  return m_search_results.GetCount();
 }
 
 template <typename T>
 size_t Cheats::CheatSearchSession<T>::GetValidValueCount() const
 {
-  const auto& results = m_search_results;
-  size_t count = 0;
-  for (const auto& r : results)
-  {
-    if (r.IsValueValid())
-      ++count;
-  }
-  return count;
+  return m_search_results.GetValidValueCount();
 }
 
 template <typename T>
 u32 Cheats::CheatSearchSession<T>::GetResultAddress(size_t index) const
 {
-  return m_search_results[index].m_address;
+  return m_search_results.Get(index).m_address;
 }
 
 template <typename T>
 T Cheats::CheatSearchSession<T>::GetResultValue(size_t index) const
 {
-  return m_search_results[index].m_value;
+  return m_search_results.Get(index).m_value;
 }
 
 template <typename T>
 Cheats::SearchValue Cheats::CheatSearchSession<T>::GetResultValueAsSearchValue(size_t index) const
 {
-  return Cheats::SearchValue{m_search_results[index].m_value};
+  return Cheats::SearchValue{GetResultValue(index)};
 }
 
 template <typename T>
 std::string Cheats::CheatSearchSession<T>::GetResultValueAsString(size_t index, bool hex) const
 {
-  if (GetResultValueState(index) == Cheats::SearchResultValueState::AddressNotAccessible)
+  const SearchResult<T> result = m_search_results.Get(index);
+  if (result.m_value_state == Cheats::SearchResultValueState::AddressNotAccessible)
     return "(inaccessible)";
 
   if (hex)
   {
     if constexpr (std::is_same_v<T, float>)
-      return fmt::format("0x{0:08x}", Common::BitCast<u32>(m_search_results[index].m_value));
+      return fmt::format("0x{0:08x}", Common::BitCast<u32>(result.m_value));
     else if constexpr (std::is_same_v<T, double>)
-      return fmt::format("0x{0:016x}", Common::BitCast<u64>(m_search_results[index].m_value));
+      return fmt::format("0x{0:016x}", Common::BitCast<u64>(result.m_value));
     else
-      return fmt::format("0x{0:0{1}x}", m_search_results[index].m_value, sizeof(T) * 2);
+      return fmt::format("0x{0:0{1}x}", result.m_value, sizeof(T) * 2);
   }
 
-  return fmt::format("{}", m_search_results[index].m_value);
+  return fmt::format("{}", result.m_value);
 }
 
 template <typename T>
 Cheats::SearchResultValueState
 Cheats::CheatSearchSession<T>::GetResultValueState(size_t index) const
 {
-  return m_search_results[index].m_value_state;
+  return m_search_results.Get(index).m_value_state;
 }
 
 template <typename T>
@@ -616,15 +1142,9 @@ template <typename T>
 std::unique_ptr<Cheats::CheatSearchSessionBase>
 Cheats::CheatSearchSession<T>::ClonePartial(const std::vector<size_t>& result_indices) const
 {
-  const auto& results = m_search_results;
-  std::vector<SearchResult<T>> partial_results;
-  partial_results.reserve(result_indices.size());
-  for (size_t idx : result_indices)
-    partial_results.push_back(results[idx]);
-
   auto c =
       std::make_unique<Cheats::CheatSearchSession<T>>(m_memory_ranges, m_address_space, m_aligned);
-  c->m_search_results = std::move(partial_results);
+  c->m_search_results = m_search_results.Select(result_indices);
   c->m_compare_type = this->m_compare_type;
   c->m_filter_type = this->m_filter_type;
   c->m_value = this->m_value;
@@ -632,6 +1152,17 @@ Cheats::CheatSearchSession<T>::ClonePartial(const std::vector<size_t>& result_in
   return c;
 }
 
+template class Cheats::SearchResults<u8>;
+template class Cheats::SearchResults<u16>;
+template class Cheats::SearchResults<u32>;
+template class Cheats::SearchResults<u64>;
+template class Cheats::SearchResults<s8>;
+template class Cheats::SearchResults<s16>;
+template class Cheats::SearchResults<s32>;
+template class Cheats::SearchResults<s64>;
+template class Cheats::SearchResults<float>;
+template class Cheats::SearchResults<double>;
+
 template class Cheats::CheatSearchSession<u8>;
 template class Cheats::CheatSearchSession<u16>;
 template class Cheats::CheatSearchSession<u32>;
@@ -643,6 +1174,67 @@ template class Cheats::CheatSearchSession<s64>;
 template class Cheats::CheatSearchSession<float>;
 template class Cheats::CheatSearchSession<double>;
 
+template Cheats::SearchResults<u8>
+Cheats::NewSearchInBuffer(std::span<const u8>, u32, const std::vector<MemoryRange>&, bool,
+                          const SearchFilter<u8>&);
+template Cheats::SearchResults<u8>
+Cheats::NextSearchInBuffer(std::span<const u8>, u32, const SearchResults<u8>&,
+                           const SearchFilter<u8>&);
+template Cheats::SearchResults<u16>
+Cheats::NewSearchInBuffer(std::span<const u8>, u32, const std::vector<MemoryRange>&, bool,
+                          const SearchFilter<u16>&);
+template Cheats::SearchResults<u16>
+Cheats::NextSearchInBuffer(std::span<const u8>, u32, const SearchResults<u16>&,
+                           const SearchFilter<u16>&);
+template Cheats::SearchResults<u32>
+Cheats::NewSearchInBuffer(std::span<const u8>, u32, const std::vector<MemoryRange>&, bool,
+                          const SearchFilter<u32>&);
+template Cheats::SearchResults<u32>
+Cheats::NextSearchInBuffer(std::span<const u8>, u32, const SearchResults<u32>&,
+                           const SearchFilter<u32>&);
+template Cheats::SearchResults<u64>
+Cheats::NewSearchInBuffer(std::span<const u8>, u32, const std::vector<MemoryRange>&, bool,
+                          const SearchFilter<u64>&);
+template Cheats::SearchResults<u64>
+Cheats::NextSearchInBuffer(std::span<const u8>, u32, const SearchResults<u64>&,
+                           const SearchFilter<u64>&);
+template Cheats::SearchResults<s8>
+Cheats::NewSearchInBuffer(std::span<const u8>, u32, const std::vector<MemoryRange>&, bool,
+                          const SearchFilter<s8>&);
+template Cheats::SearchResults<s8>
+Cheats::NextSearchInBuffer(std::span<const u8>, u32, const SearchResults<s8>&,
+                           const SearchFilter<s8>&);
+template Cheats::SearchResults<s16>
+Cheats::NewSearchInBuffer(std::span<const u8>, u32, const std::vector<MemoryRange>&, bool,
+                          const SearchFilter<s16>&);
+template Cheats::SearchResults<s16>
+Cheats::NextSearchInBuffer(std::span<const u8>, u32, const SearchResults<s16>&,
+                           const SearchFilter<s16>&);
+template Cheats::SearchResults<s32>
+Cheats::NewSearchInBuffer(std::span<const u8>, u32, const std::vector<MemoryRange>&, bool,
+                          const SearchFilter<s32>&);
+template Cheats::SearchResults<s32>
+Cheats::NextSearchInBuffer(std::span<const u8>, u32, const SearchResults<s32>&,
+                           const SearchFilter<s32>&);
+template Cheats::SearchResults<s64>
+Cheats::NewSearchInBuffer(std::span<const u8>, u32, const std::vector<MemoryRange>&, bool,
+                          const SearchFilter<s64>&);
+template Cheats::SearchResults<s64>
+Cheats::NextSearchInBuffer(std::span<const u8>, u32, const SearchResults<s64>&,
+                           const SearchFilter<s64>&);
+template Cheats::SearchResults<float>
+Cheats::NewSearchInBuffer(std::span<const u8>, u32, const std::vector<MemoryRange>&, bool,
+                          const SearchFilter<float>&);
+template Cheats::SearchResults<float>
+Cheats::NextSearchInBuffer(std::span<const u8>, u32, const SearchResults<float>&,
+                           const SearchFilter<float>&);
+template Cheats::SearchResults<double>
+Cheats::NewSearchInBuffer(std::span<const u8>, u32, const std::vector<MemoryRange>&, bool,
+                          const SearchFilter<double>&);
+template Cheats::SearchResults<double>
+Cheats::NextSearchInBuffer(std::span<const u8>, u32, const SearchResults<double>&,
+                           const SearchFilter<double>&);
+
 std::unique_ptr<Cheats::CheatSearchSessionBase>
 Cheats::MakeSession(std::vector<MemoryRange> memory_ranges,
                     PowerPC::RequestedAddressSpace address_space, bool aligned, DataType data_type)
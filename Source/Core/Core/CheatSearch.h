@@ -3,9 +3,11 @@
 
 #pragma once
 
-#include <functional>
+#include <array>
+#include <cstddef>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <variant>
 #include <vector>
@@ -78,6 +80,60 @@ struct SearchResult
   }
 };
 
+// The results of a search. Results are grouped by the memory page they are in, with a bitmap of
+// which addresses in the page are results and a tightly packed list of their values. This keeps
+// searches across all of RAM compact, and allows them to be processed a page at a time.
+template <typename T>
+class SearchResults
+{
+public:
+  static constexpr u32 PAGE_SIZE = 0x1000;
+  static constexpr size_t PAGE_MASK_WORDS = PAGE_SIZE / 64;
+
+  struct Page
+  {
+    u32 m_address = 0;
+    // Bit i is set if m_address + i * GetStride() is a result.
+    std::array<u64, PAGE_MASK_WORDS> m_mask{};
+    // The values of the results, in address order. The value of a result which is not valid is
+    // unspecified.
+    std::vector<T> m_values;
+    // The state of each result, in address order. Empty if all results have m_state.
+    std::vector<SearchResultValueState> m_states;
+    SearchResultValueState m_state = SearchResultValueState::ValueFromPhysicalMemory;
+
+    SearchResultValueState GetState(size_t value_index) const
+    {
+      return m_states.empty() ? m_state : m_states[value_index];
+    }
+  };
+
+  SearchResults() = default;
+  explicit SearchResults(bool aligned) : m_aligned(aligned) {}
+
+  bool IsAligned() const { return m_aligned; }
+  u32 GetStride() const { return m_aligned ? sizeof(T) : 1; }
+
+  size_t GetCount() const { return m_count; }
+  size_t GetValidValueCount() const;
+  SearchResult<T> Get(size_t index) const;
+
+  // Returns a copy which only contains the results with the given indices.
+  SearchResults Select(std::vector<size_t> indices) const;
+
+  const std::vector<Page>& GetPages() const { return m_pages; }
+
+  // Appends a page. Pages have to be added in the order their results should be returned in.
+  void AddPage(Page page);
+
+private:
+  std::vector<Page> m_pages;
+  // The index of the first result of each page.
+  std::vector<size_t> m_first_index;
+  size_t m_count = 0;
+  bool m_aligned = false;
+};
+
 struct MemoryRange
 {
   u32 m_start;
@@ -109,21 +165,41 @@ DataType GetDataType(const SearchValue& value);
 // patches or action replay codes.
 std::vector<u8> GetValueAsByteVector(const SearchValue& value);
 
+// Decides which values are kept by a search.
+template <typename T>
+struct SearchFilter
+{
+  FilterType m_filter_type = FilterType::DoNotFilter;
+  CompareType m_compare_type = CompareType::Equal;
+  // Only used for FilterType::CompareAgainstSpecificValue.
+  T m_value{};
+};
+
 // Do a new search across the given memory region in the given address space, only keeping values
-// for which the given validator returns true.
+// which pass the given filter. FilterType::CompareAgainstLastValue is not valid for a new search.
 template <typename T>
-Common::Result<SearchErrorCode, std::vector<SearchResult<T>>>
+Common::Result<SearchErrorCode, SearchResults<T>>
 NewSearch(const Core::CPUThreadGuard& guard, const std::vector<MemoryRange>& memory_ranges,
           PowerPC::RequestedAddressSpace address_space, bool aligned,
-          const std::function<bool(const T& value)>& validator);
+          const SearchFilter<T>& filter);
 
-// Refresh the values for the given results in the given address space, only keeping values for
-// which the given validator returns true.
+// Refresh the values for the given results in the given address space, only keeping values which
+// pass the given filter.
+template <typename T>
+Common::Result<SearchErrorCode, SearchResults<T>>
+NextSearch(const Core::CPUThreadGuard& guard, const SearchResults<T>& previous_results,
+           PowerPC::RequestedAddressSpace address_space, const SearchFilter<T>& filter);
+
+// Like NewSearch and NextSearch, but on a copy of memory which starts at base_address. Addresses
+// outside of the buffer are not accessible. Used by tests.
+template <typename T>
+SearchResults<T> NewSearchInBuffer(std::span<const u8> buffer, u32 base_address,
+                                   const std::vector<MemoryRange>& memory_ranges, bool aligned,
+                                   const SearchFilter<T>& filter);
 template <typename T>
-Common::Result<SearchErrorCode, std::vector<SearchResult<T>>>
-NextSearch(const Core::CPUThreadGuard& guard, const std::vector<SearchResult<T>>& previous_results,
-           PowerPC::RequestedAddressSpace address_space,
-           const std::function<bool(const T& new_value, const T& old_value)>& validator);
+SearchResults<T> NextSearchInBuffer(std::span<const u8> buffer, u32 base_address,
+                                    const SearchResults<T>& previous_results,
+                                    const SearchFilter<T>& filter);
 
 class CheatSearchSessionBase
 {
@@ -214,7 +290,7 @@ public:
   ClonePartial(const std::vector<size_t>& result_indices) const override;
 
 private:
-  std::vector<SearchResult<T>> m_search_results;
+  SearchResults<T> m_search_results;
   std::vector<MemoryRange> m_memory_ranges;
   PowerPC::RequestedAddressSpace m_address_space;
   CompareType m_compare_type = CompareType::Equal;
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cstring>
 #include <mutex>
 #include <queue>
@@ -95,6 +96,7 @@
 #include "VideoCommon/FrameDumper.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/PerformanceMetrics.h"
+#include "VideoCommon/PerformanceMetricsExporter.h"
 #include "VideoCommon/Present.h"
 #include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoEvents.h"
@@ -124,6 +126,7 @@ static std::atomic<bool> s_stop_frame_step;
 #ifdef USE_MEMORYWATCHER
 static std::unique_ptr<MemoryWatcher> s_memory_watcher;
 #endif
+static std::unique_ptr<PerformanceMetricsExporter> s_perf_metrics_exporter;
 
 struct HostJob
 {
@@ -389,6 +392,7 @@ static void CpuThread(const std::optional<std::string>& savestate_path, bool del
 
   // Clear performance data collected from previous threads.
   g_perf_metrics.Reset();
+  s_perf_metrics_exporter = PerformanceMetricsExporter::CreateFromConfig();
 
 #ifdef ANDROID
   // For some reason, calling the JNI function AttachCurrentThread from the CPU thread after a
@@ -444,6 +448,7 @@ static void CpuThread(const std::optional<std::string>& savestate_path, bool del
 #ifdef USE_MEMORYWATCHER
   s_memory_watcher.reset();
 #endif
+  s_perf_metrics_exporter.reset();
 
   s_is_started = false;
 
@@ -526,6 +531,13 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
   ASSERT(g_controller_interface.IsInit());
   g_controller_interface.ChangeWindow(wsi.render_window);
 
+  if (Config::Get(Config::MAIN_INPUT_POLLING_THREAD))
+  {
+    const int rate = std::clamp(Config::Get(Config::MAIN_INPUT_POLLING_RATE), 60, 8000);
+    g_controller_interface.StartInputThread(std::chrono::microseconds(1000000 / rate));
+  }
+  Common::ScopeGuard input_thread_guard{[] { g_controller_interface.StopInputThread(); }};
+
   Pad::LoadConfig();
   Pad::LoadGBAConfig();
   Keyboard::LoadConfig();
@@ -60,6 +60,63 @@ constexpr u16 idle_skip_sigs[NUM_IDLE_SIGS][MAX_IDLE_SIG_SIZE + 1] = {
      0, 0},
 };
 
+// Besides the exact signatures above, look for any tight loop which polls one of the mailboxes
+// and branches back to itself until the mail state changes:
+//
+//   LRS   $acX.M, @CMBH/@DMBH   (or LR $acX.M, @CMBH/@DMBH)
+//   ANDF  $acX.M, #imm          (or ANDCF)
+//   Jcc   <start of the loop>
+//
+// Variants of this show up in most AX and Zelda ucode versions with different registers, flags
+// and addresses, so matching the structure catches the ones the signature list misses.
+static bool IsMailboxPollLoop(const SDSP& dsp, u16 addr)
+{
+  u16 pc = addr;
+  const UDSPInstruction load = dsp.ReadIMEM(pc);
+
+  u16 loaded_reg;
+  u16 source;
+  if ((load & 0xf800) == 0x2000)
+  {
+    // LRS $(0x18+D), @M
+    loaded_reg = 0x18 + ((load >> 8) & 0x7);
+    source = load & 0xff;
+    pc += 1;
+  }
+  else if ((load & 0xffe0) == 0x00c0)
+  {
+    // LR $D, @M
+    const u16 address = dsp.ReadIMEM(static_cast<u16>(pc + 1));
+    if ((address & 0xff00) != 0xff00)
+      return false;
+    loaded_reg = load & 0x1f;
+    source = address & 0xff;
+    pc += 2;
+  }
+  else
+  {
+    return false;
+  }
+
+  if (source != DSP_CMBH && source != DSP_DMBH)
+    return false;
+
+  // ANDCF $acD.M, #I / ANDF $acD.M, #I
+  const UDSPInstruction test = dsp.ReadIMEM(pc);
+  if ((test & 0xfeff) != 0x02c0 && (test & 0xfeff) != 0x02a0)
+    return false;
+  if (loaded_reg != DSP_REG_ACM0 + ((test >> 8) & 0x1))
+    return false;
+  pc += 2;
+
+  // Jcc back to the start of the loop. An unconditional jump would never exit.
+  const UDSPInstruction jump = dsp.ReadIMEM(pc);
+  if ((jump & 0xfff0) != 0x0290 || (jump & 0xf) == 0xf)
+    return false;
+
+  return dsp.ReadIMEM(static_cast<u16>(pc + 1)) == addr;
+}
+
 Analyzer::Analyzer() = default;
 Analyzer::~Analyzer() = default;
 
@@ -169,5 +226,14 @@ void Analyzer::FindIdleSkips(const SDSP& dsp, u16 start_addr, u16 end_addr)
       }
     }
   }
+
+  for (u16 addr = start_addr; addr < end_addr; addr++)
+  {
+    if (IsStartOfInstruction(addr) && !IsIdleSkip(addr) && IsMailboxPollLoop(dsp, addr))
+    {
+      INFO_LOG_FMT(DSPLLE, "Idle skip location found at {:02x} (mailbox poll loop)", addr);
+      m_code_flags[addr] |= CODE_IDLE_SKIP;
+    }
+  }
 }
 }  // namespace DSP
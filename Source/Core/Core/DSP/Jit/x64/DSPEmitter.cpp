@@ -282,14 +282,7 @@ void DSPEmitter::Compile(u16 start_addr)
       DSPJitRegCache c(m_gpr);
       HandleLoop();
       m_gpr.SaveRegs();
-      if (!Host::OnThread() && analyzer.IsIdleSkip(start_addr))
-      {
-        MOV(16, R(EAX), Imm16(DSP_IDLE_SKIP_CYCLES));
-      }
-      else
-      {
-        MOV(16, R(EAX), Imm16(m_block_size[start_addr]));
-      }
+      MOV(16, R(EAX), Imm16(GetBlockExitCycles()));
       JMP(m_return_dispatcher, Jump::Near);
       m_gpr.LoadRegs(false);
       m_gpr.FlushRegs(c, false);
@@ -318,14 +311,7 @@ void DSPEmitter::Compile(u16 start_addr)
         DSPJitRegCache c(m_gpr);
         // don't update g_dsp.pc -- the branch insn already did
         m_gpr.SaveRegs();
-        if (!Host::OnThread() && analyzer.IsIdleSkip(start_addr))
-        {
-          MOV(16, R(EAX), Imm16(DSP_IDLE_SKIP_CYCLES));
-        }
-        else
-        {
-          MOV(16, R(EAX), Imm16(m_block_size[start_addr]));
-        }
+        MOV(16, R(EAX), Imm16(GetBlockExitCycles()));
         JMP(m_return_dispatcher, Jump::Near);
         m_gpr.LoadRegs(false);
         m_gpr.FlushRegs(c, false);
@@ -344,6 +330,10 @@ void DSPEmitter::Compile(u16 start_addr)
   if (fixup_pc)
   {
     MOV(16, M_SDSP_pc(), Imm16(m_compile_pc));
+
+    // The block ended without branching (it got too long, or the next instruction starts an idle
+    // loop), so chain straight into the next block instead of going through the dispatcher.
+    EmitBlockLink(m_compile_pc);
   }
 
   m_blocks[start_addr] = (DSPCompiledCode)entryPoint;
@@ -381,17 +371,21 @@ void DSPEmitter::Compile(u16 start_addr)
   }
 
   m_gpr.SaveRegs();
-  if (!Host::OnThread() && analyzer.IsIdleSkip(start_addr))
-  {
-    MOV(16, R(EAX), Imm16(DSP_IDLE_SKIP_CYCLES));
-  }
-  else
-  {
-    MOV(16, R(EAX), Imm16(m_block_size[start_addr]));
-  }
+  MOV(16, R(EAX), Imm16(GetBlockExitCycles()));
   JMP(m_return_dispatcher, Jump::Near);
 }
 
+u16 DSPEmitter::GetBlockExitCycles() const
+{
+  // Idle loops (the DSP waiting for mail) give up the rest of the time slice. This also applies
+  // when running on the DSP thread, which then sleeps until it is given more cycles instead of
+  // spinning on the mailbox registers.
+  if (m_dsp_core.DSPState().GetAnalyzer().IsIdleSkip(m_start_address))
+    return DSP_IDLE_SKIP_CYCLES;
+
+  return m_block_size[m_start_address];
+}
+
 void DSPEmitter::CompileCurrent(DSPEmitter& emitter)
 {
   emitter.Compile(emitter.m_dsp_core.DSPState().pc);
@@ -213,6 +213,8 @@ private:
 
   void WriteBranchExit();
   void WriteBlockLink(u16 dest);
+  void EmitBlockLink(u16 dest);
+  u16 GetBlockExitCycles() const;
 
   void ReJitConditional(UDSPInstruction opc, void (DSPEmitter::*conditional_fn)(UDSPInstruction));
   void r_jcc(UDSPInstruction opc);
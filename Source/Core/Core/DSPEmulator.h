@@ -27,6 +27,8 @@ public:
   virtual u16 DSP_ReadControlRegister() = 0;
   virtual u16 DSP_WriteControlRegister(u16 value) = 0;
   virtual void DSP_Update(int cycles) = 0;
+  // Called before the CPU side accesses ARAM, for DSP emulators which may lag behind the CPU.
+  virtual void DSP_SyncForARAMAccess() {}
   virtual void DSP_StopSoundStream() = 0;
   virtual u32 DSP_UpdateRate() = 0;
 
@@ -131,7 +131,10 @@ void DolphinAnalytics::ReportGameStart()
   Send(builder);
 
   // Reset per-game state.
-  m_reported_quirks.fill(false);
+  {
+    std::lock_guard lk{m_reported_quirks_mutex};
+    m_reported_quirks.fill(false);
+  }
   InitializePerformanceSampling();
 }
 
@@ -174,9 +177,12 @@ void DolphinAnalytics::ReportGameQuirk(GameQuirk quirk)
   u32 quirk_idx = static_cast<u32>(quirk);
 
   // Only report once per run.
-  if (m_reported_quirks[quirk_idx])
-    return;
-  m_reported_quirks[quirk_idx] = true;
+  {
+    std::lock_guard lk{m_reported_quirks_mutex};
+    if (m_reported_quirks[quirk_idx])
+      return;
+    m_reported_quirks[quirk_idx] = true;
+  }
 
   Common::AnalyticsReportBuilder builder(m_per_game_builder);
   builder.AddData("type", "quirk");
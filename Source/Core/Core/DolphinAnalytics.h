@@ -176,8 +176,10 @@ private:
   bool m_sampling_performance_info = false;  // Whether we are currently collecting samples.
   std::vector<PerformanceSample> m_performance_samples;
 
-  // What quirks have already been reported about the current game.
+  // What quirks have already been reported about the current game. Quirks can be reported from
+  // any thread (e.g. the AX HLE voice threads), so this is guarded by its own mutex.
   std::array<bool, static_cast<size_t>(GameQuirk::COUNT)> m_reported_quirks;
+  std::mutex m_reported_quirks_mutex;
 
   // Builder that contains all non variable data that should be sent with all
   // reports.
@@ -459,6 +459,8 @@ void DSPManager::Do_ARAM_DMA()
   auto& core_timing = m_system.GetCoreTiming();
   auto& memory = m_system.GetMemory();
 
+  m_dsp_emulator->DSP_SyncForARAMAccess();
+
   m_dsp_control.DMAState = 1;
 
   // ARAM DMA transfer rate has been measured on real hw
@@ -7,6 +7,7 @@
 #include <array>
 #include <cstring>
 #include <iterator>
+#include <vector>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -15,6 +16,7 @@
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/DSP.h"
@@ -30,6 +32,10 @@ namespace DSP::HLE
 AXUCode::AXUCode(DSPHLE* dsphle, u32 crc) : UCodeInterface(dsphle, crc)
 {
   INFO_LOG_FMT(DSPHLE, "Instantiating AXUCode: crc={:08x}", crc);
+
+  const int voice_threads = std::clamp(Config::Get(Config::MAIN_DSP_HLE_VOICE_THREADS), 0, 16);
+  if (voice_threads > 0)
+    m_voice_threads.Reset("AX Voice Worker", voice_threads);
 }
 
 void AXUCode::Initialize()
@@ -404,6 +410,9 @@ void AXUCode::ProcessPBList(u32 pb_addr)
   // 32KHz to 48KHz, but AX always process at 32KHz.
   constexpr u32 spms = 32;
 
+  if (m_voice_threads.GetThreadCount() > 1 && ProcessPBListInParallel(pb_addr))
+    return;
+
   AXPB pb;
 
   while (pb_addr)
@@ -434,6 +443,100 @@ void AXUCode::ProcessPBList(u32 pb_addr)
   }
 }
 
+bool AXUCode::ProcessPBListInParallel(u32 pb_addr)
+{
+  constexpr u32 spms = 32;
+
+  // Read the whole list first. Only the PB updates can change next_pb, so applying all of them to
+  // a copy of the PB is enough to find the next one.
+  std::vector<u32> pb_addrs;
+  std::vector<AXPB> pbs;
+  std::vector<u16*> updates;
+  std::vector<VoiceMemoryRange> ranges;
+  while (pb_addr)
+  {
+    // Guard against games building a circular list. The serial path is used for those, so that
+    // they at least hang the same way they did before.
+    if (pbs.size() == 0x1000)
+      return false;
+
+    AXPB& pb = pbs.emplace_back();
+    ReadPB(pb_addr, pb, m_crc);
+
+    const u32 updates_addr = HILO_TO_32(pb.updates.data);
+    u16* pb_updates = (u16*)HLEMemory_Get_Pointer(updates_addr);
+
+    AXPB next_pb = pb;
+    for (int curr_ms = 0; curr_ms < 5; ++curr_ms)
+      ApplyUpdatesForMs(curr_ms, next_pb, next_pb.updates.num_updates, pb_updates);
+
+    u32 num_updates = 0;
+    for (u16 ms_updates : next_pb.updates.num_updates)
+      num_updates += ms_updates;
+
+    pb_addrs.push_back(pb_addr);
+    updates.push_back(pb_updates);
+    ranges.emplace_back(pb_addr, u32(sizeof(AXPB)));
+    ranges.emplace_back(updates_addr, num_updates * 4);
+
+    pb_addr = HILO_TO_32(next_pb.next_pb);
+  }
+
+  if (!AreVoiceMemoryRangesDisjoint(ranges))
+    return false;
+
+  const std::array<BufferDesc, 9> mixing_buffers = {{
+      {m_samples_main_left, spms},
+      {m_samples_main_right, spms},
+      {m_samples_main_surround, spms},
+      {m_samples_auxA_left, spms},
+      {m_samples_auxA_right, spms},
+      {m_samples_auxA_surround, spms},
+      {m_samples_auxB_left, spms},
+      {m_samples_auxB_right, spms},
+      {m_samples_auxB_surround, spms},
+  }};
+  ClearVoiceThreadBuffers<5>(mixing_buffers);
+
+  m_voice_threads.ParallelFor(pbs.size(), [&](size_t voice, size_t thread_index) {
+    AXBuffers buffers;
+    const auto thread_buffers = GetVoiceThreadBuffers<5>(mixing_buffers, thread_index);
+    std::copy(thread_buffers.begin(), thread_buffers.end(), std::begin(buffers.ptrs));
+
+    AXPB& pb = pbs[voice];
+    for (int curr_ms = 0; curr_ms < 5; ++curr_ms)
+    {
+      ApplyUpdatesForMs(curr_ms, pb, pb.updates.num_updates, updates[voice]);
+
+      ProcessVoice(pb, buffers, spms, ConvertMixerControl(pb.mixer_control),
+                   m_coeffs_checksum ? m_coeffs.data() : nullptr);
+
+      // Forward the buffers
+      for (auto& ptr : buffers.ptrs)
+        ptr += spms;
+    }
+  });
+
+  for (size_t voice = 0; voice < pbs.size(); ++voice)
+    WritePB(pb_addrs[voice], pbs[voice], m_crc);
+
+  MergeVoiceThreadBuffers<5>(mixing_buffers);
+  return true;
+}
+
+bool AXUCode::AreVoiceMemoryRangesDisjoint(std::vector<VoiceMemoryRange>& ranges)
+{
+  std::erase_if(ranges, [](const VoiceMemoryRange& range) { return range.second == 0; });
+  std::sort(ranges.begin(), ranges.end());
+
+  for (size_t i = 1; i < ranges.size(); ++i)
+  {
+    if (u64(ranges[i - 1].first) + ranges[i - 1].second > ranges[i].first)
+      return false;
+  }
+  return true;
+}
+
 void AXUCode::MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr)
 {
   int* buffers[3] = {nullptr};
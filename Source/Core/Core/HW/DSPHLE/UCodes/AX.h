@@ -13,10 +13,13 @@
 
 #include <array>
 #include <optional>
+#include <utility>
+#include <vector>
 
 #include "Common/BitUtils.h"
 #include "Common/CommonTypes.h"
 #include "Common/Swap.h"
+#include "Common/ThreadPool.h"
 #include "Core/HW/DSPHLE/UCodes/UCodes.h"
 #include "Core/HW/Memmap.h"
 #include "Core/System.h"
@@ -163,9 +166,68 @@ protected:
       }
     }
   }
+  // Voices can optionally be processed in parallel (see MAIN_DSP_HLE_VOICE_THREADS). Every thread
+  // then mixes into its own zeroed copy of the mixing buffers, and the copies are added to the
+  // real buffers once all voices are done. Voices only ever add to the mixing buffers, and
+  // integer addition is associative, so the output is identical to processing them serially.
+  Common::ThreadPool m_voice_threads;
+  std::vector<int> m_voice_thread_samples;
+
+  // A (start address, size) pair of emulated memory which a voice reads from or writes to.
+  using VoiceMemoryRange = std::pair<u32, u32>;
+
+  // Voices can only be processed out of order if none of their PBs (or update lists) overlap,
+  // which is always the case for well-behaved games.
+  static bool AreVoiceMemoryRangesDisjoint(std::vector<VoiceMemoryRange>& ranges);
+
+  // Zeroes the per-thread copies of the given mixing buffers.
+  template <int Millis, size_t BufCount>
+  void ClearVoiceThreadBuffers(const std::array<BufferDesc, BufCount>& buffers)
+  {
+    size_t samples_per_thread = 0;
+    for (const BufferDesc& buf : buffers)
+      samples_per_thread += Millis * buf.samples_per_milli;
+    m_voice_thread_samples.assign(m_voice_threads.GetThreadCount() * samples_per_thread, 0);
+  }
+
+  // Returns thread_index's copy of each of the given mixing buffers.
+  template <int Millis, size_t BufCount>
+  std::array<int*, BufCount> GetVoiceThreadBuffers(const std::array<BufferDesc, BufCount>& buffers,
+                                                   size_t thread_index)
+  {
+    const size_t samples_per_thread =
+        m_voice_thread_samples.size() / m_voice_threads.GetThreadCount();
+    int* ptr = m_voice_thread_samples.data() + thread_index * samples_per_thread;
+
+    std::array<int*, BufCount> thread_buffers;
+    for (size_t i = 0; i < BufCount; ++i)
+    {
+      thread_buffers[i] = ptr;
+      ptr += Millis * buffers[i].samples_per_milli;
+    }
+    return thread_buffers;
+  }
+
+  // Adds what every thread mixed to the given mixing buffers.
+  template <int Millis, size_t BufCount>
+  void MergeVoiceThreadBuffers(const std::array<BufferDesc, BufCount>& buffers)
+  {
+    for (size_t thread = 0; thread < m_voice_threads.GetThreadCount(); ++thread)
+    {
+      const std::array<int*, BufCount> thread_buffers =
+          GetVoiceThreadBuffers<Millis>(buffers, thread);
+      for (size_t i = 0; i < BufCount; ++i)
+      {
+        for (int j = 0; j < Millis * buffers[i].samples_per_milli; ++j)
+          buffers[i].ptr[j] += thread_buffers[i][j];
+      }
+    }
+  }
+
   void SetupProcessing(u32 init_addr);
   void DownloadAndMixWithVolume(u32 addr, u16 vol_main, u16 vol_auxa, u16 vol_auxb);
   void ProcessPBList(u32 pb_addr);
+  bool ProcessPBListInParallel(u32 pb_addr);
   void MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr);
   void UploadLRS(u32 dst_addr);
   void SetMainLR(u32 src_addr);
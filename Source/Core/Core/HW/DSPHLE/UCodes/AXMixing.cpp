@@ -0,0 +1,214 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DSPHLE/UCodes/AXMixing.h"
+
+#include <algorithm>
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+
+#if defined(_M_X86_64)
+#include "Common/Intrinsics.h"
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
+namespace DSP::HLE::AXMixing
+{
+namespace
+{
+// The volume is a u16 in the PB, so all volume arithmetic wraps around at 16 bits. The SIMD
+// versions keep it in 32-bit lanes (which wrap around at a multiple of 2^16) and mask it before
+// use.
+//
+// input * volume always fits in a s32 (-32768 * 65535 > INT32_MIN), so none of the versions need
+// wider intermediates.
+s32 ScaleSample(s16 input, u16 volume)
+{
+  return std::clamp((s32(input) * s32(volume)) >> 15, -32767, 32767);
+}
+
+// If Accumulate is set, the scaled samples are added to mix_out, otherwise they are stored to
+// scaled_out. Returns the volume after processing <count> samples starting at <start>.
+template <bool Accumulate>
+u16 ScaleSamples_Scalar(int* mix_out, s16* scaled_out, const s16* input, u32 start, u32 count,
+                        u16 volume, u16 volume_delta)
+{
+  for (u32 i = start; i < count; ++i)
+  {
+    const s32 sample = ScaleSample(input[i], volume);
+    if constexpr (Accumulate)
+      mix_out[i] += sample;
+    else
+      scaled_out[i] = static_cast<s16>(sample);
+    volume += volume_delta;
+  }
+  return volume;
+}
+
+#if defined(_M_X86_64)
+template <bool Accumulate>
+FUNCTION_TARGET_SSR41 u16 ScaleSamples_SSE41(int* mix_out, s16* scaled_out, const s16* input,
+                                             u32 count, u16 volume, u16 volume_delta)
+{
+  const __m128i lane_volume_steps =
+      _mm_mullo_epi32(_mm_set1_epi32(volume_delta), _mm_setr_epi32(0, 1, 2, 3));
+  const __m128i volume_step = _mm_set1_epi32(volume_delta * 4);
+  const __m128i volume_mask = _mm_set1_epi32(0xFFFF);
+  const __m128i min_sample = _mm_set1_epi32(-32767);
+  const __m128i max_sample = _mm_set1_epi32(32767);
+
+  __m128i volumes = _mm_add_epi32(_mm_set1_epi32(volume), lane_volume_steps);
+
+  u32 i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    const __m128i samples =
+        _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(input + i)));
+    __m128i scaled =
+        _mm_srai_epi32(_mm_mullo_epi32(samples, _mm_and_si128(volumes, volume_mask)), 15);
+    scaled = _mm_min_epi32(_mm_max_epi32(scaled, min_sample), max_sample);
+
+    if constexpr (Accumulate)
+    {
+      __m128i* out = reinterpret_cast<__m128i*>(mix_out + i);
+      _mm_storeu_si128(out, _mm_add_epi32(_mm_loadu_si128(out), scaled));
+    }
+    else
+    {
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(scaled_out + i), _mm_packs_epi32(scaled, scaled));
+    }
+
+    volumes = _mm_add_epi32(volumes, volume_step);
+  }
+
+  return ScaleSamples_Scalar<Accumulate>(mix_out, scaled_out, input, i, count,
+                                         static_cast<u16>(volume + i * volume_delta),
+                                         volume_delta);
+}
+
+template <bool Accumulate>
+FUNCTION_TARGET_AVX2 u16 ScaleSamples_AVX2(int* mix_out, s16* scaled_out, const s16* input,
+                                           u32 count, u16 volume, u16 volume_delta)
+{
+  const __m256i lane_volume_steps = _mm256_mullo_epi32(_mm256_set1_epi32(volume_delta),
+                                                       _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+  const __m256i volume_step = _mm256_set1_epi32(volume_delta * 8);
+  const __m256i volume_mask = _mm256_set1_epi32(0xFFFF);
+  const __m256i min_sample = _mm256_set1_epi32(-32767);
+  const __m256i max_sample = _mm256_set1_epi32(32767);
+
+  __m256i volumes = _mm256_add_epi32(_mm256_set1_epi32(volume), lane_volume_steps);
+
+  u32 i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m256i samples =
+        _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i)));
+    __m256i scaled =
+        _mm256_srai_epi32(_mm256_mullo_epi32(samples, _mm256_and_si256(volumes, volume_mask)), 15);
+    scaled = _mm256_min_epi32(_mm256_max_epi32(scaled, min_sample), max_sample);
+
+    if constexpr (Accumulate)
+    {
+      __m256i* out = reinterpret_cast<__m256i*>(mix_out + i);
+      _mm256_storeu_si256(out, _mm256_add_epi32(_mm256_loadu_si256(out), scaled));
+    }
+    else
+    {
+      // _mm256_packs_epi32 packs within 128-bit lanes, so pack the two halves manually instead.
+      const __m128i packed = _mm_packs_epi32(_mm256_castsi256_si128(scaled),
+                                             _mm256_extracti128_si256(scaled, 1));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(scaled_out + i), packed);
+    }
+
+    volumes = _mm256_add_epi32(volumes, volume_step);
+  }
+
+  return ScaleSamples_Scalar<Accumulate>(mix_out, scaled_out, input, i, count,
+                                         static_cast<u16>(volume + i * volume_delta),
+                                         volume_delta);
+}
+#elif defined(_M_ARM_64)
+template <bool Accumulate>
+u16 ScaleSamples_NEON(int* mix_out, s16* scaled_out, const s16* input, u32 count, u16 volume,
+                      u16 volume_delta)
+{
+  static constexpr s32 lane_indices[4] = {0, 1, 2, 3};
+  const int32x4_t lane_volume_steps =
+      vmulq_s32(vdupq_n_s32(volume_delta), vld1q_s32(lane_indices));
+  const int32x4_t volume_step = vdupq_n_s32(volume_delta * 4);
+  const int32x4_t volume_mask = vdupq_n_s32(0xFFFF);
+  const int32x4_t min_sample = vdupq_n_s32(-32767);
+  const int32x4_t max_sample = vdupq_n_s32(32767);
+
+  int32x4_t volumes = vaddq_s32(vdupq_n_s32(volume), lane_volume_steps);
+
+  u32 i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    const int32x4_t samples = vmovl_s16(vld1_s16(input + i));
+    int32x4_t scaled = vshrq_n_s32(vmulq_s32(samples, vandq_s32(volumes, volume_mask)), 15);
+    scaled = vminq_s32(vmaxq_s32(scaled, min_sample), max_sample);
+
+    if constexpr (Accumulate)
+      vst1q_s32(mix_out + i, vaddq_s32(vld1q_s32(mix_out + i), scaled));
+    else
+      vst1_s16(scaled_out + i, vmovn_s32(scaled));
+
+    volumes = vaddq_s32(volumes, volume_step);
+  }
+
+  return ScaleSamples_Scalar<Accumulate>(mix_out, scaled_out, input, i, count,
+                                         static_cast<u16>(volume + i * volume_delta),
+                                         volume_delta);
+}
+#endif
+
+using ScaleSamplesFunction = u16 (*)(int* mix_out, s16* scaled_out, const s16* input, u32 count,
+                                     u16 volume, u16 volume_delta);
+
+template <bool Accumulate>
+u16 ScaleSamples_Generic(int* mix_out, s16* scaled_out, const s16* input, u32 count, u16 volume,
+                         u16 volume_delta)
+{
+  return ScaleSamples_Scalar<Accumulate>(mix_out, scaled_out, input, 0, count, volume,
+                                         volume_delta);
+}
+
+template <bool Accumulate>
+ScaleSamplesFunction GetScaleSamplesFunction()
+{
+#if defined(_M_X86_64)
+  if (cpu_info.bAVX2)
+    return ScaleSamples_AVX2<Accumulate>;
+  if (cpu_info.bSSE4_1)
+    return ScaleSamples_SSE41<Accumulate>;
+  return ScaleSamples_Generic<Accumulate>;
+#elif defined(_M_ARM_64)
+  return ScaleSamples_NEON<Accumulate>;
+#else
+  return ScaleSamples_Generic<Accumulate>;
+#endif
+}
+}  // namespace
+
+s16 MixAdd(int* out, const s16* input, u32 count, u16* volume, u16 volume_delta)
+{
+  static const ScaleSamplesFunction scale_samples = GetScaleSamplesFunction<true>();
+
+  const u16 last_volume = static_cast<u16>(*volume + (count - 1) * volume_delta);
+  *volume = scale_samples(out, nullptr, input, count, *volume, volume_delta);
+
+  // Recomputing the last sample is cheaper than getting it out of a vector register.
+  return static_cast<s16>(ScaleSample(input[count - 1], last_volume));
+}
+
+void ApplyVolume(s16* samples, u32 count, u16* volume, u16 volume_delta)
+{
+  static const ScaleSamplesFunction scale_samples = GetScaleSamplesFunction<false>();
+
+  *volume = scale_samples(nullptr, samples, samples, count, *volume, volume_delta);
+}
+}  // namespace DSP::HLE::AXMixing
@@ -0,0 +1,26 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+// Vectorized versions of the per-sample loops in AXVoice.h. These are shared between AX GC and
+// AX Wii, and produce exactly the same output as the scalar loops they replace.
+namespace DSP::HLE::AXMixing
+{
+// Scales each input sample by a volume which starts at <volume> and wraps around after adding
+// <volume_delta> for each sample, then saturates the result to [-32767, 32767]:
+//
+//   sample = clamp((input[i] * volume) >> 15, -32767, 32767);
+//   volume += volume_delta;
+//
+// <volume> is updated to the volume after the last sample.
+
+// Adds the scaled samples to <out>. Returns the last scaled sample, which is what the ucode keeps
+// as the dpop value. <count> must not be zero.
+s16 MixAdd(int* out, const s16* input, u32 count, u16* volume, u16 volume_delta);
+
+// Replaces <samples> with the scaled samples.
+void ApplyVolume(s16* samples, u32 count, u16* volume, u16 volume_delta);
+}  // namespace DSP::HLE::AXMixing
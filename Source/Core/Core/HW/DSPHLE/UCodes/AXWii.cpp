@@ -7,6 +7,8 @@
 
 #include <algorithm>
 #include <array>
+#include <iterator>
+#include <vector>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -414,6 +416,10 @@ void AXWiiUCode::ProcessPBList(u32 pb_addr)
   // 32KHz to 48KHz, but AX always process at 32KHz.
   constexpr u32 spms = 32;
 
+  // Old AXWii versions apply updates every millisecond, which is left to the serial path.
+  if (!m_old_axwii && m_voice_threads.GetThreadCount() > 1 && ProcessPBListInParallel(pb_addr))
+    return;
+
   AXPBWii pb;
 
   while (pb_addr)
@@ -456,6 +462,60 @@ void AXWiiUCode::ProcessPBList(u32 pb_addr)
   }
 }
 
+bool AXWiiUCode::ProcessPBListInParallel(u32 pb_addr)
+{
+  // Without updates nothing can change next_pb, so the whole list can be read upfront.
+  std::vector<u32> pb_addrs;
+  std::vector<AXPBWii> pbs;
+  std::vector<VoiceMemoryRange> ranges;
+  while (pb_addr)
+  {
+    // Guard against games building a circular list. The serial path is used for those, so that
+    // they at least hang the same way they did before.
+    if (pbs.size() == 0x1000)
+      return false;
+
+    AXPBWii& pb = pbs.emplace_back();
+    ReadPB(pb_addr, pb, m_crc);
+
+    pb_addrs.push_back(pb_addr);
+    ranges.emplace_back(pb_addr, u32(sizeof(AXPBWii)));
+
+    pb_addr = HILO_TO_32(pb.next_pb);
+  }
+
+  if (!AreVoiceMemoryRangesDisjoint(ranges))
+    return false;
+
+  const std::array<BufferDesc, 20> mixing_buffers = {{
+      {m_samples_main_left, 32}, {m_samples_main_right, 32}, {m_samples_main_surround, 32},
+      {m_samples_auxA_left, 32}, {m_samples_auxA_right, 32}, {m_samples_auxA_surround, 32},
+      {m_samples_auxB_left, 32}, {m_samples_auxB_right, 32}, {m_samples_auxB_surround, 32},
+      {m_samples_auxC_left, 32}, {m_samples_auxC_right, 32}, {m_samples_auxC_surround, 32},
+
+      {m_samples_wm0, 6},        {m_samples_aux0, 6},        {m_samples_wm1, 6},
+      {m_samples_aux1, 6},       {m_samples_wm2, 6},         {m_samples_aux2, 6},
+      {m_samples_wm3, 6},        {m_samples_aux3, 6},
+  }};
+  ClearVoiceThreadBuffers<3>(mixing_buffers);
+
+  m_voice_threads.ParallelFor(pbs.size(), [&](size_t voice, size_t thread_index) {
+    AXBuffers buffers;
+    const auto thread_buffers = GetVoiceThreadBuffers<3>(mixing_buffers, thread_index);
+    std::copy(thread_buffers.begin(), thread_buffers.end(), std::begin(buffers.ptrs));
+
+    AXPBWii& pb = pbs[voice];
+    ProcessVoice(pb, buffers, 96, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
+                 m_coeffs_checksum ? m_coeffs.data() : nullptr);
+  });
+
+  for (size_t voice = 0; voice < pbs.size(); ++voice)
+    WritePB(pb_addrs[voice], pbs[voice], m_crc);
+
+  MergeVoiceThreadBuffers<3>(mixing_buffers);
+  return true;
+}
+
 void AXWiiUCode::MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr, u16 volume)
 {
   std::array<u16, 96> volume_ramp;
@@ -63,6 +63,7 @@ protected:
   void AddToLR(u32 val_addr, bool neg);
   void AddSubToLR(u32 val_addr);
   void ProcessPBList(u32 pb_addr);
+  bool ProcessPBListInParallel(u32 pb_addr);
   void MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr, u16 volume);
   void UploadAUXMixLRSC(int aux_id, u32* addresses, u16 volume);
   void OutputSamples(u32 lr_addr, u32 surround_addr, u16 volume, bool upload_auxc);
@@ -3,6 +3,8 @@
 
 #include "Core/HW/DSPLLE/DSPLLE.h"
 
+#include <algorithm>
+#include <array>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -15,6 +17,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/MemoryUtil.h"
 #include "Common/Thread.h"
+#include "Common/Timer.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
@@ -27,9 +30,17 @@
 #include "Core/DSP/Jit/DSPEmitterBase.h"
 #include "Core/HW/Memmap.h"
 #include "Core/Host.h"
+#include "VideoCommon/PerformanceMetrics.h"
 
 namespace DSP::LLE
 {
+// Upper bound for the number of cycles the DSP thread runs at once. This keeps the count within
+// what the JIT can handle, and lets a waiting CPU thread notice progress sooner.
+constexpr u32 MAX_THREAD_SLICE_CYCLES = 0x8000;
+
+// Upper bound for MAIN_DSP_THREAD_CYCLE_WINDOW, roughly 13 ms of DSP time.
+constexpr u32 MAX_CYCLE_WINDOW = 0x100000;
+
 DSPLLE::DSPLLE() = default;
 
 DSPLLE::~DSPLLE()
@@ -60,21 +71,25 @@ void DSPLLE::DSPThread(DSPLLE* dsp_lle)
 
   while (dsp_lle->m_is_running.IsSet())
   {
-    const int cycles = static_cast<int>(dsp_lle->m_cycle_count.load());
+    // The CPU thread may add more cycles while we are running, so only subtract what was run.
+    const u32 cycles = std::min(dsp_lle->m_cycle_count.load(), MAX_THREAD_SLICE_CYCLES);
     if (cycles > 0)
     {
       std::unique_lock dsp_thread_lock(dsp_lle->m_dsp_thread_mutex, std::try_to_lock);
       if (dsp_thread_lock)
       {
+        const PerformanceMetrics::BusyScope busy_scope(g_perf_metrics,
+                                                       PerformanceMetrics::BusyThread::DSP);
         if (dsp_lle->m_dsp_core.IsJITCreated())
         {
-          dsp_lle->m_dsp_core.RunCycles(cycles);
+          dsp_lle->m_dsp_core.RunCycles(static_cast<int>(cycles));
         }
         else
         {
-          dsp_lle->m_dsp_core.GetInterpreter().RunCyclesThread(cycles);
+          dsp_lle->m_dsp_core.GetInterpreter().RunCyclesThread(static_cast<int>(cycles));
         }
-        dsp_lle->m_cycle_count.store(0);
+        dsp_lle->m_cycle_count.fetch_sub(cycles);
+        dsp_lle->m_ppc_event.Set();
         continue;
       }
     }
@@ -151,6 +166,17 @@ bool DSPLLE::Initialize(bool wii, bool dsp_thread)
   m_wii = wii;
   m_is_dsp_on_thread = dsp_thread;
 
+  // Determinism (netplay, movies) already forces the DSP off its thread, so the window only ever
+  // applies to non-deterministic sessions.
+  m_cycle_window = static_cast<u32>(
+      std::clamp<int>(Config::Get(Config::MAIN_DSP_THREAD_CYCLE_WINDOW), 0, MAX_CYCLE_WINDOW));
+  for (SyncPointStats& stats : m_sync_point_stats)
+  {
+    stats.calls = 0;
+    stats.waits = 0;
+    stats.wait_time_us = 0;
+  }
+
   m_dsp_core.Reset();
 
   InitInstructionTable();
@@ -174,6 +200,63 @@ void DSPLLE::DSP_StopSoundStream()
   m_ppc_event.Set();
   m_dsp_event.Set();
   m_dsp_thread.join();
+
+  LogSyncPointStats();
+}
+
+void DSPLLE::WaitForDSPThread(SyncPoint point, u32 max_pending_cycles)
+{
+  SyncPointStats& stats = m_sync_point_stats[static_cast<size_t>(point)];
+  stats.calls.fetch_add(1, std::memory_order_relaxed);
+
+  if (m_cycle_count.load() <= max_pending_cycles)
+    return;
+
+  stats.waits.fetch_add(1, std::memory_order_relaxed);
+  const u64 start_time = Common::Timer::NowUs();
+
+  while (m_cycle_count.load() > max_pending_cycles && m_is_running.IsSet())
+  {
+    m_dsp_event.Set();
+    m_ppc_event.Wait();
+  }
+
+  stats.wait_time_us.fetch_add(Common::Timer::NowUs() - start_time, std::memory_order_relaxed);
+}
+
+void DSPLLE::SyncMailbox(Mailbox mailbox)
+{
+  if (!IsDecoupled())
+    return;
+
+  // Once the DSP has posted mail, or has taken the mail the CPU posted, only the CPU can change
+  // the state of the mailbox again, so there is nothing for the DSP to catch up on.
+  const bool is_full = (m_dsp_core.PeekMailbox(mailbox) & 0x80000000) != 0;
+  if (mailbox == Mailbox::DSP ? is_full : !is_full)
+  {
+    m_sync_point_stats[static_cast<size_t>(SyncPoint::Mailbox)].calls.fetch_add(
+        1, std::memory_order_relaxed);
+    return;
+  }
+
+  WaitForDSPThread(SyncPoint::Mailbox, 0);
+}
+
+void DSPLLE::LogSyncPointStats() const
+{
+  static constexpr std::array<const char*, static_cast<size_t>(SyncPoint::Count)> names{
+      "update",
+      "mailbox",
+      "control register",
+      "ARAM",
+  };
+
+  for (size_t i = 0; i < names.size(); ++i)
+  {
+    const SyncPointStats& stats = m_sync_point_stats[i];
+    INFO_LOG_FMT(DSPLLE, "DSP thread sync point {}: {} calls, {} waits, {} us waiting", names[i],
+                 stats.calls.load(), stats.waits.load(), stats.wait_time_us.load());
+  }
 }
 
 void DSPLLE::Shutdown()
@@ -183,6 +266,9 @@ void DSPLLE::Shutdown()
 
 u16 DSPLLE::DSP_WriteControlRegister(u16 value)
 {
+  if (IsDecoupled())
+    WaitForDSPThread(SyncPoint::ControlRegister, 0);
+
   m_dsp_core.GetInterpreter().WriteControlRegister(value);
 
   if ((value & CR_EXTERNAL_INT) != 0)
@@ -212,18 +298,26 @@ u16 DSPLLE::DSP_ReadControlRegister()
 
 u16 DSPLLE::DSP_ReadMailBoxHigh(bool cpu_mailbox)
 {
-  return m_dsp_core.ReadMailboxHigh(cpu_mailbox ? Mailbox::CPU : Mailbox::DSP);
+  const Mailbox mailbox = cpu_mailbox ? Mailbox::CPU : Mailbox::DSP;
+  SyncMailbox(mailbox);
+  return m_dsp_core.ReadMailboxHigh(mailbox);
 }
 
 u16 DSPLLE::DSP_ReadMailBoxLow(bool cpu_mailbox)
 {
-  return m_dsp_core.ReadMailboxLow(cpu_mailbox ? Mailbox::CPU : Mailbox::DSP);
+  const Mailbox mailbox = cpu_mailbox ? Mailbox::CPU : Mailbox::DSP;
+  SyncMailbox(mailbox);
+  return m_dsp_core.ReadMailboxLow(mailbox);
 }
 
 void DSPLLE::DSP_WriteMailBoxHigh(bool cpu_mailbox, u16 value)
 {
   if (cpu_mailbox)
   {
+    // Give a lagging DSP thread the chance to take the previous mail before it gets replaced.
+    if (IsDecoupled() && (m_dsp_core.PeekMailbox(Mailbox::CPU) & 0x80000000) != 0)
+      WaitForDSPThread(SyncPoint::Mailbox, 0);
+
     if ((m_dsp_core.PeekMailbox(Mailbox::CPU) & 0x80000000) != 0)
     {
       // the DSP didn't read the previous value
@@ -276,13 +370,22 @@ void DSPLLE::DSP_Update(int cycles)
   }
   else
   {
-    // Wait for DSP thread to complete its cycle. Note: this logic should be thought through.
-    m_ppc_event.Wait();
+    // In lockstep mode, wait for the DSP thread to complete its previous slice. Otherwise it only
+    // has to be within the cycle window, and catches up at the other sync points.
+    WaitForDSPThread(SyncPoint::Update, m_cycle_window);
     m_cycle_count.fetch_add(dsp_cycles);
     m_dsp_event.Set();
   }
 }
 
+void DSPLLE::DSP_SyncForARAMAccess()
+{
+  // The accelerator reads ARAM from the DSP thread, so don't let a DMA change ARAM under a DSP
+  // which hasn't reached the current time yet.
+  if (IsDecoupled())
+    WaitForDSPThread(SyncPoint::ARAM, 0);
+}
+
 u32 DSPLLE::DSP_UpdateRate()
 {
   return 12600;  // TO BE TWEAKED
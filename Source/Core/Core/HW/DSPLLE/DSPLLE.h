@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <mutex>
 #include <thread>
@@ -35,18 +36,52 @@ public:
   u16 DSP_ReadControlRegister() override;
   u16 DSP_WriteControlRegister(u16 value) override;
   void DSP_Update(int cycles) override;
+  void DSP_SyncForARAMAccess() override;
   void DSP_StopSoundStream() override;
   u32 DSP_UpdateRate() override;
 
+  // Places where the CPU thread may have to wait for the DSP thread.
+  enum class SyncPoint
+  {
+    Update,
+    Mailbox,
+    ControlRegister,
+    ARAM,
+    Count,
+  };
+
+  struct SyncPointStats
+  {
+    std::atomic<u64> calls{};
+    std::atomic<u64> waits{};
+    std::atomic<u64> wait_time_us{};
+  };
+
+  const SyncPointStats& GetSyncPointStats(SyncPoint point) const
+  {
+    return m_sync_point_stats[static_cast<size_t>(point)];
+  }
+
 private:
   static void DSPThread(DSPLLE* dsp_lle);
 
+  // Blocks until the DSP thread has at most max_pending_cycles left to run.
+  void WaitForDSPThread(SyncPoint point, u32 max_pending_cycles);
+  // Lets the DSP thread catch up before the CPU observes the given mailbox, unless the mailbox is
+  // in a state which only the CPU can change.
+  void SyncMailbox(Mailbox mailbox);
+  bool IsDecoupled() const { return m_is_dsp_on_thread && m_cycle_window != 0; }
+  void LogSyncPointStats() const;
+
   DSPCore m_dsp_core;
   std::thread m_dsp_thread;
   std::mutex m_dsp_thread_mutex;
   bool m_is_dsp_on_thread = false;
   Common::Flag m_is_running;
   std::atomic<u32> m_cycle_count{};
+  // How many cycles the DSP thread may lag behind the CPU (see MAIN_DSP_THREAD_CYCLE_WINDOW).
+  u32 m_cycle_window = 0;
+  std::array<SyncPointStats, static_cast<size_t>(SyncPoint::Count)> m_sync_point_stats;
 
   Common::Event m_dsp_event;
   Common::Event m_ppc_event;
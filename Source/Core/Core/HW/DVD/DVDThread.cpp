@@ -20,6 +20,7 @@
 #include "Common/SPSCQueue.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
+#include "Common/ZoneProfiler.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
@@ -342,6 +343,8 @@ void DVDThread::DVDThreadMain()
     ReadRequest request;
     while (m_request_queue.Pop(request))
     {
+      PROFILE_ZONE("DVDThread::Read");
+
       m_file_logger.Log(*m_disc, request.partition, request.dvd_offset);
 
       std::vector<u8> buffer(request.length);
@@ -85,6 +85,13 @@ int GCIFile::UsesBlock(u16 block_num)
   return -1;
 }
 
+void GCIFile::MarkBlockDirty(size_t index)
+{
+  if (m_dirty_blocks.size() < m_save_data.size())
+    m_dirty_blocks.resize(m_save_data.size());
+  m_dirty_blocks[index] = true;
+}
+
 void GCIFile::DoState(PointerWrap& p)
 {
   p.Do(m_gci_header);
@@ -92,5 +99,12 @@ void GCIFile::DoState(PointerWrap& p)
   p.Do(m_filename);
   p.Do(m_save_data);
   p.Do(m_used_blocks);
+
+  // The save data may not match what was last written to disk anymore.
+  if (p.IsReadMode())
+  {
+    m_dirty_blocks.clear();
+    m_needs_full_write = true;
+  }
 }
 }  // namespace Memcard
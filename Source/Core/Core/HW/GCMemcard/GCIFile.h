@@ -21,11 +21,18 @@ public:
   bool HasCopyProtection() const;
   void DoState(PointerWrap& p);
   int UsesBlock(u16 blocknum);
+  void MarkBlockDirty(size_t index);
 
   DEntry m_gci_header;
   std::vector<GCMBlock> m_save_data;
   std::vector<u16> m_used_blocks;
   bool m_dirty = false;
   std::string m_filename;
+
+  // Blocks of m_save_data that were modified since the file was last written to disk.
+  std::vector<bool> m_dirty_blocks;
+  // Set if the file on disk may also differ from m_save_data in blocks that are not dirty,
+  // in which case the whole file has to be rewritten.
+  bool m_needs_full_write = false;
 };
 }  // namespace Memcard
@@ -268,7 +268,8 @@ void GCMemcardDirectory::FlushThread()
 
   Common::SetCurrentThreadName(fmt::format("Memcard {} flushing thread", m_card_slot).c_str());
 
-  constexpr std::chrono::seconds flush_interval{1};
+  const std::chrono::milliseconds flush_interval{
+      std::max(Config::Get(Config::MAIN_GCI_FOLDER_FLUSH_DELAY), 0)};
   while (true)
   {
     // no-op until signalled
@@ -294,6 +295,21 @@ GCMemcardDirectory::~GCMemcardDirectory()
   m_flush_thread.join();
 
   FlushToFile();
+
+  const WriteStats stats = GetWriteStats();
+  INFO_LOG_FMT(EXPANSIONINTERFACE,
+               "GCI folder in slot {}: {} guest writes ({} bytes) were flushed with {} host "
+               "writes ({} bytes)",
+               m_card_slot, stats.guest_writes, stats.guest_bytes, stats.host_commits,
+               stats.host_bytes);
+}
+
+GCMemcardDirectory::WriteStats GCMemcardDirectory::GetWriteStats() const
+{
+  return {m_guest_writes.load(std::memory_order_relaxed),
+          m_guest_write_bytes.load(std::memory_order_relaxed),
+          m_host_commits.load(std::memory_order_relaxed),
+          m_host_write_bytes.load(std::memory_order_relaxed)};
 }
 
 s32 GCMemcardDirectory::Read(u32 src_address, s32 length, u8* dest_address)
@@ -337,13 +353,15 @@ s32 GCMemcardDirectory::Read(u32 src_address, s32 length, u8* dest_address)
       m_last_block_address = (u8*)&m_bat2;
       break;
     default:
-      m_last_block = SaveAreaRW(block);
-
-      if (m_last_block == -1)
+      if (SaveAreaRW(block) == -1)
       {
         memset(dest_address, 0xFF, length);
         return 0;
       }
+
+      // Only blocks which were looked up for writing are cached, so that the next write to this
+      // block goes through SaveAreaRW again and marks it as dirty.
+      m_last_block = -1;
     }
   }
 
@@ -371,6 +389,9 @@ s32 GCMemcardDirectory::Write(u32 dest_address, s32 length, const u8* src_addres
     DEBUG_ASSERT_MSG(EXPANSIONINTERFACE, (dest_address + length) % Memcard::BLOCK_SIZE == 0,
                      "Memcard directory Write Logic Error");
   }
+  m_guest_writes.fetch_add(1, std::memory_order_relaxed);
+  m_guest_write_bytes.fetch_add(length, std::memory_order_relaxed);
+
   if (m_last_block != block)
   {
     switch (block)
@@ -492,6 +513,8 @@ inline void GCMemcardDirectory::SyncSaves()
         const u32 new_gamecode = Common::swap32(current->m_dir_entries[i].m_gamecode.data());
         const u32 old_start = m_saves[i].m_gci_header.m_first_block;
         const u32 new_start = current->m_dir_entries[i].m_first_block;
+        const u16 old_block_count = m_saves[i].m_gci_header.m_block_count;
+        const u16 new_block_count = current->m_dir_entries[i].m_block_count;
 
         if ((gamecode != 0xFFFFFFFF) && (gamecode != new_gamecode))
         {
@@ -507,7 +530,10 @@ inline void GCMemcardDirectory::SyncSaves()
           INFO_LOG_FMT(EXPANSIONINTERFACE, "Save moved from {:#x} to {:#x}", old_start, new_start);
           m_saves[i].m_used_blocks.clear();
           m_saves[i].m_save_data.clear();
+          m_saves[i].m_dirty_blocks.clear();
         }
+        if (old_start != new_start || old_block_count != new_block_count)
+          m_saves[i].m_needs_full_write = true;
         if (m_saves[i].m_used_blocks.empty())
         {
           SetUsedBlocks(i);
@@ -521,6 +547,7 @@ inline void GCMemcardDirectory::SyncSaves()
       m_saves[i].m_gci_header.m_gamecode = Memcard::DEntry::UNINITIALIZED_GAMECODE;
       m_saves[i].m_save_data.clear();
       m_saves[i].m_used_blocks.clear();
+      m_saves[i].m_dirty_blocks.clear();
       m_saves[i].m_dirty = true;
     }
   }
@@ -547,11 +574,13 @@ inline s32 GCMemcardDirectory::SaveAreaRW(u32 block, bool writing)
             m_saves[i].m_save_data.emplace_back();
             num_blocks--;
           }
+          m_saves[i].m_needs_full_write = true;
         }
 
         if (writing)
         {
           m_saves[i].m_dirty = true;
+          m_saves[i].MarkBlockDirty(idx);
         }
 
         m_last_block = block;
@@ -620,8 +649,43 @@ bool GCMemcardDirectory::SetUsedBlocks(int save_index)
 
 void GCMemcardDirectory::FlushToFile()
 {
-  std::unique_lock l(m_write_mutex);
-  Memcard::DEntry invalid;
+  std::vector<PendingWrite> writes;
+  {
+    std::unique_lock l(m_write_mutex);
+    writes = CollectPendingWrites();
+  }
+
+  // The file I/O happens without holding the lock, so that the game does not have to wait for it.
+  for (const PendingWrite& write : writes)
+  {
+    if (CommitWrite(write) || write.is_deletion)
+      continue;
+
+    // The dirty blocks of the failed write are gone, so the file on disk can no longer be patched.
+    std::unique_lock l(m_write_mutex);
+    for (Memcard::GCIFile& save : m_saves)
+    {
+      if (save.m_filename == write.filename)
+        save.m_needs_full_write = true;
+    }
+  }
+
+#if _WRITE_MC_HEADER
+  u8 mc[BLOCK_SIZE * MC_FST_BLOCKS];
+  Read(0, BLOCK_SIZE * MC_FST_BLOCKS, mc);
+  File::IOFile hdrfile(m_save_directory + MC_HDR, "wb");
+  hdrfile.WriteBytes(mc, BLOCK_SIZE * MC_FST_BLOCKS);
+#endif
+}
+
+std::vector<GCMemcardDirectory::PendingWrite> GCMemcardDirectory::CollectPendingWrites()
+{
+  std::vector<PendingWrite> writes;
+
+  // Make the next write to the cached block go through SaveAreaRW again, so that it marks the
+  // block as dirty.
+  m_last_block = -1;
+
   for (Memcard::GCIFile& save : m_saves)
   {
     if (save.m_dirty)
@@ -656,44 +720,28 @@ void GCMemcardDirectory::FlushToFile()
                            default_save_name);
           }
           save.m_filename = default_save_name;
+          save.m_needs_full_write = true;
         }
-        File::IOFile gci(save.m_filename, "wb");
-        if (gci)
-        {
-          gci.WriteBytes(&save.m_gci_header, Memcard::DENTRY_SIZE);
-          for (const Memcard::GCMBlock& block : save.m_save_data)
-            gci.WriteBytes(block.m_block.data(), Memcard::BLOCK_SIZE);
 
-          if (gci.IsGood())
-          {
-            Core::DisplayMessage("Wrote save contents to GCI Folder", 4000);
-          }
-          else
-          {
-            Core::DisplayMessage(
-                fmt::format("Failed to write save contents to {}", save.m_filename), 10000);
-            ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to save data to {}", save.m_filename);
-          }
-        }
-        else
-        {
-          Core::DisplayMessage(
-              fmt::format("Failed to open file at {} for writing", save.m_filename), 10000);
-          ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to open file at {} for writing",
-                        save.m_filename);
-        }
+        PendingWrite& write = writes.emplace_back();
+        write.filename = save.m_filename;
+        write.header = save.m_gci_header;
+        write.save_data = save.m_save_data;
+        write.full_write = save.m_needs_full_write;
+        write.dirty_blocks = std::move(save.m_dirty_blocks);
+        save.m_dirty_blocks.clear();
+        save.m_needs_full_write = false;
       }
       else if (save.m_filename.length() != 0)
       {
         save.m_dirty = false;
-        std::string& old_name = save.m_filename;
-        std::string deleted_name = old_name + ".deleted";
-        if (File::Exists(deleted_name))
-          File::Delete(deleted_name);
-        File::Rename(old_name, deleted_name);
+        PendingWrite& write = writes.emplace_back();
+        write.filename = std::move(save.m_filename);
+        write.is_deletion = true;
         save.m_filename.clear();
         save.m_save_data.clear();
         save.m_used_blocks.clear();
+        save.m_dirty_blocks.clear();
       }
     }
 
@@ -707,14 +755,81 @@ void GCMemcardDirectory::FlushToFile()
     {
       INFO_LOG_FMT(EXPANSIONINTERFACE, "Flushing savedata to disk for {}", save.m_filename);
       save.m_save_data.clear();
+      save.m_dirty_blocks.clear();
     }
   }
-#if _WRITE_MC_HEADER
-  u8 mc[BLOCK_SIZE * MC_FST_BLOCKS];
-  Read(0, BLOCK_SIZE * MC_FST_BLOCKS, mc);
-  File::IOFile hdrfile(m_save_directory + MC_HDR, "wb");
-  hdrfile.WriteBytes(mc, BLOCK_SIZE * MC_FST_BLOCKS);
-#endif
+
+  return writes;
+}
+
+bool GCMemcardDirectory::CommitWrite(const PendingWrite& write)
+{
+  if (write.is_deletion)
+  {
+    const std::string deleted_name = write.filename + ".deleted";
+    if (File::Exists(deleted_name))
+      File::Delete(deleted_name);
+    if (!File::Rename(write.filename, deleted_name))
+      return false;
+    m_host_commits.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  // Changes are written to a temporary file which then replaces the GCI file, so that the GCI
+  // file is never left half-written.
+  const std::string temp_path = File::GetTempFilenameForAtomicWrite(write.filename);
+  const u64 file_size =
+      Memcard::DENTRY_SIZE + static_cast<u64>(write.save_data.size()) * Memcard::BLOCK_SIZE;
+  u64 bytes_written = 0;
+  bool written = false;
+  {
+    // If the GCI file on disk is otherwise up to date, start from a copy of it and only write the
+    // modified blocks. The copy is free on host filesystems that support copy-on-write clones.
+    File::IOFile gci;
+    const bool partial = !write.full_write && File::GetSize(write.filename) == file_size &&
+                         File::CloneRegularFile(write.filename, temp_path) &&
+                         gci.Open(temp_path, "r+b");
+    if (!partial)
+      gci.Open(temp_path, "wb");
+
+    if (gci)
+    {
+      gci.WriteBytes(&write.header, Memcard::DENTRY_SIZE);
+      bytes_written += Memcard::DENTRY_SIZE;
+      for (size_t i = 0; i < write.save_data.size(); ++i)
+      {
+        if (partial)
+        {
+          if (i >= write.dirty_blocks.size() || !write.dirty_blocks[i])
+            continue;
+          gci.Seek(Memcard::DENTRY_SIZE + i * Memcard::BLOCK_SIZE, File::SeekOrigin::Begin);
+        }
+        gci.WriteBytes(write.save_data[i].m_block.data(), Memcard::BLOCK_SIZE);
+        bytes_written += Memcard::BLOCK_SIZE;
+      }
+      written = gci.IsGood();
+    }
+    else
+    {
+      Core::DisplayMessage(fmt::format("Failed to open file at {} for writing", write.filename),
+                           10000);
+      ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to open file at {} for writing", temp_path);
+      return false;
+    }
+  }
+
+  if (written && File::Rename(temp_path, write.filename))
+  {
+    m_host_commits.fetch_add(1, std::memory_order_relaxed);
+    m_host_write_bytes.fetch_add(bytes_written, std::memory_order_relaxed);
+    Core::DisplayMessage("Wrote save contents to GCI Folder", 4000);
+    return true;
+  }
+
+  File::Delete(temp_path, File::IfAbsentBehavior::NoConsoleWarning);
+  Core::DisplayMessage(fmt::format("Failed to write save contents to {}", write.filename), 10000);
+  ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to save data to {}", write.filename);
+  return false;
 }
 
 void GCMemcardDirectory::DoState(PointerWrap& p)
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -41,7 +42,34 @@ public:
   void ClearAll() override {}
   void DoState(PointerWrap& p) override;
 
+  struct WriteStats
+  {
+    // Block writes done by the emulated game.
+    u64 guest_writes;
+    u64 guest_bytes;
+    // Files written (or deleted) on the host.
+    u64 host_commits;
+    u64 host_bytes;
+  };
+  WriteStats GetWriteStats() const;
+
 private:
+  // A change to a GCI file, copied from m_saves so that it can be written without holding
+  // m_write_mutex.
+  struct PendingWrite
+  {
+    std::string filename;
+    bool is_deletion = false;
+    Memcard::DEntry header;
+    std::vector<Memcard::GCMBlock> save_data;
+    // If not set, only the header and the blocks in dirty_blocks have changed.
+    bool full_write = true;
+    std::vector<bool> dirty_blocks;
+  };
+  std::vector<PendingWrite> CollectPendingWrites();
+  // Returns false if the change could not be written.
+  bool CommitWrite(const PendingWrite& write);
+
   bool LoadGCI(Memcard::GCIFile gci);
   inline s32 SaveAreaRW(u32 block, bool writing = false);
   // s32 DirectoryRead(u32 offset, u32 length, u8* dest_address);
@@ -65,4 +93,9 @@ private:
   std::mutex m_write_mutex;
   Common::Flag m_exiting;
   std::thread m_flush_thread;
+
+  std::atomic<u64> m_guest_writes = 0;
+  std::atomic<u64> m_guest_write_bytes = 0;
+  std::atomic<u64> m_host_commits = 0;
+  std::atomic<u64> m_host_write_bytes = 0;
 };
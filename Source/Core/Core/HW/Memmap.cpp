@@ -14,6 +14,7 @@
 #include <memory>
 #include <tuple>
 
+#include "Common/Assert.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -230,11 +231,25 @@ bool MemoryManager::InitFastmemArena()
 
   m_is_fastmem_arena_initialized = true;
   m_fastmem_arena_size = memory_size;
+
+  // Page table mappings are made at the granularity of the emulated MMU's pages, which only
+  // works if the host can map memory at that granularity too.
+  m_is_page_table_fastmem_supported = m_arena.GetMappingGranularity() == PowerPC::HW_PAGE_SIZE;
+  if (!m_is_page_table_fastmem_supported)
+  {
+    INFO_LOG_FMT(MEMMAP, "Host mapping granularity is {:#x}, page table fastmem disabled",
+                 m_arena.GetMappingGranularity());
+  }
+
   return true;
 }
 
 void MemoryManager::UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
 {
+  // BAT mappings take precedence over the page table, so any page table mapping could be in the
+  // way of the new BAT layout. The MMU recreates them on demand.
+  RemoveAllPageTableMappings();
+
   for (auto& entry : m_logical_mapped_entries)
   {
     m_arena.UnmapFromMemoryRegion(entry.mapped_pointer, entry.mapped_size);
@@ -290,6 +305,69 @@ void MemoryManager::UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
   }
 }
 
+bool MemoryManager::AddPageTableMapping(u32 logical_address, u32 translated_address)
+{
+  if (!m_is_fastmem_arena_initialized || !m_is_page_table_fastmem_supported)
+    return false;
+
+  DEBUG_ASSERT((logical_address & PowerPC::HW_PAGE_MASK) == 0);
+  DEBUG_ASSERT((translated_address & PowerPC::HW_PAGE_MASK) == 0);
+
+  if (m_page_table_mapped_entries.contains(logical_address))
+    return true;
+
+  for (const PhysicalMemoryRegion& region : m_physical_regions)
+  {
+    if (!region.active)
+      continue;
+
+    // Only map memory which would also be treated as RAM by the slow path.
+    u32 usable_size = region.size;
+    if (region.out_pointer == &m_ram)
+      usable_size = GetRamSizeReal();
+    else if (region.out_pointer == &m_exram)
+      usable_size = GetExRamSizeReal();
+
+    if (translated_address < region.physical_address ||
+        translated_address - region.physical_address >= usable_size)
+    {
+      continue;
+    }
+
+    const u32 position = region.shm_position + translated_address - region.physical_address;
+    u8* base = m_logical_base + logical_address;
+    void* mapped_pointer = m_arena.MapInMemoryRegion(position, PowerPC::HW_PAGE_SIZE, base);
+    if (!mapped_pointer)
+    {
+      WARN_LOG_FMT(MEMMAP, "Failed to map page at 0x{:08X} into logical fastmem region at 0x{:08X}",
+                   translated_address, logical_address);
+      return false;
+    }
+
+    m_page_table_mapped_entries.emplace(logical_address, mapped_pointer);
+    return true;
+  }
+
+  return false;
+}
+
+void MemoryManager::RemovePageTableMapping(u32 logical_address)
+{
+  const auto it = m_page_table_mapped_entries.find(logical_address);
+  if (it == m_page_table_mapped_entries.end())
+    return;
+
+  m_arena.UnmapFromMemoryRegion(it->second, PowerPC::HW_PAGE_SIZE);
+  m_page_table_mapped_entries.erase(it);
+}
+
+void MemoryManager::RemoveAllPageTableMappings()
+{
+  for (const auto& [logical_address, mapped_pointer] : m_page_table_mapped_entries)
+    m_arena.UnmapFromMemoryRegion(mapped_pointer, PowerPC::HW_PAGE_SIZE);
+  m_page_table_mapped_entries.clear();
+}
+
 void MemoryManager::DoState(PointerWrap& p)
 {
   const u32 current_ram_size = GetRamSize();
@@ -371,6 +449,8 @@ void MemoryManager::ShutdownFastmemArena()
     m_arena.UnmapFromMemoryRegion(base, region.size);
   }
 
+  RemoveAllPageTableMappings();
+
   for (auto& entry : m_logical_mapped_entries)
   {
     m_arena.UnmapFromMemoryRegion(entry.mapped_pointer, entry.mapped_size);
@@ -385,6 +465,7 @@ void MemoryManager::ShutdownFastmemArena()
   m_logical_base = nullptr;
 
   m_is_fastmem_arena_initialized = false;
+  m_is_page_table_fastmem_supported = false;
 }
 
 void MemoryManager::Clear()
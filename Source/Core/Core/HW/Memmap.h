@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -100,6 +101,14 @@ public:
 
   void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table);
 
+  // Page table translations are shadowed in the logical fastmem area one hardware page at a time.
+  // The MMU is responsible for only adding mappings that are valid for direct access, and for
+  // removing them again whenever the translation they were created from stops being valid.
+  bool IsPageTableFastmemSupported() const { return m_is_page_table_fastmem_supported; }
+  bool AddPageTableMapping(u32 logical_address, u32 translated_address);
+  void RemovePageTableMapping(u32 logical_address);
+  void RemoveAllPageTableMappings();
+
   void Clear();
 
   // Routines to access physically addressed memory, designed for use by
@@ -186,6 +195,7 @@ private:
   u32 m_exram_mask = 0;
 
   bool m_is_fastmem_arena_initialized = false;
+  bool m_is_page_table_fastmem_supported = false;
 
   // STATE_TO_SAVE
   // Save the Init(), Shutdown() state
@@ -223,7 +233,8 @@ private:
   //
   // The 4GB starting at m_logical_base represents access from the CPU
   // with address translation turned on.  This mapping is computed based
-  // on the BAT registers.
+  // on the BAT registers, plus any page table translations currently in the
+  // data TLB which have been mapped in on demand by the MMU.
   //
   // Each of these 4GB regions is surrounded by 2GB of empty space so overflows
   // in address computation in the JIT don't access unrelated memory.
@@ -240,6 +251,9 @@ private:
 
   std::vector<LogicalMemoryView> m_logical_mapped_entries;
 
+  // Logical page address -> host pointer of the page mapped for it.
+  std::map<u32, void*> m_page_table_mapped_entries;
+
   std::array<void*, PowerPC::BAT_PAGE_COUNT> m_physical_page_mappings{};
   std::array<void*, PowerPC::BAT_PAGE_COUNT> m_logical_page_mappings{};
 
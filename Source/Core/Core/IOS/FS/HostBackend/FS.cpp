@@ -5,7 +5,10 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <filesystem>
 #include <optional>
+#include <set>
 #include <string_view>
 #include <type_traits>
 #include <unordered_map>
@@ -15,12 +18,16 @@
 #include "Common/Align.h"
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
+#include "Common/Crypto/SHA1.h"
 #include "Common/FileUtil.h"
+#include "Common/Hash.h"
 #include "Common/Logging/Log.h"
 #include "Common/NandPaths.h"
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/IOS/ES/ES.h"
+#include "Core/IOS/FS/HostBackend/SnapshotBlobs.h"
 #include "Core/IOS/IOS.h"
 #include "Core/Movie.h"
 #include "Core/WiiRoot.h"
@@ -79,6 +86,30 @@ struct SerializedFstEntry
 static_assert(std::is_standard_layout<SerializedFstEntry>());
 static_assert(sizeof(SerializedFstEntry) == 0x20);
 
+constexpr u32 FST_JOURNAL_MAGIC = 0x4C4A5346;  // "FSJL"
+/// The journal is folded back into the FST once it has this many changes.
+constexpr u32 MAX_FST_JOURNAL_RECORDS = 1024;
+
+struct FstJournalHeader
+{
+  u32 magic;
+  /// CRC32 of the FST file that the journal applies to.
+  /// Used to detect journals that were already folded into the FST but could not be deleted.
+  u32 fst_checksum;
+};
+
+/// Followed by the op (one byte), the metadata as a SerializedFstEntry (without a name),
+/// and the path and new path as null-terminated strings.
+struct FstJournalRecordHeader
+{
+  /// CRC32 of everything after the header. Used to detect records that were only partially
+  /// written, e.g. because Dolphin crashed.
+  u32 checksum;
+  u32 size;
+};
+constexpr u32 MIN_FST_JOURNAL_RECORD_SIZE = 1 + sizeof(SerializedFstEntry) + 2;
+constexpr u32 MAX_FST_JOURNAL_RECORD_SIZE = MIN_FST_JOURNAL_RECORD_SIZE + 2 * MaxPathLength;
+
 template <typename T>
 auto GetMetadataFields(T& obj)
 {
@@ -90,6 +121,29 @@ auto GetNamePredicate(const std::string& name)
   return [&name](const auto& entry) { return entry.name == name; };
 }
 
+u32 GetFileChecksum(const std::string& path)
+{
+  // A missing file is treated like an empty one.
+  std::string contents;
+  File::ReadFileToString(path, contents);
+  return Common::ComputeCRC32(contents);
+}
+
+/// Lets cached file hashes detect changes which weren't made through HostFileSystem.
+std::optional<s64> GetModificationTime(const std::string& path)
+{
+  std::error_code error;
+  const auto time = std::filesystem::last_write_time(StringToPath(path), error);
+  if (error)
+    return std::nullopt;
+  return static_cast<s64>(time.time_since_epoch().count());
+}
+
+u64 GetUsedClusters(u64 file_size)
+{
+  return Common::AlignUp(file_size, CLUSTER_SIZE) / CLUSTER_SIZE;
+}
+
 // Convert the host directory entries into ones that can be exposed to the emulated system.
 static u64 FixupDirectoryEntries(File::FSTEntry* dir, bool is_root)
 {
@@ -152,15 +206,30 @@ HostFileSystem::HostFileSystem(const std::string& root_path,
   File::CreateFullPath(m_root_path + '/');
   ResetFst();
   LoadFst();
+
+  // Fold any changes from the previous session into the FST, so that every session starts
+  // without a journal.
+  const bool had_journal = ReplayFstJournal();
+  if (CheckFstConsistency() || had_journal)
+    SaveFst();
 }
 
-HostFileSystem::~HostFileSystem() = default;
+HostFileSystem::~HostFileSystem()
+{
+  if (m_fst_journal.IsOpen())
+    SaveFst();
+}
 
 std::string HostFileSystem::GetFstFilePath() const
 {
   return fmt::format("{}/fst.bin", m_root_path);
 }
 
+std::string HostFileSystem::GetFstJournalFilePath() const
+{
+  return fmt::format("{}/fst.journal", m_root_path);
+}
+
 void HostFileSystem::ResetFst()
 {
   m_root_entry = {};
@@ -171,6 +240,8 @@ void HostFileSystem::ResetFst()
 
 void HostFileSystem::LoadFst()
 {
+  m_fst_checksum = GetFileChecksum(GetFstFilePath());
+
   File::IOFile file{GetFstFilePath(), "rb"};
   // Existing filesystems will not have a FST. This is not a problem,
   // as the rest of HostFileSystem will use sane defaults.
@@ -232,7 +303,226 @@ void HostFileSystem::SaveFst()
     }
   }
   if (!File::Rename(temp_path, dest_path))
+  {
     PanicAlertFmt("IOS_FS: Failed to rename temporary FST file");
+    return;
+  }
+  m_fst_checksum = Common::ComputeCRC32(reinterpret_cast<const u8*>(to_write.data()),
+                                        to_write.size() * sizeof(SerializedFstEntry));
+
+  ForgetFileDigests(dest_path);
+
+  // The journal has been applied to the FST now.
+  m_fst_journal.Close();
+  m_fst_journal_records = 0;
+  File::Delete(GetFstJournalFilePath(), File::IfAbsentBehavior::NoConsoleWarning);
+}
+
+void HostFileSystem::JournalFstChange(FstJournalOp op, const std::string& path,
+                                      const Metadata& data, const std::string& new_path)
+{
+  if (m_fst_journal_records >= MAX_FST_JOURNAL_RECORDS)
+  {
+    SaveFst();
+    return;
+  }
+
+  if (!m_fst_journal.IsOpen())
+  {
+    const FstJournalHeader header{FST_JOURNAL_MAGIC, m_fst_checksum};
+    if (!m_fst_journal.Open(GetFstJournalFilePath(), "wb") || !m_fst_journal.WriteArray(&header, 1))
+    {
+      ERROR_LOG_FMT(IOS_FS, "Failed to create FST journal; writing the whole FST instead");
+      SaveFst();
+      return;
+    }
+  }
+
+  SerializedFstEntry serialized_data;
+  GetMetadataFields(serialized_data) = GetMetadataFields(data);
+
+  std::vector<u8> contents;
+  contents.reserve(MIN_FST_JOURNAL_RECORD_SIZE + path.size() + new_path.size());
+  contents.push_back(static_cast<u8>(op));
+  const u8* serialized_data_ptr = reinterpret_cast<const u8*>(&serialized_data);
+  contents.insert(contents.end(), serialized_data_ptr,
+                  serialized_data_ptr + sizeof(serialized_data));
+  for (const std::string* str : {&path, &new_path})
+  {
+    contents.insert(contents.end(), str->begin(), str->end());
+    contents.push_back(0);
+  }
+
+  if (!m_file_digests.empty())
+    ForgetFileDigests(GetFstJournalFilePath());
+
+  const FstJournalRecordHeader header{Common::ComputeCRC32(contents.data(), contents.size()),
+                                      static_cast<u32>(contents.size())};
+  if (!m_fst_journal.WriteArray(&header, 1) ||
+      !m_fst_journal.WriteBytes(contents.data(), contents.size()) || !m_fst_journal.Flush())
+  {
+    ERROR_LOG_FMT(IOS_FS, "Failed to write to FST journal; writing the whole FST instead");
+    SaveFst();
+    return;
+  }
+  ++m_fst_journal_records;
+}
+
+bool HostFileSystem::ReplayFstJournal()
+{
+  File::IOFile file{GetFstJournalFilePath(), "rb"};
+  if (!file)
+    return false;
+
+  FstJournalHeader header;
+  if (!file.ReadArray(&header, 1) || header.magic != FST_JOURNAL_MAGIC)
+  {
+    WARN_LOG_FMT(IOS_FS, "Ignoring invalid FST journal");
+    return true;
+  }
+
+  if (header.fst_checksum != m_fst_checksum)
+  {
+    INFO_LOG_FMT(IOS_FS, "Ignoring FST journal for a different FST");
+    return true;
+  }
+
+  u32 num_records = 0;
+  FstJournalRecordHeader record;
+  while (file.ReadArray(&record, 1))
+  {
+    std::vector<u8> contents(record.size);
+    if (record.size < MIN_FST_JOURNAL_RECORD_SIZE || record.size > MAX_FST_JOURNAL_RECORD_SIZE ||
+        !file.ReadBytes(contents.data(), contents.size()) ||
+        Common::ComputeCRC32(contents.data(), contents.size()) != record.checksum)
+    {
+      WARN_LOG_FMT(IOS_FS, "Discarding incomplete FST journal record {}", num_records);
+      break;
+    }
+
+    const auto op = static_cast<FstJournalOp>(contents[0]);
+    SerializedFstEntry serialized_data;
+    std::memcpy(&serialized_data, &contents[1], sizeof(serialized_data));
+    Metadata data{};
+    GetMetadataFields(data) = GetMetadataFields(serialized_data);
+
+    constexpr size_t strings_offset = 1 + sizeof(SerializedFstEntry);
+    const std::string_view strings{reinterpret_cast<const char*>(contents.data()) + strings_offset,
+                                   contents.size() - strings_offset};
+    const size_t path_end = strings.find('\0');
+    if (op > FstJournalOp::SetMetadata || path_end == std::string_view::npos ||
+        strings.back() != '\0')
+    {
+      WARN_LOG_FMT(IOS_FS, "Discarding invalid FST journal record {}", num_records);
+      break;
+    }
+    const std::string path{strings.substr(0, path_end)};
+    const std::string new_path{strings.substr(path_end + 1, strings.size() - path_end - 2)};
+
+    ReplayFstChange(op, path, data, new_path);
+    ++num_records;
+  }
+
+  INFO_LOG_FMT(IOS_FS, "Replayed {} changes from the FST journal", num_records);
+  return true;
+}
+
+void HostFileSystem::ReplayFstChange(FstJournalOp op, const std::string& path,
+                                     const Metadata& data, const std::string& new_path)
+{
+  if (!IsValidPath(path))
+    return;
+
+  // This mirrors what the corresponding operations do to the FST.
+  switch (op)
+  {
+  case FstJournalOp::Create:
+  {
+    FstEntry* entry = FindOrCreateFstEntry(&m_root_entry, path, false);
+    entry->children.clear();
+    GetMetadataFields(entry->data) = GetMetadataFields(data);
+    break;
+  }
+  case FstJournalOp::SetMetadata:
+  {
+    FstEntry* entry = FindOrCreateFstEntry(&m_root_entry, path, false);
+    entry->data.uid = data.uid;
+    entry->data.gid = data.gid;
+    entry->data.attribute = data.attribute;
+    entry->data.modes = data.modes;
+    break;
+  }
+  case FstJournalOp::Delete:
+  {
+    const auto split_path = SplitPathAndBasename(path);
+    FstEntry* parent = FindOrCreateFstEntry(&m_root_entry, split_path.parent, false);
+    const auto it = std::find_if(parent->children.begin(), parent->children.end(),
+                                 GetNamePredicate(split_path.file_name));
+    if (it != parent->children.end())
+      parent->children.erase(it);
+    break;
+  }
+  case FstJournalOp::Rename:
+  {
+    if (!IsValidNonRootPath(new_path))
+      return;
+
+    const auto split_old_path = SplitPathAndBasename(path);
+    const auto split_new_path = SplitPathAndBasename(new_path);
+    FstEntry* old_parent = FindOrCreateFstEntry(&m_root_entry, split_old_path.parent, false);
+    const auto it = std::find_if(old_parent->children.begin(), old_parent->children.end(),
+                                 GetNamePredicate(split_old_path.file_name));
+    if (it == old_parent->children.end())
+      return;
+
+    FstEntry entry = std::move(*it);
+    old_parent->children.erase(it);
+
+    FstEntry* new_entry = FindOrCreateFstEntry(&m_root_entry, new_path, false);
+    new_entry->name = split_new_path.file_name;
+    new_entry->data = entry.data;
+    new_entry->children = std::move(entry.children);
+    break;
+  }
+  }
+}
+
+bool HostFileSystem::CheckFstConsistency()
+{
+  bool changed = false;
+  const auto check_children = [this, &changed](const auto& check, FstEntry& entry,
+                                               const std::string& path) -> void {
+    for (auto it = entry.children.begin(); it != entry.children.end();)
+    {
+      const std::string child_path = path + '/' + it->name;
+      const File::FileInfo info{m_root_path + Common::EscapePath(child_path)};
+      if (!info.Exists())
+      {
+        INFO_LOG_FMT(IOS_FS, "Dropping FST entry for missing file {}", child_path);
+        it = entry.children.erase(it);
+        changed = true;
+        continue;
+      }
+
+      if (it->data.is_file != info.IsFile())
+      {
+        it->data.is_file = info.IsFile();
+        changed = true;
+      }
+
+      if (it->data.is_file && !it->children.empty())
+      {
+        WARN_LOG_FMT(IOS_FS, "{} is a file but also has children; clearing children", child_path);
+        it->children.clear();
+        changed = true;
+      }
+
+      check(check, *it, child_path);
+      ++it;
+    }
+  };
+  check_children(check_children, m_root_entry, "");
+  return changed;
 }
 
 HostFileSystem::FstEntry* HostFileSystem::GetFstEntryForPath(const std::string& path)
@@ -248,7 +538,26 @@ HostFileSystem::FstEntry* HostFileSystem::GetFstEntryForPath(const std::string&
   if (!host_file_info.Exists())
     return nullptr;
 
-  FstEntry* entry = host_file.is_redirect ? &m_redirect_fst : &m_root_entry;
+  FstEntry* entry = FindOrCreateFstEntry(host_file.is_redirect ? &m_redirect_fst : &m_root_entry,
+                                         path, host_file.is_redirect);
+  entry->data.is_file = host_file_info.IsFile();
+  if (entry->data.is_file && !entry->children.empty())
+  {
+    WARN_LOG_FMT(IOS_FS, "{} is a file but also has children; clearing children", path);
+    entry->children.clear();
+  }
+
+  return entry;
+}
+
+HostFileSystem::FstEntry* HostFileSystem::FindOrCreateFstEntry(FstEntry* root,
+                                                               const std::string& path,
+                                                               bool is_redirect)
+{
+  if (path == "/")
+    return root;
+
+  FstEntry* entry = root;
   std::string complete_path = "";
   for (const std::string& component : SplitString(std::string(path.substr(1)), '/'))
   {
@@ -265,30 +574,118 @@ HostFileSystem::FstEntry* HostFileSystem::GetFstEntryForPath(const std::string&
       // This code path is also reached when creating a new file or directory;
       // proper metadata is filled in later.
       INFO_LOG_FMT(IOS_FS, "Creating a default entry for {} ({})", complete_path,
-                   host_file.is_redirect ? "redirect" : "NAND");
+                   is_redirect ? "redirect" : "NAND");
       entry = &entry->children.emplace_back();
       entry->name = component;
       entry->data.modes = {Mode::ReadWrite, Mode::ReadWrite, Mode::ReadWrite};
     }
   }
+  return entry;
+}
 
-  entry->data.is_file = host_file_info.IsFile();
-  if (entry->data.is_file && !entry->children.empty())
+Common::SHA1::Digest HostFileSystem::GetFileDigest(const std::string& host_path, u64 size)
+{
+  const std::optional<s64> modification_time = GetModificationTime(host_path);
+  const auto it = m_file_digests.find(host_path);
+  if (it != m_file_digests.end() && it->second.size == size && modification_time &&
+      it->second.modification_time == *modification_time)
   {
-    WARN_LOG_FMT(IOS_FS, "{} is a file but also has children; clearing children", path);
-    entry->children.clear();
+    return it->second.digest;
   }
 
-  return entry;
+  auto context = Common::SHA1::CreateContext();
+  File::IOFile file(host_path, "rb");
+  std::vector<u8> buffer(BUFFER_CHUNK_SIZE);
+  for (u64 remaining = size; remaining != 0;)
+  {
+    const size_t count = static_cast<size_t>(std::min<u64>(remaining, buffer.size()));
+    if (!file.ReadBytes(buffer.data(), count))
+    {
+      ERROR_LOG_FMT(IOS_FS, "Failed to read {} for hashing", host_path);
+      break;
+    }
+    context->Update(buffer.data(), count);
+    remaining -= count;
+  }
+
+  const Common::SHA1::Digest digest = context->Finish();
+  if (modification_time)
+    m_file_digests.insert_or_assign(host_path, FileDigest{size, *modification_time, digest});
+  return digest;
+}
+
+void HostFileSystem::ForgetFileDigests(const std::string& host_path)
+{
+  if (m_file_digests.empty())
+    return;
+
+  m_file_digests.erase(host_path);
+
+  const std::string prefix = host_path + '/';
+  auto it = m_file_digests.lower_bound(prefix);
+  while (it != m_file_digests.end() && it->first.starts_with(prefix))
+    it = m_file_digests.erase(it);
+}
+
+Common::SHA1::Digest HostFileSystem::SnapshotFile(const std::string& host_path, u64 size)
+{
+  const Common::SHA1::Digest digest = GetFileDigest(host_path, size);
+  SnapshotBlobs::AddReference(digest);
+
+  const std::string blob_path = SnapshotBlobs::GetBlobPath(digest);
+  if (File::Exists(blob_path))
+    return digest;
+
+  // Blobs are never modified once written, so they must not share storage with the original file
+  // other than through copy-on-write.
+  File::CreateFullPath(blob_path);
+  const std::string temp_path = File::GetTempFilenameForAtomicWrite(blob_path);
+  if (!File::CloneRegularFile(host_path, temp_path) || !File::Rename(temp_path, blob_path))
+  {
+    PanicAlertFmt("IOS_FS: Failed to store {} for the savestate", host_path);
+    File::Delete(temp_path, File::IfAbsentBehavior::NoConsoleWarning);
+  }
+  return digest;
+}
+
+bool HostFileSystem::RestoreFile(const std::string& host_path, u64 size,
+                                 const Common::SHA1::Digest& digest)
+{
+  const File::FileInfo info(host_path);
+  if (info.IsDirectory())
+    File::DeleteDirRecursively(host_path);
+  else if (info.IsFile() && info.GetSize() == size && GetFileDigest(host_path, size) == digest)
+    return true;
+
+  const std::string blob_path = SnapshotBlobs::GetBlobPath(digest);
+  if (!File::IsFile(blob_path))
+  {
+    ERROR_LOG_FMT(IOS_FS, "Cannot restore {}: {} is missing", host_path, blob_path);
+    return false;
+  }
+
+  ForgetFileDigests(host_path);
+  if (!File::CloneRegularFile(blob_path, host_path))
+    return false;
+
+  if (const std::optional<s64> modification_time = GetModificationTime(host_path))
+    m_file_digests.insert_or_assign(host_path, FileDigest{size, *modification_time, digest});
+  return true;
 }
 
-void HostFileSystem::DoStateRead(PointerWrap& p, std::string start_directory_path)
+void HostFileSystem::DoStateRead(PointerWrap& p, std::string start_directory_path,
+                                 bool embedded)
 {
   std::string path = BuildFilename(start_directory_path).host_path;
-  File::DeleteDirRecursively(path);
-  File::CreateDir(path);
+  if (!File::IsDirectory(path))
+  {
+    File::Delete(path, File::IfAbsentBehavior::NoConsoleWarning);
+    File::CreateDir(path);
+  }
 
-  // now restore from the stream
+  // Only files that differ from the snapshot are restored. Everything else is kept as is.
+  std::set<std::string> snapshot_paths;
+  u32 missing_files = 0;
   while (1)
   {
     char type = 0;
@@ -298,36 +695,80 @@ void HostFileSystem::DoStateRead(PointerWrap& p, std::string start_directory_pat
     std::string file_name;
     p.Do(file_name);
     std::string name = path + "/" + file_name;
+    snapshot_paths.insert(name);
     switch (type)
     {
     case 'd':
     {
-      File::CreateDir(name);
+      if (!File::IsDirectory(name))
+      {
+        File::Delete(name, File::IfAbsentBehavior::NoConsoleWarning);
+        File::CreateDir(name);
+      }
       break;
     }
     case 'f':
     {
-      u32 size = 0;
+      u64 size = 0;
       p.Do(size);
 
-      File::IOFile handle(name, "wb");
-      char buf[BUFFER_CHUNK_SIZE];
-      u32 count = size;
-      while (count > BUFFER_CHUNK_SIZE)
+      if (embedded)
       {
-        p.DoArray(buf);
-        handle.WriteArray(&buf[0], BUFFER_CHUNK_SIZE);
-        count -= BUFFER_CHUNK_SIZE;
+        if (File::IsDirectory(name))
+          File::DeleteDirRecursively(name);
+        ForgetFileDigests(name);
+
+        File::IOFile handle(name, "wb");
+        std::vector<u8> buffer(BUFFER_CHUNK_SIZE);
+        for (u64 remaining = size; remaining != 0;)
+        {
+          const size_t count = static_cast<size_t>(std::min<u64>(remaining, buffer.size()));
+          p.DoArray(buffer.data(), static_cast<u32>(count));
+          handle.WriteBytes(buffer.data(), count);
+          remaining -= count;
+        }
+        break;
       }
-      p.DoArray(&buf[0], count);
-      handle.WriteArray(&buf[0], count);
+
+      Common::SHA1::Digest digest{};
+      p.DoArray(digest);
+      if (p.IsReadMode() && !RestoreFile(name, size, digest))
+        ++missing_files;
       break;
     }
     }
   }
+
+  // Remove whatever was created after the snapshot was taken.
+  const auto remove_new_entries = [&](const auto& remove, const File::FSTEntry& entry) -> void {
+    for (const File::FSTEntry& child : entry.children)
+    {
+      if (snapshot_paths.contains(child.physicalName))
+      {
+        if (child.isDirectory)
+          remove(remove, child);
+        continue;
+      }
+
+      ForgetFileDigests(child.physicalName);
+      if (child.isDirectory)
+        File::DeleteDirRecursively(child.physicalName);
+      else
+        File::Delete(child.physicalName);
+    }
+  };
+  remove_new_entries(remove_new_entries, File::ScanDirectoryTree(path, true));
+
+  if (missing_files != 0)
+  {
+    PanicAlertFmt("IOS_FS: {} files in {} could not be restored because their contents are "
+                  "missing from the savestate blob store.",
+                  missing_files, start_directory_path);
+  }
 }
 
-void HostFileSystem::DoStateWriteOrMeasure(PointerWrap& p, std::string start_directory_path)
+void HostFileSystem::DoStateWriteOrMeasure(PointerWrap& p, std::string start_directory_path,
+                                           bool embedded)
 {
   std::string path = BuildFilename(start_directory_path).host_path;
   File::FSTEntry parent_entry = File::ScanDirectoryTree(path, true);
@@ -348,20 +789,33 @@ void HostFileSystem::DoStateWriteOrMeasure(PointerWrap& p, std::string start_dir
     }
     else
     {
-      u32 size = (u32)entry.size;
+      u64 size = entry.size;
       p.Do(size);
 
-      File::IOFile handle(entry.physicalName, "rb");
-      char buf[BUFFER_CHUNK_SIZE];
-      u32 count = size;
-      while (count > BUFFER_CHUNK_SIZE)
+      if (embedded)
       {
-        handle.ReadArray(&buf[0], BUFFER_CHUNK_SIZE);
-        p.DoArray(buf);
-        count -= BUFFER_CHUNK_SIZE;
+        // Measuring only needs the size of the state, so skip reading.
+        File::IOFile handle;
+        if (p.IsWriteMode())
+          handle.Open(entry.physicalName, "rb");
+        std::vector<u8> buffer(BUFFER_CHUNK_SIZE);
+        for (u64 remaining = size; remaining != 0;)
+        {
+          const size_t count = static_cast<size_t>(std::min<u64>(remaining, buffer.size()));
+          if (p.IsWriteMode() && !handle.ReadBytes(buffer.data(), count))
+            ERROR_LOG_FMT(IOS_FS, "Failed to read {} for the savestate", entry.physicalName);
+          p.DoArray(buffer.data(), static_cast<u32>(count));
+          remaining -= count;
+        }
+      }
+      else
+      {
+        // Measuring only needs the size of the state, so skip hashing.
+        Common::SHA1::Digest digest{};
+        if (p.IsWriteMode())
+          digest = SnapshotFile(entry.physicalName, size);
+        p.DoArray(digest);
       }
-      handle.ReadArray(&buf[0], count);
-      p.DoArray(&buf[0], count);
     }
     todo.pop_front();
   }
@@ -376,9 +830,14 @@ void HostFileSystem::DoState(PointerWrap& p)
   for (Handle& handle : m_handles)
     handle.host_file.reset();
 
+  // The NAND root (including the FST) may be part of the savestate.
+  if (m_fst_journal.IsOpen())
+    SaveFst();
+
   // The format for the next part of the save state is follows:
   // 1. bool Movie::WasMovieActiveWhenStateSaved() &&
   // WiiRoot::WasWiiRootTemporaryDirectoryWhenStateSaved()
+  // 1a. bool whether file contents are embedded (rather than stored in the blob store).
   // 2. Contents of the "/tmp" directory recursively.
   // 3. u32 size_of_nand_folder_saved_below (or 0, if the root
   // of the NAND folder is not savestated below).
@@ -395,15 +854,25 @@ void HostFileSystem::DoState(PointerWrap& p)
       Movie::IsMovieActive() && Core::WiiRootIsTemporary();
   p.Do(original_save_state_made_during_movie_recording);
 
+  // The savestate that a movie starts from is copied next to the movie, so it has to be
+  // self-contained.
+  bool embedded = Config::Get(Config::MAIN_EMBED_NAND_IN_SAVESTATES) ||
+                  Movie::IsRecordingInputFromSaveState();
+  p.Do(embedded);
+
   u32 temp_val = 0;
 
   if (!p.IsReadMode())
   {
-    DoStateWriteOrMeasure(p, "/tmp");
+    // Only the blobs which this savestate refers to are of interest to the caller.
+    if (p.IsWriteMode())
+      SnapshotBlobs::TakeReferences();
+
+    DoStateWriteOrMeasure(p, "/tmp", embedded);
     u8* previous_position = p.ReserveU32();
     if (original_save_state_made_during_movie_recording)
     {
-      DoStateWriteOrMeasure(p, "/");
+      DoStateWriteOrMeasure(p, "/", embedded);
       if (p.IsWriteMode())
       {
         u32 size_of_nand = p.GetOffsetFromPreviousPosition(previous_position) - sizeof(u32);
@@ -413,7 +882,8 @@ void HostFileSystem::DoState(PointerWrap& p)
   }
   else  // case where we're in read mode.
   {
-    DoStateRead(p, "/tmp");
+    m_directory_stats.clear();
+    DoStateRead(p, "/tmp", embedded);
     if (!Movie::IsMovieActive() || !original_save_state_made_during_movie_recording ||
         !Core::WiiRootIsTemporary() ||
         (original_save_state_made_during_movie_recording !=
@@ -425,7 +895,12 @@ void HostFileSystem::DoState(PointerWrap& p)
     {
       p.Do(temp_val);
       if (Movie::IsMovieActive() && Core::WiiRootIsTemporary())
-        DoStateRead(p, "/");
+      {
+        DoStateRead(p, "/", embedded);
+        // The FST file was restored too.
+        ResetFst();
+        LoadFst();
+      }
     }
   }
 
@@ -451,6 +926,8 @@ ResultCode HostFileSystem::Format(Uid uid)
     return ResultCode::UnknownError;
   ResetFst();
   SaveFst();
+  m_directory_stats.clear();
+  m_file_digests.clear();
   // Reset and close all handles.
   m_handles = {};
   return ResultCode::Success;
@@ -469,7 +946,8 @@ ResultCode HostFileSystem::CreateFileOrDirectory(Uid uid, Gid gid, const std::st
     return ResultCode::TooManyPathComponents;
 
   const auto split_path = SplitPathAndBasename(path);
-  const std::string host_path = BuildFilename(path).host_path;
+  const auto host_file = BuildFilename(path);
+  const std::string& host_path = host_file.host_path;
 
   FstEntry* parent = GetFstEntryForPath(split_path.parent);
   if (!parent)
@@ -481,6 +959,7 @@ ResultCode HostFileSystem::CreateFileOrDirectory(Uid uid, Gid gid, const std::st
   if (File::Exists(host_path))
     return ResultCode::AlreadyExists;
 
+  ForgetFileDigests(host_path);
   const bool ok = is_file ? File::CreateEmptyFile(host_path) : File::CreateDir(host_path);
   if (!ok)
   {
@@ -496,7 +975,16 @@ ResultCode HostFileSystem::CreateFileOrDirectory(Uid uid, Gid gid, const std::st
   child->data.uid = uid;
   child->data.gid = gid;
   child->data.attribute = attr;
-  SaveFst();
+
+  if (host_file.is_redirect)
+  {
+    m_directory_stats.clear();
+  }
+  else
+  {
+    JournalFstChange(FstJournalOp::Create, path, child->data);
+    AddPathUsage(path, PathUsage{is_file, 1, 0});
+  }
   return ResultCode::Success;
 }
 
@@ -531,7 +1019,8 @@ ResultCode HostFileSystem::Delete(Uid uid, Gid gid, const std::string& path)
   if (!IsValidNonRootPath(path))
     return ResultCode::Invalid;
 
-  const std::string host_path = BuildFilename(path).host_path;
+  const auto host_file = BuildFilename(path);
+  const std::string& host_path = host_file.host_path;
   const auto split_path = SplitPathAndBasename(path);
 
   FstEntry* parent = GetFstEntryForPath(split_path.parent);
@@ -544,6 +1033,8 @@ ResultCode HostFileSystem::Delete(Uid uid, Gid gid, const std::string& path)
   if (!File::Exists(host_path))
     return ResultCode::NotFound;
 
+  const std::optional<PathUsage> usage = GetPathUsage(path);
+  ForgetFileDigests(host_path);
   if (File::IsFile(host_path) && !IsFileOpened(path))
     File::Delete(host_path);
   else if (File::IsDirectory(host_path) && !IsDirectoryInUse(path))
@@ -555,7 +1046,18 @@ ResultCode HostFileSystem::Delete(Uid uid, Gid gid, const std::string& path)
                                GetNamePredicate(split_path.file_name));
   if (it != parent->children.end())
     parent->children.erase(it);
-  SaveFst();
+
+  if (host_file.is_redirect)
+  {
+    m_directory_stats.clear();
+  }
+  else
+  {
+    JournalFstChange(FstJournalOp::Delete, path);
+    if (usage)
+      AddPathUsage(path, *usage, true);
+    InvalidateDirectoryStats(path);
+  }
 
   return ResultCode::Success;
 }
@@ -599,6 +1101,11 @@ ResultCode HostFileSystem::Rename(Uid uid, Gid gid, const std::string& old_path,
   const std::string& host_old_path = host_old_info.host_path;
   const std::string& host_new_path = host_new_info.host_path;
 
+  const std::optional<PathUsage> old_usage = GetPathUsage(old_path);
+  const std::optional<PathUsage> replaced_usage = GetPathUsage(new_path);
+  ForgetFileDigests(host_old_path);
+  ForgetFileDigests(host_new_path);
+
   // If there is already something of the same type at the new path, delete it.
   if (File::Exists(host_new_path))
   {
@@ -651,7 +1158,26 @@ ResultCode HostFileSystem::Rename(Uid uid, Gid gid, const std::string& old_path,
     old_parent->children.erase(it);
   }
 
-  SaveFst();
+  if (host_old_info.is_redirect || host_new_info.is_redirect)
+  {
+    // Only the NAND FST is saved, so moving an entry in or out of it needs a full write.
+    if (!host_old_info.is_redirect || !host_new_info.is_redirect)
+      SaveFst();
+    m_directory_stats.clear();
+  }
+  else
+  {
+    JournalFstChange(FstJournalOp::Rename, old_path, {}, new_path);
+    if (replaced_usage)
+      AddPathUsage(new_path, *replaced_usage, true);
+    if (old_usage)
+    {
+      AddPathUsage(old_path, *old_usage, true);
+      AddPathUsage(new_path, *old_usage);
+    }
+    InvalidateDirectoryStats(old_path);
+    InvalidateDirectoryStats(new_path);
+  }
 
   return ResultCode::Success;
 }
@@ -765,7 +1291,8 @@ ResultCode HostFileSystem::SetMetadata(Uid caller_uid, const std::string& path,
     entry->data.uid = uid;
     entry->data.attribute = attr;
     entry->data.modes = modes;
-    SaveFst();
+    if (!BuildFilename(path).is_redirect)
+      JournalFstChange(FstJournalOp::SetMetadata, path, entry->data);
   }
 
   return ResultCode::Success;
@@ -779,7 +1306,7 @@ static u64 ComputeUsedClusters(const File::FSTEntry& parent_entry)
     if (entry.isDirectory)
       clusters += ComputeUsedClusters(entry);
     else
-      clusters += Common::AlignUp(entry.size, CLUSTER_SIZE) / CLUSTER_SIZE;
+      clusters += GetUsedClusters(entry.size);
   }
   return clusters;
 }
@@ -820,6 +1347,10 @@ HostFileSystem::GetExtendedDirectoryStats(const std::string& wii_path)
   if (!IsValidPath(wii_path))
     return ResultCode::Invalid;
 
+  const auto cached_stats = m_directory_stats.find(wii_path);
+  if (cached_stats != m_directory_stats.end())
+    return cached_stats->second;
+
   ExtendedDirectoryStats stats{};
   std::string path(BuildFilename(wii_path).host_path);
   File::FileInfo info(path);
@@ -840,11 +1371,68 @@ HostFileSystem::GetExtendedDirectoryStats(const std::string& wii_path)
   {
     return ResultCode::Invalid;
   }
+  m_directory_stats.emplace(wii_path, stats);
   return stats;
 }
 
+std::optional<HostFileSystem::PathUsage> HostFileSystem::GetPathUsage(const std::string& wii_path)
+{
+  if (m_directory_stats.empty())
+    return std::nullopt;
+
+  const File::FileInfo info{BuildFilename(wii_path).host_path};
+  if (info.IsFile())
+    return PathUsage{true, 1, GetUsedClusters(info.GetSize())};
+
+  if (info.IsDirectory())
+  {
+    const auto stats = GetExtendedDirectoryStats(wii_path);
+    if (stats)
+      return PathUsage{false, stats->used_inodes, stats->used_clusters};
+  }
+
+  return std::nullopt;
+}
+
+void HostFileSystem::AddPathUsage(std::string_view wii_path, const PathUsage& usage, bool subtract)
+{
+  // Unsigned wraparound takes care of subtraction.
+  const u64 inodes = subtract ? 0 - usage.inodes : usage.inodes;
+  const u64 clusters = subtract ? 0 - usage.clusters : usage.clusters;
+
+  for (size_t separator = wii_path.rfind('/'); separator != std::string_view::npos;)
+  {
+    const bool is_root = separator == 0;
+    const std::string_view directory = is_root ? "/" : wii_path.substr(0, separator);
+
+    // Files directly in the root directory are hidden from the emulated system.
+    // See FixupDirectoryEntries.
+    const bool is_hidden = is_root && usage.is_file && wii_path.rfind('/') == 0;
+
+    const auto it = m_directory_stats.find(directory);
+    if (it != m_directory_stats.end() && !is_hidden)
+    {
+      it->second.used_inodes += inodes;
+      it->second.used_clusters += clusters;
+    }
+
+    separator = is_root ? std::string_view::npos : wii_path.rfind('/', separator - 1);
+  }
+}
+
+void HostFileSystem::InvalidateDirectoryStats(const std::string& wii_path)
+{
+  m_directory_stats.erase(wii_path);
+
+  const std::string prefix = wii_path + '/';
+  auto it = m_directory_stats.lower_bound(prefix);
+  while (it != m_directory_stats.end() && it->first.starts_with(prefix))
+    it = m_directory_stats.erase(it);
+}
+
 void HostFileSystem::SetNandRedirects(std::vector<NandRedirect> nand_redirects)
 {
   m_nand_redirects = std::move(nand_redirects);
+  m_directory_stats.clear();
 }
 }  // namespace IOS::HLE::FS
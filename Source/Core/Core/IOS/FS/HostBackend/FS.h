@@ -6,10 +6,13 @@
 #include <array>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
 #include "Common/IOFile.h"
 #include "Core/IOS/FS/FileSystem.h"
 
@@ -60,8 +63,20 @@ public:
   void SetNandRedirects(std::vector<NandRedirect> nand_redirects) override;
 
 private:
-  void DoStateWriteOrMeasure(PointerWrap& p, std::string start_directory_path);
-  void DoStateRead(PointerWrap& p, std::string start_directory_path);
+  /// Unless their contents are embedded, savestates only contain the hashes of files. Their
+  /// contents are kept in a content-addressed blob store shared by all savestates (see
+  /// SnapshotBlobs.h), so each version of a file is only stored once.
+  void DoStateWriteOrMeasure(PointerWrap& p, std::string start_directory_path, bool embedded);
+  void DoStateRead(PointerWrap& p, std::string start_directory_path, bool embedded);
+
+  /// Makes sure that the blob store contains the current contents of a file and returns their hash.
+  Common::SHA1::Digest SnapshotFile(const std::string& host_path, u64 size);
+  /// Brings a file back to the given contents. Files that already match are left untouched.
+  /// Returns false if the contents are missing from the blob store.
+  bool RestoreFile(const std::string& host_path, u64 size, const Common::SHA1::Digest& digest);
+  Common::SHA1::Digest GetFileDigest(const std::string& host_path, u64 size);
+  /// Must be called whenever files are modified, for host_path itself and everything under it.
+  void ForgetFileDigests(const std::string& host_path);
 
   struct FstEntry
   {
@@ -101,14 +116,53 @@ private:
   bool IsFileOpened(const std::string& path) const;
   bool IsDirectoryInUse(const std::string& path) const;
 
+  enum class FstJournalOp : u8
+  {
+    Create,
+    Delete,
+    Rename,
+    SetMetadata,
+  };
+
   std::string GetFstFilePath() const;
+  std::string GetFstJournalFilePath() const;
   void ResetFst();
   void LoadFst();
+  /// Writes the whole FST and discards the journal.
   void SaveFst();
+  /// Records a change to the FST in the journal instead of rewriting the whole FST.
+  /// The journal is folded back into the FST once it gets too long, and on shutdown.
+  void JournalFstChange(FstJournalOp op, const std::string& path, const Metadata& data = {},
+                        const std::string& new_path = {});
+  /// Applies the changes from a journal left behind by a previous session.
+  /// Returns true if a journal file was found.
+  bool ReplayFstJournal();
+  void ReplayFstChange(FstJournalOp op, const std::string& path, const Metadata& data,
+                       const std::string& new_path);
+  /// Drops FST entries for files which no longer exist on the host and fixes up their types.
+  /// Returns true if anything was changed.
+  bool CheckFstConsistency();
   /// Get the FST entry for a file (or directory).
   /// Automatically creates fallback entries for parents if they do not exist.
   /// Returns nullptr if the path is invalid or the file does not exist.
   FstEntry* GetFstEntryForPath(const std::string& path);
+  /// Same as GetFstEntryForPath, but only looks at the FST and not at the host filesystem.
+  static FstEntry* FindOrCreateFstEntry(FstEntry* root, const std::string& path,
+                                        bool is_redirect);
+
+  /// Space taken up by a file or a directory tree, as counted by GetExtendedDirectoryStats.
+  struct PathUsage
+  {
+    bool is_file;
+    u64 inodes;
+    u64 clusters;
+  };
+  /// Returns std::nullopt if there are no cached directory stats that could need updating.
+  std::optional<PathUsage> GetPathUsage(const std::string& wii_path);
+  /// Adds (or subtracts) usage to the cached stats of every parent directory of wii_path.
+  void AddPathUsage(std::string_view wii_path, const PathUsage& usage, bool subtract = false);
+  /// Drops the cached stats for wii_path and everything under it.
+  void InvalidateDirectoryStats(const std::string& wii_path);
 
   /// FST entry for the filesystem root.
   ///
@@ -120,6 +174,28 @@ private:
   /// filesystem root manually.
   FstEntry m_root_entry{};
   std::string m_root_path;
+  /// CRC32 of the FST file as it was last loaded or saved, which the journal applies to.
+  u32 m_fst_checksum = 0;
+  File::IOFile m_fst_journal;
+  u32 m_fst_journal_records = 0;
+
+  /// Stats for the directories that the emulated software has asked about.
+  ///
+  /// Computing these means walking the host directory tree, so they are kept up to date
+  /// by the operations that change them rather than recomputed on each request.
+  std::map<std::string, ExtendedDirectoryStats, std::less<>> m_directory_stats;
+
+  struct FileDigest
+  {
+    u64 size;
+    s64 modification_time;
+    Common::SHA1::Digest digest;
+  };
+  /// Hashes of files that have not been modified since they were last snapshotted or restored,
+  /// keyed by host path. Avoids rehashing the whole NAND for every savestate.
+  /// Entries are also ignored once a file's size or modification time no longer matches.
+  std::map<std::string, FileDigest, std::less<>> m_file_digests;
+
   std::map<std::string, std::weak_ptr<File::IOFile>> m_open_files;
   std::array<Handle, 16> m_handles{};
 
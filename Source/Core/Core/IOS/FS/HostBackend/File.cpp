@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <memory>
 
+#include "Common/Align.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
@@ -148,12 +149,29 @@ Result<u32> HostFileSystem::WriteBytesToFile(Fd fd, const u8* ptr, u32 count)
   if ((u8(handle->mode) & u8(Mode::Write)) == 0)
     return ResultCode::AccessDenied;
 
+  // Only needed for keeping the cached directory stats up to date.
+  const u64 old_size = m_directory_stats.empty() ? 0 : handle->host_file->GetSize();
+
+  if (!m_file_digests.empty())
+    ForgetFileDigests(BuildFilename(handle->wii_path).host_path);
+
   // File might be opened twice, need to seek before we read
   handle->host_file->Seek(handle->file_offset, File::SeekOrigin::Begin);
   if (!handle->host_file->WriteBytes(ptr, count))
     return ResultCode::AccessDenied;
 
   handle->file_offset += count;
+
+  if (!m_directory_stats.empty() && handle->file_offset > old_size)
+  {
+    const u64 old_clusters = Common::AlignUp(old_size, CLUSTER_SIZE) / CLUSTER_SIZE;
+    const u64 new_clusters = Common::AlignUp<u64>(handle->file_offset, CLUSTER_SIZE) / CLUSTER_SIZE;
+    if (BuildFilename(handle->wii_path).is_redirect)
+      m_directory_stats.clear();
+    else if (new_clusters != old_clusters)
+      AddPathUsage(handle->wii_path, PathUsage{true, 0, new_clusters - old_clusters});
+  }
+
   return count;
 }
 
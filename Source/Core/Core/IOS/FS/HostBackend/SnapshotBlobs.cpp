@@ -0,0 +1,165 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/IOS/FS/HostBackend/SnapshotBlobs.h"
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string_view>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+
+namespace IOS::HLE::FS::SnapshotBlobs
+{
+namespace
+{
+// Savestate path -> hashes of the blobs it refers to
+using ReferenceIndex = std::map<std::string, std::set<std::string>>;
+
+std::mutex s_mutex;
+std::vector<Common::SHA1::Digest> s_pending_references;
+
+std::string GetStorePath()
+{
+  return File::GetUserPath(D_STATESAVES_IDX) + "NAND/";
+}
+
+std::string GetIndexPath()
+{
+  return GetStorePath() + "references";
+}
+
+// The index holds a line with the path of each savestate, followed by a line with the hashes of
+// its blobs separated by spaces.
+ReferenceIndex LoadIndex()
+{
+  ReferenceIndex index;
+  std::string contents;
+  if (!File::ReadFileToString(GetIndexPath(), contents))
+    return index;
+
+  const std::vector<std::string> lines = SplitString(contents, '\n');
+  for (size_t i = 0; i + 1 < lines.size(); i += 2)
+  {
+    std::set<std::string>& hashes = index[lines[i]];
+    for (const std::string& hash : SplitString(lines[i + 1], ' '))
+    {
+      if (!hash.empty())
+        hashes.insert(hash);
+    }
+  }
+  return index;
+}
+
+void SaveIndex(const ReferenceIndex& index)
+{
+  std::string contents;
+  for (const auto& [state_path, hashes] : index)
+    contents += fmt::format("{}\n{}\n", state_path, fmt::join(hashes, " "));
+
+  const std::string index_path = GetIndexPath();
+  const std::string temp_path = File::GetTempFilenameForAtomicWrite(index_path);
+  File::CreateFullPath(index_path);
+  if (!File::WriteStringToFile(temp_path, contents) || !File::Rename(temp_path, index_path))
+    ERROR_LOG_FMT(IOS_FS, "Failed to write {}", index_path);
+}
+}  // namespace
+
+std::string GetBlobPath(const Common::SHA1::Digest& digest)
+{
+  const std::string hash = Common::BytesToHexString(digest);
+  return fmt::format("{}{}/{}", GetStorePath(), hash.substr(0, 2), hash.substr(2));
+}
+
+void AddReference(const Common::SHA1::Digest& digest)
+{
+  std::lock_guard lk(s_mutex);
+  s_pending_references.push_back(digest);
+}
+
+std::vector<Common::SHA1::Digest> TakeReferences()
+{
+  std::lock_guard lk(s_mutex);
+  return std::exchange(s_pending_references, {});
+}
+
+void RecordReferences(const std::string& state_path, std::vector<Common::SHA1::Digest> digests)
+{
+  std::lock_guard lk(s_mutex);
+  ReferenceIndex index = LoadIndex();
+  if (digests.empty() && !index.contains(state_path))
+    return;
+
+  std::set<std::string>& hashes = index[state_path];
+  hashes.clear();
+  for (const Common::SHA1::Digest& digest : digests)
+    hashes.insert(Common::BytesToHexString(digest));
+  if (hashes.empty())
+    index.erase(state_path);
+
+  SaveIndex(index);
+}
+
+void MoveReferences(const std::string& old_state_path, const std::string& new_state_path)
+{
+  std::lock_guard lk(s_mutex);
+  ReferenceIndex index = LoadIndex();
+  const auto it = index.find(old_state_path);
+  if (it == index.end())
+  {
+    if (index.erase(new_state_path) != 0)
+      SaveIndex(index);
+    return;
+  }
+
+  index.insert_or_assign(new_state_path, std::move(it->second));
+  index.erase(old_state_path);
+  SaveIndex(index);
+}
+
+void CollectGarbage()
+{
+  std::lock_guard lk(s_mutex);
+  s_pending_references.clear();
+
+  const std::string store_path = GetStorePath();
+  if (!File::IsDirectory(store_path))
+    return;
+
+  ReferenceIndex index = LoadIndex();
+  const size_t num_states = index.size();
+  std::erase_if(index, [](const auto& entry) { return !File::IsFile(entry.first); });
+  if (index.size() != num_states)
+    SaveIndex(index);
+
+  std::set<std::string_view> referenced;
+  for (const auto& [state_path, hashes] : index)
+    referenced.insert(hashes.begin(), hashes.end());
+
+  u32 num_deleted = 0;
+  for (const File::FSTEntry& directory : File::ScanDirectoryTree(store_path, true).children)
+  {
+    // Everything else (such as the index itself) is not a blob
+    if (!directory.isDirectory || directory.virtualName.size() != 2)
+      continue;
+
+    for (const File::FSTEntry& blob : directory.children)
+    {
+      if (blob.isDirectory || referenced.contains(directory.virtualName + blob.virtualName))
+        continue;
+
+      if (File::Delete(blob.physicalName))
+        ++num_deleted;
+    }
+  }
+
+  if (num_deleted != 0)
+    INFO_LOG_FMT(IOS_FS, "Deleted {} NAND blobs which no savestate refers to", num_deleted);
+}
+}  // namespace IOS::HLE::FS::SnapshotBlobs
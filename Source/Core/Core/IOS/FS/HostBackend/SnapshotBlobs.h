@@ -0,0 +1,36 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Common/Crypto/SHA1.h"
+
+// Content-addressed store for the NAND files which savestates refer to by hash.
+//
+// Every savestate file which refers to blobs is listed in an index next to the blobs, along with
+// the hashes it needs. CollectGarbage() deletes the blobs which none of the listed savestates
+// need anymore, once those savestates have been deleted or overwritten. States which are only
+// kept in memory are covered too, as garbage is only collected before emulation starts.
+//
+// Savestates which are copied somewhere else are not tracked. Those need their NAND contents to
+// be embedded (see Config::MAIN_EMBED_NAND_IN_SAVESTATES).
+
+namespace IOS::HLE::FS::SnapshotBlobs
+{
+std::string GetBlobPath(const Common::SHA1::Digest& digest);
+
+// Called for each blob which the NAND snapshot that is currently being written refers to
+void AddReference(const Common::SHA1::Digest& digest);
+// Returns the blobs which were referenced since the last call
+std::vector<Common::SHA1::Digest> TakeReferences();
+
+// Lists a savestate file in the index, replacing the blobs it previously referred to (if any)
+void RecordReferences(const std::string& state_path, std::vector<Common::SHA1::Digest> digests);
+// Called when a savestate file is renamed
+void MoveReferences(const std::string& old_state_path, const std::string& new_state_path);
+
+void CollectGarbage();
+}  // namespace IOS::HLE::FS::SnapshotBlobs
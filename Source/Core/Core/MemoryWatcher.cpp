@@ -3,23 +3,67 @@
 
 #include "Core/MemoryWatcher.h"
 
+#include <algorithm>
 #include <cstring>
+#include <fcntl.h>
 #include <fstream>
-#include <iostream>
+#include <iterator>
+#include <new>
 #include <sstream>
+#include <string_view>
+#include <sys/mman.h>
 #include <unistd.h>
 
+#include <fmt/format.h>
+
+#include "Common/Align.h"
 #include "Common/FileUtil.h"
-#include "Core/HW/SystemTimers.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+#include "Common/Swap.h"
 #include "Core/PowerPC/MMU.h"
 
+namespace
+{
+// Changes in a range which are closer together than this are sent as one change, as the
+// per-change overhead is bigger than resending a few unchanged bytes.
+constexpr u32 DIFF_MERGE_DISTANCE = 16;
+
+// Single values at fixed addresses which are closer together than this are read with one copy.
+constexpr u32 BATCH_MERGE_DISTANCE = 64;
+constexpr u32 MAX_BATCH_SIZE = 0x1000;
+constexpr u64 ADDRESS_SPACE_END = 0x100000000;
+
+constexpr size_t SHARED_MEMORY_SIZE =
+    MemoryWatcher::SHARED_MEMORY_HEADER_SIZE + MemoryWatcher::SHARED_MEMORY_CAPACITY;
+
+static_assert(sizeof(MemoryWatcher::SharedMemoryHeader) <=
+              MemoryWatcher::SHARED_MEMORY_HEADER_SIZE);
+static_assert(std::atomic<u64>::is_always_lock_free);
+static_assert(sizeof(MemoryWatcher::RecordHeader) == MemoryWatcher::RECORD_ALIGNMENT);
+static_assert(sizeof(MemoryWatcher::ChangeHeader) % 4 == 0);
+
+template <typename T>
+void Append(std::vector<u8>* buffer, const T& value)
+{
+  const u8* bytes = reinterpret_cast<const u8*>(&value);
+  buffer->insert(buffer->end(), bytes, bytes + sizeof(T));
+}
+}  // namespace
+
 MemoryWatcher::MemoryWatcher()
 {
   m_running = false;
   if (!LoadAddresses(File::GetUserPath(F_MEMORYWATCHERLOCATIONS_IDX)))
     return;
-  if (!OpenSocket(File::GetUserPath(F_MEMORYWATCHERSOCKET_IDX)))
+
+  const bool socket_open = OpenSocket(File::GetUserPath(F_MEMORYWATCHERSOCKET_IDX));
+  const bool shared_memory_open =
+      OpenSharedMemory(File::GetUserPath(F_MEMORYWATCHERSHAREDMEMORY_IDX));
+  if (!socket_open && !shared_memory_open)
     return;
+
+  BuildBatches();
   m_running = true;
 }
 
@@ -29,7 +73,9 @@ MemoryWatcher::~MemoryWatcher()
     return;
 
   m_running = false;
-  close(m_fd);
+  if (m_fd >= 0)
+    close(m_fd);
+  CloseSharedMemory();
 }
 
 bool MemoryWatcher::LoadAddresses(const std::string& path)
@@ -43,19 +89,86 @@ bool MemoryWatcher::LoadAddresses(const std::string& path)
   while (std::getline(locations, line))
     ParseLine(line);
 
-  return !m_values.empty();
+  return !m_watches.empty();
 }
 
 void MemoryWatcher::ParseLine(const std::string& line)
 {
-  m_values[line] = 0;
-  m_addresses[line] = std::vector<u32>();
+  Watch watch;
+  watch.line = line;
 
-  std::istringstream offsets(line);
+  std::string_view spec = line;
+  if (const size_t at = spec.find('@'); at != std::string_view::npos)
+  {
+    if (!TryParse(std::string(StripWhitespace(spec.substr(at + 1))), &watch.sample_interval, 10) ||
+        watch.sample_interval == 0)
+    {
+      WARN_LOG_FMT(CORE, "MemoryWatcher: Invalid sample interval in \"{}\"", line);
+      return;
+    }
+    spec = spec.substr(0, at);
+  }
+  if (const size_t colon = spec.find(':'); colon != std::string_view::npos)
+  {
+    if (!TryParse(std::string(StripWhitespace(spec.substr(colon + 1))), &watch.size, 16) ||
+        watch.size == 0)
+    {
+      WARN_LOG_FMT(CORE, "MemoryWatcher: Invalid range size in \"{}\"", line);
+      return;
+    }
+    spec = spec.substr(0, colon);
+  }
+
+  std::istringstream offsets{std::string(spec)};
   offsets >> std::hex;
   u32 offset;
   while (offsets >> offset)
-    m_addresses[line].push_back(offset);
+    watch.offsets.push_back(offset);
+
+  if (watch.offsets.empty())
+    return;
+
+  m_watches.push_back(std::move(watch));
+}
+
+void MemoryWatcher::BuildBatches()
+{
+  std::vector<size_t> fixed;
+  for (size_t i = 0; i < m_watches.size(); ++i)
+  {
+    if (m_watches[i].size == 0 && m_watches[i].offsets.size() == 1)
+      fixed.push_back(i);
+    else
+      m_unbatched.push_back(i);
+  }
+
+  std::sort(fixed.begin(), fixed.end(), [this](size_t a, size_t b) {
+    return m_watches[a].offsets[0] < m_watches[b].offsets[0];
+  });
+
+  for (size_t i : fixed)
+  {
+    const u64 address = m_watches[i].offsets[0];
+    if (!m_batches.empty())
+    {
+      Batch& batch = m_batches.back();
+      const u64 batch_end = u64(batch.address) + batch.size;
+      const u64 new_end = std::max(batch_end, address + sizeof(u32));
+      if (address <= batch_end + BATCH_MERGE_DISTANCE &&
+          new_end - batch.address <= MAX_BATCH_SIZE && new_end <= ADDRESS_SPACE_END)
+      {
+        batch.size = static_cast<u32>(new_end - batch.address);
+        batch.watches.push_back(i);
+        continue;
+      }
+    }
+
+    // Values which wrap around the end of the address space can't be read with one copy.
+    if (address + sizeof(u32) > ADDRESS_SPACE_END)
+      m_unbatched.push_back(i);
+    else
+      m_batches.push_back(Batch{static_cast<u32>(address), sizeof(u32), {i}});
+  }
 }
 
 bool MemoryWatcher::OpenSocket(const std::string& path)
@@ -67,10 +180,55 @@ bool MemoryWatcher::OpenSocket(const std::string& path)
   return m_fd >= 0;
 }
 
-u32 MemoryWatcher::ChasePointer(const Core::CPUThreadGuard& guard, const std::string& line)
+bool MemoryWatcher::OpenSharedMemory(const std::string& path)
+{
+  // Readers which still have a previous session's file mapped keep their own copy.
+  unlink(path.c_str());
+
+  m_shm_fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (m_shm_fd < 0)
+  {
+    ERROR_LOG_FMT(CORE, "MemoryWatcher: Failed to create {}", path);
+    return false;
+  }
+
+  if (ftruncate(m_shm_fd, SHARED_MEMORY_SIZE) != 0)
+  {
+    ERROR_LOG_FMT(CORE, "MemoryWatcher: Failed to resize {}", path);
+    CloseSharedMemory();
+    return false;
+  }
+
+  void* const memory =
+      mmap(nullptr, SHARED_MEMORY_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, m_shm_fd, 0);
+  if (memory == MAP_FAILED)
+  {
+    ERROR_LOG_FMT(CORE, "MemoryWatcher: Failed to map {}", path);
+    CloseSharedMemory();
+    return false;
+  }
+
+  m_shm = static_cast<u8*>(memory);
+  new (m_shm) SharedMemoryHeader{SHARED_MEMORY_MAGIC, SHARED_MEMORY_VERSION,
+                                 SHARED_MEMORY_HEADER_SIZE, SHARED_MEMORY_CAPACITY, 0, 0};
+  return true;
+}
+
+void MemoryWatcher::CloseSharedMemory()
+{
+  if (m_shm)
+    munmap(m_shm, SHARED_MEMORY_SIZE);
+  m_shm = nullptr;
+
+  if (m_shm_fd >= 0)
+    close(m_shm_fd);
+  m_shm_fd = -1;
+}
+
+u32 MemoryWatcher::ChasePointer(const Core::CPUThreadGuard& guard, const Watch& watch) const
 {
   u32 value = 0;
-  for (u32 offset : m_addresses[line])
+  for (u32 offset : watch.offsets)
   {
     value = PowerPC::MMU::HostRead_U32(guard, value + offset);
     if (!PowerPC::MMU::HostIsRAMAddress(guard, value))
@@ -79,26 +237,170 @@ u32 MemoryWatcher::ChasePointer(const Core::CPUThreadGuard& guard, const std::st
   return value;
 }
 
-std::string MemoryWatcher::ComposeMessages(const Core::CPUThreadGuard& guard)
+bool MemoryWatcher::ReadRAM(const Core::CPUThreadGuard& guard, u32 address, u32 size,
+                            u8* out) const
+{
+  while (size != 0)
+  {
+    const u32 page_offset = address & PowerPC::HW_PAGE_MASK;
+    const u32 chunk = std::min<u32>(size, PowerPC::HW_PAGE_SIZE - page_offset);
+
+    if (const u8* page = PowerPC::MMU::HostGetRAMPagePointer(guard, address))
+    {
+      std::memcpy(out, page + page_offset, chunk);
+    }
+    else if (PowerPC::MMU::HostIsRAMAddress(guard, address))
+    {
+      // RAM which can't be accessed directly, e.g. because the data cache is being emulated.
+      for (u32 i = 0; i < chunk; ++i)
+        out[i] = PowerPC::MMU::HostRead_U8(guard, address + i);
+    }
+    else
+    {
+      return false;
+    }
+
+    address += chunk;
+    out += chunk;
+    size -= chunk;
+  }
+  return true;
+}
+
+bool MemoryWatcher::IsDue(const Watch& watch) const
 {
-  std::ostringstream message_stream;
-  message_stream << std::hex;
+  return m_frame % watch.sample_interval == 0;
+}
 
-  for (auto& entry : m_values)
+void MemoryWatcher::UpdateValue(size_t id, u32 new_value)
+{
+  Watch& watch = m_watches[id];
+  if (new_value == watch.value)
+    return;
+
+  watch.value = new_value;
+  AddChange(id, ChangeType::Value, 0, reinterpret_cast<const u8*>(&new_value), sizeof(new_value));
+}
+
+void MemoryWatcher::UpdateRange(const Core::CPUThreadGuard& guard, size_t id)
+{
+  Watch& watch = m_watches[id];
+
+  u32 address = 0;
+  for (size_t i = 0; i + 1 < watch.offsets.size(); ++i)
+  {
+    address = PowerPC::MMU::HostRead_U32(guard, address + watch.offsets[i]);
+    if (!PowerPC::MMU::HostIsRAMAddress(guard, address))
+      return;
+  }
+  address += watch.offsets.back();
+
+  m_buffer.resize(watch.size);
+  if (!ReadRAM(guard, address, watch.size, m_buffer.data()))
+    return;
+
+  if (watch.data.empty())
   {
-    std::string address = entry.first;
-    u32& current_value = entry.second;
+    AddChange(id, ChangeType::Range, 0, m_buffer.data(), watch.size);
+    std::swap(watch.data, m_buffer);
+    return;
+  }
 
-    u32 new_value = ChasePointer(guard, address);
-    if (new_value != current_value)
+  const u8* const old_data = watch.data.data();
+  const u8* const new_data = m_buffer.data();
+  u32 i = 0;
+  while (i < watch.size)
+  {
+    // Skip over unchanged data a word at a time.
+    if (i + sizeof(u64) <= watch.size && std::memcmp(old_data + i, new_data + i, sizeof(u64)) == 0)
+    {
+      i += sizeof(u64);
+      continue;
+    }
+    if (old_data[i] == new_data[i])
+    {
+      ++i;
+      continue;
+    }
+
+    const u32 start = i;
+    u32 end = i + 1;
+    for (u32 j = end; j < watch.size && j < end + DIFF_MERGE_DISTANCE; ++j)
     {
-      // Update the value
-      current_value = new_value;
-      message_stream << address << '\n' << new_value << '\n';
+      if (old_data[j] != new_data[j])
+        end = j + 1;
     }
+
+    AddChange(id, ChangeType::Range, start, new_data + start, end - start);
+    i = end;
+  }
+
+  std::swap(watch.data, m_buffer);
+}
+
+void MemoryWatcher::AddChange(size_t id, ChangeType type, u32 offset, const u8* data, u32 size)
+{
+  const Watch& watch = m_watches[id];
+  auto message = std::back_inserter(m_message);
+  if (type == ChangeType::Value)
+  {
+    u32 value;
+    std::memcpy(&value, data, sizeof(value));
+    fmt::format_to(message, "{}\n{:x}\n", watch.line, value);
+  }
+  else
+  {
+    fmt::format_to(message, "{}\n{:x} ", watch.line, offset);
+    for (u32 i = 0; i < size; ++i)
+      fmt::format_to(message, "{:02x}", data[i]);
+    m_message.push_back('\n');
+  }
+
+  if (!m_shm)
+    return;
+
+  Append(&m_record, ChangeHeader{static_cast<u32>(id), type, offset, size});
+  m_record.insert(m_record.end(), data, data + size);
+  m_record.resize(Common::AlignUp(m_record.size(), 4));
+  ++m_change_count;
+}
+
+void MemoryWatcher::WriteRecord()
+{
+  m_record.resize(Common::AlignUp(m_record.size(), RECORD_ALIGNMENT));
+  const u32 size = static_cast<u32>(m_record.size());
+  if (size > SHARED_MEMORY_CAPACITY)
+  {
+    WARN_LOG_FMT(CORE, "MemoryWatcher: Dropping {} byte record which doesn't fit the ring", size);
+    return;
   }
 
-  return message_stream.str();
+  const RecordHeader record_header{size, m_change_count, m_frame};
+  std::memcpy(m_record.data(), &record_header, sizeof(record_header));
+
+  auto* const header = reinterpret_cast<SharedMemoryHeader*>(m_shm);
+  u8* const ring = m_shm + SHARED_MEMORY_HEADER_SIZE;
+
+  u64 position = header->write_position.load(std::memory_order_relaxed);
+  u32 ring_offset = static_cast<u32>(position % SHARED_MEMORY_CAPACITY);
+  const u32 padding_size =
+      SHARED_MEMORY_CAPACITY - ring_offset < size ? SHARED_MEMORY_CAPACITY - ring_offset : 0;
+
+  // Lets readers which are copying out the data that is about to be overwritten notice it. The
+  // fence keeps the writes below from becoming visible before the reservation.
+  header->reserved_position.store(position + padding_size + size, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  if (padding_size != 0)
+  {
+    const RecordHeader padding{padding_size, PADDING_RECORD, m_frame};
+    std::memcpy(ring + ring_offset, &padding, sizeof(padding));
+    position += padding.size;
+    ring_offset = 0;
+  }
+
+  std::memcpy(ring + ring_offset, m_record.data(), size);
+  header->write_position.store(position + size, std::memory_order_release);
 }
 
 void MemoryWatcher::Step(const Core::CPUThreadGuard& guard)
@@ -106,7 +408,60 @@ void MemoryWatcher::Step(const Core::CPUThreadGuard& guard)
   if (!m_running)
     return;
 
-  std::string message = ComposeMessages(guard);
-  sendto(m_fd, message.c_str(), message.size() + 1, 0, reinterpret_cast<sockaddr*>(&m_addr),
-         sizeof(m_addr));
+  m_message.clear();
+  m_record.resize(sizeof(RecordHeader));
+  m_change_count = 0;
+
+  for (const Batch& batch : m_batches)
+  {
+    if (std::none_of(batch.watches.begin(), batch.watches.end(),
+                     [this](size_t id) { return IsDue(m_watches[id]); }))
+    {
+      continue;
+    }
+
+    m_buffer.resize(batch.size);
+    const bool read = ReadRAM(guard, batch.address, batch.size, m_buffer.data());
+    for (size_t id : batch.watches)
+    {
+      const Watch& watch = m_watches[id];
+      if (!IsDue(watch))
+        continue;
+
+      if (read)
+      {
+        u32 value;
+        std::memcpy(&value, m_buffer.data() + (watch.offsets[0] - batch.address), sizeof(value));
+        UpdateValue(id, Common::swap32(value));
+      }
+      else
+      {
+        // Not RAM, so this has to go through the regular path (which may read MMIO).
+        UpdateValue(id, ChasePointer(guard, watch));
+      }
+    }
+  }
+
+  for (size_t id : m_unbatched)
+  {
+    const Watch& watch = m_watches[id];
+    if (!IsDue(watch))
+      continue;
+
+    if (watch.size == 0)
+      UpdateValue(id, ChasePointer(guard, watch));
+    else
+      UpdateRange(guard, id);
+  }
+
+  if (m_fd >= 0)
+  {
+    sendto(m_fd, m_message.c_str(), m_message.size() + 1, 0, reinterpret_cast<sockaddr*>(&m_addr),
+           sizeof(m_addr));
+  }
+
+  if (m_shm && m_change_count != 0)
+    WriteRecord();
+
+  ++m_frame;
 }
@@ -5,7 +5,7 @@
 
 #include "Common/CommonTypes.h"
 
-#include <map>
+#include <atomic>
 #include <string>
 #include <sys/socket.h>
 #include <sys/un.h>
@@ -24,28 +24,142 @@ class CPUThreadGuard;
 // "ABCD EF" will watch the address at (*0xABCD) + 0xEF.
 // The output to the socket is two lines. The first is the address from the
 // input file, and the second is the new value in hex.
+//
+// A line can end in ":<size>" (hex) to watch a whole range of memory instead of a single value.
+// "ABCD EF:40" watches the 0x40 bytes starting at (*0xABCD) + 0xEF. Only the parts of a range
+// which changed are reported; on the socket, the second line is then "<offset> <bytes>", both in
+// hex, with offset being relative to the start of the range.
+//
+// A line can also end in "@<frames>" (decimal) to only sample it every that many frames, e.g.
+// "ABCD:40@4". By default, everything is sampled every frame.
+//
+// The same changes are also written in a binary format to a ring buffer in a shared memory file
+// next to the socket (see SharedMemoryHeader), which is much cheaper to consume for large ranges.
 class MemoryWatcher final
 {
 public:
+  // The shared memory file starts with this header, followed by a ring of <capacity> bytes.
+  // Everything is in host byte order.
+  //
+  // The ring is a sequence of records, each starting with a RecordHeader and aligned to
+  // RECORD_ALIGNMENT. A record never wraps around the end of the ring; a padding record
+  // (change_count == PADDING_RECORD) fills the rest of the ring instead.
+  //
+  // Readers keep their own read position and consume records until it reaches write_position
+  // (loaded with acquire semantics). A record at position p is only valid if reserved_position is
+  // at most p + capacity once the record has been copied out: readers have to copy the record
+  // first, then issue an acquire fence, and only then load reserved_position. Otherwise the reader
+  // fell behind and the record was (possibly partially) overwritten while it was being copied.
+  struct SharedMemoryHeader
+  {
+    u32 magic;
+    u32 version;
+    u32 header_size;
+    u32 capacity;
+    // Total number of bytes ever written. The record at position p is stored at byte
+    // header_size + p % capacity of the file. Only updated once a whole record has been written.
+    std::atomic<u64> write_position;
+    // Where write_position will be once the record that is being written is done. Updated before
+    // any of the record is written, followed by a release fence.
+    std::atomic<u64> reserved_position;
+  };
+
+  // One record is written per sampled frame which had any changes.
+  struct RecordHeader
+  {
+    // Including this header and any padding.
+    u32 size;
+    u32 change_count;
+    u64 frame;
+  };
+
+  enum class ChangeType : u32
+  {
+    // A 4 byte value (in host byte order) from a line without a size.
+    Value = 0,
+    // Raw bytes (in guest byte order) from a watched range.
+    Range = 1,
+  };
+
+  // Followed by <size> bytes of data, padded to a multiple of 4 bytes.
+  struct ChangeHeader
+  {
+    // Index of the watched line in the input file, only counting lines which contain an address.
+    u32 id;
+    ChangeType type;
+    // Offset from the start of the watched range.
+    u32 offset;
+    u32 size;
+  };
+
+  static constexpr u32 SHARED_MEMORY_MAGIC = 0x52574D44;  // "DMWR"
+  static constexpr u32 SHARED_MEMORY_VERSION = 2;
+  static constexpr u32 SHARED_MEMORY_HEADER_SIZE = 64;
+  static constexpr u32 SHARED_MEMORY_CAPACITY = 1024 * 1024;
+  static constexpr u32 RECORD_ALIGNMENT = 16;
+  static constexpr u32 PADDING_RECORD = 0xFFFFFFFF;
+
   MemoryWatcher();
   ~MemoryWatcher();
   void Step(const Core::CPUThreadGuard& guard);
 
 private:
+  struct Watch
+  {
+    // The line as stored in the file.
+    std::string line;
+    // Offsets to follow. Every offset but the last is added to a pointer read from memory.
+    std::vector<u32> offsets;
+    // 0 for a single 32-bit value.
+    u32 size = 0;
+    u32 sample_interval = 1;
+    // The last value that was sent, or the last contents of the range.
+    u32 value = 0;
+    std::vector<u8> data;
+  };
+
+  // Watches of a single value at a fixed address which are close enough together to be read with
+  // one copy.
+  struct Batch
+  {
+    u32 address;
+    u32 size;
+    std::vector<size_t> watches;
+  };
+
   bool LoadAddresses(const std::string& path);
   bool OpenSocket(const std::string& path);
+  bool OpenSharedMemory(const std::string& path);
+  void CloseSharedMemory();
 
   void ParseLine(const std::string& line);
-  u32 ChasePointer(const Core::CPUThreadGuard& guard, const std::string& line);
-  std::string ComposeMessages(const Core::CPUThreadGuard& guard);
+  void BuildBatches();
+  u32 ChasePointer(const Core::CPUThreadGuard& guard, const Watch& watch) const;
+  bool ReadRAM(const Core::CPUThreadGuard& guard, u32 address, u32 size, u8* out) const;
+  bool IsDue(const Watch& watch) const;
+
+  void UpdateValue(size_t id, u32 new_value);
+  void UpdateRange(const Core::CPUThreadGuard& guard, size_t id);
+  void AddChange(size_t id, ChangeType type, u32 offset, const u8* data, u32 size);
+  void WriteRecord();
 
   bool m_running = false;
+  u64 m_frame = 0;
 
-  int m_fd;
+  int m_fd = -1;
   sockaddr_un m_addr{};
 
-  // Address as stored in the file -> list of offsets to follow
-  std::map<std::string, std::vector<u32>> m_addresses;
-  // Address as stored in the file -> current value
-  std::map<std::string, u32> m_values;
+  int m_shm_fd = -1;
+  u8* m_shm = nullptr;
+
+  std::vector<Watch> m_watches;
+  std::vector<Batch> m_batches;
+  // Watches which aren't part of any batch.
+  std::vector<size_t> m_unbatched;
+
+  // Scratch buffers, reused across steps.
+  std::string m_message;
+  std::vector<u8> m_record;
+  std::vector<u8> m_buffer;
+  u32 m_change_count = 0;
 };
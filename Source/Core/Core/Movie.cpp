@@ -61,6 +61,7 @@
 
 #include "Core/IOS/USB/Bluetooth/BTEmu.h"
 #include "Core/IOS/USB/Bluetooth/WiimoteDevice.h"
+#include "Core/MovieInputLog.h"
 #include "Core/NetPlayProto.h"
 #include "Core/State.h"
 #include "Core/System.h"
@@ -96,7 +97,7 @@ static std::array<ControllerType, 4> s_controllers{};
 static std::array<bool, 4> s_wiimotes{};
 static ControllerState s_padState;
 static DTMHeader tmpHeader;
-static std::vector<u8> s_temp_input;
+static InputLog s_temp_input;
 static u64 s_currentByte = 0;
 static u64 s_currentFrame = 0, s_totalFrames = 0;  // VI
 static u64 s_currentLagCount = 0;
@@ -126,6 +127,7 @@ static std::string s_InputDisplay[8];
 static std::string s_current_file_name;
 
 static void GetSettings();
+static DTMHeader MakeHeader();
 static bool IsMovieHeader(const std::array<u8, 4>& magic)
 {
   return magic[0] == 'D' && magic[1] == 'T' && magic[2] == 'M' && magic[3] == 0x1A;
@@ -230,6 +232,10 @@ void FrameUpdate()
   {
     s_totalFrames = s_currentFrame;
     s_totalLagCount = s_currentLagCount;
+
+    s_temp_input.MarkFrame(s_currentFrame, s_currentByte);
+    if (s_temp_input.IsStreaming() && s_currentFrame % InputLog::CHECKPOINT_INTERVAL == 0)
+      s_temp_input.Checkpoint(MakeHeader());
   }
 
   s_bPolled = false;
@@ -583,8 +589,9 @@ bool BeginRecordingInput(const ControllerTypeArray& controllers,
       if (File::Exists(save_path))
         File::Delete(save_path);
 
-      State::SaveAs(save_path);
+      // Set first, so that the NAND contents are embedded into the savestate
       s_bRecordingFromSaveState = true;
+      State::SaveAs(save_path);
 
       std::thread md5thread(GetMD5);
       md5thread.detach();
@@ -600,10 +607,15 @@ bool BeginRecordingInput(const ControllerTypeArray& controllers,
 
     s_playMode = PlayMode::Recording;
     s_author = Config::Get(Config::MAIN_MOVIE_MOVIE_AUTHOR);
-    s_temp_input.clear();
+    s_temp_input.Clear();
 
     s_currentByte = 0;
 
+    const std::string stream_path = Config::Get(Config::MAIN_MOVIE_STREAM_RECORDING_PATH);
+    if (!stream_path.empty() && !s_temp_input.CreateStream(stream_path, MakeHeader()))
+      PanicAlertFmtT("Failed to create {0}. The movie will only be kept in memory.", stream_path);
+    s_temp_input.MarkFrame(0, 0);
+
     // This is a bit of a hack, SYSCONF movie code expects the movie layer active for both recording
     // and playback. That layer is really only designed for playback, not recording. Also, we can't
     // know if we're using a Wii at this point. So, we'll assume a Wii is used here. In practice,
@@ -890,8 +902,8 @@ void RecordInput(const GCPadStatus* PadStatus, int controllerID)
 
   CheckPadStatus(PadStatus, controllerID);
 
-  s_temp_input.resize(s_currentByte + sizeof(ControllerState));
-  memcpy(&s_temp_input[s_currentByte], &s_padState, sizeof(ControllerState));
+  s_temp_input.Resize(s_currentByte);
+  s_temp_input.Write(s_currentByte, &s_padState, sizeof(ControllerState));
   s_currentByte += sizeof(ControllerState);
 }
 
@@ -911,9 +923,9 @@ void RecordWiimote(int wiimote, const u8* data, u8 size)
     return;
 
   InputUpdate();
-  s_temp_input.resize(s_currentByte + size + 1);
-  s_temp_input[s_currentByte++] = size;
-  memcpy(&s_temp_input[s_currentByte], data, size);
+  s_temp_input.Resize(s_currentByte);
+  s_temp_input.Write(s_currentByte++, &size, 1);
+  s_temp_input.Write(s_currentByte, data, size);
   s_currentByte += size;
 }
 
@@ -972,6 +984,16 @@ bool PlayInput(const std::string& movie_path, std::optional<std::string>* savest
     return false;
   }
 
+  recording_file.Close();
+
+  // The input is read from the file as it's played back rather than all at once
+  if (!s_temp_input.OpenForPlayback(movie_path))
+  {
+    PanicAlertFmtT("Failed to read {0}", movie_path);
+    return false;
+  }
+  s_currentByte = 0;
+
   ReadHeader();
   s_totalFrames = tmpHeader.frameCount;
   s_totalLagCount = tmpHeader.lagCount;
@@ -988,11 +1010,6 @@ bool PlayInput(const std::string& movie_path, std::optional<std::string>* savest
 
   Core::UpdateWantDeterminism();
 
-  s_temp_input.resize(recording_file.GetSize() - 256);
-  recording_file.ReadBytes(s_temp_input.data(), s_temp_input.size());
-  s_currentByte = 0;
-  recording_file.Close();
-
   // Load savestate (and skip to frame data)
   if (tmpHeader.bFromSaveState && savestate_path)
   {
@@ -1080,8 +1097,8 @@ void LoadInput(const std::string& movie_path)
     s_totalInputCount = tmpHeader.inputCount;
     s_totalTickCount = s_tickCountAtLastInput = tmpHeader.tickCount;
 
-    s_temp_input.resize(static_cast<size_t>(totalSavedBytes));
-    t_record.ReadBytes(s_temp_input.data(), s_temp_input.size());
+    s_temp_input.ReadFrom(t_record, totalSavedBytes);
+    s_temp_input.ReadFrameIndex(movie_path);
   }
   else if (s_currentByte > 0)
   {
@@ -1103,7 +1120,7 @@ void LoadInput(const std::string& movie_path)
       std::vector<u8> movInput(s_currentByte);
       t_record.ReadArray(movInput.data(), movInput.size());
 
-      const auto result = std::mismatch(movInput.begin(), movInput.end(), s_temp_input.begin());
+      const auto result = std::mismatch(movInput.begin(), movInput.end(), s_temp_input.data());
 
       if (result.first != movInput.end())
       {
@@ -1122,13 +1139,13 @@ void LoadInput(const std::string& movie_path)
                          "read-only mode off. Otherwise you'll probably get a desync.",
                          byte_offset, byte_offset);
 
-          std::copy(movInput.begin(), movInput.end(), s_temp_input.begin());
+          s_temp_input.Write(0, movInput.data(), movInput.size());
         }
         else
         {
           const ptrdiff_t frame = mismatch_index / sizeof(ControllerState);
           ControllerState curPadState;
-          memcpy(&curPadState, &s_temp_input[frame * sizeof(ControllerState)],
+          memcpy(&curPadState, s_temp_input.data() + frame * sizeof(ControllerState),
                  sizeof(ControllerState));
           ControllerState movPadState;
           memcpy(&movPadState, &movInput[frame * sizeof(ControllerState)], sizeof(ControllerState));
@@ -1193,6 +1210,21 @@ void LoadInput(const std::string& movie_path)
   }
 }
 
+// NOTE: CPU Thread
+bool SeekToFrame(u64 frame)
+{
+  if (!IsPlayingInput())
+    return false;
+
+  const std::optional<u64> offset = s_temp_input.GetFrameOffset(frame);
+  if (!offset)
+    return false;
+
+  s_currentFrame = frame;
+  s_currentByte = *offset;
+  return true;
+}
+
 // NOTE: CPU Thread
 static void CheckInputEnd()
 {
@@ -1220,7 +1252,7 @@ void PlayController(GCPadStatus* PadStatus, int controllerID)
     return;
   }
 
-  memcpy(&s_padState, &s_temp_input[s_currentByte], sizeof(ControllerState));
+  memcpy(&s_padState, s_temp_input.data() + s_currentByte, sizeof(ControllerState));
   s_currentByte += sizeof(ControllerState);
 
   PadStatus->isConnected = s_padState.is_connected;
@@ -1311,7 +1343,7 @@ bool PlayWiimote(int wiimote, WiimoteCommon::DataReportBuilder& rpt, int ext,
   }
 
   const u8 size = rpt.GetDataSize();
-  const u8 sizeInMovie = s_temp_input[s_currentByte];
+  const u8 sizeInMovie = s_temp_input.data()[s_currentByte];
 
   if (size != sizeInMovie)
   {
@@ -1336,7 +1368,7 @@ bool PlayWiimote(int wiimote, WiimoteCommon::DataReportBuilder& rpt, int ext,
     return false;
   }
 
-  memcpy(rpt.GetDataPtr(), &s_temp_input[s_currentByte], size);
+  memcpy(rpt.GetDataPtr(), s_temp_input.data() + s_currentByte, size);
   s_currentByte += size;
 
   s_currentInputCount++;
@@ -1369,6 +1401,8 @@ void EndPlayInput(bool cont)
     s_playMode = PlayMode::None;
     Core::DisplayMessage("Movie End.", 2000);
     s_bRecordingFromSaveState = false;
+    if (s_temp_input.IsStreaming())
+      s_temp_input.Checkpoint(MakeHeader());
     Config::RemoveLayer(Config::LayerType::Movie);
     // we don't clear these things because otherwise we can't resume playback if we load a movie
     // state later
@@ -1380,11 +1414,8 @@ void EndPlayInput(bool cont)
   }
 }
 
-// NOTE: Save State + Host Thread
-void SaveRecording(const std::string& filename)
+static DTMHeader MakeHeader()
 {
-  File::IOFile save_record(filename, "wb");
-  // Create the real header now and write it
   DTMHeader header;
   memset(&header, 0, sizeof(DTMHeader));
 
@@ -1431,9 +1462,14 @@ void SaveRecording(const std::string& filename)
   header.uniqueID = 0;
   // header.audioEmulator;
 
-  save_record.WriteArray(&header, 1);
+  return header;
+}
 
-  bool success = save_record.WriteBytes(s_temp_input.data(), s_temp_input.size());
+// NOTE: Save State + Host Thread
+void SaveRecording(const std::string& filename)
+{
+  // Create the real header now and write it
+  bool success = s_temp_input.SaveAs(filename, MakeHeader());
 
   if (success && s_bRecordingFromSaveState)
   {
@@ -1575,7 +1611,10 @@ static void GetMD5()
 // NOTE: EmuThread
 void Shutdown()
 {
+  // A streamed recording is complete once its header is up to date
+  if (s_temp_input.IsStreaming())
+    s_temp_input.Checkpoint(MakeHeader());
   s_currentInputCount = s_totalInputCount = s_totalFrames = s_tickCountAtLastInput = 0;
-  s_temp_input.clear();
+  s_temp_input.Clear();
 }
 }  // namespace Movie
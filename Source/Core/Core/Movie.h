@@ -183,6 +183,11 @@ void RecordWiimote(int wiimote, const u8* data, u8 size);
 
 bool PlayInput(const std::string& movie_path, std::optional<std::string>* savestate_path);
 void LoadInput(const std::string& movie_path);
+// Moves playback to the start of the given frame through the frame index of the movie, without
+// parsing the input before it. Only the position in the movie changes, so the emulated state has
+// to be restored separately, e.g. by loading a savestate which was made at that frame. Returns
+// false if the movie isn't played back or the frame isn't in its index.
+bool SeekToFrame(u64 frame);
 void ReadHeader();
 void PlayController(GCPadStatus* PadStatus, int controllerID);
 bool PlayWiimote(int wiimote, WiimoteCommon::DataReportBuilder& rpt, int ext,
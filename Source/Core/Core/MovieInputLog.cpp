@@ -0,0 +1,463 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/MovieInputLog.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <system_error>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+#include "Core/Movie.h"
+
+namespace Movie
+{
+namespace
+{
+#pragma pack(push, 1)
+struct FrameIndexHeader
+{
+  std::array<u8, 4> magic;
+  u32 version;
+};
+#pragma pack(pop)
+
+constexpr FrameIndexHeader FRAME_INDEX_HEADER{{'D', 'T', 'I', 0x1A}, 1};
+
+// Stands in for the frames which weren't marked, e.g. the ones before the frame at which recording
+// resumed after loading a savestate whose movie has no index
+constexpr u64 UNKNOWN_FRAME_OFFSET = std::numeric_limits<u64>::max();
+
+std::string GetFrameIndexPath(const std::string& movie_path)
+{
+  return movie_path + ".idx";
+}
+
+// Used when a streamed recording is replaced with the input of another movie
+constexpr u64 COPY_CHUNK_SIZE = 1024 * 1024;
+}  // namespace
+
+InputLog::FileMapping::~FileMapping()
+{
+  Unmap();
+}
+
+bool InputLog::FileMapping::Map(const std::string& path)
+{
+  Unmap();
+
+#ifdef _WIN32
+  const HANDLE file = CreateFileW(UTF8ToWString(path).c_str(), GENERIC_READ,
+                                  FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+  {
+    CloseHandle(file);
+    return false;
+  }
+
+  const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (!mapping)
+    return false;
+
+  // The view keeps the mapping alive
+  void* const view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (!view)
+    return false;
+
+  m_size = static_cast<u64>(size.QuadPart);
+#else
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat file_info;
+  if (fstat(fd, &file_info) != 0 || file_info.st_size == 0)
+  {
+    close(fd);
+    return false;
+  }
+
+  void* const view = mmap(nullptr, file_info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (view == MAP_FAILED)
+    return false;
+
+  m_size = static_cast<u64>(file_info.st_size);
+#endif
+
+  m_data = static_cast<const u8*>(view);
+  m_mapped = true;
+  return true;
+}
+
+void InputLog::FileMapping::Unmap()
+{
+  if (!m_mapped)
+    return;
+
+#ifdef _WIN32
+  UnmapViewOfFile(m_data);
+#else
+  munmap(const_cast<u8*>(m_data), m_size);
+#endif
+
+  m_data = nullptr;
+  m_size = 0;
+  m_mapped = false;
+}
+
+InputLog::InputLog() = default;
+
+InputLog::~InputLog() = default;
+
+void InputLog::Clear()
+{
+  std::lock_guard lk(m_mutex);
+
+  m_mapping.Unmap();
+  m_stream.Close();
+  m_frame_index_file.Close();
+
+  m_mode = Mode::Memory;
+  m_size = 0;
+  m_memory.clear();
+  m_path.clear();
+  m_stream_position.reset();
+  m_frame_index.clear();
+  m_frame_index_written = 0;
+}
+
+bool InputLog::OpenForPlayback(const std::string& path)
+{
+  std::lock_guard lk(m_mutex);
+
+  Clear();
+
+  if (!m_mapping.Map(path) || m_mapping.GetSize() < sizeof(DTMHeader))
+  {
+    m_mapping.Unmap();
+    return false;
+  }
+
+  m_mode = Mode::Mapped;
+  m_size = m_mapping.GetSize() - sizeof(DTMHeader);
+  ReadFrameIndex(path);
+  return true;
+}
+
+bool InputLog::CreateStream(const std::string& path, const DTMHeader& header)
+{
+  std::lock_guard lk(m_mutex);
+
+  Clear();
+
+  if (!m_stream.Open(path, "wb") || !m_stream.WriteArray(&header, 1))
+  {
+    ERROR_LOG_FMT(CORE, "Failed to create movie {}", path);
+    m_stream.Close();
+    return false;
+  }
+
+  if (!m_frame_index_file.Open(GetFrameIndexPath(path), "wb") ||
+      !m_frame_index_file.WriteArray(&FRAME_INDEX_HEADER, 1))
+  {
+    WARN_LOG_FMT(CORE, "Failed to create the frame index of movie {}", path);
+    m_frame_index_file.Close();
+  }
+
+  m_mode = Mode::Stream;
+  m_path = path;
+  m_stream_position = 0;
+  return true;
+}
+
+bool InputLog::ReadFrom(File::IOFile& file, u64 size)
+{
+  std::lock_guard lk(m_mutex);
+
+  m_frame_index.clear();
+  m_frame_index_written = 0;
+
+  if (m_mode != Mode::Stream)
+  {
+    m_mapping.Unmap();
+    m_mode = Mode::Memory;
+    m_memory.resize(size);
+    m_size = size;
+    return file.ReadBytes(m_memory.data(), m_memory.size());
+  }
+
+  Resize(0);
+
+  std::vector<u8> buffer(std::min(size, COPY_CHUNK_SIZE));
+  for (u64 offset = 0; offset < size; offset += buffer.size())
+  {
+    const size_t chunk_size = std::min<u64>(size - offset, buffer.size());
+    if (!file.ReadBytes(buffer.data(), chunk_size))
+      return false;
+    Write(offset, buffer.data(), chunk_size);
+  }
+
+  return true;
+}
+
+void InputLog::ReadFrameIndex(const std::string& movie_path)
+{
+  std::lock_guard lk(m_mutex);
+
+  m_frame_index.clear();
+  m_frame_index_written = 0;
+
+  File::IOFile file(GetFrameIndexPath(movie_path), "rb");
+  FrameIndexHeader header;
+  if (!file.ReadArray(&header, 1) || header.magic != FRAME_INDEX_HEADER.magic ||
+      header.version != FRAME_INDEX_HEADER.version)
+  {
+    return;
+  }
+
+  std::vector<u64> frame_index((file.GetSize() - sizeof(FrameIndexHeader)) / sizeof(u64));
+  if (!file.ReadArray(frame_index.data(), frame_index.size()))
+    return;
+
+  // An index which was left behind by another movie of the same name can't be trusted. The index
+  // of a streamed recording can only be behind its input, though.
+  u64 previous_offset = 0;
+  for (const u64 offset : frame_index)
+  {
+    if (offset == UNKNOWN_FRAME_OFFSET)
+      continue;
+    if (offset < previous_offset || offset > m_size)
+    {
+      WARN_LOG_FMT(CORE, "Ignoring the frame index of movie {} as it doesn't fit its input",
+                   movie_path);
+      return;
+    }
+    previous_offset = offset;
+  }
+
+  m_frame_index = std::move(frame_index);
+}
+
+bool InputLog::SaveAs(const std::string& path, const DTMHeader& header)
+{
+  std::lock_guard lk(m_mutex);
+
+  std::error_code error;
+  if (m_mode == Mode::Stream &&
+      std::filesystem::equivalent(StringToPath(path), StringToPath(m_path), error))
+  {
+    // The input is already in the file, which must not be truncated while it's being streamed to
+    Checkpoint(header);
+    return true;
+  }
+
+  const u8* const input = data();
+  if (!input && m_size != 0)
+    return false;
+
+  // Truncating a file which is mapped would make reading the mapping fault, so the movie is
+  // written next to it and then moved over it.
+  const std::string temp_path = File::GetTempFilenameForAtomicWrite(path);
+  {
+    File::IOFile file(temp_path, "wb");
+    if (!file.WriteArray(&header, 1) || !file.WriteBytes(input, m_size))
+    {
+      file.Close();
+      File::Delete(temp_path);
+      return false;
+    }
+  }
+
+  if (!File::Rename(temp_path, path))
+    return false;
+
+  SaveFrameIndex(path);
+  return true;
+}
+
+const u8* InputLog::data()
+{
+  std::lock_guard lk(m_mutex);
+
+  switch (m_mode)
+  {
+  case Mode::Memory:
+    return m_memory.data();
+  case Mode::Stream:
+    if (!m_mapping.IsMapped())
+    {
+      m_stream.Flush();
+      if (!m_mapping.Map(m_path))
+      {
+        ERROR_LOG_FMT(CORE, "Failed to map movie {}", m_path);
+        return nullptr;
+      }
+    }
+    return m_mapping.GetData() + sizeof(DTMHeader);
+  case Mode::Mapped:
+    return m_mapping.GetData() + sizeof(DTMHeader);
+  }
+
+  return nullptr;
+}
+
+void InputLog::Resize(u64 size)
+{
+  std::lock_guard lk(m_mutex);
+
+  if (m_mode == Mode::Mapped)
+    CopyToMemory();
+
+  if (m_mode == Mode::Memory)
+  {
+    m_memory.resize(size);
+  }
+  else if (size != m_size)
+  {
+    // A file which is mapped can't be truncated on Windows
+    m_mapping.Unmap();
+    m_stream.Flush();
+    m_stream.Resize(sizeof(DTMHeader) + size);
+    m_stream_position.reset();
+  }
+
+  m_size = size;
+}
+
+void InputLog::Write(u64 offset, const void* data, size_t size)
+{
+  std::lock_guard lk(m_mutex);
+
+  if (m_mode == Mode::Mapped)
+    CopyToMemory();
+
+  if (m_mode == Mode::Memory)
+  {
+    if (offset + size > m_memory.size())
+      m_memory.resize(offset + size);
+    std::memcpy(m_memory.data() + offset, data, size);
+  }
+  else
+  {
+    m_mapping.Unmap();
+
+    // Seeking flushes the write buffer, so only do it when input isn't simply appended
+    if (m_stream_position != offset)
+      m_stream.Seek(sizeof(DTMHeader) + offset, File::SeekOrigin::Begin);
+    m_stream.WriteBytes(data, size);
+    m_stream_position = offset + size;
+  }
+
+  m_size = std::max<u64>(m_size, offset + size);
+}
+
+void InputLog::MarkFrame(u64 frame, u64 offset)
+{
+  std::lock_guard lk(m_mutex);
+
+  // After loading an earlier savestate, the frames which follow it are recorded again
+  m_frame_index.resize(frame, UNKNOWN_FRAME_OFFSET);
+  m_frame_index.push_back(offset);
+  m_frame_index_written = std::min<size_t>(m_frame_index_written, frame);
+}
+
+void InputLog::Checkpoint(const DTMHeader& header)
+{
+  std::lock_guard lk(m_mutex);
+
+  if (m_mode != Mode::Stream)
+    return;
+
+  m_stream.Seek(0, File::SeekOrigin::Begin);
+  m_stream.WriteArray(&header, 1);
+  m_stream.Flush();
+  m_stream_position.reset();
+
+  WriteFrameIndex();
+}
+
+std::optional<u64> InputLog::GetFrameOffset(u64 frame)
+{
+  std::lock_guard lk(m_mutex);
+
+  // The index of a recording can be ahead of its input after the input was cut short
+  if (frame >= m_frame_index.size() || m_frame_index[frame] > m_size)
+    return std::nullopt;
+
+  return m_frame_index[frame];
+}
+
+void InputLog::CopyToMemory()
+{
+  const u8* const input = m_mapping.GetData() + sizeof(DTMHeader);
+  m_memory.assign(input, input + m_size);
+  m_mapping.Unmap();
+  m_mode = Mode::Memory;
+}
+
+void InputLog::WriteFrameIndex()
+{
+  if (!m_frame_index_file.IsOpen())
+    return;
+
+  // Drop the entries of frames which were recorded again since the last checkpoint
+  const u64 written_size = sizeof(FrameIndexHeader) + m_frame_index_written * sizeof(u64);
+  m_frame_index_file.Flush();
+  m_frame_index_file.Resize(written_size);
+  m_frame_index_file.Seek(written_size, File::SeekOrigin::Begin);
+
+  m_frame_index_file.WriteArray(m_frame_index.data() + m_frame_index_written,
+                                m_frame_index.size() - m_frame_index_written);
+  m_frame_index_file.Flush();
+  m_frame_index_written = m_frame_index.size();
+}
+
+void InputLog::SaveFrameIndex(const std::string& movie_path) const
+{
+  const std::string index_path = GetFrameIndexPath(movie_path);
+  if (m_frame_index.empty())
+  {
+    // Don't leave the index of a previous movie next to this one
+    File::Delete(index_path, File::IfAbsentBehavior::NoConsoleWarning);
+    return;
+  }
+
+  const std::string temp_path = File::GetTempFilenameForAtomicWrite(index_path);
+  {
+    File::IOFile file(temp_path, "wb");
+    if (!file.WriteArray(&FRAME_INDEX_HEADER, 1) ||
+        !file.WriteArray(m_frame_index.data(), m_frame_index.size()))
+    {
+      WARN_LOG_FMT(CORE, "Failed to write the frame index of movie {}", movie_path);
+      file.Close();
+      File::Delete(temp_path);
+      File::Delete(index_path, File::IfAbsentBehavior::NoConsoleWarning);
+      return;
+    }
+  }
+
+  File::Rename(temp_path, index_path);
+}
+}  // namespace Movie
@@ -0,0 +1,129 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+
+namespace Movie
+{
+struct DTMHeader;
+
+// The input data of a movie, which follows its DTMHeader.
+//
+// By default it's kept in memory. A movie which is played back is memory mapped instead of being
+// read in full, and is only copied into memory once something writes to it (e.g. when recording
+// resumes at its end). A recording can also be streamed to a file, which input is appended to as
+// it's recorded. Its header is rewritten every CHECKPOINT_INTERVAL frames, so the file is always a
+// playable movie which lags behind the recording by at most that much.
+//
+// The offset at which the input of each VI frame starts is kept in a frame index, so that seeking
+// to a frame doesn't need to parse all of the input before it. It's saved next to the movie (its
+// path with ".idx" appended) along with the header, and read along with movies which are played
+// back. The index is optional, a movie without one just can't be seeked.
+//
+// Input is recorded and played back on the CPU thread, while savestates save the movie on their
+// worker thread through SaveAs. The mapping is only replaced or unmapped under m_mutex by the
+// thread which changes the input, so SaveAs never sees it go away, and a pointer returned by data()
+// stays valid on the thread which changes the input until it does so.
+class InputLog
+{
+public:
+  static constexpr u64 CHECKPOINT_INTERVAL = 600;
+
+  InputLog();
+  ~InputLog();
+
+  InputLog(const InputLog&) = delete;
+  InputLog& operator=(const InputLog&) = delete;
+
+  // Discards all input and closes any file
+  void Clear();
+  // Maps the input of an existing movie. The file is never written to.
+  bool OpenForPlayback(const std::string& path);
+  // Creates a movie which the input is streamed to from now on
+  bool CreateStream(const std::string& path, const DTMHeader& header);
+  // Replaces the input with the given number of bytes from the file's current position. The frame
+  // index is cleared, see ReadFrameIndex.
+  bool ReadFrom(File::IOFile& file, u64 size);
+  // Replaces the frame index with the one saved next to the given movie, if it fits the input
+  void ReadFrameIndex(const std::string& movie_path);
+  // Writes a movie with the given header and all of the input. The file is replaced rather than
+  // written in place, as it may be the one which is mapped. If the recording is streamed to it
+  // already, only its header is updated.
+  bool SaveAs(const std::string& path, const DTMHeader& header);
+
+  bool IsStreaming() const { return m_mode == Mode::Stream; }
+
+  u64 size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+  // The returned pointer is only valid until the input is changed
+  const u8* data();
+
+  void Resize(u64 size);
+  void Write(u64 offset, const void* data, size_t size);
+
+  // Called when the given frame starts at the given offset while recording
+  void MarkFrame(u64 frame, u64 offset);
+  // Writes the header and the frame index of a streamed recording
+  void Checkpoint(const DTMHeader& header);
+
+  std::optional<u64> GetFrameOffset(u64 frame);
+
+private:
+  enum class Mode
+  {
+    Memory,
+    Mapped,
+    Stream,
+  };
+
+  class FileMapping
+  {
+  public:
+    ~FileMapping();
+
+    bool Map(const std::string& path);
+    void Unmap();
+
+    bool IsMapped() const { return m_mapped; }
+    const u8* GetData() const { return m_data; }
+    u64 GetSize() const { return m_size; }
+
+  private:
+    const u8* m_data = nullptr;
+    u64 m_size = 0;
+    bool m_mapped = false;
+  };
+
+  void CopyToMemory();
+  void WriteFrameIndex();
+  void SaveFrameIndex(const std::string& movie_path) const;
+
+  // Held while the input or the files are accessed. Recursive, as some of the public functions are
+  // implemented with the others.
+  std::recursive_mutex m_mutex;
+
+  Mode m_mode = Mode::Memory;
+  u64 m_size = 0;
+
+  std::vector<u8> m_memory;
+  FileMapping m_mapping;
+
+  std::string m_path;
+  File::IOFile m_stream;
+  // Where the next write to m_stream goes without seeking first, relative to the end of the header
+  std::optional<u64> m_stream_position;
+
+  std::vector<u64> m_frame_index;
+  File::IOFile m_frame_index_file;
+  // How many entries of m_frame_index are in m_frame_index_file already
+  size_t m_frame_index_written = 0;
+};
+}  // namespace Movie
@@ -10,6 +10,7 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <span>
 #include <thread>
 #include <tuple>
@@ -67,7 +68,7 @@
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/SyncIdentifier.h"
 #include "Core/System.h"
-#include "DiscIO/Blob.h"
+#include "DiscIO/GameDigest.h"
 
 #include "InputCommon/ControllerEmu/ControlGroup/Attachments.h"
 #include "InputCommon/GCAdapter.h"
@@ -1015,10 +1016,6 @@ void NetPlayClient::OnSyncSaveData(sf::Packet& packet)
     OnSyncSaveDataNotify(packet);
     break;
 
-  case SyncSaveDataID::RawData:
-    OnSyncSaveDataRaw(packet);
-    break;
-
   case SyncSaveDataID::GCIData:
     OnSyncSaveDataGCI(packet);
     break;
@@ -1027,8 +1024,12 @@ void NetPlayClient::OnSyncSaveData(sf::Packet& packet)
     OnSyncSaveDataWii(packet);
     break;
 
-  case SyncSaveDataID::GBAData:
-    OnSyncSaveDataGBA(packet);
+  case SyncSaveDataID::BlockHashRequest:
+    OnSyncSaveDataBlockHashRequest(packet);
+    break;
+
+  case SyncSaveDataID::BlockData:
+    OnSyncSaveDataBlockData(packet);
     break;
 
   default:
@@ -1041,6 +1042,7 @@ void NetPlayClient::OnSyncSaveDataNotify(sf::Packet& packet)
 {
   packet >> m_sync_save_data_count;
   m_sync_save_data_success_count = 0;
+  m_sync_save_delta_paths.clear();
 
   INFO_LOG_FMT(NETPLAY, "Initializing wait for {} savegame chunks.", m_sync_save_data_count);
 
@@ -1050,44 +1052,6 @@ void NetPlayClient::OnSyncSaveDataNotify(sf::Packet& packet)
     m_dialog->AppendChat(Common::GetStringT("Synchronizing save data..."));
 }
 
-void NetPlayClient::OnSyncSaveDataRaw(sf::Packet& packet)
-{
-  bool is_slot_a;
-  std::string region;
-  int size_override;
-  packet >> is_slot_a >> region >> size_override;
-
-  INFO_LOG_FMT(NETPLAY, "Received raw memcard data for slot {}: region {}, size override {}.",
-               is_slot_a ? 'A' : 'B', region, size_override);
-
-  // This check is mainly intended to filter out characters which have special meanings in paths
-  if (region != JAP_DIR && region != USA_DIR && region != EUR_DIR)
-  {
-    WARN_LOG_FMT(NETPLAY, "Received invalid raw memory card region.");
-    SyncSaveDataResponse(false);
-    return;
-  }
-
-  std::string size_suffix;
-  if (size_override >= 0 && size_override <= 4)
-  {
-    size_suffix = fmt::format(
-        ".{}", Memcard::MbitToFreeBlocks(Memcard::MBIT_SIZE_MEMORY_CARD_59 << size_override));
-  }
-
-  const std::string path = File::GetUserPath(D_GCUSER_IDX) + GC_MEMCARD_NETPLAY +
-                           (is_slot_a ? "A." : "B.") + region + size_suffix + ".raw";
-  if (File::Exists(path) && !File::Delete(path))
-  {
-    PanicAlertFmtT("Failed to delete NetPlay memory card. Verify your write permissions.");
-    SyncSaveDataResponse(false);
-    return;
-  }
-
-  const bool success = DecompressPacketIntoFile(packet, path);
-  SyncSaveDataResponse(success);
-}
-
 void NetPlayClient::OnSyncSaveDataGCI(sf::Packet& packet)
 {
   bool is_slot_a;
@@ -1278,24 +1242,96 @@ void NetPlayClient::OnSyncSaveDataWii(sf::Packet& packet)
   SyncSaveDataResponse(true);
 }
 
-void NetPlayClient::OnSyncSaveDataGBA(sf::Packet& packet)
+void NetPlayClient::OnSyncSaveDataBlockHashRequest(sf::Packet& packet)
 {
-  u8 slot;
-  packet >> slot;
+  u8 file_id;
+  DeltaSaveType type;
+  packet >> file_id >> type;
 
-  INFO_LOG_FMT(NETPLAY, "Received GBA save for slot {}.", slot);
+  std::string path;
+  switch (type)
+  {
+  case DeltaSaveType::RawMemcard:
+  {
+    bool is_slot_a;
+    std::string region;
+    int size_override;
+    packet >> is_slot_a >> region >> size_override;
+
+    INFO_LOG_FMT(NETPLAY, "Received raw memcard request for slot {}: region {}, size override {}.",
+                 is_slot_a ? 'A' : 'B', region, size_override);
+
+    // This check is mainly intended to filter out characters which have special meanings in paths
+    if (region != JAP_DIR && region != USA_DIR && region != EUR_DIR)
+    {
+      WARN_LOG_FMT(NETPLAY, "Received invalid raw memory card region.");
+      SyncSaveDataResponse(false);
+      return;
+    }
+
+    std::string size_suffix;
+    if (size_override >= 0 && size_override <= 4)
+    {
+      size_suffix = fmt::format(
+          ".{}", Memcard::MbitToFreeBlocks(Memcard::MBIT_SIZE_MEMORY_CARD_59 << size_override));
+    }
+
+    path = File::GetUserPath(D_GCUSER_IDX) + GC_MEMCARD_NETPLAY + (is_slot_a ? "A." : "B.") +
+           region + size_suffix + ".raw";
+    break;
+  }
 
-  const std::string path =
-      fmt::format("{}{}{}.sav", File::GetUserPath(D_GBAUSER_IDX), GBA_SAVE_NETPLAY, slot + 1);
-  if (File::Exists(path) && !File::Delete(path))
+  case DeltaSaveType::GBA:
   {
-    PanicAlertFmtT("Failed to delete NetPlay GBA{0} save file. Verify your write permissions.",
-                   slot + 1);
+    u8 slot;
+    packet >> slot;
+
+    INFO_LOG_FMT(NETPLAY, "Received GBA save request for slot {}.", slot);
+
+    path = fmt::format("{}{}{}.sav", File::GetUserPath(D_GBAUSER_IDX), GBA_SAVE_NETPLAY, slot + 1);
+    break;
+  }
+
+  default:
+    WARN_LOG_FMT(NETPLAY, "Received block hash request for unknown save type {}.",
+                 static_cast<u8>(type));
     SyncSaveDataResponse(false);
     return;
   }
 
-  const bool success = DecompressPacketIntoFile(packet, path);
+  // Our copy of the save from the last session is usually identical or close to the server's, so
+  // only the blocks which differ from it have to be sent
+  sf::Packet response_packet;
+  response_packet << MessageID::SyncSaveData;
+  response_packet << SyncSaveDataID::BlockHashes;
+  response_packet << file_id;
+  if (!HashFileBlocksIntoPacket(path, response_packet))
+  {
+    SyncSaveDataResponse(false);
+    return;
+  }
+
+  m_sync_save_delta_paths.insert_or_assign(file_id, std::move(path));
+  Send(response_packet);
+}
+
+void NetPlayClient::OnSyncSaveDataBlockData(sf::Packet& packet)
+{
+  u8 file_id;
+  packet >> file_id;
+
+  const auto it = m_sync_save_delta_paths.find(file_id);
+  if (it == m_sync_save_delta_paths.end())
+  {
+    WARN_LOG_FMT(NETPLAY, "Received save blocks for unknown file {}.", file_id);
+    SyncSaveDataResponse(false);
+    return;
+  }
+
+  INFO_LOG_FMT(NETPLAY, "Received save blocks for {}.", it->second);
+
+  const bool success = DecompressPacketIntoFileDelta(packet, it->second);
+  m_sync_save_delta_paths.erase(it);
   SyncSaveDataResponse(success);
 }
 
@@ -2540,35 +2576,6 @@ bool NetPlayClient::DoAllPlayersHaveGame()
   });
 }
 
-static std::string SHA1Sum(const std::string& file_path, std::function<bool(int)> report_progress)
-{
-  std::vector<u8> data(8 * 1024 * 1024);
-  u64 read_offset = 0;
-
-  std::unique_ptr<DiscIO::BlobReader> file(DiscIO::CreateBlobReader(file_path));
-  u64 game_size = file->GetDataSize();
-
-  auto ctx = Common::SHA1::CreateContext();
-
-  while (read_offset < game_size)
-  {
-    size_t read_size = std::min(static_cast<u64>(data.size()), game_size - read_offset);
-    if (!file->Read(read_offset, read_size, data.data()))
-      return "";
-
-    ctx->Update(data.data(), read_size);
-    read_offset += read_size;
-
-    int progress =
-        static_cast<int>(static_cast<float>(read_offset) / static_cast<float>(game_size) * 100);
-    if (!report_progress(progress))
-      return "";
-  }
-
-  // Convert to hex
-  return fmt::format("{:02x}", fmt::join(ctx->Finish(), ""));
-}
-
 void NetPlayClient::ComputeGameDigest(const SyncIdentifier& sync_identifier)
 {
   if (m_should_compute_game_digest)
@@ -2595,14 +2602,16 @@ void NetPlayClient::ComputeGameDigest(const SyncIdentifier& sync_identifier)
   if (m_game_digest_thread.joinable())
     m_game_digest_thread.join();
   m_game_digest_thread = std::thread([this, file]() {
-    std::string sum = SHA1Sum(file, [&](int progress) {
-      sf::Packet packet;
-      packet << MessageID::GameDigestProgress;
-      packet << progress;
-      SendAsync(std::move(packet));
-
-      return m_should_compute_game_digest;
-    });
+    const std::optional<Common::SHA1::Digest> digest =
+        DiscIO::ComputeGameDigest(file, [&](int progress) {
+          sf::Packet packet;
+          packet << MessageID::GameDigestProgress;
+          packet << progress;
+          SendAsync(std::move(packet));
+
+          return m_should_compute_game_digest;
+        });
+    const std::string sum = digest ? fmt::format("{:02x}", fmt::join(*digest, "")) : "";
 
     sf::Packet packet;
     packet << MessageID::GameDigestResult;
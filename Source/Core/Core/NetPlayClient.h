@@ -300,10 +300,10 @@ private:
   void OnDesyncDetected(sf::Packet& packet);
   void OnSyncSaveData(sf::Packet& packet);
   void OnSyncSaveDataNotify(sf::Packet& packet);
-  void OnSyncSaveDataRaw(sf::Packet& packet);
   void OnSyncSaveDataGCI(sf::Packet& packet);
   void OnSyncSaveDataWii(sf::Packet& packet);
-  void OnSyncSaveDataGBA(sf::Packet& packet);
+  void OnSyncSaveDataBlockHashRequest(sf::Packet& packet);
+  void OnSyncSaveDataBlockData(sf::Packet& packet);
   void OnSyncCodes(sf::Packet& packet);
   void OnSyncCodesNotify();
   void OnSyncCodesNotifyGecko(sf::Packet& packet);
@@ -334,6 +334,8 @@ private:
   Common::Event m_wait_on_input_event;
   u8 m_sync_save_data_count = 0;
   u8 m_sync_save_data_success_count = 0;
+  // Local paths of the save files whose block hashes were sent, by the server's ID for them
+  std::map<u8, std::string> m_sync_save_delta_paths;
   u16 m_sync_gecko_codes_count = 0;
   u16 m_sync_gecko_codes_success_count = 0;
   bool m_sync_gecko_codes_complete = false;
@@ -4,10 +4,13 @@
 #include "Core/NetPlayCommon.h"
 
 #include <algorithm>
+#include <memory>
 
 #include <fmt/format.h>
 #include <lzo/lzo1x.h>
+#include <zstd.h>
 
+#include "Common/Crypto/SHA1.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
 #include "Common/MsgHandler.h"
@@ -297,4 +300,250 @@ std::optional<std::vector<u8>> DecompressPacketIntoBuffer(sf::Packet& packet)
 
   return out_buffer;
 }
+
+struct ZstdCStreamDeleter
+{
+  void operator()(ZSTD_CStream* stream) const { ZSTD_freeCStream(stream); }
+};
+
+struct ZstdDStreamDeleter
+{
+  void operator()(ZSTD_DStream* stream) const { ZSTD_freeDStream(stream); }
+};
+
+static u64 GetSaveBlockCount(u64 file_size)
+{
+  return (file_size + SAVE_SYNC_BLOCK_SIZE - 1) / SAVE_SYNC_BLOCK_SIZE;
+}
+
+static size_t GetSaveBlockSize(u64 file_size, u64 block_index)
+{
+  return static_cast<size_t>(
+      std::min<u64>(SAVE_SYNC_BLOCK_SIZE, file_size - block_index * SAVE_SYNC_BLOCK_SIZE));
+}
+
+static Common::SHA1::Digest HashSaveBlock(const std::vector<u8>& data, u64 block_index)
+{
+  return Common::SHA1::CalculateDigest(&data[block_index * SAVE_SYNC_BLOCK_SIZE],
+                                       GetSaveBlockSize(data.size(), block_index));
+}
+
+static std::optional<std::vector<u8>> ReadSaveFile(const std::string& file_path)
+{
+  std::vector<u8> data;
+  if (!File::Exists(file_path))
+    return data;
+
+  File::IOFile file(file_path, "rb");
+  if (!file)
+  {
+    PanicAlertFmtT("Failed to open file \"{0}\".", file_path);
+    return std::nullopt;
+  }
+
+  data.resize(file.GetSize());
+  if (!data.empty() && !file.ReadBytes(data.data(), data.size()))
+  {
+    PanicAlertFmtT("Error reading file: {0}", file_path);
+    return std::nullopt;
+  }
+
+  return data;
+}
+
+bool HashFileBlocksIntoPacket(const std::string& file_path, sf::Packet& packet)
+{
+  const std::optional<std::vector<u8>> data = ReadSaveFile(file_path);
+  if (!data)
+    return false;
+
+  packet << sf::Uint64{data->size()};
+  const u64 block_count = GetSaveBlockCount(data->size());
+  for (u64 i = 0; i < block_count; ++i)
+  {
+    for (u8 byte : HashSaveBlock(*data, i))
+      packet << byte;
+  }
+
+  return true;
+}
+
+bool CompressFileDeltaIntoPacket(const std::string& file_path, sf::Packet& hashes_packet,
+                                 sf::Packet& packet)
+{
+  const std::optional<std::vector<u8>> data = ReadSaveFile(file_path);
+  if (!data)
+    return false;
+
+  // Blocks past the end of our copy of the file aren't needed, so don't trust the remote size
+  // any further than that
+  const u64 block_count = GetSaveBlockCount(data->size());
+  const u64 remote_block_count =
+      std::min(GetSaveBlockCount(Common::PacketReadU64(hashes_packet)), block_count);
+
+  std::vector<u32> changed_blocks;
+  for (u64 i = 0; i < block_count; ++i)
+  {
+    Common::SHA1::Digest remote_hash{};
+    if (i < remote_block_count)
+    {
+      for (u8& byte : remote_hash)
+        hashes_packet >> byte;
+    }
+
+    if (!hashes_packet || i >= remote_block_count || remote_hash != HashSaveBlock(*data, i))
+      changed_blocks.push_back(static_cast<u32>(i));
+  }
+
+  packet << sf::Uint64{data->size()};
+  packet << static_cast<u32>(changed_blocks.size());
+  for (u32 block_index : changed_blocks)
+    packet << block_index;
+
+  // The changed blocks are sent as a single zstd stream, split into pieces the same way as the
+  // LZO compressed files above
+  std::unique_ptr<ZSTD_CStream, ZstdCStreamDeleter> stream(ZSTD_createCStream());
+  if (!stream)
+  {
+    PanicAlertFmtT("Internal zstd Error - compression failed");
+    return false;
+  }
+
+  std::vector<u8> out_buffer(ZSTD_CStreamOutSize());
+  const auto compress = [&](ZSTD_inBuffer* in, ZSTD_EndDirective directive) {
+    size_t result;
+    do
+    {
+      ZSTD_outBuffer out{out_buffer.data(), out_buffer.size(), 0};
+      result = ZSTD_compressStream2(stream.get(), &out, in, directive);
+      if (ZSTD_isError(result))
+        return false;
+      if (out.pos != 0)
+      {
+        packet << static_cast<u32>(out.pos);
+        packet.append(out_buffer.data(), out.pos);
+      }
+    } while (in->pos != in->size || (directive == ZSTD_e_end && result != 0));
+    return true;
+  };
+
+  for (u32 block_index : changed_blocks)
+  {
+    ZSTD_inBuffer in{&(*data)[u64{block_index} * SAVE_SYNC_BLOCK_SIZE],
+                     GetSaveBlockSize(data->size(), block_index), 0};
+    if (!compress(&in, ZSTD_e_continue))
+    {
+      PanicAlertFmtT("Internal zstd Error - compression failed");
+      return false;
+    }
+  }
+
+  ZSTD_inBuffer in{nullptr, 0, 0};
+  if (!compress(&in, ZSTD_e_end))
+  {
+    PanicAlertFmtT("Internal zstd Error - compression failed");
+    return false;
+  }
+
+  // Mark end of data
+  packet << static_cast<u32>(0);
+
+  return true;
+}
+
+bool DecompressPacketIntoFileDelta(sf::Packet& packet, const std::string& file_path)
+{
+  const u64 file_size = Common::PacketReadU64(packet);
+  u32 changed_count = 0;
+  packet >> changed_count;
+
+  // Every block index takes up four bytes of the packet, which bounds the count before anything
+  // gets allocated for it
+  const u64 block_count = GetSaveBlockCount(file_size);
+  if (changed_count > block_count || changed_count > packet.getDataSize() / sizeof(u32))
+    return false;
+
+  std::vector<u32> changed_blocks(changed_count);
+  u64 changed_size = 0;
+  for (size_t i = 0; i < changed_blocks.size(); ++i)
+  {
+    packet >> changed_blocks[i];
+    if (changed_blocks[i] >= block_count || (i != 0 && changed_blocks[i] <= changed_blocks[i - 1]))
+      return false;
+    changed_size += GetSaveBlockSize(file_size, changed_blocks[i]);
+  }
+
+  if (!packet)
+    return false;
+
+  std::unique_ptr<ZSTD_DStream, ZstdDStreamDeleter> stream(ZSTD_createDStream());
+  if (!stream)
+  {
+    PanicAlertFmtT("Internal zstd Error - decompression failed");
+    return false;
+  }
+
+  std::vector<u8> changed_data(changed_size);
+  std::vector<u8> in_buffer;
+  ZSTD_outBuffer out{changed_data.data(), changed_data.size(), 0};
+  size_t result = 1;
+  while (true)
+  {
+    u32 cur_len = 0;
+    packet >> cur_len;
+    if (!cur_len)
+      break;  // We reached the end of the data stream
+
+    in_buffer.resize(cur_len);
+    for (size_t j = 0; j < cur_len; j++)
+      packet >> in_buffer[j];
+
+    ZSTD_inBuffer in{in_buffer.data(), in_buffer.size(), 0};
+    while (in.pos != in.size)
+    {
+      const size_t previous_in_pos = in.pos;
+      const size_t previous_out_pos = out.pos;
+      result = ZSTD_decompressStream(stream.get(), &out, &in);
+      if (ZSTD_isError(result) || (in.pos == previous_in_pos && out.pos == previous_out_pos))
+      {
+        PanicAlertFmtT("Internal zstd Error - decompression failed");
+        return false;
+      }
+    }
+  }
+
+  if (!packet || result != 0 || out.pos != changed_data.size())
+  {
+    PanicAlertFmtT("Internal zstd Error - decompression failed");
+    return false;
+  }
+
+  if (file_size == 0)
+  {
+    // The sender doesn't have the file
+    return !File::Exists(file_path) || File::Delete(file_path);
+  }
+
+  File::IOFile file(file_path, File::Exists(file_path) ? "r+b" : "wb");
+  if (!file || !file.Resize(file_size))
+  {
+    PanicAlertFmtT("Failed to open file \"{0}\". Verify your write permissions.", file_path);
+    return false;
+  }
+
+  size_t data_offset = 0;
+  for (u32 block_index : changed_blocks)
+  {
+    const size_t block_size = GetSaveBlockSize(file_size, block_index);
+    if (!file.Seek(u64{block_index} * SAVE_SYNC_BLOCK_SIZE, File::SeekOrigin::Begin) ||
+        !file.WriteBytes(&changed_data[data_offset], block_size))
+    {
+      PanicAlertFmtT("Error writing file: {0}", file_path);
+      return false;
+    }
+    data_offset += block_size;
+  }
+
+  return true;
+}
 }  // namespace NetPlay
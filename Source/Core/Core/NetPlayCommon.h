@@ -26,4 +26,15 @@ bool CompressBufferIntoPacket(const std::vector<u8>& in_buffer, sf::Packet& pack
 bool DecompressPacketIntoFile(sf::Packet& packet, const std::string& file_path);
 bool DecompressPacketIntoFolder(sf::Packet& packet, const std::string& folder_path);
 std::optional<std::vector<u8>> DecompressPacketIntoBuffer(sf::Packet& packet);
+
+// Save files which players usually already have a copy of are synchronized by only sending the
+// blocks which differ. The receiver describes its copy with HashFileBlocksIntoPacket, the sender
+// answers with CompressFileDeltaIntoPacket, and the receiver applies that to its copy with
+// DecompressPacketIntoFileDelta. A missing file is treated like an empty one.
+constexpr u32 SAVE_SYNC_BLOCK_SIZE = 64 * 1024;
+
+bool HashFileBlocksIntoPacket(const std::string& file_path, sf::Packet& packet);
+bool CompressFileDeltaIntoPacket(const std::string& file_path, sf::Packet& hashes_packet,
+                                 sf::Packet& packet);
+bool DecompressPacketIntoFileDelta(sf::Packet& packet, const std::string& file_path);
 }  // namespace NetPlay
@@ -201,10 +201,18 @@ enum class SyncSaveDataID : u8
   Notify = 0,
   Success = 1,
   Failure = 2,
-  RawData = 3,
   GCIData = 4,
   WiiData = 5,
-  GBAData = 6
+  BlockHashRequest = 7,
+  BlockHashes = 8,
+  BlockData = 9,
+};
+
+// Save files which are synchronized block by block, see SAVE_SYNC_BLOCK_SIZE
+enum class DeltaSaveType : u8
+{
+  RawMemcard = 0,
+  GBA = 1,
 };
 
 enum class SyncCodeID : u8
@@ -1163,6 +1163,44 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
     }
     break;
 
+    case SyncSaveDataID::BlockHashes:
+    {
+      u8 file_id;
+      packet >> file_id;
+
+      std::optional<DeltaSaveFile> file;
+      {
+        std::lock_guard lk(m_delta_save_files_lock);
+        if (file_id < m_delta_save_files.size())
+          file = m_delta_save_files[file_id];
+      }
+
+      if (!m_start_pending || !file)
+      {
+        INFO_LOG_FMT(NETPLAY, "SyncSaveData: Ignoring block hashes of unknown save {}.", file_id);
+        break;
+      }
+
+      INFO_LOG_FMT(NETPLAY, "Sending differing blocks of {} to client {}.", file->path,
+                   player.pid);
+
+      sf::Packet spac;
+      spac << MessageID::SyncSaveData;
+      spac << SyncSaveDataID::BlockData;
+      spac << file_id;
+      if (!CompressFileDeltaIntoPacket(file->path, packet, spac))
+      {
+        m_dialog->AppendChat(Common::GetStringT("Error synchronizing save data!"));
+        m_dialog->OnGameStartAborted();
+        ChunkedDataAbort();
+        m_start_pending = false;
+        break;
+      }
+
+      SendChunked(std::move(spac), player.pid, file->title);
+    }
+    break;
+
     case SyncSaveDataID::Failure:
     {
       m_dialog->AppendChat(Common::FmtFormatT("{0} failed to synchronize.", player.name));
@@ -1788,6 +1826,11 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
 
   m_save_data_synced_players = 0;
 
+  {
+    std::lock_guard lk(m_delta_save_files_lock);
+    m_delta_save_files.clear();
+  }
+
   {
     sf::Packet pac;
     pac << MessageID::SyncSaveData;
@@ -1818,28 +1861,18 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
               Memcard::MBIT_SIZE_MEMORY_CARD_2043;
       const std::string path = Config::GetMemcardPath(slot, game_region, card_size_mbits);
 
+      INFO_LOG_FMT(NETPLAY, "Requesting block hashes of raw memcard {} in slot {}.", path,
+                   is_slot_a ? 'A' : 'B');
+
       sf::Packet pac;
       pac << MessageID::SyncSaveData;
-      pac << SyncSaveDataID::RawData;
+      pac << SyncSaveDataID::BlockHashRequest;
+      pac << AddDeltaSaveFile(
+          path, fmt::format("Memory Card {} Synchronization", is_slot_a ? 'A' : 'B'));
+      pac << DeltaSaveType::RawMemcard;
       pac << is_slot_a << region << size_override;
 
-      if (File::Exists(path))
-      {
-        INFO_LOG_FMT(NETPLAY, "Sending data of raw memcard {} in slot {}.", path,
-                     is_slot_a ? 'A' : 'B');
-        if (!CompressFileIntoPacket(path, pac))
-          return false;
-      }
-      else
-      {
-        // No file, so we'll say the size is 0
-        INFO_LOG_FMT(NETPLAY, "Sending empty marker for raw memcard {} in slot {}.", path,
-                     is_slot_a ? 'A' : 'B');
-        pac << sf::Uint64{0};
-      }
-
-      SendChunkedToClients(std::move(pac), 1,
-                           fmt::format("Memory Card {} Synchronization", is_slot_a ? 'A' : 'B'));
+      SendAsyncToClients(std::move(pac), 1, CHUNKED_DATA_CHANNEL);
     }
     else if (Config::Get(Config::GetInfoForEXIDevice(slot)) ==
              ExpansionInterface::EXIDeviceType::MemoryCardFolder)
@@ -1988,37 +2021,35 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
   {
     if (m_gba_config[i].enabled && m_gba_config[i].has_rom)
     {
-      sf::Packet pac;
-      pac << MessageID::SyncSaveData;
-      pac << SyncSaveDataID::GBAData;
-      pac << static_cast<u8>(i);
-
       std::string path;
 #ifdef HAS_LIBMGBA
       path = HW::GBA::Core::GetSavePath(Config::Get(Config::MAIN_GBA_ROM_PATHS[i]),
                                         static_cast<int>(i));
 #endif
-      if (File::Exists(path))
-      {
-        INFO_LOG_FMT(NETPLAY, "Sending data of GBA save at {} for slot {}.", path, i);
-        if (!CompressFileIntoPacket(path, pac))
-          return false;
-      }
-      else
-      {
-        // No file, so we'll say the size is 0
-        INFO_LOG_FMT(NETPLAY, "Sending empty marker for GBA save at {} for slot {}.", path, i);
-        pac << sf::Uint64{0};
-      }
 
-      SendChunkedToClients(std::move(pac), 1,
-                           fmt::format("GBA{} Save File Synchronization", i + 1));
+      INFO_LOG_FMT(NETPLAY, "Requesting block hashes of GBA save at {} for slot {}.", path, i);
+
+      sf::Packet pac;
+      pac << MessageID::SyncSaveData;
+      pac << SyncSaveDataID::BlockHashRequest;
+      pac << AddDeltaSaveFile(path, fmt::format("GBA{} Save File Synchronization", i + 1));
+      pac << DeltaSaveType::GBA;
+      pac << static_cast<u8>(i);
+
+      SendAsyncToClients(std::move(pac), 1, CHUNKED_DATA_CHANNEL);
     }
   }
 
   return true;
 }
 
+u8 NetPlayServer::AddDeltaSaveFile(std::string path, std::string title)
+{
+  std::lock_guard lk(m_delta_save_files_lock);
+  m_delta_save_files.push_back(DeltaSaveFile{std::move(path), std::move(title)});
+  return static_cast<u8>(m_delta_save_files.size() - 1);
+}
+
 bool NetPlayServer::SyncCodes()
 {
   INFO_LOG_FMT(NETPLAY, "Sending codes to clients.");
@@ -124,6 +124,7 @@ private:
   bool SetupNetSettings();
   std::optional<SaveSyncInfo> CollectSaveSyncInfo();
   bool SyncSaveData(const SaveSyncInfo& sync_info);
+  u8 AddDeltaSaveFile(std::string path, std::string title);
   bool SyncCodes();
   void CheckSyncAndStartGame();
 
@@ -184,6 +185,16 @@ private:
 
   std::map<PlayerId, Client> m_players;
 
+  // Save files which clients are sent the differing blocks of, indexed by the ID that the
+  // SyncSaveData messages about them carry
+  struct DeltaSaveFile
+  {
+    std::string path;
+    std::string title;
+  };
+  std::vector<DeltaSaveFile> m_delta_save_files;
+  std::mutex m_delta_save_files_lock;
+
   std::unordered_map<u32, std::vector<std::pair<PlayerId, u64>>> m_timebase_by_frame;
   bool m_desync_detected = false;
 
@@ -289,6 +289,7 @@ void MemChecks::Add(TMemCheck memory_check)
     {
       m_mem_checks.emplace_back(std::move(memory_check));
     }
+    UpdateIndex();
     // If this is the first one, clear the JIT cache so it can switch to
     // watchpoint-compatible code.
     if (!had_any)
@@ -320,6 +321,7 @@ void MemChecks::Remove(u32 address)
 
   Core::RunAsCPUThread([&] {
     m_mem_checks.erase(iter);
+    UpdateIndex();
     if (!HasAny())
       m_system.GetJitInterface().ClearCache();
     m_system.GetMMU().DBATUpdated();
@@ -330,6 +332,7 @@ void MemChecks::Clear()
 {
   Core::RunAsCPUThread([&] {
     m_mem_checks.clear();
+    UpdateIndex();
     m_system.GetJitInterface().ClearCache();
     m_system.GetMMU().DBATUpdated();
   });
@@ -337,16 +340,18 @@ void MemChecks::Clear()
 
 TMemCheck* MemChecks::GetMemCheck(u32 address, size_t size)
 {
-  const auto iter =
-      std::find_if(m_mem_checks.begin(), m_mem_checks.end(), [address, size](const auto& mc) {
-        return mc.end_address >= address && address + size - 1 >= mc.start_address;
-      });
+  // If several memchecks overlap, the one which was added first wins.
+  size_t found = m_mem_checks.size();
+  ForEachOverlappingMemCheck(address, u64(address) + size - 1, [&found](size_t index) {
+    found = std::min(found, index);
+    return true;
+  });
 
   // None found
-  if (iter == m_mem_checks.cend())
+  if (found == m_mem_checks.size())
     return nullptr;
 
-  return &*iter;
+  return &m_mem_checks[found];
 }
 
 bool MemChecks::OverlapsMemcheck(u32 address, u32 length) const
@@ -354,15 +359,66 @@ bool MemChecks::OverlapsMemcheck(u32 address, u32 length) const
   if (!HasAny())
     return false;
 
+  // Checks the naturally aligned block of the given length which contains the address.
   const u32 page_end_suffix = length - 1;
-  const u32 page_end_address = address | page_end_suffix;
+  bool overlaps = false;
+  ForEachOverlappingMemCheck(address & ~page_end_suffix, address | page_end_suffix,
+                             [&overlaps](size_t) {
+                               overlaps = true;
+                               return false;
+                             });
+  return overlaps;
+}
+
+template <typename Function>
+void MemChecks::ForEachOverlappingMemCheck(u64 start, u64 end, Function function) const
+{
+  // Entries starting after the end of the range can't overlap it, and the remaining entries can
+  // be skipped once none of them reach the start of the range.
+  auto iter = std::upper_bound(m_index.begin(), m_index.end(), end,
+                               [](u64 value, const IndexEntry& entry) {
+                                 return value < entry.start_address;
+                               });
+  while (iter != m_index.begin())
+  {
+    --iter;
+    if (iter->max_end_address < start)
+      return;
+    if (iter->end_address >= start && !function(iter->mem_check_index))
+      return;
+  }
+}
+
+void MemChecks::UpdateIndex()
+{
+  m_index.clear();
+  m_watched_pages.clear();
+  if (m_mem_checks.empty())
+    return;
+
+  m_index.reserve(m_mem_checks.size());
+  m_watched_pages.resize((u64(1) << (32 - WATCHED_PAGE_SHIFT)) / 64);
+  for (size_t i = 0; i < m_mem_checks.size(); ++i)
+  {
+    const TMemCheck& mc = m_mem_checks[i];
+    m_index.push_back({mc.start_address, mc.end_address, 0, i});
+
+    for (u32 page = mc.start_address >> WATCHED_PAGE_SHIFT;
+         page <= mc.end_address >> WATCHED_PAGE_SHIFT; ++page)
+    {
+      m_watched_pages[page / 64] |= u64(1) << (page % 64);
+    }
+  }
 
-  return std::any_of(m_mem_checks.cbegin(), m_mem_checks.cend(), [&](const auto& mc) {
-    return ((mc.start_address | page_end_suffix) == page_end_address ||
-            (mc.end_address | page_end_suffix) == page_end_address) ||
-           ((mc.start_address | page_end_suffix) < page_end_address &&
-            (mc.end_address | page_end_suffix) > page_end_address);
+  std::sort(m_index.begin(), m_index.end(), [](const IndexEntry& a, const IndexEntry& b) {
+    return a.start_address < b.start_address;
   });
+  u32 max_end_address = 0;
+  for (IndexEntry& entry : m_index)
+  {
+    max_end_address = std::max(max_end_address, entry.end_address);
+    entry.max_end_address = max_end_address;
+  }
 }
 
 bool TMemCheck::Action(Core::System& system, Core::DebugInterface* debug_interface, u64 value,
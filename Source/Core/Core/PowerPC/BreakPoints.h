@@ -126,7 +126,40 @@ public:
   void Clear();
   bool HasAny() const { return !m_mem_checks.empty(); }
 
+  // Returns whether any memcheck overlaps the 4 KiB page containing the given address. Meant as a
+  // cheap test for whether an access needs to go through GetMemCheck at all.
+  bool IsPageWatched(u32 address) const
+  {
+    const u32 page = address >> WATCHED_PAGE_SHIFT;
+    return !m_watched_pages.empty() && ((m_watched_pages[page / 64] >> (page % 64)) & 1) != 0;
+  }
+
 private:
+  static constexpr u32 WATCHED_PAGE_SHIFT = 12;
+
+  struct IndexEntry
+  {
+    u32 start_address;
+    u32 end_address;
+    // The highest end_address of this and all preceding entries.
+    u32 max_end_address;
+    size_t mem_check_index;
+  };
+
+  // Calls function with the index into m_mem_checks of every memcheck overlapping [start, end],
+  // from the highest start address to the lowest, until it returns false.
+  template <typename Function>
+  void ForEachOverlappingMemCheck(u64 start, u64 end, Function function) const;
+
+  // Must be called whenever memchecks are added or removed.
+  void UpdateIndex();
+
   TMemChecks m_mem_checks;
+  // m_mem_checks sorted by start address, so that the memchecks overlapping an address can be
+  // found without looking at all of them.
+  std::vector<IndexEntry> m_index;
+  // One bit per page, set if the page is overlapped by a memcheck. Empty if there are no
+  // memchecks.
+  std::vector<u64> m_watched_pages;
   Core::System& m_system;
 };
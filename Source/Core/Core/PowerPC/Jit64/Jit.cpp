@@ -39,6 +39,7 @@
 #include "Core/PowerPC/Jit64Common/Jit64Constants.h"
 #include "Core/PowerPC/Jit64Common/Jit64PowerPCState.h"
 #include "Core/PowerPC/Jit64Common/TrampolineCache.h"
+#include "Core/PowerPC/JitCommon/JitTrace.h"
 #include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCAnalyst.h"
@@ -152,6 +153,18 @@ bool Jit64::HandleFault(uintptr_t access_address, SContext* ctx)
                    "PC {:#018x}, access address {:#018x}, memory base {:#018x}, MSR.DR {}",
                    ctx->CTX_PC, access_address, memory_base, ppc_state.msr.DR);
     }
+    else if (ppc_state.msr.DR)
+    {
+      // If the address is mapped through the page table, map the page into the fastmem area and
+      // retry the access instead of permanently sending this instruction down the slow path.
+      const auto it = m_back_patch_info.find(reinterpret_cast<u8*>(ctx->CTX_PC));
+      if (it != m_back_patch_info.end() &&
+          m_mmu.HandlePageTableFastmemFault(static_cast<u32>(access_address - memory_base),
+                                            !it->second.read))
+      {
+        return true;
+      }
+    }
 
     return BackPatch(ctx);
   }
@@ -926,6 +939,17 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
     IntializeSpeculativeConstants();
   }
 
+  // Only record the block once the checks above can no longer bail out to the dispatcher, as the
+  // block gets recompiled (and is executed again) if they do. Speculative constants are only
+  // immediates in the register cache at this point, so nothing needs to be saved.
+  if (m_trace_writer)
+  {
+    TraceBlockDefinition();
+    ABI_PushRegistersAndAdjustStack({}, 0);
+    ABI_CallFunctionPC(JitTrace::Writer::RecordBlockExecuted, m_trace_writer, js.blockStart);
+    ABI_PopRegistersAndAdjustStack({}, 0);
+  }
+
   // Translate instructions
   for (u32 i = 0; i < code_block.m_num_instructions; i++)
   {
@@ -24,6 +24,7 @@
 #include "Core/PatchEngine.h"
 #include "Core/PowerPC/Interpreter/Interpreter.h"
 #include "Core/PowerPC/JitArm64/JitArm64_RegCache.h"
+#include "Core/PowerPC/JitCommon/JitTrace.h"
 #include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/PowerPC/Profiler.h"
@@ -136,7 +137,17 @@ bool JitArm64::HandleFault(uintptr_t access_address, SContext* ctx)
       }
       else
       {
-        success = HandleFastmemFault(ctx);
+        // If the address is mapped through the page table, map the page into the fastmem area and
+        // retry the access instead of backpatching. We don't know whether the access was a load or
+        // a store, so translate it as a load; this only maps pages whose C bit is already set.
+        if (m_ppc_state.msr.DR)
+        {
+          success = m_mmu.HandlePageTableFastmemFault(
+              static_cast<u32>(access_address - memory_base), false);
+        }
+
+        if (!success)
+          success = HandleFastmemFault(ctx);
       }
     }
   }
@@ -1021,6 +1032,29 @@ bool JitArm64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
     IntializeSpeculativeConstants();
   }
 
+  // Only record the block once the checks above can no longer bail out to the dispatcher, as the
+  // block gets recompiled (and is executed again) if they do.
+  if (m_trace_writer)
+  {
+    TraceBlockDefinition();
+
+    // Speculative constants may already be cached in host registers.
+    gpr.Lock(ARM64Reg::W30);
+    BitSet32 regs_in_use = gpr.GetCallerSavedUsed();
+    BitSet32 fprs_in_use = fpr.GetCallerSavedUsed();
+    regs_in_use[DecodeReg(ARM64Reg::W30)] = 0;
+
+    ABI_PushRegisters(regs_in_use);
+    m_float_emit.ABI_PushRegisters(fprs_in_use, ARM64Reg::X30);
+    MOVP2R(ARM64Reg::X0, m_trace_writer);
+    MOVI2R(ARM64Reg::W1, js.blockStart);
+    MOVP2R(ARM64Reg::X8, &JitTrace::Writer::RecordBlockExecuted);
+    BLR(ARM64Reg::X8);
+    m_float_emit.ABI_PopRegisters(fprs_in_use, ARM64Reg::X30);
+    ABI_PopRegisters(regs_in_use);
+    gpr.Unlock(ARM64Reg::W30);
+  }
+
   // Translate instructions
   for (u32 i = 0; i < code_block.m_num_instructions; i++)
   {
@@ -19,6 +19,7 @@
 #include "Core/CoreTiming.h"
 #include "Core/HW/CPU.h"
 #include "Core/MemTools.h"
+#include "Core/PowerPC/JitCommon/JitTrace.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
@@ -279,3 +280,13 @@ bool JitBase::ShouldHandleFPExceptionForInstruction(const PPCAnalyst::CodeOp* op
   else
     return false;
 }
+
+void JitBase::TraceBlockDefinition()
+{
+  if (!m_trace_writer)
+    return;
+
+  m_trace_writer->BeginBlockDefinition(js.blockStart, code_block.m_num_instructions);
+  for (u32 i = 0; i < code_block.m_num_instructions; ++i)
+    m_trace_writer->AddBlockInstruction(m_code_buffer[i].address, m_code_buffer[i].inst.hex);
+}
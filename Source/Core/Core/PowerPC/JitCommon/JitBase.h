@@ -25,6 +25,10 @@ namespace Core
 {
 class System;
 }
+namespace JitTrace
+{
+class Writer;
+}
 namespace PowerPC
 {
 class MMU;
@@ -161,6 +165,9 @@ protected:
   bool m_cleanup_after_stackfault = false;
   u8* m_stack_guard = nullptr;
 
+  // If set, compiled blocks record their execution in this trace.
+  JitTrace::Writer* m_trace_writer = nullptr;
+
   static const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 22> JIT_SETTINGS;
 
   bool DoesConfigNeedRefresh();
@@ -175,6 +182,9 @@ protected:
 
   bool ShouldHandleFPExceptionForInstruction(const PPCAnalyst::CodeOp* op);
 
+  // Adds the block currently being compiled to the trace.
+  void TraceBlockDefinition();
+
 public:
   explicit JitBase(Core::System& system);
   JitBase(const JitBase&) = delete;
@@ -185,6 +195,9 @@ public:
 
   bool IsDebuggingEnabled() const { return m_enable_debugging; }
 
+  // The cache has to be cleared afterwards for this to apply to all blocks.
+  void SetTraceWriter(JitTrace::Writer* writer) { m_trace_writer = writer; }
+
   static const u8* Dispatch(JitBase& jit);
   virtual JitBaseBlockCache* GetBlockCache() = 0;
 
@@ -0,0 +1,313 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/PowerPC/JitCommon/JitTrace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include <zstd.h>
+
+#include "Common/Logging/Log.h"
+#include "Common/Thread.h"
+
+namespace JitTrace
+{
+namespace
+{
+// Larger blocks than this can't be produced by the PPC analyzer, so this only guards against
+// corrupted traces.
+constexpr u32 MAX_BLOCK_INSTRUCTIONS = 0x10000;
+}  // namespace
+
+Writer::Writer() = default;
+
+Writer::~Writer()
+{
+  Close();
+}
+
+bool Writer::Open(const std::string& path)
+{
+  Close();
+
+  if (!m_file.Open(path, "wb"))
+    return false;
+
+  const FileHeader header{FILE_MAGIC, FILE_VERSION};
+  if (!m_file.WriteArray(&header, 1))
+  {
+    m_file.Close();
+    return false;
+  }
+
+  m_stream = ZSTD_createCStream();
+  if (!m_stream)
+  {
+    m_file.Close();
+    return false;
+  }
+
+  m_out_buffer.resize(ZSTD_CStreamOutSize());
+  m_ring = std::make_unique<u32[]>(RING_SIZE);
+  m_write_index.store(0, std::memory_order_relaxed);
+  m_read_index.store(0, std::memory_order_relaxed);
+  m_failed = false;
+
+  m_running.Set();
+  m_thread = std::thread(&Writer::ThreadFunc, this);
+  return true;
+}
+
+void Writer::Close()
+{
+  if (!m_thread.joinable())
+    return;
+
+  m_running.Clear();
+  m_wake_event.Set();
+  m_thread.join();
+
+  ZSTD_freeCStream(m_stream);
+  m_stream = nullptr;
+  m_ring.reset();
+  m_file.Close();
+}
+
+void Writer::RecordBlockExecuted(Writer& writer, u32 address)
+{
+  writer.Push(address | static_cast<u32>(EntryType::BlockExecuted));
+}
+
+void Writer::BeginBlockDefinition(u32 address, u32 instruction_count)
+{
+  Push(address | static_cast<u32>(EntryType::BlockDefinition));
+  Push(instruction_count);
+}
+
+void Writer::AddBlockInstruction(u32 address, u32 instruction)
+{
+  Push(address);
+  Push(instruction);
+}
+
+void Writer::Push(u32 word)
+{
+  const u64 write_index = m_write_index.load(std::memory_order_relaxed);
+  if (write_index - m_read_index.load(std::memory_order_acquire) >= RING_SIZE)
+    WaitForSpace();
+
+  m_ring[write_index & RING_MASK] = word;
+  m_write_index.store(write_index + 1, std::memory_order_release);
+
+  if ((write_index & (WAKE_INTERVAL - 1)) == 0)
+    m_wake_event.Set();
+}
+
+void Writer::WaitForSpace()
+{
+  // Dropping entries would make the trace useless, so the CPU thread has to wait for the writer
+  // thread to catch up.
+  const u64 write_index = m_write_index.load(std::memory_order_relaxed);
+  while (write_index - m_read_index.load(std::memory_order_acquire) >= RING_SIZE)
+  {
+    m_wake_event.Set();
+    std::this_thread::yield();
+  }
+}
+
+void Writer::ThreadFunc()
+{
+  Common::SetCurrentThreadName("JIT trace writer");
+
+  while (m_running.IsSet())
+  {
+    m_wake_event.WaitFor(std::chrono::milliseconds(100));
+    Drain(false);
+  }
+
+  // Everything has been recorded by the time Close clears m_running.
+  Drain(true);
+}
+
+bool Writer::Drain(bool finish)
+{
+  u64 read_index = m_read_index.load(std::memory_order_relaxed);
+  const u64 write_index = m_write_index.load(std::memory_order_acquire);
+
+  if (m_failed)
+  {
+    // Keep the ring moving so that the CPU thread doesn't get stuck.
+    m_read_index.store(write_index, std::memory_order_release);
+    return false;
+  }
+
+  const auto compress = [this](ZSTD_inBuffer* in, ZSTD_EndDirective directive) {
+    size_t result;
+    do
+    {
+      ZSTD_outBuffer out{m_out_buffer.data(), m_out_buffer.size(), 0};
+      result = ZSTD_compressStream2(m_stream, &out, in, directive);
+      if (ZSTD_isError(result) || !m_file.WriteBytes(m_out_buffer.data(), out.pos))
+        return false;
+    } while (in->pos != in->size || (directive == ZSTD_e_end && result != 0));
+    return true;
+  };
+
+  while (read_index != write_index)
+  {
+    const u64 count = std::min(write_index - read_index, RING_SIZE - (read_index & RING_MASK));
+    ZSTD_inBuffer in{&m_ring[read_index & RING_MASK], count * sizeof(u32), 0};
+    if (!compress(&in, ZSTD_e_continue))
+    {
+      ERROR_LOG_FMT(POWERPC, "Failed to write JIT trace");
+      m_failed = true;
+      m_read_index.store(write_index, std::memory_order_release);
+      return false;
+    }
+
+    // zstd has copied whatever it still needs, so the CPU thread can reuse this part of the ring.
+    read_index += count;
+    m_read_index.store(read_index, std::memory_order_release);
+  }
+
+  if (finish)
+  {
+    ZSTD_inBuffer in{nullptr, 0, 0};
+    if (!compress(&in, ZSTD_e_end))
+    {
+      ERROR_LOG_FMT(POWERPC, "Failed to write JIT trace");
+      m_failed = true;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+Reader::Reader() = default;
+
+Reader::~Reader()
+{
+  if (m_stream)
+    ZSTD_freeDStream(m_stream);
+}
+
+bool Reader::Open(const std::string& path)
+{
+  if (!m_file.Open(path, "rb"))
+    return false;
+
+  FileHeader header;
+  if (!m_file.ReadArray(&header, 1) || header.magic != FILE_MAGIC ||
+      header.version != FILE_VERSION)
+  {
+    return false;
+  }
+
+  m_stream = ZSTD_createDStream();
+  if (!m_stream)
+    return false;
+
+  m_in_buffer.resize(ZSTD_DStreamInSize());
+  m_out_buffer.resize(ZSTD_DStreamOutSize());
+  return true;
+}
+
+bool Reader::ReadEntry(Entry* entry)
+{
+  u32 word;
+  if (!ReadWord(&word))
+    return false;
+
+  entry->type = static_cast<EntryType>(word & ENTRY_TYPE_MASK);
+  entry->address = word & ~ENTRY_TYPE_MASK;
+  entry->instructions.clear();
+
+  switch (entry->type)
+  {
+  case EntryType::BlockExecuted:
+    return true;
+
+  case EntryType::BlockDefinition:
+  {
+    u32 count;
+    if (!ReadWord(&count) || count > MAX_BLOCK_INSTRUCTIONS)
+      break;
+
+    entry->instructions.resize(count);
+    for (Instruction& instruction : entry->instructions)
+    {
+      if (!ReadWord(&instruction.address) || !ReadWord(&instruction.hex))
+      {
+        m_corrupted = true;
+        return false;
+      }
+    }
+    return true;
+  }
+  }
+
+  m_corrupted = true;
+  return false;
+}
+
+bool Reader::ReadWord(u32* word)
+{
+  while (m_out_size - m_out_position < sizeof(u32))
+  {
+    if (!Refill())
+      return false;
+  }
+
+  std::memcpy(word, m_out_buffer.data() + m_out_position, sizeof(u32));
+  m_out_position += sizeof(u32);
+  return true;
+}
+
+bool Reader::Refill()
+{
+  if (m_corrupted)
+    return false;
+
+  // Keep any partial word around.
+  const size_t leftover = m_out_size - m_out_position;
+  std::memmove(m_out_buffer.data(), m_out_buffer.data() + m_out_position, leftover);
+  m_out_position = 0;
+  m_out_size = leftover;
+
+  if (m_in_position == m_in_size)
+  {
+    size_t read = 0;
+    if (!m_end_of_file)
+      m_file.ReadArray(m_in_buffer.data(), m_in_buffer.size(), &read);
+
+    if (read == 0)
+    {
+      // A trace which was cut off (e.g. by a crash) is still readable up to that point.
+      m_end_of_file = true;
+      if (leftover != 0 || !m_frame_complete)
+        m_corrupted = true;
+      return false;
+    }
+
+    m_in_position = 0;
+    m_in_size = read;
+  }
+
+  ZSTD_inBuffer in{m_in_buffer.data(), m_in_size, m_in_position};
+  ZSTD_outBuffer out{m_out_buffer.data(), m_out_buffer.size(), m_out_size};
+  const size_t result = ZSTD_decompressStream(m_stream, &out, &in);
+  if (ZSTD_isError(result))
+  {
+    m_corrupted = true;
+    return false;
+  }
+
+  m_in_position = in.pos;
+  m_out_size = out.pos;
+  m_frame_complete = result == 0;
+  return true;
+}
+}  // namespace JitTrace
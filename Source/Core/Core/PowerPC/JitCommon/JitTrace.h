@@ -0,0 +1,144 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
+#include "Common/IOFile.h"
+
+struct ZSTD_CCtx_s;
+struct ZSTD_DCtx_s;
+
+// Block level execution traces recorded by the JITs.
+//
+// A trace file starts with a FileHeader, followed by a zstd stream of u32 words in host byte order.
+// Since PowerPC instructions are 4-byte aligned, the low two bits of the first word of each entry
+// say what kind of entry it is:
+//
+//   address | 0: The block starting at address was executed.
+//   address | 1: A block starting at address was compiled. The next word is the number of
+//                instructions n, followed by n pairs of (instruction address, instruction). Blocks
+//                are always defined before they're first executed, and a later definition at the
+//                same address replaces the earlier one.
+//
+// Recording only touches a ring buffer on the CPU thread. Compressing and writing the trace is done
+// on a separate thread.
+namespace JitTrace
+{
+struct FileHeader
+{
+  u32 magic;
+  u32 version;
+};
+
+constexpr u32 FILE_MAGIC = 0x52544A44;  // "DJTR"
+constexpr u32 FILE_VERSION = 1;
+
+enum class EntryType : u32
+{
+  BlockExecuted = 0,
+  BlockDefinition = 1,
+};
+
+constexpr u32 ENTRY_TYPE_MASK = 3;
+
+class Writer
+{
+public:
+  Writer();
+  ~Writer();
+
+  Writer(const Writer&) = delete;
+  Writer& operator=(const Writer&) = delete;
+
+  bool Open(const std::string& path);
+  // Writes out everything which has been recorded and finishes the file.
+  void Close();
+
+  // Called from JIT code at the start of every block.
+  static void RecordBlockExecuted(Writer& writer, u32 address);
+
+  void BeginBlockDefinition(u32 address, u32 instruction_count);
+  void AddBlockInstruction(u32 address, u32 instruction);
+
+private:
+  void Push(u32 word);
+  void WaitForSpace();
+  void ThreadFunc();
+  bool Drain(bool finish);
+
+  static constexpr u64 RING_SIZE = 1 << 20;
+  static constexpr u64 RING_MASK = RING_SIZE - 1;
+  // How often the CPU thread wakes up the writer thread, in words.
+  static constexpr u64 WAKE_INTERVAL = RING_SIZE / 4;
+
+  std::unique_ptr<u32[]> m_ring;
+  std::atomic<u64> m_write_index = 0;
+  std::atomic<u64> m_read_index = 0;
+
+  File::IOFile m_file;
+  ZSTD_CCtx_s* m_stream = nullptr;
+  std::vector<u8> m_out_buffer;
+  // Only accessed by the writer thread.
+  bool m_failed = false;
+
+  std::thread m_thread;
+  Common::Flag m_running;
+  Common::Event m_wake_event;
+};
+
+class Reader
+{
+public:
+  struct Instruction
+  {
+    u32 address;
+    u32 hex;
+  };
+
+  struct Entry
+  {
+    EntryType type;
+    u32 address;
+    // Only set for BlockDefinition.
+    std::vector<Instruction> instructions;
+  };
+
+  Reader();
+  ~Reader();
+
+  Reader(const Reader&) = delete;
+  Reader& operator=(const Reader&) = delete;
+
+  bool Open(const std::string& path);
+
+  // Returns false once the end of the trace has been reached, or if the trace is corrupted (in
+  // which case IsCorrupted returns true).
+  bool ReadEntry(Entry* entry);
+  bool IsCorrupted() const { return m_corrupted; }
+
+private:
+  bool ReadWord(u32* word);
+  bool Refill();
+
+  File::IOFile m_file;
+  ZSTD_DCtx_s* m_stream = nullptr;
+  std::vector<u8> m_in_buffer;
+  size_t m_in_position = 0;
+  size_t m_in_size = 0;
+  std::vector<u8> m_out_buffer;
+  size_t m_out_position = 0;
+  size_t m_out_size = 0;
+  bool m_end_of_file = false;
+  bool m_frame_complete = false;
+  bool m_corrupted = false;
+};
+}  // namespace JitTrace
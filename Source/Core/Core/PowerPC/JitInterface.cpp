@@ -26,6 +26,7 @@
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
+#include "Core/PowerPC/JitCommon/JitTrace.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
 #include "Core/PowerPC/PowerPC.h"
@@ -212,6 +213,44 @@ JitInterface::GetHostCode(u32 address) const
   return result;
 }
 
+bool JitInterface::StartTrace(const std::string& filename)
+{
+  if (!m_jit)
+    return false;
+
+  StopTrace();
+
+  auto writer = std::make_unique<JitTrace::Writer>();
+  if (!writer->Open(filename))
+    return false;
+
+  m_trace_writer = std::move(writer);
+  m_jit->SetTraceWriter(m_trace_writer.get());
+  // Blocks only record their execution if they were compiled while tracing.
+  m_jit->ClearCache();
+  return true;
+}
+
+void JitInterface::StopTrace()
+{
+  if (!m_trace_writer)
+    return;
+
+  if (m_jit)
+  {
+    m_jit->SetTraceWriter(nullptr);
+    m_jit->ClearCache();
+  }
+
+  m_trace_writer->Close();
+  m_trace_writer.reset();
+}
+
+bool JitInterface::IsTracing() const
+{
+  return m_trace_writer != nullptr;
+}
+
 bool JitInterface::HandleFault(uintptr_t access_address, SContext* ctx)
 {
   // Prevent nullptr dereference on a crash with no JIT present
@@ -333,6 +372,8 @@ void JitInterface::CompileExceptionCheckFromJIT(JitInterface& jit_interface, Exc
 
 void JitInterface::Shutdown()
 {
+  StopTrace();
+
   if (m_jit)
   {
     m_jit->Shutdown();
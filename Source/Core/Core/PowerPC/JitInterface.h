@@ -18,6 +18,10 @@ namespace Core
 {
 class System;
 }
+namespace JitTrace
+{
+class Writer;
+}
 namespace PowerPC
 {
 enum class CPUCore;
@@ -67,6 +71,13 @@ public:
   void GetProfileResults(Profiler::ProfileStats* prof_stats) const;
   std::variant<GetHostCodeError, GetHostCodeResult> GetHostCode(u32 address) const;
 
+  // Starts writing a trace of every executed JIT block to the given file (see JitTrace.h),
+  // replacing the current trace if there is one. Only Jit64 and JitArm64 support this. Clears the
+  // JIT cache.
+  bool StartTrace(const std::string& filename);
+  void StopTrace();
+  bool IsTracing() const;
+
   // Memory Utilities
   bool HandleFault(uintptr_t access_address, SContext* ctx);
   bool HandleStackFault();
@@ -102,5 +113,6 @@ public:
 
 private:
   std::unique_ptr<JitBase> m_jit;
+  std::unique_ptr<JitTrace::Writer> m_trace_writer;
   Core::System& m_system;
 };
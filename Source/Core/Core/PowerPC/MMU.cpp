@@ -530,10 +530,14 @@ std::optional<ReadResult<u32>> MMU::HostTryReadInstruction(const Core::CPUThread
 
 void MMU::Memcheck(u32 address, u64 var, bool write, size_t size)
 {
-  if (!m_power_pc.GetMemChecks().HasAny())
+  MemChecks& mem_checks = m_power_pc.GetMemChecks();
+  if (!mem_checks.IsPageWatched(address) &&
+      !mem_checks.IsPageWatched(address + static_cast<u32>(size) - 1))
+  {
     return;
+  }
 
-  TMemCheck* mc = m_power_pc.GetMemChecks().GetMemCheck(address, size);
+  TMemCheck* mc = mem_checks.GetMemCheck(address, size);
   if (mc == nullptr)
     return;
 
@@ -908,9 +912,8 @@ std::optional<ReadResult<std::string>> MMU::HostTryReadString(const Core::CPUThr
 
 bool MMU::IsOptimizableRAMAddress(const u32 address) const
 {
-  if (m_power_pc.GetMemChecks().HasAny())
-    return false;
-
+  // Memchecks don't need to be checked here, since UpdateBATs leaves BAT_PHYSICAL_BIT unset for
+  // pages which they overlap.
   if (!m_ppc_state.msr.DR)
     return false;
 
@@ -999,6 +1002,57 @@ bool MMU::HostIsInstructionRAMAddress(const Core::CPUThreadGuard& guard, u32 add
   return false;
 }
 
+const u8* MMU::HostGetRAMPagePointer(const Core::CPUThreadGuard& guard, u32 address,
+                                     RequestedAddressSpace space)
+{
+  auto& mmu = guard.GetSystem().GetMMU();
+  if (mmu.m_ppc_state.m_enable_dcache)
+    return nullptr;
+
+  bool translate = false;
+  switch (space)
+  {
+  case RequestedAddressSpace::Effective:
+    translate = mmu.m_ppc_state.msr.DR;
+    break;
+  case RequestedAddressSpace::Physical:
+    break;
+  case RequestedAddressSpace::Virtual:
+    if (!mmu.m_ppc_state.msr.DR)
+      return nullptr;
+    translate = true;
+    break;
+  }
+
+  address &= ~static_cast<u32>(HW_PAGE_MASK);
+  if (translate)
+  {
+    const auto translate_address = mmu.TranslateAddress<XCheckTLBFlag::NoException>(address);
+    if (!translate_address.Success())
+      return nullptr;
+    address = translate_address.address;
+  }
+
+  // This has to match the RAM cases of ReadFromHardware.
+  const u32 segment = address >> 28;
+  if (mmu.m_memory.GetL1Cache() && segment == 0xE &&
+      address < (0xE0000000 + mmu.m_memory.GetL1CacheSize()))
+  {
+    return &mmu.m_memory.GetL1Cache()[address & 0x0FFFFFFF];
+  }
+  if (mmu.m_memory.GetRAM() && segment == 0x0 &&
+      (address & 0x0FFFFFFF) < mmu.m_memory.GetRamSizeReal())
+  {
+    return &mmu.m_memory.GetRAM()[address & mmu.m_memory.GetRamMask()];
+  }
+  if (mmu.m_memory.GetEXRAM() && segment == 0x1 &&
+      (address & 0x0FFFFFFF) < mmu.m_memory.GetExRamSizeReal())
+  {
+    return &mmu.m_memory.GetEXRAM()[address & 0x0FFFFFFF];
+  }
+  return nullptr;
+}
+
 void MMU::DMA_LCToMemory(const u32 mem_address, const u32 cache_address, const u32 num_blocks)
 {
   // TODO: It's not completely clear this is the right spot for this code;
@@ -1205,7 +1259,7 @@ void MMU::TouchDCacheLine(u32 address, bool store)
 
 u32 MMU::IsOptimizableMMIOAccess(u32 address, u32 access_size) const
 {
-  if (m_power_pc.GetMemChecks().HasAny())
+  if (m_power_pc.GetMemChecks().IsPageWatched(address))
     return 0;
 
   if (!m_ppc_state.msr.DR)
@@ -1228,7 +1282,7 @@ u32 MMU::IsOptimizableMMIOAccess(u32 address, u32 access_size) const
 
 bool MMU::IsOptimizableGatherPipeWrite(u32 address) const
 {
-  if (m_power_pc.GetMemChecks().HasAny())
+  if (m_power_pc.GetMemChecks().IsPageWatched(address))
     return false;
 
   if (!m_ppc_state.msr.DR)
@@ -1314,6 +1368,10 @@ void MMU::SDRUpdated()
 
   m_ppc_state.pagetable_base = htaborg << 16;
   m_ppc_state.pagetable_hashmask = ((htabmask << 10) | 0x3ff);
+
+  // Games are expected to invalidate the TLB after moving the page table, but be conservative and
+  // drop the host mappings right away.
+  m_memory.RemoveAllPageTableMappings();
 }
 
 enum class TLBLookupResult
@@ -1379,8 +1437,8 @@ static TLBLookupResult LookupTLBPageAddress(PowerPC::PowerPCState& ppc_state,
   return TLBLookupResult::NotFound;
 }
 
-static void UpdateTLBEntry(PowerPC::PowerPCState& ppc_state, const XCheckTLBFlag flag, UPTE_Hi pte2,
-                           const u32 address)
+static void UpdateTLBEntry(PowerPC::PowerPCState& ppc_state, Memory::MemoryManager& memory,
+                           const XCheckTLBFlag flag, UPTE_Hi pte2, const u32 address)
 {
   if (IsNoExceptionFlag(flag))
     return;
@@ -1388,6 +1446,11 @@ static void UpdateTLBEntry(PowerPC::PowerPCState& ppc_state, const XCheckTLBFlag
   const u32 tag = address >> HW_PAGE_INDEX_SHIFT;
   TLBEntry& tlbe = ppc_state.tlb[IsOpcodeFlag(flag)][tag & HW_PAGE_INDEX_MASK];
   const u32 index = tlbe.recent == 0 && tlbe.tag[0] != TLBEntry::INVALID_TAG;
+
+  // Page table fastmem mappings only live as long as the data TLB entry they were created from.
+  if (!IsOpcodeFlag(flag) && tlbe.tag[index] != TLBEntry::INVALID_TAG)
+    memory.RemovePageTableMapping(tlbe.tag[index] << HW_PAGE_INDEX_SHIFT);
+
   tlbe.recent = index;
   tlbe.paddr[index] = pte2.RPN << HW_PAGE_INDEX_SHIFT;
   tlbe.pte[index] = pte2.Hex;
@@ -1398,6 +1461,12 @@ void MMU::InvalidateTLBEntry(u32 address)
 {
   const u32 entry_index = (address >> HW_PAGE_INDEX_SHIFT) & HW_PAGE_INDEX_MASK;
 
+  for (const u32 tag : m_ppc_state.tlb[0][entry_index].tag)
+  {
+    if (tag != TLBEntry::INVALID_TAG)
+      m_memory.RemovePageTableMapping(tag << HW_PAGE_INDEX_SHIFT);
+  }
+
   m_ppc_state.tlb[0][entry_index].Invalidate();
   m_ppc_state.tlb[1][entry_index].Invalidate();
 }
@@ -1488,7 +1557,7 @@ MMU::TranslateAddressResult MMU::TranslatePageAddress(const EffectiveAddress add
 
         // We already updated the TLB entry if this was caused by a C bit.
         if (res != TLBLookupResult::UpdateC)
-          UpdateTLBEntry(m_ppc_state, flag, pte2, address.Hex);
+          UpdateTLBEntry(m_ppc_state, m_memory, flag, pte2, address.Hex);
 
         *wi = (pte2.WIMG & 0b1100) != 0;
 
@@ -1647,6 +1716,47 @@ void MMU::IBATUpdated()
   m_system.GetJitInterface().ClearSafe();
 }
 
+bool MMU::HandlePageTableFastmemFault(u32 address, bool write)
+{
+  if (!m_ppc_state.msr.DR || !m_memory.IsPageTableFastmemSupported())
+    return false;
+
+  const u32 page_address = address & ~static_cast<u32>(HW_PAGE_MASK);
+
+  // Fastmem doesn't support memchecks.
+  if (m_power_pc.GetMemChecks().IsPageWatched(page_address))
+    return false;
+
+  // Translate the same way the faulting access would have, so that the R and C bits and the TLB
+  // end up in the state the slow path would have left them in. A page fault is left to the slow
+  // path, which raises the DSI.
+  const TranslateAddressResult translated_address =
+      write ? TranslateAddress<XCheckTLBFlag::Write>(address) :
+              TranslateAddress<XCheckTLBFlag::Read>(address);
+  if (translated_address.result != TranslateAddressResultEnum::PAGE_TABLE_TRANSLATED)
+    return false;
+
+  const u32 tag = address >> HW_PAGE_INDEX_SHIFT;
+  const TLBEntry& tlbe = m_ppc_state.tlb[0][tag & HW_PAGE_INDEX_MASK];
+  u32 pte_hex;
+  if (tlbe.tag[0] == tag)
+    pte_hex = tlbe.pte[0];
+  else if (tlbe.tag[1] == tag)
+    pte_hex = tlbe.pte[1];
+  else
+    return false;
+
+  // Accesses through the host mapping don't update the C bit, so pages which haven't been written
+  // to yet have to keep going through the slow path. The same goes for uncached memory, like for
+  // BATs.
+  const UPTE_Hi pte2(pte_hex);
+  if (pte2.C == 0 || (pte2.WIMG & 0b1100) != 0)
+    return false;
+
+  return m_memory.AddPageTableMapping(page_address,
+                                      translated_address.address & ~static_cast<u32>(HW_PAGE_MASK));
+}
+
 // Translate effective address using BAT or PAT.  Returns 0 if the address cannot be translated.
 // Through the hardware looks up BAT and TLB in parallel, BAT is used first if available.
 // So we first check if there is a matching BAT entry, else we look for the TLB in
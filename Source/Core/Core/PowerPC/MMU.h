@@ -207,6 +207,14 @@ public:
   HostIsInstructionRAMAddress(const Core::CPUThreadGuard& guard, u32 address,
                               RequestedAddressSpace space = RequestedAddressSpace::Effective);
 
+  // Returns a pointer to the host memory backing the HW page that contains the given address, or
+  // nullptr if reads from that page in the given address space can't be served directly from host
+  // memory (because it isn't RAM, or because the data cache is being emulated). Meant for scanning
+  // large amounts of memory without going through HostTryRead for every value.
+  static const u8*
+  HostGetRAMPagePointer(const Core::CPUThreadGuard& guard, u32 address,
+                        RequestedAddressSpace space = RequestedAddressSpace::Effective);
+
   // Routines for the CPU core to access memory.
 
   // Used by interpreter to read instructions, uses iCache
@@ -242,6 +250,12 @@ public:
   void DBATUpdated();
   void IBATUpdated();
 
+  // Called when a fastmem access with MSR.DR set faulted. If the address is translated through the
+  // page table to RAM, the page is mapped into the logical fastmem area so that the access (and
+  // later accesses to the same page) can be retried directly. The mapping is removed again when the
+  // corresponding data TLB entry is evicted or invalidated. Returns whether a mapping was added.
+  bool HandlePageTableFastmemFault(u32 address, bool write);
+
   // Result changes based on the BAT registers and MSR.DR.  Returns whether
   // it's safe to optimize a read or write to this address to an unguarded
   // memory access.  Does not consider page tables.
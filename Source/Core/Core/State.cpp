@@ -20,6 +20,7 @@
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
 #include "Common/Event.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
@@ -28,6 +29,7 @@
 #include "Common/Timer.h"
 #include "Common/Version.h"
 #include "Common/WorkQueueThread.h"
+#include "Common/ZoneProfiler.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
@@ -37,6 +39,7 @@
 #include "Core/HW/Memmap.h"
 #include "Core/HW/Wiimote.h"
 #include "Core/Host.h"
+#include "Core/IOS/FS/HostBackend/SnapshotBlobs.h"
 #include "Core/Movie.h"
 #include "Core/NetPlayClient.h"
 #include "Core/PowerPC/PowerPC.h"
@@ -77,6 +80,8 @@ struct CompressAndDumpState_args
 {
   std::vector<u8> buffer_vector;
   std::string filename;
+  // The NAND blobs which the state refers to
+  std::vector<Common::SHA1::Digest> nand_blobs;
   std::shared_ptr<Common::Event> state_write_done_event;
 };
 
@@ -96,7 +101,7 @@ static size_t s_state_writes_in_queue;
 static std::condition_variable s_state_write_queue_is_empty;
 
 // Don't forget to increase this after doing changes on the savestate system
-constexpr u32 STATE_VERSION = 162;  // Last changed in PR 11767
+constexpr u32 STATE_VERSION = 164;  // Last changed for embedding NAND contents
 
 // Maps savestate versions to Dolphin versions.
 // Versions after 42 don't need to be added to this list,
@@ -170,6 +175,8 @@ static bool DoStateVersion(PointerWrap& p, std::string* version_created_by)
 
 static void DoState(PointerWrap& p)
 {
+  PROFILE_ZONE("State::DoState");
+
   std::string version_created_by;
   if (!DoStateVersion(p, &version_created_by))
   {
@@ -274,6 +281,9 @@ void SaveToBuffer(std::vector<u8>& buffer)
         ptr = buffer.data();
         PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
         DoState(p);
+
+        // States in memory are gone by the time garbage is collected, so they aren't tracked.
+        IOS::HLE::FS::SnapshotBlobs::TakeReferences();
       },
       true);
 }
@@ -356,6 +366,8 @@ static std::map<double, int> GetSavedStates()
 
 static void CompressAndDumpState(CompressAndDumpState_args& save_args)
 {
+  PROFILE_ZONE("State::CompressAndDumpState");
+
   const u8* const buffer_data = save_args.buffer_vector.data();
   const size_t buffer_size = save_args.buffer_vector.size();
   const std::string& filename = save_args.filename;
@@ -440,9 +452,10 @@ static void CompressAndDumpState(CompressAndDumpState_args& save_args)
       {
         Core::DisplayMessage("Failed to move previous state to state undo backup", 1000);
       }
-      else if (File::Exists(dtmname))
+      else
       {
-        if (!File::Rename(dtmname, last_state_dtmname))
+        IOS::HLE::FS::SnapshotBlobs::MoveReferences(filename, last_state_filename);
+        if (File::Exists(dtmname) && !File::Rename(dtmname, last_state_dtmname))
           Core::DisplayMessage("Failed to move previous state's dtm to state undo backup", 1000);
       }
     }
@@ -456,6 +469,7 @@ static void CompressAndDumpState(CompressAndDumpState_args& save_args)
     // TODO: This should also be atomic. This is possible on all systems, but needs a special
     // implementation of IOFile on Windows.
     f.Close();
+    IOS::HLE::FS::SnapshotBlobs::RecordReferences(filename, std::move(save_args.nand_blobs));
     File::Rename(temp_filename, filename);
   }
 
@@ -489,6 +503,8 @@ void SaveAs(const std::string& filename, bool wait)
         ptr = current_buffer.data();
         PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
         DoState(p);
+        std::vector<Common::SHA1::Digest> nand_blobs =
+            IOS::HLE::FS::SnapshotBlobs::TakeReferences();
 
         if (p.IsWriteMode())
         {
@@ -499,6 +515,7 @@ void SaveAs(const std::string& filename, bool wait)
           CompressAndDumpState_args save_args;
           save_args.buffer_vector = std::move(current_buffer);
           save_args.filename = filename;
+          save_args.nand_blobs = std::move(nand_blobs);
           if (wait)
           {
             sync_event = std::make_shared<Common::Event>();
@@ -559,6 +576,8 @@ u64 GetUnixTimeOfSlot(int slot)
 
 static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_data)
 {
+  PROFILE_ZONE("State::LoadFileStateData");
+
   File::IOFile f;
 
   {
@@ -724,6 +743,9 @@ void Init()
   if (lzo_init() != LZO_E_OK)
     PanicAlertFmtT("Internal LZO Error - lzo_init() failed");
 
+  // Nothing refers to the NAND blobs of deleted savestates anymore, as no state is in memory yet.
+  IOS::HLE::FS::SnapshotBlobs::CollectGarbage();
+
   s_save_thread.Reset("Savestate Worker", [](CompressAndDumpState_args args) {
     CompressAndDumpState(args);
 
@@ -0,0 +1,308 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DiscIO/GameDigest.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Common/Align.h"
+#include "Common/ChunkFile.h"
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+#include "Common/ThreadPool.h"
+#include "DiscIO/Blob.h"
+
+namespace DiscIO
+{
+namespace
+{
+constexpr u32 CACHE_REVISION = 1;
+
+constexpr size_t SERIAL_CHUNK_SIZE = 8 * 1024 * 1024;
+constexpr u64 MIN_PARALLEL_CHUNK_SIZE = 2 * 1024 * 1024;
+
+struct CacheKey
+{
+  std::string path;
+  u64 file_size;
+  s64 write_time;
+};
+
+struct CacheEntry
+{
+  CacheKey key;
+  Common::SHA1::Digest digest;
+};
+
+std::mutex s_cache_lock;
+
+std::string GetCachePath()
+{
+  return File::GetUserPath(D_CACHE_IDX) + "gamedigest.cache";
+}
+
+void DoCacheEntries(PointerWrap& p, std::vector<CacheEntry>& entries)
+{
+  p.DoEachElement(entries, [](PointerWrap& state, CacheEntry& entry) {
+    state.Do(entry.key.path);
+    state.Do(entry.key.file_size);
+    state.Do(entry.key.write_time);
+    state.DoArray(entry.digest);
+  });
+}
+
+// Missing or outdated cache files count as empty
+std::vector<CacheEntry> ReadCache()
+{
+  std::vector<CacheEntry> entries;
+
+  File::IOFile file(GetCachePath(), "rb");
+  std::vector<u8> buffer(file ? file.GetSize() : 0);
+  if (buffer.empty() || !file.ReadBytes(buffer.data(), buffer.size()))
+    return entries;
+
+  u8* ptr = buffer.data();
+  PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
+  u32 revision = 0;
+  p.Do(revision);
+  if (revision != CACHE_REVISION)
+    return entries;
+  DoCacheEntries(p, entries);
+  if (!p.IsReadMode())
+    entries.clear();
+
+  return entries;
+}
+
+void WriteCache(std::vector<CacheEntry>& entries)
+{
+  u32 revision = CACHE_REVISION;
+
+  u8* ptr = nullptr;
+  PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+  p_measure.Do(revision);
+  DoCacheEntries(p_measure, entries);
+  const size_t buffer_size = reinterpret_cast<size_t>(ptr);
+
+  std::vector<u8> buffer(buffer_size);
+  ptr = buffer.data();
+  PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
+  p.Do(revision);
+  DoCacheEntries(p, entries);
+
+  const std::string cache_path = GetCachePath();
+  File::IOFile file(cache_path, "wb");
+  if (!file.WriteBytes(buffer.data(), buffer.size()))
+  {
+    file.Close();
+    File::Delete(cache_path);
+  }
+}
+
+// Only formats which keep all of their data in the given file can be checked for changes.
+std::optional<CacheKey> GetCacheKey(const std::string& path, const BlobReader& reader)
+{
+  switch (reader.GetBlobType())
+  {
+  case BlobType::PLAIN:
+  case BlobType::GCZ:
+  case BlobType::CISO:
+  case BlobType::TGC:
+  case BlobType::WIA:
+  case BlobType::RVZ:
+    break;
+  default:
+    return std::nullopt;
+  }
+
+  std::error_code error;
+  const auto write_time = std::filesystem::last_write_time(StringToPath(path), error);
+  if (error)
+    return std::nullopt;
+
+  return CacheKey{path, File::GetSize(path),
+                  static_cast<s64>(write_time.time_since_epoch().count())};
+}
+
+std::optional<Common::SHA1::Digest> LookUpCachedDigest(const CacheKey& key)
+{
+  std::lock_guard lk(s_cache_lock);
+
+  const std::vector<CacheEntry> entries = ReadCache();
+  const auto it = std::find_if(entries.begin(), entries.end(), [&key](const CacheEntry& entry) {
+    return entry.key.path == key.path && entry.key.file_size == key.file_size &&
+           entry.key.write_time == key.write_time;
+  });
+  if (it == entries.end())
+    return std::nullopt;
+
+  return it->digest;
+}
+
+void StoreCachedDigest(const CacheKey& key, const Common::SHA1::Digest& digest)
+{
+  std::lock_guard lk(s_cache_lock);
+
+  std::vector<CacheEntry> entries = ReadCache();
+  std::erase_if(entries, [&key](const CacheEntry& entry) { return entry.key.path == key.path; });
+  entries.push_back(CacheEntry{key, digest});
+  WriteCache(entries);
+}
+
+bool IsCompressed(BlobType blob_type)
+{
+  return blob_type == BlobType::GCZ || blob_type == BlobType::WIA || blob_type == BlobType::RVZ;
+}
+
+int GetProgress(u64 read_offset, u64 data_size)
+{
+  return static_cast<int>(static_cast<float>(read_offset) / static_cast<float>(data_size) * 100);
+}
+
+std::optional<Common::SHA1::Digest>
+ComputeDigestSerially(BlobReader& reader, const std::function<bool(int)>& report_progress)
+{
+  std::vector<u8> data(SERIAL_CHUNK_SIZE);
+  const u64 data_size = reader.GetDataSize();
+  auto ctx = Common::SHA1::CreateContext();
+
+  u64 read_offset = 0;
+  while (read_offset < data_size)
+  {
+    const size_t read_size = std::min(static_cast<u64>(data.size()), data_size - read_offset);
+    if (!reader.Read(read_offset, read_size, data.data()))
+      return std::nullopt;
+
+    ctx->Update(data.data(), read_size);
+    read_offset += read_size;
+
+    if (!report_progress(GetProgress(read_offset, data_size)))
+      return std::nullopt;
+  }
+
+  return ctx->Finish();
+}
+
+// Decompression is what makes hashing compressed images slow, so every thread gets its own reader
+// and decompresses a different chunk of a batch. The chunks of the previous batch are hashed in
+// order while the current batch is being read, which keeps the digest identical to the serial one.
+std::optional<Common::SHA1::Digest>
+ComputeDigestInParallel(const std::string& path, std::unique_ptr<BlobReader> reader,
+                        const std::function<bool(int)>& report_progress)
+{
+  const u64 data_size = reader->GetDataSize();
+  const u64 block_size = std::max<u64>(reader->GetBlockSize(), 1);
+  // Chunks cover whole blocks so that no block has to be decompressed by more than one thread
+  const u64 chunk_size = Common::AlignUp(MIN_PARALLEL_CHUNK_SIZE, block_size);
+
+  const size_t thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+  Common::ThreadPool thread_pool("Game Digest", thread_count - 1);
+  const size_t batch_size = thread_count;
+
+  std::vector<std::unique_ptr<BlobReader>> readers(thread_count);
+  readers[0] = std::move(reader);
+
+  std::array<std::vector<std::vector<u8>>, 2> batches;
+  std::array<size_t, 2> batch_chunk_counts{};
+  for (std::vector<std::vector<u8>>& batch : batches)
+    batch.resize(batch_size);
+
+  auto ctx = Common::SHA1::CreateContext();
+  std::atomic_bool read_failed = false;
+
+  const auto hash_batch = [&](size_t batch_index, u64 batch_offset) {
+    for (size_t i = 0; i < batch_chunk_counts[batch_index]; ++i)
+    {
+      const u64 offset = batch_offset + i * chunk_size;
+      ctx->Update(batches[batch_index][i].data(), std::min(chunk_size, data_size - offset));
+    }
+  };
+
+  u64 previous_batch_offset = 0;
+  size_t current = 0;
+  for (u64 batch_offset = 0; batch_offset < data_size; batch_offset += batch_size * chunk_size)
+  {
+    const size_t previous = current ^ 1;
+    const size_t chunk_count = static_cast<size_t>(
+        std::min<u64>(batch_size, (data_size - batch_offset + chunk_size - 1) / chunk_size));
+    batch_chunk_counts[current] = chunk_count;
+
+    // Item 0 hashes the previous batch, the other items each read one chunk of the current batch
+    thread_pool.ParallelFor(chunk_count + 1, [&](size_t index, size_t thread_index) {
+      if (index == 0)
+      {
+        hash_batch(previous, previous_batch_offset);
+        return;
+      }
+
+      std::unique_ptr<BlobReader>& thread_reader = readers[thread_index];
+      if (!thread_reader)
+        thread_reader = CreateBlobReader(path);
+
+      const size_t chunk_index = index - 1;
+      const u64 offset = batch_offset + chunk_index * chunk_size;
+      const u64 read_size = std::min(chunk_size, data_size - offset);
+      std::vector<u8>& buffer = batches[current][chunk_index];
+      buffer.resize(chunk_size);
+      if (!thread_reader || !thread_reader->Read(offset, read_size, buffer.data()))
+        read_failed = true;
+    });
+
+    if (read_failed)
+      return std::nullopt;
+
+    previous_batch_offset = batch_offset;
+    current = previous;
+
+    const u64 read_offset = std::min(data_size, batch_offset + batch_size * chunk_size);
+    if (!report_progress(GetProgress(read_offset, data_size)))
+      return std::nullopt;
+  }
+
+  hash_batch(current ^ 1, previous_batch_offset);
+
+  return ctx->Finish();
+}
+}  // namespace
+
+std::optional<Common::SHA1::Digest>
+ComputeGameDigest(const std::string& path, const std::function<bool(int)>& report_progress)
+{
+  std::unique_ptr<BlobReader> reader = CreateBlobReader(path);
+  if (!reader)
+    return std::nullopt;
+
+  const std::optional<CacheKey> cache_key = GetCacheKey(path, *reader);
+  if (cache_key)
+  {
+    if (const std::optional<Common::SHA1::Digest> digest = LookUpCachedDigest(*cache_key))
+    {
+      INFO_LOG_FMT(DISCIO, "Using cached digest of {}", path);
+      report_progress(100);
+      return digest;
+    }
+  }
+
+  std::optional<Common::SHA1::Digest> digest;
+  if (IsCompressed(reader->GetBlobType()))
+    digest = ComputeDigestInParallel(path, std::move(reader), report_progress);
+  else
+    digest = ComputeDigestSerially(*reader, report_progress);
+
+  if (digest && cache_key)
+    StoreCachedDigest(*cache_key, *digest);
+
+  return digest;
+}
+}  // namespace DiscIO
@@ -0,0 +1,25 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <string>
+
+#include "Common/Crypto/SHA1.h"
+
+namespace DiscIO
+{
+// Computes the SHA-1 of the data of a game as read through a BlobReader, i.e. the same digest as
+// for the uncompressed image regardless of the format it's stored in.
+//
+// Compressed images are decompressed on multiple threads. Digests of files which can be checked
+// for changes using their size and modification time are kept in the cache directory, so asking
+// for the digest of an unchanged file again is instant.
+//
+// report_progress is called with a percentage and can return false to cancel the computation.
+// Returns std::nullopt if reading the file failed or the computation was cancelled.
+std::optional<Common::SHA1::Digest>
+ComputeGameDigest(const std::string& path, const std::function<bool(int)>& report_progress);
+}  // namespace DiscIO
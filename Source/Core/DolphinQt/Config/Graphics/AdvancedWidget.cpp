@@ -160,12 +160,15 @@ void AdvancedWidget::CreateWidgets()
       // i18n: VS is short for vertex shaders.
       tr("Prefer VS for Point/Line Expansion"), Config::GFX_PREFER_VS_FOR_LINE_POINT_EXPANSION);
   m_cpu_cull = new ConfigBool(tr("Cull Vertices on the CPU"), Config::GFX_CPU_CULL);
+  m_cpu_cull_triangles =
+      new ConfigBool(tr("Cull Triangles on the CPU"), Config::GFX_CPU_CULL_TRIANGLES);
 
   misc_layout->addWidget(m_enable_cropping, 0, 0);
   misc_layout->addWidget(m_enable_prog_scan, 0, 1);
   misc_layout->addWidget(m_backend_multithreading, 1, 0);
   misc_layout->addWidget(m_prefer_vs_for_point_line_expansion, 1, 1);
   misc_layout->addWidget(m_cpu_cull, 2, 0);
+  misc_layout->addWidget(m_cpu_cull_triangles, 3, 0);
 #ifdef _WIN32
   m_borderless_fullscreen =
       new ConfigBool(tr("Borderless Fullscreen"), Config::GFX_BORDERLESS_FULLSCREEN);
@@ -375,6 +378,12 @@ void AdvancedWidget::AddDescriptions()
       QT_TR_NOOP("Cull vertices on the CPU to reduce the number of draw calls required.  "
                  "May affect performance and draw statistics.<br><br>"
                  "<dolphin_emphasis>If unsure, leave this unchecked.</dolphin_emphasis>");
+  static const char TR_CPU_CULL_TRIANGLES_DESCRIPTION[] =
+      QT_TR_NOOP("Cull individual triangles on the CPU and only send the remaining ones to the "
+                 "GPU. Triangles which face away, have no area or lie entirely outside of the "
+                 "screen are removed.<br><br>Reduces the work of the GPU at the cost of more CPU "
+                 "work. May affect performance and draw statistics.<br><br>"
+                 "<dolphin_emphasis>If unsure, leave this unchecked.</dolphin_emphasis>");
   static const char TR_DEFER_EFB_ACCESS_INVALIDATION_DESCRIPTION[] = QT_TR_NOOP(
       "Defers invalidation of the EFB access cache until a GPU synchronization command "
       "is executed. If disabled, the cache will be invalidated with every draw call. "
@@ -448,6 +457,7 @@ void AdvancedWidget::AddDescriptions()
   m_prefer_vs_for_point_line_expansion->SetDescription(
       tr(TR_PREFER_VS_FOR_POINT_LINE_EXPANSION_DESCRIPTION).arg(vsexpand_extra));
   m_cpu_cull->SetDescription(tr(TR_CPU_CULL_DESCRIPTION));
+  m_cpu_cull_triangles->SetDescription(tr(TR_CPU_CULL_TRIANGLES_DESCRIPTION));
 #ifdef _WIN32
   m_borderless_fullscreen->SetDescription(tr(TR_BORDERLESS_FULLSCREEN_DESCRIPTION));
 #endif
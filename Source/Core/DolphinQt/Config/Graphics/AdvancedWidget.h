@@ -70,6 +70,7 @@ private:
   ConfigBool* m_backend_multithreading;
   ConfigBool* m_prefer_vs_for_point_line_expansion;
   ConfigBool* m_cpu_cull;
+  ConfigBool* m_cpu_cull_triangles;
   ConfigBool* m_borderless_fullscreen;
 
   // Experimental
@@ -111,7 +111,6 @@ GameTracker::GameTracker(QObject* parent) : QFileSystemWatcher(parent)
 void GameTracker::LoadCache()
 {
   m_cache.Load();
-  m_cache_loaded_event.Set();
 }
 
 void GameTracker::Start()
@@ -122,13 +121,6 @@ void GameTracker::Start()
   m_initial_games_emitted = true;
 
   m_load_thread.EmplaceItem(Command{CommandType::Start, {}});
-
-  m_cache_loaded_event.Wait();
-
-  m_cache.ForEach(
-      [this](const std::shared_ptr<const UICommon::GameFile>& game) { emit GameLoaded(game); });
-
-  m_initial_games_emitted_event.Set();
 }
 
 void GameTracker::StartInternal()
@@ -153,7 +145,9 @@ void GameTracker::StartInternal()
   };
   const auto emit_game_removed = [this](const std::string& path) { emit GameRemoved(path); };
 
-  m_initial_games_emitted_event.Wait();
+  // Cached games are only deserialized as they're handed out, so the first ones show up in the
+  // game list without waiting for the whole cache to be read.
+  m_cache.ForEach(emit_game_loaded);
 
   bool cache_updated =
       m_cache.Update(paths, emit_game_loaded, emit_game_removed, m_processing_halted);
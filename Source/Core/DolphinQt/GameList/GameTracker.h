@@ -13,7 +13,6 @@
 #include <QString>
 #include <QVector>
 
-#include "Common/Event.h"
 #include "Common/WorkQueueThread.h"
 #include "UICommon/GameFileCache.h"
 
@@ -89,8 +88,6 @@ private:
   QVector<QString> m_tracked_paths;
   Common::WorkQueueThread<Command> m_load_thread;
   UICommon::GameFileCache m_cache;
-  Common::Event m_cache_loaded_event;
-  Common::Event m_initial_games_emitted_event;
   bool m_initial_games_emitted = false;
   bool m_started = false;
   bool m_needs_purge = false;
@@ -19,6 +19,7 @@
 #include "Common/CommonPaths.h"
 #include "Common/FileUtil.h"
 #include "Common/StringUtil.h"
+#include "Common/ZoneProfiler.h"
 
 #include "Core/Boot/Boot.h"
 #include "Core/CommonTitles.h"
@@ -142,6 +143,9 @@ void MenuBar::OnEmulationStateChanged(Core::State state)
   m_jit_clear_cache->setEnabled(running);
   m_jit_log_coverage->setEnabled(!running);
   m_jit_search_instruction->setEnabled(running);
+  m_jit_trace->setEnabled(running);
+  if (!running)
+    m_jit_trace->setChecked(false);
 
   // Symbols
   m_symbols->setEnabled(running);
@@ -218,6 +222,12 @@ void MenuBar::AddToolsMenu()
 
   tools_menu->addAction(tr("FIFO Player"), this, &MenuBar::ShowFIFOPlayer);
 
+#ifdef USE_ZONE_PROFILING
+  m_zone_trace = tools_menu->addAction(tr("Record Performance Trace..."));
+  m_zone_trace->setCheckable(true);
+  connect(m_zone_trace, &QAction::triggered, this, &MenuBar::ToggleZoneTrace);
+#endif
+
   auto* usb_device_menu = new QMenu(tr("Emulated USB Devices"), tools_menu);
   usb_device_menu->addAction(tr("&Skylanders Portal"), this, &MenuBar::ShowSkylanderPortal);
   usb_device_menu->addAction(tr("&Infinity Base"), this, &MenuBar::ShowInfinityBase);
@@ -856,6 +866,10 @@ void MenuBar::AddJITMenu()
   m_jit_search_instruction =
       m_jit->addAction(tr("Search for an Instruction"), this, &MenuBar::SearchInstruction);
 
+  m_jit_trace = m_jit->addAction(tr("Record JIT Block Trace..."));
+  m_jit_trace->setCheckable(true);
+  connect(m_jit_trace, &QAction::triggered, this, &MenuBar::ToggleJITTrace);
+
   m_jit->addSeparator();
 
   m_jit_off = m_jit->addAction(tr("JIT Off (JIT Core)"));
@@ -1723,6 +1737,65 @@ void MenuBar::LogInstructions()
   PPCTables::LogCompiledInstructions();
 }
 
+void MenuBar::ToggleJITTrace(bool enabled)
+{
+  auto& jit_interface = Core::System::GetInstance().GetJitInterface();
+  if (!enabled)
+  {
+    Core::RunAsCPUThread([&jit_interface] { jit_interface.StopTrace(); });
+    return;
+  }
+
+  const QString file = DolphinFileDialog::getSaveFileName(
+      this, tr("Save JIT block trace"), QDir::homePath(), tr("JIT Block Trace (*.djt)"));
+
+  bool started = false;
+  if (!file.isEmpty())
+  {
+    const std::string path = file.toStdString();
+    Core::RunAsCPUThread([&] { started = jit_interface.StartTrace(path); });
+    if (!started)
+    {
+      ModalMessageBox::warning(this, tr("Error"),
+                               tr("Failed to start recording a JIT block trace."));
+    }
+  }
+
+  if (!started)
+    m_jit_trace->setChecked(false);
+}
+
+#ifdef USE_ZONE_PROFILING
+void MenuBar::ToggleZoneTrace(bool enabled)
+{
+  if (!enabled)
+  {
+    if (!Common::ZoneProfiler::StopRecording())
+    {
+      ModalMessageBox::warning(this, tr("Error"), tr("Failed to write the performance trace."));
+    }
+    return;
+  }
+
+  const QString file = DolphinFileDialog::getSaveFileName(
+      this, tr("Save performance trace"), QDir::homePath(), tr("Chrome Trace (*.json)"));
+
+  bool started = false;
+  if (!file.isEmpty())
+  {
+    started = Common::ZoneProfiler::StartRecording(file.toStdString());
+    if (!started)
+    {
+      ModalMessageBox::warning(this, tr("Error"),
+                               tr("Failed to start recording a performance trace."));
+    }
+  }
+
+  if (!started)
+    m_zone_trace->setChecked(false);
+}
+#endif
+
 void MenuBar::SearchInstruction()
 {
   bool good;
@@ -158,6 +158,9 @@ private:
   void ExportWiiSaves();
   void CheckNAND();
   void NANDExtractCertificates();
+#ifdef USE_ZONE_PROFILING
+  void ToggleZoneTrace(bool enabled);
+#endif
   void ChangeDebugFont();
 
   // Debugging UI
@@ -183,6 +186,7 @@ private:
   void ClearCache();
   void LogInstructions();
   void SearchInstruction();
+  void ToggleJITTrace(bool enabled);
 
   void OnSelectionChanged(std::shared_ptr<const UICommon::GameFile> game_file);
   void OnRecordingStatusChanged(bool recording);
@@ -213,6 +217,9 @@ private:
   QAction* m_check_nand;
   QAction* m_extract_certificates;
   std::array<QAction*, 5> m_wii_remotes;
+#ifdef USE_ZONE_PROFILING
+  QAction* m_zone_trace;
+#endif
 
   // Emulation
   QAction* m_play_action;
@@ -267,6 +274,7 @@ private:
   QAction* m_jit_clear_cache;
   QAction* m_jit_log_coverage;
   QAction* m_jit_search_instruction;
+  QAction* m_jit_trace;
   QAction* m_jit_off;
   QAction* m_jit_loadstore_off;
   QAction* m_jit_loadstore_lbzx_off;
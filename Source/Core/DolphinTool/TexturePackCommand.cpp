@@ -0,0 +1,185 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/TexturePackCommand.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "Common/FileSearch.h"
+#include "Common/StringUtil.h"
+#include "Common/ThreadPool.h"
+#include "VideoCommon/Assets/CustomTextureData.h"
+#include "VideoCommon/Assets/DirectFilesystemAssetLibrary.h"
+#include "VideoCommon/Assets/TexturePackArchive.h"
+
+namespace DolphinTool
+{
+namespace
+{
+struct TextureFile
+{
+  std::string name;
+  std::string path;
+  bool has_arbitrary_mipmaps;
+};
+
+// Mipmaps are stored as separate "<texture>_mip<level>" files, which are loaded along with the
+// texture they belong to.
+bool IsMipmapFile(std::string_view filename)
+{
+  const size_t mip_index = filename.rfind("_mip");
+  if (mip_index == std::string_view::npos || mip_index + 4 == filename.size())
+    return false;
+
+  const std::string_view level = filename.substr(mip_index + 4);
+  return std::all_of(level.begin(), level.end(), [](char c) { return c >= '0' && c <= '9'; });
+}
+
+// Finds the textures of a pack the same way as Dolphin does when loading the pack directly.
+std::vector<TextureFile> FindTextureFiles(const std::string& directory)
+{
+  std::vector<TextureFile> result;
+  std::unordered_set<std::string> names;
+
+  for (const std::string& path : Common::DoFileSearch({directory}, {".png", ".dds"}, true))
+  {
+    std::string filename;
+    SplitPath(path, nullptr, &filename, nullptr);
+    if (!filename.starts_with("tex1_") || IsMipmapFile(filename))
+      continue;
+
+    const size_t arb_index = filename.rfind("_arb");
+    const bool has_arbitrary_mipmaps = arb_index != std::string::npos;
+    if (has_arbitrary_mipmaps)
+      filename.erase(arb_index, 4);
+
+    if (!names.insert(filename).second)
+    {
+      fmt::print(std::cerr, "Warning: Skipping '{}', texture {} was already added\n", path,
+                 filename);
+      continue;
+    }
+
+    result.push_back(TextureFile{std::move(filename), path, has_arbitrary_mipmaps});
+  }
+
+  return result;
+}
+}  // namespace
+
+int TexturePackCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: texpack [options]...");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to a custom texture pack DIRECTORY.")
+      .metavar("DIRECTORY");
+
+  parser.add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Path to the texture pack archive FILE to create. Dolphin loads archives with the "
+            ".dtp extension which are placed in a custom texture directory.")
+      .metavar("FILE");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  const std::string& input_directory = options["input"];
+  if (input_directory.empty())
+  {
+    fmt::print(std::cerr, "Error: No input set\n");
+    return EXIT_FAILURE;
+  }
+
+  const std::string& output_file_path = options["output"];
+  if (output_file_path.empty())
+  {
+    fmt::print(std::cerr, "Error: No output set\n");
+    return EXIT_FAILURE;
+  }
+
+  const std::vector<TextureFile> texture_files = FindTextureFiles(input_directory);
+  if (texture_files.empty())
+  {
+    fmt::print(std::cerr, "Error: No custom textures found in '{}'\n", input_directory);
+    return EXIT_FAILURE;
+  }
+
+  VideoCommon::TexturePackArchiveWriter writer;
+  if (!writer.Open(output_file_path))
+  {
+    fmt::print(std::cerr, "Error: Unable to create '{}'\n", output_file_path);
+    return EXIT_FAILURE;
+  }
+
+  auto library = std::make_shared<VideoCommon::DirectFilesystemAssetLibrary>();
+  for (const TextureFile& texture_file : texture_files)
+  {
+    library->SetAssetIDMapData(texture_file.name,
+                               std::map<std::string, std::filesystem::path>{
+                                   {"", StringToPath(texture_file.path)}});
+  }
+
+  // Decoding PNGs is by far the slowest part, so textures are decoded in parallel in batches which
+  // are then written out in order.
+  const size_t thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+  Common::ThreadPool thread_pool("Texture Pack Decoder", thread_count - 1);
+  const size_t batch_size = thread_count * 4;
+
+  size_t packed_count = 0;
+  size_t failed_count = 0;
+  std::vector<VideoCommon::CustomTextureData> batch(batch_size);
+  std::vector<size_t> bytes_loaded(batch_size);
+  for (size_t batch_start = 0; batch_start < texture_files.size(); batch_start += batch_size)
+  {
+    const size_t count = std::min(batch_size, texture_files.size() - batch_start);
+    thread_pool.ParallelFor(count, [&](size_t i, size_t) {
+      batch[i] = {};
+      // Loading as a game texture validates the mipmap chain.
+      bytes_loaded[i] =
+          library->LoadGameTexture(texture_files[batch_start + i].name, &batch[i]).m_bytes_loaded;
+    });
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      const TextureFile& texture_file = texture_files[batch_start + i];
+      if (bytes_loaded[i] == 0 ||
+          !writer.AddTexture(texture_file.name, texture_file.has_arbitrary_mipmaps, batch[i]))
+      {
+        fmt::print(std::cerr, "Warning: Unable to add '{}'\n", texture_file.path);
+        ++failed_count;
+        continue;
+      }
+      ++packed_count;
+    }
+  }
+
+  if (!writer.Finish())
+  {
+    fmt::print(std::cerr, "Error: Unable to write '{}'\n", output_file_path);
+    return EXIT_FAILURE;
+  }
+
+  fmt::print(std::cout, "Packed {} textures ({:.1f} MiB) into '{}'\n", packed_count,
+             writer.GetDataSize() / (1024.0 * 1024.0), output_file_path);
+  if (failed_count != 0)
+    fmt::print(std::cerr, "{} textures could not be added\n", failed_count);
+
+  return EXIT_SUCCESS;
+}
+}  // namespace DolphinTool
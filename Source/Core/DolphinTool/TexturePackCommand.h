@@ -0,0 +1,12 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace DolphinTool
+{
+int TexturePackCommand(const std::vector<std::string>& args);
+}  // namespace DolphinTool
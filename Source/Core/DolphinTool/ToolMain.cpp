@@ -18,13 +18,15 @@
 
 #include "DolphinTool/ConvertCommand.h"
 #include "DolphinTool/HeaderCommand.h"
+#include "DolphinTool/TexturePackCommand.h"
+#include "DolphinTool/TraceCommand.h"
 #include "DolphinTool/VerifyCommand.h"
 
 static void PrintUsage()
 {
   fmt::print(std::cerr, "usage: dolphin-tool COMMAND -h\n"
                         "\n"
-                        "commands supported: [convert, verify, header]\n");
+                        "commands supported: [convert, verify, header, trace, texpack]\n");
 }
 
 #ifdef _WIN32
@@ -51,6 +53,10 @@ int main(int argc, char* argv[])
     return DolphinTool::VerifyCommand(args);
   else if (command_str == "header")
     return DolphinTool::HeaderCommand(args);
+  else if (command_str == "trace")
+    return DolphinTool::TraceCommand(args);
+  else if (command_str == "texpack")
+    return DolphinTool::TexturePackCommand(args);
   PrintUsage();
   return EXIT_FAILURE;
 }
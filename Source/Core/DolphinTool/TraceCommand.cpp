@@ -0,0 +1,222 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/TraceCommand.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/GekkoDisassembler.h"
+#include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/JitCommon/JitTrace.h"
+
+namespace DolphinTool
+{
+namespace
+{
+using Instruction = JitTrace::Reader::Instruction;
+using Instructions = std::shared_ptr<const std::vector<Instruction>>;
+
+struct Block
+{
+  // Null if the trace didn't contain a definition for the block.
+  Instructions instructions;
+  u64 execution_count = 0;
+};
+
+// Only branches with an immediate target can be followed without knowing the register state.
+std::optional<u32> GetStaticBranchTarget(const Instruction& instruction)
+{
+  const UGeckoInstruction inst{instruction.hex};
+  const u32 base = inst.AA ? 0 : instruction.address;
+  switch (inst.OPCD)
+  {
+  case 16:  // bcx
+    return base + SignExt16(s16(inst.BD << 2));
+  case 18:  // bx
+    return base + SignExt26(inst.LI << 2);
+  default:
+    return std::nullopt;
+  }
+}
+
+// Returns how many instructions of the block were executed, given the address of the block which
+// was executed next. The trace only records block entries, so a conditional exit from the middle
+// of a block is only detected if it has an immediate target.
+size_t GetExecutedInstructionCount(const std::vector<Instruction>& instructions,
+                                   std::optional<u32> next_block)
+{
+  if (!next_block)
+    return instructions.size();
+
+  for (size_t i = 0; i + 1 < instructions.size(); ++i)
+  {
+    if (GetStaticBranchTarget(instructions[i]) == next_block &&
+        instructions[i + 1].address != *next_block)
+    {
+      return i + 1;
+    }
+  }
+  return instructions.size();
+}
+
+void PrintBlock(u32 address, const Instructions& instructions, std::optional<u32> next_block)
+{
+  if (!instructions)
+  {
+    fmt::print(std::cout, "{:08x}  <unknown block>\n", address);
+    return;
+  }
+
+  const size_t count = GetExecutedInstructionCount(*instructions, next_block);
+  for (size_t i = 0; i < count; ++i)
+  {
+    const Instruction& instruction = (*instructions)[i];
+    fmt::print(std::cout, "{:08x}  {:08x}  {}\n", instruction.address, instruction.hex,
+               Common::GekkoDisassembler::Disassemble(instruction.hex, instruction.address));
+  }
+}
+
+void PrintSummary(const std::unordered_map<u32, Block>& blocks, u64 total_executions,
+                  size_t max_blocks)
+{
+  std::vector<std::pair<u32, const Block*>> sorted;
+  sorted.reserve(blocks.size());
+  for (const auto& [address, block] : blocks)
+    sorted.emplace_back(address, &block);
+
+  std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+    return a.second->execution_count > b.second->execution_count;
+  });
+  if (sorted.size() > max_blocks)
+    sorted.resize(max_blocks);
+
+  fmt::print(std::cout, "{} blocks compiled, {} block executions\n\n", blocks.size(),
+             total_executions);
+  fmt::print(std::cout, "{:>8}  {:>12}  {:>7}  {:>6}\n", "Address", "Executions", "Share",
+             "Length");
+  for (const auto& [address, block] : sorted)
+  {
+    const double share = total_executions == 0 ?
+                             0.0 :
+                             100.0 * block->execution_count / static_cast<double>(total_executions);
+    fmt::print(std::cout, "{:08x}  {:>12}  {:>6.2f}%  {:>6}\n", address, block->execution_count,
+               share, block->instructions ? block->instructions->size() : 0);
+  }
+}
+}  // namespace
+
+int TraceCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: trace [options]...");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to a JIT block trace FILE.")
+      .metavar("FILE");
+
+  parser.add_option("-s", "--summary")
+      .action("store_true")
+      .help("Optional. Print the most frequently executed blocks instead of the instruction "
+            "stream.");
+
+  parser.add_option("-n", "--count")
+      .type("int")
+      .action("store")
+      .set_default(20)
+      .help("Optional. Number of blocks to list in the summary. [%default]")
+      .metavar("COUNT");
+
+  parser.add_option("-l", "--limit")
+      .type("int")
+      .action("store")
+      .help("Optional. Stop after this many block executions.")
+      .metavar("LIMIT");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  const std::string& input_file_path = options["input"];
+  if (input_file_path.empty())
+  {
+    fmt::print(std::cerr, "Error: No input set\n");
+    return EXIT_FAILURE;
+  }
+
+  const bool summary = options.is_set_by_user("summary");
+  const int summary_count = static_cast<int>(options.get("count"));
+  std::optional<u64> limit;
+  if (options.is_set_by_user("limit"))
+  {
+    const int limit_value = static_cast<int>(options.get("limit"));
+    if (limit_value < 0)
+    {
+      fmt::print(std::cerr, "Error: Invalid limit\n");
+      return EXIT_FAILURE;
+    }
+    limit = static_cast<u64>(limit_value);
+  }
+
+  JitTrace::Reader reader;
+  if (!reader.Open(input_file_path))
+  {
+    fmt::print(std::cerr, "Error: Unable to open JIT trace\n");
+    return EXIT_FAILURE;
+  }
+
+  std::unordered_map<u32, Block> blocks;
+  u64 total_executions = 0;
+
+  // Printing a block needs to know which block comes after it, so printing lags one entry behind.
+  // The block's instructions are kept alive in case it gets redefined in the meantime.
+  std::optional<u32> pending_address;
+  Instructions pending_instructions;
+  const auto print_pending = [&](std::optional<u32> next_block) {
+    if (pending_address && !summary)
+      PrintBlock(*pending_address, pending_instructions, next_block);
+  };
+
+  JitTrace::Reader::Entry entry;
+  while ((!limit || total_executions < *limit) && reader.ReadEntry(&entry))
+  {
+    if (entry.type == JitTrace::EntryType::BlockDefinition)
+    {
+      blocks[entry.address].instructions =
+          std::make_shared<const std::vector<Instruction>>(std::move(entry.instructions));
+      continue;
+    }
+
+    print_pending(entry.address);
+
+    Block& block = blocks[entry.address];
+    ++block.execution_count;
+    ++total_executions;
+    pending_address = entry.address;
+    pending_instructions = block.instructions;
+  }
+  print_pending(std::nullopt);
+
+  if (summary)
+    PrintSummary(blocks, total_executions, static_cast<size_t>(std::max(summary_count, 0)));
+
+  if (reader.IsCorrupted())
+  {
+    fmt::print(std::cerr, "Error: The trace is truncated or corrupted\n");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+}  // namespace DolphinTool
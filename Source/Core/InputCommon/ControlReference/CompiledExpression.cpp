@@ -0,0 +1,277 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "InputCommon/ControlReference/CompiledExpression.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "Common/Assert.h"
+#include "InputCommon/ControlReference/ExpressionParser.h"
+#include "InputCommon/ControlReference/FunctionExpression.h"
+
+namespace ciface::ExpressionParser
+{
+CompiledExpression::CompiledExpression(const Expression& expression)
+{
+  ExpressionCompiler compiler;
+  expression.Compile(compiler);
+  m_instructions = compiler.TakeInstructions();
+
+  u32 depth = 0;
+  u32 max_depth = 0;
+  for (const Instruction& instruction : m_instructions)
+  {
+    depth = depth + 1 - GetOperandCount(instruction.op);
+    max_depth = std::max(max_depth, depth);
+  }
+
+  if (max_depth > MAX_STACK_DEPTH)
+  {
+    m_instructions.clear();
+    ExpressionCompiler call_compiler;
+    call_compiler.EmitCall(expression);
+    m_instructions = call_compiler.TakeInstructions();
+  }
+}
+
+ControlState CompiledExpression::GetValue() const
+{
+  std::array<ControlState, MAX_STACK_DEPTH> stack;
+  u32 size = 0;
+
+  for (const Instruction& instruction : m_instructions)
+  {
+    switch (instruction.op)
+    {
+    case Op::Constant:
+      stack[size++] = instruction.constant;
+      break;
+    case Op::Input:
+      stack[size++] = GetInputValue(instruction.input);
+      break;
+    case Op::Variable:
+      stack[size++] = *instruction.variable;
+      break;
+    case Op::Call:
+      stack[size++] = instruction.expression->GetValue();
+      break;
+    default:
+      size -= GetOperandCount(instruction.op);
+      stack[size] = Apply(instruction.op, &stack[size]);
+      ++size;
+      break;
+    }
+  }
+
+  return stack[0];
+}
+
+u32 CompiledExpression::GetOperandCount(Op op)
+{
+  switch (op)
+  {
+  case Op::Constant:
+  case Op::Input:
+  case Op::Variable:
+  case Op::Call:
+    return 0;
+  case Op::Not:
+  case Op::Minus:
+  case Op::Abs:
+  case Op::Sin:
+  case Op::Cos:
+  case Op::Tan:
+  case Op::ASin:
+  case Op::ACos:
+  case Op::ATan:
+  case Op::Sqrt:
+    return 1;
+  case Op::Clamp:
+  case Op::If:
+    return 3;
+  default:
+    return 2;
+  }
+}
+
+// These have to match the GetValue functions of the expressions exactly, or folded constants and
+// compiled expressions would give different results than the tree.
+ControlState CompiledExpression::Apply(Op op, const ControlState* operands)
+{
+  const ControlState a = operands[0];
+  const ControlState b = GetOperandCount(op) >= 2 ? operands[1] : 0.0;
+
+  switch (op)
+  {
+  case Op::Add:
+    return a + b;
+  case Op::Sub:
+    return a - b;
+  case Op::Mul:
+    return a * b;
+  case Op::Div:
+  {
+    const ControlState result = a / b;
+    return std::isinf(result) ? 0.0 : result;
+  }
+  case Op::Mod:
+  {
+    const ControlState result = std::fmod(a, b);
+    return std::isnan(result) ? 0.0 : result;
+  }
+  case Op::Min:
+    return std::min(a, b);
+  case Op::Max:
+    return std::max(a, b);
+  case Op::LessThan:
+    return a < b;
+  case Op::GreaterThan:
+    return a > b;
+  case Op::Xor:
+    return std::max(std::min(1 - a, b), std::min(a, 1 - b));
+  case Op::Comma:
+    return b;
+  case Op::Not:
+    return 1.0 - a;
+  case Op::Minus:
+    return 0.0 - a;
+  case Op::Abs:
+    return std::abs(a);
+  case Op::Sin:
+    return std::sin(a);
+  case Op::Cos:
+    return std::cos(a);
+  case Op::Tan:
+    return std::tan(a);
+  case Op::ASin:
+    return std::asin(a);
+  case Op::ACos:
+    return std::acos(a);
+  case Op::ATan:
+    return std::atan(a);
+  case Op::ATan2:
+    return std::atan2(a, b);
+  case Op::Sqrt:
+    return std::sqrt(a);
+  case Op::Pow:
+    return std::pow(a, b);
+  case Op::Clamp:
+    return std::clamp(a, b, operands[2]);
+  case Op::If:
+    return a > CONDITION_THRESHOLD ? b : operands[2];
+  case Op::Deadzone:
+    return std::copysign(std::max(0.0, std::abs(a) - b) / (1.0 - b), a);
+  default:
+    ASSERT(false);
+    return 0.0;
+  }
+}
+
+void ExpressionCompiler::EmitConstant(ControlState value)
+{
+  Instruction& instruction = m_instructions.emplace_back();
+  instruction.op = Op::Constant;
+  instruction.constant = value;
+}
+
+void ExpressionCompiler::EmitInput(Core::Device::Input* input)
+{
+  // Unbound controls are always 0
+  if (!input)
+  {
+    EmitConstant(0.0);
+    return;
+  }
+
+  Instruction& instruction = m_instructions.emplace_back();
+  instruction.op = Op::Input;
+  instruction.input = input;
+}
+
+void ExpressionCompiler::EmitVariable(const ControlState* variable)
+{
+  if (!variable)
+  {
+    EmitConstant(0.0);
+    return;
+  }
+
+  Instruction& instruction = m_instructions.emplace_back();
+  instruction.op = Op::Variable;
+  instruction.variable = variable;
+}
+
+void ExpressionCompiler::EmitCall(const Expression& expression)
+{
+  Instruction& instruction = m_instructions.emplace_back();
+  instruction.op = Op::Call;
+  instruction.expression = &expression;
+  m_has_calls = true;
+}
+
+void ExpressionCompiler::EmitOperation(Op op, const Expression& expression,
+                                       const std::vector<const Expression*>& operands)
+{
+  DEBUG_ASSERT(operands.size() == CompiledExpression::GetOperandCount(op));
+
+  std::vector<ExpressionCompiler> compiled(operands.size());
+  bool has_calls = false;
+  bool all_constant = true;
+  size_t variable_operand_count = 0;
+  for (size_t i = 0; i < operands.size(); ++i)
+  {
+    operands[i]->Compile(compiled[i]);
+    has_calls |= compiled[i].m_has_calls;
+    if (!compiled[i].IsConstant())
+    {
+      all_constant = false;
+      ++variable_operand_count;
+    }
+  }
+
+  // The tree evaluates operands in an unspecified order, and a call can have side effects which
+  // other operands see (e.g. a hotkey suppressing an input). if() also has to skip the branch
+  // which isn't taken.
+  if (has_calls && (variable_operand_count > 1 || op == Op::If))
+  {
+    EmitCall(expression);
+    return;
+  }
+
+  if (all_constant)
+  {
+    std::array<ControlState, 3> values{};
+    for (size_t i = 0; i < compiled.size(); ++i)
+      values[i] = compiled[i].m_instructions[0].constant;
+    EmitConstant(CompiledExpression::Apply(op, values.data()));
+    return;
+  }
+
+  // The value of the left side of a comma is discarded, so it's only needed for its side effects
+  if (op == Op::Comma && !compiled[0].m_has_calls)
+    compiled.erase(compiled.begin());
+
+  for (ExpressionCompiler& operand : compiled)
+  {
+    m_instructions.insert(m_instructions.end(), operand.m_instructions.begin(),
+                          operand.m_instructions.end());
+    m_has_calls |= operand.m_has_calls;
+  }
+
+  if (op != Op::Comma || compiled.size() == 2)
+    m_instructions.emplace_back().op = op;
+}
+
+std::vector<CompiledExpression::Instruction> ExpressionCompiler::TakeInstructions()
+{
+  m_has_calls = false;
+  return std::move(m_instructions);
+}
+
+bool ExpressionCompiler::IsConstant() const
+{
+  return m_instructions.size() == 1 && m_instructions[0].op == Op::Constant;
+}
+}  // namespace ciface::ExpressionParser
@@ -0,0 +1,119 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "InputCommon/ControllerInterface/CoreDevice.h"
+
+namespace ciface::ExpressionParser
+{
+class Expression;
+
+// A flat stack program which computes the value of an Expression tree without walking it.
+// Everything which only depends on literals is folded into constants, and controls are read
+// through the input pointers found by UpdateReferences, so the program has to be compiled again
+// whenever the references of the tree are updated.
+//
+// Parts of the tree which have state or side effects (e.g. toggle(), hotkeys or assignments) are
+// kept as calls to Expression::GetValue, and evaluating those can't be reordered or skipped. The
+// result is therefore always the same as the one of the tree.
+class CompiledExpression
+{
+public:
+  enum class Op : u8
+  {
+    Constant,
+    Input,
+    Variable,
+    Call,
+
+    // Operations on the values on top of the stack, which are replaced with the result
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Mod,
+    Min,
+    Max,
+    LessThan,
+    GreaterThan,
+    Xor,
+    Comma,
+    Not,
+    Minus,
+    Abs,
+    Sin,
+    Cos,
+    Tan,
+    ASin,
+    ACos,
+    ATan,
+    ATan2,
+    Sqrt,
+    Pow,
+    Clamp,
+    If,
+    Deadzone,
+  };
+
+  struct Instruction
+  {
+    Op op;
+    union
+    {
+      ControlState constant;
+      Core::Device::Input* input;
+      const ControlState* variable;
+      const Expression* expression;
+    };
+  };
+
+  // Programs which need more stack than this just call the tree
+  static constexpr u32 MAX_STACK_DEPTH = 32;
+
+  CompiledExpression() = default;
+  explicit CompiledExpression(const Expression& expression);
+
+  ControlState GetValue() const;
+
+  bool IsEmpty() const { return m_instructions.empty(); }
+  const std::vector<Instruction>& GetInstructions() const { return m_instructions; }
+
+  static u32 GetOperandCount(Op op);
+  static ControlState Apply(Op op, const ControlState* operands);
+
+private:
+  std::vector<Instruction> m_instructions;
+};
+
+// Used by Expression::Compile to append its instructions
+class ExpressionCompiler
+{
+public:
+  using Op = CompiledExpression::Op;
+  using Instruction = CompiledExpression::Instruction;
+
+  void EmitConstant(ControlState value);
+  void EmitInput(Core::Device::Input* input);
+  void EmitVariable(const ControlState* variable);
+  // Calls expression.GetValue() when the program runs
+  void EmitCall(const Expression& expression);
+
+  // Emits op applied to the values of the operands. If the operands can't be evaluated by the
+  // program without changing the order in which side effects happen, a call to expression is
+  // emitted instead.
+  void EmitOperation(Op op, const Expression& expression,
+                     const std::vector<const Expression*>& operands);
+
+  std::vector<Instruction> TakeInstructions();
+
+private:
+  bool IsConstant() const;
+
+  std::vector<Instruction> m_instructions;
+  bool m_has_calls = false;
+};
+}  // namespace ciface::ExpressionParser
@@ -6,6 +6,7 @@
 #include <cmath>
 #include <memory>
 
+#include "InputCommon/ControlReference/CompiledExpression.h"
 #include "InputCommon/ControlReference/ExpressionParser.h"
 #include "InputCommon/ControllerInterface/CoreDevice.h"
 
@@ -47,6 +48,9 @@ protected:
   ControlReference();
   std::string m_expression;
   std::unique_ptr<ciface::ExpressionParser::Expression> m_parsed_expression;
+  // Points into m_parsed_expression and the controls it's bound to, so it has to be compiled again
+  // whenever either of them changes.
+  ciface::ExpressionParser::CompiledExpression m_compiled_expression;
   ciface::ExpressionParser::ParseStatus m_parse_status =
       ciface::ExpressionParser::ParseStatus::EmptyExpression;
 };
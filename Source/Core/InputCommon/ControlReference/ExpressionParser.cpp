@@ -18,6 +18,7 @@
 #include "Common/Common.h"
 #include "Common/StringUtil.h"
 
+#include "InputCommon/ControlReference/CompiledExpression.h"
 #include "InputCommon/ControlReference/FunctionExpression.h"
 
 namespace ciface::ExpressionParser
@@ -268,7 +269,7 @@ public:
     // FYI: Clamping values greater than 1.0 is purposely not done to support unbounded values in
     // the future. (e.g. raw accelerometer/gyro data)
 
-    return std::max(0.0, m_input->GetState());
+    return std::max(0.0, m_input->GetLatchedState());
   }
   void SetValue(ControlState value) override
   {
@@ -276,6 +277,7 @@ public:
       m_output->SetState(value);
   }
   int CountNumControls() const override { return (m_input || m_output) ? 1 : 0; }
+  void Compile(ExpressionCompiler& compiler) const override { compiler.EmitInput(m_input); }
   void UpdateReferences(ControlEnvironment& env) override
   {
     m_device = env.FindDevice(m_qualifier);
@@ -409,6 +411,44 @@ public:
     return lhs->CountNumControls() + rhs->CountNumControls();
   }
 
+  void Compile(ExpressionCompiler& compiler) const override
+  {
+    using Op = CompiledExpression::Op;
+
+    const auto emit = [&](Op compiled_op) {
+      compiler.EmitOperation(compiled_op, *this, {lhs.get(), rhs.get()});
+    };
+
+    switch (op)
+    {
+    case TOK_AND:
+      return emit(Op::Min);
+    case TOK_OR:
+      return emit(Op::Max);
+    case TOK_ADD:
+      return emit(Op::Add);
+    case TOK_SUB:
+      return emit(Op::Sub);
+    case TOK_MUL:
+      return emit(Op::Mul);
+    case TOK_DIV:
+      return emit(Op::Div);
+    case TOK_MOD:
+      return emit(Op::Mod);
+    case TOK_LTHAN:
+      return emit(Op::LessThan);
+    case TOK_GTHAN:
+      return emit(Op::GreaterThan);
+    case TOK_COMMA:
+      return emit(Op::Comma);
+    case TOK_XOR:
+      return emit(Op::Xor);
+    default:
+      // Assignments set a variable or output, which only the tree can do
+      return compiler.EmitCall(*this);
+    }
+  }
+
   void UpdateReferences(ControlEnvironment& env) override
   {
     lhs->UpdateReferences(env);
@@ -442,6 +482,8 @@ public:
 
   ControlState GetValue() const override { return m_value; }
 
+  void Compile(ExpressionCompiler& compiler) const override { compiler.EmitConstant(m_value); }
+
   std::string GetName() const override { return ValueToString(m_value); }
 
 private:
@@ -472,6 +514,11 @@ public:
 
   int CountNumControls() const override { return 1; }
 
+  void Compile(ExpressionCompiler& compiler) const override
+  {
+    compiler.EmitVariable(m_variable_ptr.get());
+  }
+
   void UpdateReferences(ControlEnvironment& env) override
   {
     m_variable_ptr = env.GetVariablePtr(m_name);
@@ -584,6 +631,10 @@ public:
   void SetValue(ControlState value) override { GetActiveChild()->SetValue(value); }
 
   int CountNumControls() const override { return GetActiveChild()->CountNumControls(); }
+  void Compile(ExpressionCompiler& compiler) const override
+  {
+    GetActiveChild()->Compile(compiler);
+  }
   void UpdateReferences(ControlEnvironment& env) override
   {
     m_lhs->UpdateReferences(env);
@@ -600,6 +651,18 @@ private:
   std::unique_ptr<Expression> m_rhs;
 };
 
+void Expression::Compile(ExpressionCompiler& compiler) const
+{
+  compiler.EmitCall(*this);
+}
+
+ControlState GetInputValue(Device::Input* input)
+{
+  if (s_hotkey_suppressions.IsSuppressed(input))
+    return 0;
+  return std::max(0.0, input->GetLatchedState());
+}
+
 std::shared_ptr<Device> ControlEnvironment::FindDevice(ControlQualifier qualifier) const
 {
   if (qualifier.has_device)
@@ -164,6 +164,8 @@ private:
   const Core::DeviceQualifier& default_device;
 };
 
+class ExpressionCompiler;
+
 class Expression
 {
 public:
@@ -172,8 +174,16 @@ public:
   virtual void SetValue(ControlState state) = 0;
   virtual int CountNumControls() const = 0;
   virtual void UpdateReferences(ControlEnvironment& finder) = 0;
+
+  // Appends instructions computing GetValue() to a CompiledExpression.
+  // By default the program calls GetValue(), which is always correct.
+  virtual void Compile(ExpressionCompiler& compiler) const;
 };
 
+// Returns the value of an input as seen by expressions, which is 0 while it's suppressed by a
+// hotkey. Used by CompiledExpression.
+ControlState GetInputValue(Core::Device::Input* input);
+
 class ParseResult
 {
 public:
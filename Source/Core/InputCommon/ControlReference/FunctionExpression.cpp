@@ -67,6 +67,11 @@ private:
 
   ControlState GetValue() const override { return 1.0 - GetArg(0).GetValue(); }
   void SetValue(ControlState value) override { GetArg(0).SetValue(1.0 - value); }
+
+  void Compile(ExpressionCompiler& compiler) const override
+  {
+    CompileOperation(compiler, CompiledExpression::Op::Not);
+  }
 };
 
 // usage: abs(expression)
@@ -83,6 +88,11 @@ private:
   }
 
   ControlState GetValue() const override { return std::abs(GetArg(0).GetValue()); }
+
+  void Compile(ExpressionCompiler& compiler) const override
+  {
+    CompileOperation(compiler, CompiledExpression::Op::Abs);
+  }
 };
 
 // usage: sin(expression)
@@ -99,6 +109,11 @@ private:
   }
 
   ControlState GetValue() const override { return std::sin(GetArg(0).GetValue()); }
+
+  void Compile(ExpressionCompiler& compiler) const override
+  {
+    CompileOperation(compiler, CompiledExpression::Op::Sin);
+  }
 };
 
 // usage: cos(expression)
@@ -115,6 +130,11 @@ private:
   }
 
   ControlState GetValue() const override { return std::cos(GetArg(0).GetValue()); }
+
+  void Compile(ExpressionCompiler& compiler) const override
+  {
+    CompileOperation(compiler, CompiledExpression::Op::Cos);
+  }
 };
 
 // usage: tan(expression)
@@ -131,6 +151,11 @@ private:
   }
 
   ControlState GetValue() const override { return std::tan(GetArg(0).GetValue()); }
+
+  void Compile(ExpressionCompiler& compiler) const override
+  {
+    CompileOperation(compiler, CompiledExpression::Op::Tan);
+  }
 };
 
 // usage: asin(expression)
@@ -147,6 +172,11 @@ private:
   }
 
   ControlState GetValue() const override { return std::asin(GetArg(0).GetValue()); }
+
+  void Compile(ExpressionCompiler& compiler) const override
+  {
+    CompileOperation(compiler, CompiledExpression::Op::ASin);
+  }
 };
 
 // usage: acos(expression)
@@ -163,6 +193,11 @@ private:
   }
 
   ControlState GetValue() const override { return std::acos(GetArg(0).GetValue()); }
+
+  void Compile(ExpressionCompiler& compiler) const override
+  {
+    CompileOperation(compiler, CompiledExpression::Op::ACos);
+  }
 };
 
 // usage: atan(expression)
@@ -179,6 +214,11 @@ private:
   }
 
   ControlState GetValue() const override { return std::atan(GetArg(0).GetValue()); }
+
+  void Compile(ExpressionCompiler& compiler) const override
+  {
+    CompileOperation(compiler, CompiledExpression::Op::ATan);
+  }
 };
 
 // usage: atan2(y, x)
@@ -198,6 +238,11 @@ private:
   {
     return std::atan2(GetArg(0).GetValue(), GetArg(1).GetValue());
   }
+
+  void Compile(ExpressionCompiler& compiler) const override
+  {
+    CompileOperation(compiler, CompiledExpression::Op::ATan2);
+  }
 };
 
 // usage: sqrt(expression)
@@ -214,6 +259,11 @@ private:
   }
 
   ControlState GetValue() const override { return std::sqrt(GetArg(0).GetValue()); }
+
+  void Compile(ExpressionCompiler& compiler) const override
+  {
+    CompileOperation(compiler, CompiledExpression::Op::Sqrt);
+  }
 };
 
 // usage: pow(base, exponent)
@@ -233,6 +283,11 @@ private:
   {
     return std::pow(GetArg(0).GetValue(), GetArg(1).GetValue());
   }
+
+  void Compile(ExpressionCompiler& compiler) const override
+  {
+    CompileOperation(compiler, CompiledExpression::Op::Pow);
+  }
 };
 
 // usage: min(a, b)
@@ -252,6 +307,11 @@ private:
   {
     return std::min(GetArg(0).GetValue(), GetArg(1).GetValue());
   }
+
+  void Compile(ExpressionCompiler& compiler) const override
+  {
+    CompileOperation(compiler, CompiledExpression::Op::Min);
+  }
 };
 
 // usage: max(a, b)
@@ -271,6 +331,11 @@ private:
   {
     return std::max(GetArg(0).GetValue(), GetArg(1).GetValue());
   }
+
+  void Compile(ExpressionCompiler& compiler) const override
+  {
+    CompileOperation(compiler, CompiledExpression::Op::Max);
+  }
 };
 
 // usage: clamp(value, min, max)
@@ -290,6 +355,11 @@ private:
   {
     return std::clamp(GetArg(0).GetValue(), GetArg(1).GetValue(), GetArg(2).GetValue());
   }
+
+  void Compile(ExpressionCompiler& compiler) const override
+  {
+    CompileOperation(compiler, CompiledExpression::Op::Clamp);
+  }
 };
 
 // usage: timer(seconds)
@@ -353,6 +423,11 @@ private:
     return (GetArg(0).GetValue() > CONDITION_THRESHOLD) ? GetArg(1).GetValue() :
                                                           GetArg(2).GetValue();
   }
+
+  void Compile(ExpressionCompiler& compiler) const override
+  {
+    CompileOperation(compiler, CompiledExpression::Op::If);
+  }
 };
 
 // usage: minus(expression)
@@ -373,6 +448,11 @@ private:
     // Subtraction for clarity:
     return 0.0 - GetArg(0).GetValue();
   }
+
+  void Compile(ExpressionCompiler& compiler) const override
+  {
+    CompileOperation(compiler, CompiledExpression::Op::Minus);
+  }
 };
 
 // usage: deadzone(input, amount)
@@ -393,6 +473,11 @@ class DeadzoneExpression : public FunctionExpression
     const ControlState deadzone = GetArg(1).GetValue();
     return std::copysign(std::max(0.0, std::abs(val) - deadzone) / (1.0 - deadzone), val);
   }
+
+  void Compile(ExpressionCompiler& compiler) const override
+  {
+    CompileOperation(compiler, CompiledExpression::Op::Deadzone);
+  }
 };
 
 // usage: smooth(input, seconds_up, seconds_down = seconds_up)
@@ -744,6 +829,17 @@ u32 FunctionExpression::GetArgCount() const
   return u32(m_args.size());
 }
 
+void FunctionExpression::CompileOperation(ExpressionCompiler& compiler,
+                                          CompiledExpression::Op op) const
+{
+  std::vector<const Expression*> operands;
+  operands.reserve(m_args.size());
+  for (auto& arg : m_args)
+    operands.push_back(arg.get());
+
+  compiler.EmitOperation(op, *this, operands);
+}
+
 void FunctionExpression::SetValue(ControlState)
 {
 }
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "InputCommon/ControlReference/CompiledExpression.h"
 #include "InputCommon/ControlReference/ExpressionParser.h"
 
 namespace ciface::ExpressionParser
@@ -45,6 +46,9 @@ protected:
   const Expression& GetArg(u32 number) const;
   u32 GetArgCount() const;
 
+  // For functions without state, which are op applied to all of the arguments
+  void CompileOperation(ExpressionCompiler& compiler, CompiledExpression::Op op) const;
+
 private:
   std::vector<std::unique_ptr<Expression>> m_args;
 };
@@ -4,9 +4,12 @@
 #include "InputCommon/ControllerInterface/ControllerInterface.h"
 
 #include <algorithm>
+#include <iterator>
+#include <vector>
 
 #include "Common/Assert.h"
 #include "Common/Logging/Log.h"
+#include "Common/Thread.h"
 #include "Core/HW/WiimoteReal/WiimoteReal.h"
 
 #ifdef CIFACE_USE_WIN32
@@ -207,6 +210,8 @@ void ControllerInterface::Shutdown()
   if (!m_is_init)
     return;
 
+  StopInputThread();
+
   // Prevent additional devices from being added during shutdown.
   m_is_init = false;
   // Additional safety measure to avoid InvokeDevicesChangedCallbacks()
@@ -260,6 +265,7 @@ void ControllerInterface::ClearDevices()
     // Devices could still be alive after this as there might be shared ptrs around holding them.
     // The InvokeDevicesChangedCallbacks() underneath should always clean all of them (it needs to).
     m_devices.clear();
+    m_snapshot_layout_changed = true;
   }
 
   InvokeDevicesChangedCallbacks();
@@ -314,6 +320,7 @@ bool ControllerInterface::AddDevice(std::shared_ptr<ciface::Core::Device> device
                        // the order on other platforms that are less tested.
                        return a->GetSortPriority() > b->GetSortPriority();
                      });
+    m_snapshot_layout_changed = true;
   }
 
   if (!m_populating_devices_counter)
@@ -344,6 +351,8 @@ void ControllerInterface::RemoveDevice(std::function<bool(const ciface::Core::De
     const size_t prev_size = m_devices.size();
     m_devices.erase(it, m_devices.end());
     any_removed = m_devices.size() != prev_size;
+    if (any_removed)
+      m_snapshot_layout_changed = true;
   }
 
   if (any_removed && (!m_populating_devices_counter || force_devices_release))
@@ -358,6 +367,10 @@ void ControllerInterface::UpdateInput()
   if (!m_is_init)
     return;
 
+  // While the input thread is running, it polls the devices and this only picks up its newest
+  // snapshot. Falls back to polling until there is one.
+  const bool use_snapshot = m_input_snapshot.Latch();
+
   // TODO: if we are an emulation input channel, we should probably always lock
   // Prefer outdated values over blocking UI or CPU thread (avoids short but noticeable frame drop)
 
@@ -373,6 +386,19 @@ void ControllerInterface::UpdateInput()
 
   std::lock_guard lk(m_devices_mutex, std::adopt_lock);
 
+  if (use_snapshot)
+  {
+    for (const auto& d : m_devices)
+      d->UpdateChannelState();
+    return;
+  }
+
+  PollDevices();
+}
+
+// Requires m_devices_population_mutex and m_devices_mutex
+void ControllerInterface::PollDevices()
+{
   for (auto& backend : m_input_backends)
     backend->UpdateInput();
 
@@ -384,6 +410,74 @@ void ControllerInterface::UpdateInput()
   }
 }
 
+// Only call from one thread at a time
+void ControllerInterface::StartInputThread(std::chrono::microseconds interval)
+{
+  if (!m_is_init || m_input_thread_running)
+    return;
+
+  m_snapshot_layout_changed = true;
+  m_input_thread_stop_event.Reset();
+  m_input_thread = std::thread(&ControllerInterface::InputThreadFunc, this, interval);
+  m_input_thread_running = true;
+}
+
+void ControllerInterface::StopInputThread()
+{
+  if (!m_input_thread_running)
+    return;
+
+  m_input_thread_stop_event.Set();
+  m_input_thread.join();
+  m_input_thread_running = false;
+
+  m_input_snapshot.Clear();
+}
+
+void ControllerInterface::InputThreadFunc(std::chrono::microseconds interval)
+{
+  Common::SetCurrentThreadName("Input polling");
+  SetCurrentInputChannel(ciface::InputChannel::Polling);
+
+  do
+  {
+    // Same as in UpdateInput(). Skipping a poll only makes the current snapshot last longer.
+    if (!m_devices_population_mutex.try_lock())
+      continue;
+
+    std::lock_guard population_lock(m_devices_population_mutex, std::adopt_lock);
+
+    if (!m_devices_mutex.try_lock())
+      continue;
+
+    std::lock_guard lk(m_devices_mutex, std::adopt_lock);
+
+    PollDevices();
+
+    if (m_snapshot_layout_changed.exchange(false))
+    {
+      std::vector<ciface::Core::Device::Input*> inputs;
+      for (const auto& d : m_devices)
+      {
+        // Relative inputs have a state per input channel, so they have to be read directly
+        std::copy_if(d->Inputs().begin(), d->Inputs().end(), std::back_inserter(inputs),
+                     [](ciface::Core::Device::Input* input) {
+                       return !dynamic_cast<ciface::Core::Device::RelativeInput*>(input);
+                     });
+      }
+      m_input_snapshot.SetLayout(inputs);
+    }
+
+    m_input_snapshot.Publish();
+  } while (!m_input_thread_stop_event.WaitFor(interval));
+}
+
+std::optional<ciface::InputSnapshotBuffer::Clock::time_point>
+ControllerInterface::GetInputSnapshotTime()
+{
+  return ciface::InputSnapshotBuffer::GetLatchedTime();
+}
+
 void ControllerInterface::SetCurrentInputChannel(ciface::InputChannel input_channel)
 {
   tls_input_channel = input_channel;
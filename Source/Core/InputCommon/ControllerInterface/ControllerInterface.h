@@ -4,15 +4,20 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <functional>
 #include <list>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <thread>
 
+#include "Common/Event.h"
 #include "Common/Matrix.h"
 #include "Common/WindowSystemInfo.h"
 #include "InputCommon/ControllerInterface/CoreDevice.h"
 #include "InputCommon/ControllerInterface/InputBackend.h"
+#include "InputCommon/ControllerInterface/InputSnapshot.h"
 
 // enable disable sources
 #ifdef _WIN32
@@ -50,6 +55,8 @@ enum class InputChannel
   SerialInterface,
   Bluetooth,
   FreeLook,
+  // Used by the input polling thread. Its per channel state is never read.
+  Polling,
   Count,
 };
 
@@ -102,6 +109,15 @@ public:
   bool IsInit() const { return m_is_init; }
   void UpdateInput();
 
+  // Moves polling the devices to a thread of their own, which publishes a snapshot of all input
+  // states every interval. UpdateInput() then only gives the calling thread the newest snapshot,
+  // so slow backends or device population don't hold up emulated controller polling.
+  void StartInputThread(std::chrono::microseconds interval);
+  void StopInputThread();
+  bool IsInputThreadRunning() const { return m_input_thread_running; }
+  // When the snapshot which the current thread reads inputs from was taken
+  static std::optional<ciface::InputSnapshotBuffer::Clock::time_point> GetInputSnapshotTime();
+
   // Set adjustment from the full render window aspect-ratio to the drawn aspect-ratio.
   // Used to fit mouse cursor inputs to the relevant region of the render window.
   void SetAspectRatioAdjustment(float);
@@ -124,6 +140,8 @@ public:
 
 private:
   void ClearDevices();
+  void InputThreadFunc(std::chrono::microseconds interval);
+  void PollDevices();
 
   std::list<std::function<void()>> m_devices_changed_callbacks;
   mutable std::recursive_mutex m_devices_population_mutex;
@@ -139,6 +157,13 @@ private:
   std::atomic<bool> m_requested_mouse_centering = false;
 
   std::vector<std::unique_ptr<ciface::InputBackend>> m_input_backends;
+
+  std::thread m_input_thread;
+  Common::Event m_input_thread_stop_event;
+  std::atomic<bool> m_input_thread_running = false;
+  // Set whenever m_devices changes, so the polling thread updates the snapshot layout
+  std::atomic<bool> m_snapshot_layout_changed = true;
+  ciface::InputSnapshotBuffer m_input_snapshot;
 };
 
 namespace ciface
@@ -14,6 +14,7 @@
 
 #include "Common/MathUtil.h"
 #include "Common/Thread.h"
+#include "InputCommon/ControllerInterface/InputSnapshot.h"
 
 namespace ciface::Core
 {
@@ -64,6 +65,14 @@ Device::~Device()
     delete output;
 }
 
+ControlState Device::Input::GetLatchedState() const
+{
+  if (const std::optional<ControlState> state = InputSnapshotBuffer::GetLatchedState(*this))
+    return *state;
+
+  return GetState();
+}
+
 std::optional<int> Device::GetPreferredId() const
 {
   return {};
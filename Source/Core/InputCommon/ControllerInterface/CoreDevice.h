@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <mutex>
@@ -34,6 +35,8 @@ constexpr int RUMBLE_LENGTH_MS = 1000 * 10;
 // I think this is better than requiring multiplication by 100 for the most common usage.
 constexpr ControlState BATTERY_INPUT_MAX_VALUE = 100.0;
 
+class InputSnapshotBuffer;
+
 namespace Core
 {
 class Device
@@ -84,12 +87,22 @@ public:
     // expression-parser or controller-emu)
     virtual ControlState GetState() const = 0;
 
+    // Returns the state of this input in the snapshot which the current thread got from the input
+    // polling thread, or GetState() if there is none.
+    ControlState GetLatchedState() const;
+
     Input* ToInput() override { return this; }
 
     // Overridden by CombinedInput,
     // so hotkey logic knows Ctrl, L_Ctrl, and R_Ctrl are the same,
     // and so input detection can return the parent name.
     virtual bool IsChild(const Input*) const { return false; }
+
+  private:
+    friend class ciface::InputSnapshotBuffer;
+
+    // Generation of the snapshot layout in the upper half, index in the lower half
+    std::atomic<u64> m_snapshot_slot = 0;
   };
 
   class RelativeInput : public Input
@@ -120,6 +133,10 @@ public:
   std::string GetQualifiedName() const;
   virtual void UpdateInput() {}
 
+  // While devices are polled by the input thread, this is called instead of UpdateInput() on the
+  // threads which read inputs. Devices which keep state per input channel update it here.
+  virtual void UpdateChannelState() {}
+
   // May be overridden to implement hotplug removal.
   // Currently handled on a per-backend basis but this could change.
   virtual bool IsValid() const { return true; }
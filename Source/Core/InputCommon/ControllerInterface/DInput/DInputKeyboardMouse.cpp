@@ -149,11 +149,9 @@ KeyboardMouse::KeyboardMouse(const LPDIRECTINPUTDEVICE8 kb_device,
   // mouse axes
   for (unsigned int i = 0; i < mouse_caps.dwAxes; ++i)
   {
-    const LONG& ax = (&m_state_in.mouse.lX)[i];
-
     // each axis gets a negative and a positive input instance associated with it
-    AddInput(new Axis(i, ax, (2 == i) ? -1 : -MOUSE_AXIS_SENSITIVITY));
-    AddInput(new Axis(i, ax, -(2 == i) ? 1 : MOUSE_AXIS_SENSITIVITY));
+    AddInput(new Axis(i, m_state_in, (2 == i) ? -1 : -MOUSE_AXIS_SENSITIVITY));
+    AddInput(new Axis(i, m_state_in, -(2 == i) ? 1 : MOUSE_AXIS_SENSITIVITY));
   }
 
   // cursor, with a hax for-loop
@@ -217,6 +215,7 @@ void KeyboardMouse::UpdateInput()
   {
     // set axes to zero
     m_state_in.mouse = {};
+    m_state_in.axis = {};
     m_state_in.relative_mouse = {};
 
     // skip this input state
@@ -236,10 +235,7 @@ void KeyboardMouse::UpdateInput()
   {
     m_state_in.relative_mouse.Move({tmp_mouse.lX, tmp_mouse.lY, tmp_mouse.lZ});
     m_state_in.relative_mouse.Update();
-
-    // need to smooth out the axes, otherwise it doesn't work for shit
-    for (unsigned int i = 0; i < 3; ++i)
-      ((&m_state_in.mouse.lX)[i] += (&tmp_mouse.lX)[i]) /= 2;
+    UpdateAxes();
 
     // copy over the buttons
     std::copy_n(tmp_mouse.rgbButtons, std::size(tmp_mouse.rgbButtons), m_state_in.mouse.rgbButtons);
@@ -256,6 +252,23 @@ void KeyboardMouse::UpdateInput()
   }
 }
 
+void KeyboardMouse::UpdateChannelState()
+{
+  // The mouse movement since this input channel's last update, which UpdateInput() does too
+  m_state_in.relative_mouse.Update();
+  UpdateAxes();
+}
+
+void KeyboardMouse::UpdateAxes()
+{
+  const Common::TVec3<LONG> delta = m_state_in.relative_mouse.GetValue();
+  Common::TVec3<LONG>& axis = m_state_in.axis[int(ControllerInterface::GetCurrentInputChannel())];
+
+  // need to smooth out the axes, otherwise it doesn't work for shit
+  for (unsigned int i = 0; i < 3; ++i)
+    (axis.data[i] += delta.data[i]) /= 2;
+}
+
 std::string KeyboardMouse::GetName() const
 {
   return "Keyboard Mouse";
@@ -317,7 +330,9 @@ ControlState KeyboardMouse::Button::GetState() const
 
 ControlState KeyboardMouse::Axis::GetState() const
 {
-  return ControlState(m_axis) / m_range;
+  const Common::TVec3<LONG>& axis =
+      m_state.axis[int(ControllerInterface::GetCurrentInputChannel())];
+  return ControlState(axis.data[m_index]) / m_range;
 }
 
 ControlState KeyboardMouse::Cursor::GetState() const
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <array>
+
 #include <windows.h>
 
 #include "Common/Matrix.h"
@@ -24,9 +26,13 @@ private:
   {
     BYTE keyboard[256]{};
 
-    // Old smoothed relative mouse movement.
+    // Mouse buttons. Its movement is kept in axis and relative_mouse instead.
     DIMOUSESTATE2 mouse{};
 
+    // Old smoothed relative mouse movement. Like relative_mouse, it's kept per input channel, as
+    // each channel reads the movement since its own last update.
+    std::array<Common::TVec3<LONG>, int(InputChannel::Count)> axis{};
+
     // Normalized mouse cursor position.
     Common::TVec2<ControlState> cursor;
 
@@ -61,16 +67,17 @@ private:
   };
 
   // Mouse movement offset axis. Includes mouse wheel
-  class Axis : public Input
+  class Axis : public RelativeInput
   {
   public:
-    Axis(u8 index, const LONG& axis, LONG range) : m_axis(axis), m_range(range), m_index(index) {}
+    Axis(u8 index, const State& state, LONG range) : m_state(state), m_range(range), m_index(index)
+    {
+    }
     std::string GetName() const override;
-    bool IsDetectable() const override { return false; }
     ControlState GetState() const override;
 
   private:
-    const LONG& m_axis;
+    const State& m_state;
     const LONG m_range;
     const u8 m_index;
   };
@@ -95,6 +102,7 @@ private:
 
 public:
   void UpdateInput() override;
+  void UpdateChannelState() override;
 
   KeyboardMouse(const LPDIRECTINPUTDEVICE8 kb_device, const LPDIRECTINPUTDEVICE8 mo_device);
   ~KeyboardMouse();
@@ -106,6 +114,7 @@ public:
 
 private:
   void UpdateCursorInput();
+  void UpdateAxes();
 
   const LPDIRECTINPUTDEVICE8 m_kb_device;
   const LPDIRECTINPUTDEVICE8 m_mo_device;
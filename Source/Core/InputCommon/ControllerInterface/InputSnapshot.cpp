@@ -0,0 +1,135 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "InputCommon/ControllerInterface/InputSnapshot.h"
+
+#include <algorithm>
+
+namespace ciface
+{
+namespace
+{
+struct LatchedSnapshot
+{
+  u32 generation = 0;
+  InputSnapshotBuffer::Clock::time_point time;
+  std::vector<ControlState> states;
+};
+
+// There is only one polling thread, so the snapshots are never mixed up between instances.
+thread_local LatchedSnapshot tls_latched;
+
+// Layout of the snapshots which are currently being published, or 0 if there are none
+std::atomic<u32> s_generation = 0;
+// Only used by the polling thread
+u32 s_last_generation = 0;
+}  // namespace
+
+InputSnapshotBuffer::InputSnapshotBuffer()
+{
+  for (Buffer& buffer : m_buffers)
+    buffer.states = std::make_unique<std::atomic<ControlState>[]>(MAX_INPUTS);
+}
+
+void InputSnapshotBuffer::SetLayout(const std::vector<Core::Device::Input*>& inputs)
+{
+  // 0 means that there are no snapshots, so it's skipped when wrapping around
+  if (++s_last_generation == 0)
+    ++s_last_generation;
+  const u32 generation = s_last_generation;
+
+  m_layout.assign(inputs.begin(), inputs.begin() + std::min<size_t>(inputs.size(), MAX_INPUTS));
+  for (u32 i = 0; i < m_layout.size(); ++i)
+    m_layout[i]->m_snapshot_slot.store(u64(generation) << 32 | i, std::memory_order_relaxed);
+
+  s_generation.store(generation, std::memory_order_relaxed);
+}
+
+void InputSnapshotBuffer::Publish()
+{
+  const s32 index = m_latest.load(std::memory_order_relaxed) == 0 ? 1 : 0;
+  Buffer& buffer = m_buffers[index];
+
+  const u32 sequence = buffer.sequence.load(std::memory_order_relaxed);
+  buffer.sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  buffer.generation.store(s_generation.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  buffer.count.store(u32(m_layout.size()), std::memory_order_relaxed);
+  buffer.time.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+  for (size_t i = 0; i < m_layout.size(); ++i)
+    buffer.states[i].store(m_layout[i]->GetState(), std::memory_order_relaxed);
+
+  buffer.sequence.store(sequence + 2, std::memory_order_release);
+  m_latest.store(index, std::memory_order_release);
+}
+
+void InputSnapshotBuffer::Clear()
+{
+  m_latest.store(-1, std::memory_order_relaxed);
+  m_layout.clear();
+  s_generation.store(0, std::memory_order_relaxed);
+}
+
+bool InputSnapshotBuffer::Latch() const
+{
+  while (true)
+  {
+    const s32 index = m_latest.load(std::memory_order_acquire);
+    if (index < 0)
+    {
+      Unlatch();
+      return false;
+    }
+
+    const Buffer& buffer = m_buffers[index];
+    const u32 sequence = buffer.sequence.load(std::memory_order_acquire);
+
+    // The polling thread has lapped this reader and is writing the buffer again
+    if (sequence & 1)
+      continue;
+
+    const u32 count = buffer.count.load(std::memory_order_relaxed);
+    tls_latched.states.resize(count);
+    for (u32 i = 0; i < count; ++i)
+      tls_latched.states[i] = buffer.states[i].load(std::memory_order_relaxed);
+    const u32 generation = buffer.generation.load(std::memory_order_relaxed);
+    const Clock::rep time = buffer.time.load(std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (buffer.sequence.load(std::memory_order_relaxed) != sequence)
+      continue;
+
+    tls_latched.generation = generation;
+    tls_latched.time = Clock::time_point(Clock::duration(time));
+    return true;
+  }
+}
+
+void InputSnapshotBuffer::Unlatch()
+{
+  tls_latched.generation = 0;
+}
+
+std::optional<InputSnapshotBuffer::Clock::time_point> InputSnapshotBuffer::GetLatchedTime()
+{
+  if (tls_latched.generation == 0)
+    return std::nullopt;
+
+  return tls_latched.time;
+}
+
+std::optional<ControlState> InputSnapshotBuffer::GetLatchedState(const Core::Device::Input& input)
+{
+  const u32 generation = tls_latched.generation;
+  if (generation == 0 || generation != s_generation.load(std::memory_order_relaxed))
+    return std::nullopt;
+
+  const u64 slot = input.m_snapshot_slot.load(std::memory_order_relaxed);
+  const u32 index = u32(slot);
+  if (u32(slot >> 32) != generation || index >= tls_latched.states.size())
+    return std::nullopt;
+
+  return tls_latched.states[index];
+}
+}  // namespace ciface
@@ -0,0 +1,68 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "InputCommon/ControllerInterface/CoreDevice.h"
+
+namespace ciface
+{
+// The states of all inputs, as published by the input polling thread.
+//
+// Publishing never waits for the threads reading the states. The polling thread takes turns
+// writing two buffers, each guarded by a sequence counter, and a reader copies the newest
+// complete one with Latch(). Until the next Latch(), all of that thread's reads through
+// Device::Input::GetLatchedState() come from its copy, so one emulated poll sees a single
+// consistent state of all devices.
+class InputSnapshotBuffer
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  // Inputs past this many are always read from their devices
+  static constexpr u32 MAX_INPUTS = 4096;
+
+  InputSnapshotBuffer();
+
+  // Only called by the polling thread, with the devices mutex held.
+  // Inputs which are left out (e.g. those of removed devices) are read from their devices again.
+  void SetLayout(const std::vector<Core::Device::Input*>& inputs);
+  void Publish();
+  // Discards all snapshots, including the ones which were already latched
+  void Clear();
+
+  // Copies the newest snapshot for the current thread. Returns false if there is none yet.
+  bool Latch() const;
+  // Makes the current thread read inputs from their devices again.
+  static void Unlatch();
+
+  // When the snapshot which the current thread latched was taken
+  static std::optional<Clock::time_point> GetLatchedTime();
+  static std::optional<ControlState> GetLatchedState(const Core::Device::Input& input);
+
+private:
+  struct Buffer
+  {
+    // Odd while the buffer is being written
+    std::atomic<u32> sequence = 0;
+    std::atomic<u32> generation = 0;
+    std::atomic<u32> count = 0;
+    std::atomic<Clock::rep> time = 0;
+    std::unique_ptr<std::atomic<ControlState>[]> states;
+  };
+
+  std::array<Buffer, 2> m_buffers;
+  // Index of the newest complete buffer, or -1 before anything was published
+  std::atomic<s32> m_latest = -1;
+
+  std::vector<Core::Device::Input*> m_layout;
+};
+}  // namespace ciface
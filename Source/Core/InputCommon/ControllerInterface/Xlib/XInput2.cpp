@@ -41,12 +41,13 @@
 // to a joystick. No real need to make this customizable.
 #define MOUSE_AXIS_SENSITIVITY 8.0f
 
-// The mouse axis controls use a weighted running average. Each frame, the new
-// value is the average of the old value and the amount of relative mouse
-// motion during that frame. The old value is weighted by a ratio of
-// MOUSE_AXIS_SMOOTHING:1 compared to the new value. Increasing
-// MOUSE_AXIS_SMOOTHING makes the controls smoother, decreasing it makes them
-// more responsive. This might be useful as a user-customizable option.
+// The mouse axis controls use a weighted running average. Each update of an
+// input channel, the new value is the average of the old value and the amount
+// of relative mouse motion since the channel's last update. The old value is
+// weighted by a ratio of MOUSE_AXIS_SMOOTHING:1 compared to the new value.
+// Increasing MOUSE_AXIS_SMOOTHING makes the controls smoother, decreasing it
+// makes them more responsive. This might be useful as a user-customizable
+// option.
 #define MOUSE_AXIS_SMOOTHING 1.5f
 
 // The scroll axis value should decay a lot faster than the mouse axes since
@@ -207,20 +208,18 @@ KeyboardMouse::KeyboardMouse(Window window, int opcode, int pointer, int keyboar
     AddInput(new Cursor(!!(i & 2), !!(i & 1), (i & 2) ? &m_state.cursor.y : &m_state.cursor.x));
 
   // Mouse Axis, X-/+, Y-/+ and Z-/+
-  AddInput(new Axis(0, false, &m_state.axis.x));
-  AddInput(new Axis(0, true, &m_state.axis.x));
-  AddInput(new Axis(1, false, &m_state.axis.y));
-  AddInput(new Axis(1, true, &m_state.axis.y));
-  AddInput(new Axis(2, false, &m_state.axis.z));
-  AddInput(new Axis(2, true, &m_state.axis.z));
+  for (u8 i = 0; i != 3; ++i)
+  {
+    AddInput(new Axis(i, false, &m_state));
+    AddInput(new Axis(i, true, &m_state));
+  }
 
   // Relative Mouse, X-/+, Y-/+ and Z-/+
-  AddInput(new RelativeMouse(0, false, &m_state.relative_mouse.x));
-  AddInput(new RelativeMouse(0, true, &m_state.relative_mouse.x));
-  AddInput(new RelativeMouse(1, false, &m_state.relative_mouse.y));
-  AddInput(new RelativeMouse(1, true, &m_state.relative_mouse.y));
-  AddInput(new RelativeMouse(2, false, &m_state.relative_mouse.z));
-  AddInput(new RelativeMouse(2, true, &m_state.relative_mouse.z));
+  for (u8 i = 0; i != 3; ++i)
+  {
+    AddInput(new RelativeMouse(i, false, &m_state.relative_mouse));
+    AddInput(new RelativeMouse(i, true, &m_state.relative_mouse));
+  }
 }
 
 KeyboardMouse::~KeyboardMouse()
@@ -348,19 +347,9 @@ void KeyboardMouse::UpdateInput()
     XFreeEventData(m_display, &event.xcookie);
   }
 
-  m_state.relative_mouse.x = delta_x;
-  m_state.relative_mouse.y = delta_y;
-  m_state.relative_mouse.z = delta_z;
-
-  // apply axis smoothing
-  m_state.axis.x *= MOUSE_AXIS_SMOOTHING;
-  m_state.axis.x += delta_x;
-  m_state.axis.x /= MOUSE_AXIS_SMOOTHING + 1.0f;
-  m_state.axis.y *= MOUSE_AXIS_SMOOTHING;
-  m_state.axis.y += delta_y;
-  m_state.axis.y /= MOUSE_AXIS_SMOOTHING + 1.0f;
-  m_state.axis.z += delta_z;
-  m_state.axis.z /= SCROLL_AXIS_DECAY;
+  m_state.relative_mouse.Move({delta_x, delta_y, delta_z});
+  m_state.relative_mouse.Update();
+  UpdateAxes();
 
   const bool should_center_mouse =
       g_controller_interface.IsMouseCenteringRequested() && Host_RendererHasFocus();
@@ -371,6 +360,30 @@ void KeyboardMouse::UpdateInput()
     XQueryKeymap(m_display, m_state.keyboard.data());
 }
 
+void KeyboardMouse::UpdateChannelState()
+{
+  // The mouse motion since this input channel's last update, which UpdateInput() does too
+  m_state.relative_mouse.Update();
+  UpdateAxes();
+}
+
+// Update the mouse axis controls of the current input channel
+void KeyboardMouse::UpdateAxes()
+{
+  const Common::Vec3 delta = m_state.relative_mouse.GetValue();
+  Common::Vec3& axis = m_state.axis[int(ControllerInterface::GetCurrentInputChannel())];
+
+  // apply axis smoothing
+  axis.x *= MOUSE_AXIS_SMOOTHING;
+  axis.x += delta.x;
+  axis.x /= MOUSE_AXIS_SMOOTHING + 1.0f;
+  axis.y *= MOUSE_AXIS_SMOOTHING;
+  axis.y += delta.y;
+  axis.y /= MOUSE_AXIS_SMOOTHING + 1.0f;
+  axis.z += delta.z;
+  axis.z /= SCROLL_AXIS_DECAY;
+}
+
 std::string KeyboardMouse::GetName() const
 {
   // This is the name string we got from the X server for this master
@@ -432,14 +445,15 @@ ControlState KeyboardMouse::Cursor::GetState() const
   return std::max(0.0f, *m_cursor / (m_positive ? 1.0f : -1.0f));
 }
 
-KeyboardMouse::Axis::Axis(u8 index, bool positive, const float* axis)
-    : m_axis(axis), m_index(index), m_positive(positive)
+KeyboardMouse::Axis::Axis(u8 index, bool positive, const State* state)
+    : m_state(state), m_index(index), m_positive(positive)
 {
   name = fmt::format("Axis {}{}", static_cast<char>('X' + m_index), (m_positive ? '+' : '-'));
 }
 
-KeyboardMouse::RelativeMouse::RelativeMouse(u8 index, bool positive, const float* axis)
-    : m_axis(axis), m_index(index), m_positive(positive)
+KeyboardMouse::RelativeMouse::RelativeMouse(u8 index, bool positive,
+                                            const RelativeMouseState* state)
+    : m_state(state), m_index(index), m_positive(positive)
 {
   name =
       fmt::format("RelativeMouse {}{}", static_cast<char>('X' + m_index), (m_positive ? '+' : '-'));
@@ -447,11 +461,14 @@ KeyboardMouse::RelativeMouse::RelativeMouse(u8 index, bool positive, const float
 
 ControlState KeyboardMouse::Axis::GetState() const
 {
-  return std::max(0.0f, *m_axis / (m_positive ? MOUSE_AXIS_SENSITIVITY : -MOUSE_AXIS_SENSITIVITY));
+  const Common::Vec3& axis = m_state->axis[int(ControllerInterface::GetCurrentInputChannel())];
+  return std::max(0.0f, axis.data[m_index] /
+                            (m_positive ? MOUSE_AXIS_SENSITIVITY : -MOUSE_AXIS_SENSITIVITY));
 }
 
 ControlState KeyboardMouse::RelativeMouse::GetState() const
 {
-  return std::max(0.0f, *m_axis / (m_positive ? MOUSE_AXIS_SENSITIVITY : -MOUSE_AXIS_SENSITIVITY));
+  return std::max(0.0f, m_state->GetValue().data[m_index] /
+                            (m_positive ? MOUSE_AXIS_SENSITIVITY : -MOUSE_AXIS_SENSITIVITY));
 }
 }  // namespace ciface::XInput2
@@ -21,6 +21,8 @@ namespace ciface::XInput2
 {
 void PopulateDevices(void* const hwnd);
 
+using RelativeMouseState = RelativeInputState<Common::Vec3>;
+
 class KeyboardMouse : public Core::Device
 {
 private:
@@ -29,8 +31,10 @@ private:
     std::array<char, 32> keyboard;
     u32 buttons;
     Common::Vec2 cursor;
-    Common::Vec3 axis;
-    Common::Vec3 relative_mouse;
+    // Smoothed relative mouse motion. Like relative_mouse, it's kept per input channel, as each
+    // channel reads the motion since its own last update.
+    std::array<Common::Vec3, int(InputChannel::Count)> axis;
+    RelativeMouseState relative_mouse;
   };
 
   class Key : public Input
@@ -77,31 +81,29 @@ private:
     std::string name;
   };
 
-  class Axis : public Input
+  class Axis : public RelativeInput
   {
   public:
     std::string GetName() const override { return name; }
-    bool IsDetectable() const override { return false; }
-    Axis(u8 index, bool positive, const float* axis);
+    Axis(u8 index, bool positive, const State* state);
     ControlState GetState() const override;
 
   private:
-    const float* m_axis;
+    const State* m_state;
     const u8 m_index;
     const bool m_positive;
     std::string name;
   };
 
-  class RelativeMouse : public Input
+  class RelativeMouse : public RelativeInput
   {
   public:
     std::string GetName() const override { return name; }
-    bool IsDetectable() const override { return false; }
-    RelativeMouse(u8 index, bool positive, const float* axis);
+    RelativeMouse(u8 index, bool positive, const RelativeMouseState* state);
     ControlState GetState() const override;
 
   private:
-    const float* m_axis;
+    const RelativeMouseState* m_state;
     const u8 m_index;
     const bool m_positive;
     std::string name;
@@ -109,9 +111,11 @@ private:
 
 private:
   void UpdateCursor(bool should_center_mouse);
+  void UpdateAxes();
 
 public:
   void UpdateInput() override;
+  void UpdateChannelState() override;
 
   KeyboardMouse(Window window, int opcode, int pointer_deviceid, int keyboard_deviceid,
                 double scroll_increment);
@@ -10,6 +10,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -19,6 +20,8 @@
 #include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/ThreadPool.h"
 
 #include "DiscIO/DirectoryBlob.h"
 
@@ -26,7 +29,25 @@
 
 namespace UICommon
 {
-static constexpr u32 CACHE_REVISION = 24;  // Last changed in PR 11557
+static constexpr u32 CACHE_MAGIC = 0x434C4744;  // "DGLC"
+static constexpr u32 CACHE_REVISION = 25;
+
+// Opening games is mostly waiting for I/O, especially on network storage, so this many are
+// scanned at the same time regardless of the number of cores.
+static constexpr size_t SCAN_THREAD_COUNT = 8;
+// New games are handed to the caller after each batch, which keeps the game list updating while
+// a large library is being scanned.
+static constexpr size_t SCAN_BATCH_SIZE = SCAN_THREAD_COUNT * 4;
+
+// The cache file starts with this header, which is followed by the index (the path of each entry
+// and where its data is) and then the data of the entries, each serialized on its own. This way,
+// loading the cache only has to read the index, and entries are read and deserialized separately.
+struct CacheHeader
+{
+  u32 magic;
+  u32 revision;
+  u64 index_size;
+};
 
 std::vector<std::string> FindAllGamePaths(const std::vector<std::string>& directories_to_scan,
                                           bool recursive_scan)
@@ -43,19 +64,36 @@ GameFileCache::GameFileCache() : m_path(File::GetUserPath(D_CACHE_IDX) + "gameli
 {
 }
 
-void GameFileCache::ForEach(std::function<void(const std::shared_ptr<const GameFile>&)> f) const
+void GameFileCache::ForEach(std::function<void(const std::shared_ptr<const GameFile>&)> f)
 {
-  for (const std::shared_ptr<GameFile>& item : m_cached_files)
-    f(item);
+  bool dropped_entries = false;
+  for (CachedFile& item : m_cached_files)
+  {
+    if (!item.file)
+      item.file = LoadEntry(item);
+
+    if (item.file)
+      f(item.file);
+    else
+      dropped_entries = true;
+  }
+
+  if (dropped_entries)
+    std::erase_if(m_cached_files, [](const CachedFile& entry) { return !entry.file; });
 }
 
-size_t GameFileCache::GetSize() const
+size_t GameFileCache::GetSize()
 {
+  // Entries which can't be loaded are dropped, so they mustn't be counted
+  LoadAllEntries();
   return m_cached_files.size();
 }
 
 void GameFileCache::Clear(DeleteOnDisk delete_on_disk)
 {
+  std::lock_guard lk(m_cache_file_lock);
+  m_cache_file.Close();
+
   if (delete_on_disk != DeleteOnDisk::No)
     File::Delete(m_path);
 
@@ -65,18 +103,28 @@ void GameFileCache::Clear(DeleteOnDisk delete_on_disk)
 std::shared_ptr<const GameFile> GameFileCache::AddOrGet(const std::string& path,
                                                         bool* cache_changed)
 {
-  auto it = std::find_if(
-      m_cached_files.begin(), m_cached_files.end(),
-      [&path](const std::shared_ptr<GameFile>& file) { return file->GetFilePath() == path; });
-  const bool found = it != m_cached_files.cend();
+  auto it = std::find_if(m_cached_files.begin(), m_cached_files.end(),
+                         [&path](const CachedFile& entry) { return entry.path == path; });
+  if (it != m_cached_files.end() && !it->file)
+  {
+    it->file = LoadEntry(*it);
+    if (!it->file)
+    {
+      m_cached_files.erase(it);
+      it = m_cached_files.end();
+      *cache_changed = true;
+    }
+  }
+
+  const bool found = it != m_cached_files.end();
   if (!found)
   {
     std::shared_ptr<UICommon::GameFile> game = std::make_shared<GameFile>(path);
     if (!game->IsValid())
       return nullptr;
-    m_cached_files.emplace_back(std::move(game));
+    m_cached_files.push_back(CachedFile{path, std::move(game)});
   }
-  std::shared_ptr<GameFile>& result = found ? *it : m_cached_files.back();
+  std::shared_ptr<GameFile>& result = found ? it->file : m_cached_files.back().file;
   if (UpdateAdditionalMetadata(&result) || !found)
     *cache_changed = true;
 
@@ -113,14 +161,14 @@ bool GameFileCache::Update(
       if (processing_halted)
         break;
 
-      if (game_paths.erase((*it)->GetFilePath()))
+      if (game_paths.erase(it->path))
       {
         ++it;
       }
       else
       {
         if (game_removed_from_cache)
-          game_removed_from_cache((*it)->GetFilePath());
+          game_removed_from_cache(it->path);
 
         cache_changed = true;
         --end;
@@ -132,19 +180,35 @@ bool GameFileCache::Update(
 
   // Now that the previous loop has run, game_paths only contains paths that
   // aren't in m_cached_files, so we simply add all of them to m_cached_files.
-  for (const std::string& path : game_paths)
+  const std::vector<std::string> new_paths(game_paths.begin(), game_paths.end());
+  if (new_paths.empty())
+    return cache_changed;
+
+  Common::ThreadPool thread_pool("Game List Scanner",
+                                 std::min(SCAN_THREAD_COUNT, new_paths.size()) - 1);
+  std::vector<std::shared_ptr<GameFile>> batch(SCAN_BATCH_SIZE);
+  for (size_t batch_start = 0; batch_start < new_paths.size(); batch_start += SCAN_BATCH_SIZE)
   {
     if (processing_halted)
       break;
 
-    auto file = std::make_shared<GameFile>(path);
-    if (file->IsValid())
+    const size_t count = std::min(SCAN_BATCH_SIZE, new_paths.size() - batch_start);
+    thread_pool.ParallelFor(count, [&](size_t i, size_t) {
+      if (!processing_halted)
+        batch[i] = std::make_shared<GameFile>(new_paths[batch_start + i]);
+    });
+
+    for (size_t i = 0; i < count; ++i)
     {
+      std::shared_ptr<GameFile> file = std::move(batch[i]);
+      if (!file || !file->IsValid())
+        continue;
+
       if (game_added_to_cache)
         game_added_to_cache(file);
 
       cache_changed = true;
-      m_cached_files.push_back(std::move(file));
+      m_cached_files.push_back(CachedFile{file->GetFilePath(), std::move(file)});
     }
   }
 
@@ -155,17 +219,19 @@ bool GameFileCache::UpdateAdditionalMetadata(
     std::function<void(const std::shared_ptr<const GameFile>&)> game_updated,
     const std::atomic_bool& processing_halted)
 {
+  LoadAllEntries();
+
   bool cache_changed = false;
 
-  for (std::shared_ptr<GameFile>& file : m_cached_files)
+  for (CachedFile& entry : m_cached_files)
   {
     if (processing_halted)
       break;
 
-    const bool updated = UpdateAdditionalMetadata(&file);
+    const bool updated = UpdateAdditionalMetadata(&entry.file);
     cache_changed |= updated;
     if (game_updated && updated)
-      game_updated(file);
+      game_updated(entry.file);
   }
 
   return cache_changed;
@@ -210,79 +276,215 @@ bool GameFileCache::UpdateAdditionalMetadata(std::shared_ptr<GameFile>* game_fil
 
 bool GameFileCache::Load()
 {
-  return SyncCacheFile(false);
+  std::lock_guard lk(m_cache_file_lock);
+
+  m_cached_files.clear();
+  m_cache_file.Open(m_path, "rb");
+  if (!m_cache_file)
+    return false;
+
+  if (!ReadCacheFile())
+  {
+    // The cache is probably corrupted or from an older version, so start over
+    m_cached_files.clear();
+    m_cache_file.Close();
+    File::Delete(m_path);
+    return false;
+  }
+
+  return true;
 }
 
 bool GameFileCache::Save()
 {
-  return SyncCacheFile(true);
+  std::lock_guard lk(m_cache_file_lock);
+
+  if (!WriteCacheFile())
+  {
+    File::Delete(m_path + ".tmp");
+    return false;
+  }
+
+  return true;
 }
 
-bool GameFileCache::SyncCacheFile(bool save)
+void GameFileCache::DoIndexState(PointerWrap& p, std::vector<CachedFile>* entries)
 {
-  const char* open_mode = save ? "wb" : "rb";
-  File::IOFile f(m_path, open_mode);
-  if (!f)
+  p.DoEachElement(*entries, [](PointerWrap& state, CachedFile& entry) {
+    state.Do(entry.path);
+    state.Do(entry.data_offset);
+    state.Do(entry.data_size);
+  });
+}
+
+bool GameFileCache::ReadCacheFile()
+{
+  CacheHeader header;
+  if (!m_cache_file.ReadArray(&header, 1) || header.magic != CACHE_MAGIC ||
+      header.revision != CACHE_REVISION)
+  {
+    return false;
+  }
+
+  const u64 file_size = m_cache_file.GetSize();
+  if (header.index_size == 0 || header.index_size > file_size - sizeof(CacheHeader))
+    return false;
+
+  std::vector<u8> index(header.index_size);
+  if (!m_cache_file.ReadBytes(index.data(), index.size()))
+    return false;
+
+  u8* ptr = index.data();
+  PointerWrap p(&ptr, index.size(), PointerWrap::Mode::Read);
+  DoIndexState(p, &m_cached_files);
+  if (!p.IsReadMode())
     return false;
-  bool success = false;
-  if (save)
+
+  // Entries whose data isn't within the file are dropped, the others are still usable
+  const u64 data_start = sizeof(CacheHeader) + header.index_size;
+  std::erase_if(m_cached_files, [&](const CachedFile& entry) {
+    return entry.data_offset < data_start || entry.data_offset > file_size ||
+           entry.data_size == 0 || entry.data_size > file_size - entry.data_offset;
+  });
+
+  return true;
+}
+
+bool GameFileCache::WriteCacheFile()
+{
+  const std::string temp_path = m_path + ".tmp";
+  File::IOFile file(temp_path, "wb");
+  if (!file)
+    return false;
+
+  // Entries which haven't been deserialized are copied as is from the current cache file
+  std::vector<CachedFile> new_entries(m_cached_files.size());
+  for (size_t i = 0; i < m_cached_files.size(); ++i)
+  {
+    new_entries[i].path = m_cached_files[i].path;
+    new_entries[i].data_size = m_cached_files[i].data_size;
+    if (m_cached_files[i].file)
+    {
+      u8* ptr = nullptr;
+      PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+      m_cached_files[i].file->DoState(p_measure);
+      new_entries[i].data_size = reinterpret_cast<size_t>(ptr);
+    }
+  }
+
+  // The size of the index doesn't depend on the offsets, so they can be filled in after this
+  u8* ptr = nullptr;
+  PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+  DoIndexState(p_measure, &new_entries);
+  const CacheHeader header{CACHE_MAGIC, CACHE_REVISION, reinterpret_cast<size_t>(ptr)};
+
+  u64 data_offset = sizeof(CacheHeader) + header.index_size;
+  for (CachedFile& entry : new_entries)
   {
-    // Measure the size of the buffer.
-    u8* ptr = nullptr;
-    PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
-    DoState(&p_measure);
-    const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-
-    // Then actually do the write.
-    std::vector<u8> buffer(buffer_size);
-    ptr = buffer.data();
-    PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
-    DoState(&p, buffer_size);
-    if (f.WriteBytes(buffer.data(), buffer.size()))
-      success = true;
+    entry.data_offset = data_offset;
+    data_offset += entry.data_size;
   }
-  else
+
+  std::vector<u8> buffer(header.index_size);
+  ptr = buffer.data();
+  PointerWrap p_index(&ptr, buffer.size(), PointerWrap::Mode::Write);
+  DoIndexState(p_index, &new_entries);
+  if (!file.WriteArray(&header, 1) || !file.WriteBytes(buffer.data(), buffer.size()))
+    return false;
+
+  for (size_t i = 0; i < m_cached_files.size(); ++i)
   {
-    std::vector<u8> buffer(f.GetSize());
-    if (!buffer.empty() && f.ReadBytes(buffer.data(), buffer.size()))
+    if (m_cached_files[i].file)
     {
-      u8* ptr = buffer.data();
-      PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
-      DoState(&p, buffer.size());
-      if (p.IsReadMode())
-        success = true;
+      buffer.resize(new_entries[i].data_size);
+      ptr = buffer.data();
+      PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Write);
+      m_cached_files[i].file->DoState(p);
     }
+    else if (!ReadEntryData(m_cached_files[i], &buffer))
+    {
+      return false;
+    }
+
+    if (!file.WriteBytes(buffer.data(), buffer.size()))
+      return false;
   }
-  if (!success)
+
+  if (!file.Close())
+    return false;
+
+  m_cache_file.Close();
+  const bool renamed = File::Rename(temp_path, m_path);
+  m_cache_file.Open(m_path, "rb");
+  if (!renamed)
+    return false;
+
+  for (size_t i = 0; i < m_cached_files.size(); ++i)
   {
-    // If some file operation failed, try to delete the probably-corrupted cache
-    f.Close();
-    File::Delete(m_path);
+    m_cached_files[i].data_offset = new_entries[i].data_offset;
+    m_cached_files[i].data_size = new_entries[i].data_size;
   }
-  return success;
+
+  return true;
 }
 
-void GameFileCache::DoState(PointerWrap* p, u64 size)
+void GameFileCache::LoadAllEntries()
 {
-  struct
-  {
-    u32 revision;
-    u64 expected_size;
-  } header = {CACHE_REVISION, size};
-  p->Do(header);
-  if (p->IsReadMode())
+  std::vector<size_t> unloaded_entries;
+  for (size_t i = 0; i < m_cached_files.size(); ++i)
   {
-    if (header.revision != CACHE_REVISION || header.expected_size != size)
-    {
-      p->SetMeasureMode();
-      return;
-    }
+    if (!m_cached_files[i].file)
+      unloaded_entries.push_back(i);
   }
-  p->DoEachElement(m_cached_files, [](PointerWrap& state, std::shared_ptr<GameFile>& elem) {
-    if (state.IsReadMode())
-      elem = std::make_shared<GameFile>();
-    elem->DoState(state);
+
+  if (unloaded_entries.empty())
+    return;
+
+  const size_t thread_count =
+      std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), unloaded_entries.size());
+  Common::ThreadPool thread_pool("Game List Cache Loader", thread_count - 1);
+  thread_pool.ParallelFor(unloaded_entries.size(), [&](size_t i, size_t) {
+    CachedFile& entry = m_cached_files[unloaded_entries[i]];
+    entry.file = LoadEntry(entry);
   });
+
+  std::erase_if(m_cached_files, [](const CachedFile& entry) { return !entry.file; });
+}
+
+std::shared_ptr<GameFile> GameFileCache::LoadEntry(const CachedFile& entry)
+{
+  std::vector<u8> data;
+  {
+    std::lock_guard lk(m_cache_file_lock);
+    if (!ReadEntryData(entry, &data))
+      return nullptr;
+  }
+
+  u8* ptr = data.data();
+  PointerWrap p(&ptr, data.size(), PointerWrap::Mode::Read);
+  auto file = std::make_shared<GameFile>();
+  file->DoState(p);
+  if (!p.IsReadMode() || file->GetFilePath() != entry.path)
+  {
+    WARN_LOG_FMT(COMMON, "Dropping corrupted game list cache entry of {}", entry.path);
+    return nullptr;
+  }
+
+  return file;
+}
+
+// m_cache_file_lock must be held while calling this
+bool GameFileCache::ReadEntryData(const CachedFile& entry, std::vector<u8>* data)
+{
+  data->resize(entry.data_size);
+  if (!m_cache_file.Seek(entry.data_offset, File::SeekOrigin::Begin) ||
+      !m_cache_file.ReadBytes(data->data(), data->size()))
+  {
+    m_cache_file.ClearError();
+    return false;
+  }
+
+  return true;
 }
 
 }  // namespace UICommon
@@ -7,10 +7,12 @@
 #include <cstddef>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
 
 class PointerWrap;
 
@@ -32,9 +34,13 @@ public:
 
   GameFileCache();
 
-  void ForEach(std::function<void(const std::shared_ptr<const GameFile>&)> f) const;
+  // Deserializes each entry which hasn't been yet right before handing it to f, so the first
+  // entries are handed out without waiting for the rest of the cache. Entries which fail to load
+  // are dropped.
+  void ForEach(std::function<void(const std::shared_ptr<const GameFile>&)> f);
+  // Entries which fail to load aren't counted, so this deserializes every entry.
+  size_t GetSize();
 
-  size_t GetSize() const;
   void Clear(DeleteOnDisk delete_on_disk);
 
   // Returns nullptr if the file is invalid.
@@ -49,17 +55,38 @@ public:
       std::function<void(const std::shared_ptr<const GameFile>&)> game_updated = {},
       const std::atomic_bool& processing_halted = false);
 
+  // Load only reads the index of the cache file, entries are deserialized once they're needed.
   bool Load();
   bool Save();
 
 private:
+  // Entries which were loaded from the cache file are only deserialized once they're needed,
+  // until then just their path and where their data is in the cache file are known.
+  struct CachedFile
+  {
+    std::string path;
+    std::shared_ptr<GameFile> file;
+    u64 data_offset = 0;
+    u64 data_size = 0;
+  };
+
   bool UpdateAdditionalMetadata(std::shared_ptr<GameFile>* game_file);
 
-  bool SyncCacheFile(bool save);
-  void DoState(PointerWrap* p, u64 size = 0);
+  // Deserializes all entries which haven't been yet. Entries which fail to load are dropped.
+  void LoadAllEntries();
+  std::shared_ptr<GameFile> LoadEntry(const CachedFile& entry);
+  bool ReadEntryData(const CachedFile& entry, std::vector<u8>* data);
+
+  bool ReadCacheFile();
+  bool WriteCacheFile();
+  static void DoIndexState(PointerWrap& p, std::vector<CachedFile>* entries);
 
   std::string m_path;
-  std::vector<std::shared_ptr<GameFile>> m_cached_files;
+  std::vector<CachedFile> m_cached_files;
+
+  // The cache file which the entries that haven't been deserialized yet are read from
+  File::IOFile m_cache_file;
+  std::mutex m_cache_file_lock;
 };
 
 }  // namespace UICommon
@@ -3,6 +3,7 @@
 
 #include "VideoBackends/D3D/D3DVertexManager.h"
 
+#include <cstring>
 #include <d3d11.h>
 
 #include "Common/Align.h"
@@ -29,11 +30,12 @@
 
 namespace DX11
 {
-static ComPtr<ID3D11Buffer> AllocateConstantBuffer(u32 size)
+static ComPtr<ID3D11Buffer> AllocateConstantBuffer(u32 size, bool dynamic)
 {
   const u32 cbsize = Common::AlignUp(size, 16u);  // must be a multiple of 16
-  const CD3D11_BUFFER_DESC cbdesc(cbsize, D3D11_BIND_CONSTANT_BUFFER, D3D11_USAGE_DYNAMIC,
-                                  D3D11_CPU_ACCESS_WRITE);
+  const CD3D11_BUFFER_DESC cbdesc(cbsize, D3D11_BIND_CONSTANT_BUFFER,
+                                  dynamic ? D3D11_USAGE_DYNAMIC : D3D11_USAGE_DEFAULT,
+                                  dynamic ? D3D11_CPU_ACCESS_WRITE : 0);
   ComPtr<ID3D11Buffer> cbuf;
   const HRESULT hr = D3D::device->CreateBuffer(&cbdesc, nullptr, &cbuf);
   ASSERT_MSG(VIDEO, SUCCEEDED(hr), "Failed to create shader constant buffer (size={}): {}", cbsize,
@@ -55,6 +57,21 @@ static void UpdateConstantBuffer(ID3D11Buffer* const buffer, const void* data, u
   ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, data_size);
 }
 
+static bool SupportsPartialConstantBufferUpdates()
+{
+  if (!D3D::device1)
+    return false;
+
+  D3D11_FEATURE_DATA_D3D11_OPTIONS options{};
+  if (FAILED(D3D::device1->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options,
+                                               sizeof(options))))
+  {
+    return false;
+  }
+
+  return options.ConstantBufferPartialUpdate != FALSE;
+}
+
 static ComPtr<ID3D11ShaderResourceView>
 CreateTexelBufferView(ID3D11Buffer* buffer, TexelBufferFormat format, DXGI_FORMAT srv_format)
 {
@@ -88,9 +105,17 @@ bool VertexManager::Initialize()
       D3DCommon::SetDebugObjectName(m_buffers[i].Get(), "Buffer of VertexManager");
   }
 
-  m_vertex_constant_buffer = AllocateConstantBuffer(sizeof(VertexShaderConstants));
-  m_geometry_constant_buffer = AllocateConstantBuffer(sizeof(GeometryShaderConstants));
-  m_pixel_constant_buffer = AllocateConstantBuffer(sizeof(PixelShaderConstants));
+  // With partial updates, the driver copies only the ranges which changed into the buffers.
+  // Otherwise the buffers are dynamic and rewritten completely.
+  if (!SupportsPartialConstantBufferUpdates() || FAILED(D3D::context.As(&m_context1)))
+    m_context1.Reset();
+  const bool dynamic_constant_buffers = !m_context1;
+  m_vertex_constant_buffer =
+      AllocateConstantBuffer(sizeof(VertexShaderConstants), dynamic_constant_buffers);
+  m_geometry_constant_buffer =
+      AllocateConstantBuffer(sizeof(GeometryShaderConstants), dynamic_constant_buffers);
+  m_pixel_constant_buffer =
+      AllocateConstantBuffer(sizeof(PixelShaderConstants), dynamic_constant_buffers);
   if (!m_vertex_constant_buffer || !m_geometry_constant_buffer || !m_pixel_constant_buffer)
     return false;
 
@@ -123,7 +148,7 @@ void VertexManager::UploadUtilityUniforms(const void* uniforms, u32 uniforms_siz
 {
   // Just use the one buffer for all three.
   InvalidateConstants();
-  UpdateConstantBuffer(m_vertex_constant_buffer.Get(), uniforms, uniforms_size);
+  WriteConstantBuffer(m_vertex_constant_buffer.Get(), uniforms, uniforms_size);
   D3D::stateman->SetVertexConstants(m_vertex_constant_buffer.Get());
   D3D::stateman->SetGeometryConstants(m_vertex_constant_buffer.Get());
   D3D::stateman->SetPixelConstants(m_vertex_constant_buffer.Get());
@@ -260,33 +285,65 @@ void VertexManager::CommitBuffer(u32 num_vertices, u32 vertex_stride, u32 num_in
   D3D::stateman->SetIndexBuffer(m_buffers[m_current_buffer].Get());
 }
 
-void VertexManager::UploadUniforms()
+void VertexManager::WriteConstantBuffer(ID3D11Buffer* buffer, const void* data, u32 data_size)
 {
-  auto& system = Core::System::GetInstance();
+  if (!m_context1)
+  {
+    UpdateConstantBuffer(buffer, data, data_size);
+    return;
+  }
 
-  auto& vertex_shader_manager = system.GetVertexShaderManager();
-  if (vertex_shader_manager.dirty)
+  // The copied box has to cover whole rows of 16 bytes
+  const u32 aligned_size = Common::AlignUp(data_size, 16u);
+  if (aligned_size != data_size)
   {
-    UpdateConstantBuffer(m_vertex_constant_buffer.Get(), &vertex_shader_manager.constants,
-                         sizeof(VertexShaderConstants));
-    vertex_shader_manager.dirty = false;
+    m_constant_staging_buffer.assign(aligned_size, 0);
+    std::memcpy(m_constant_staging_buffer.data(), data, data_size);
+    data = m_constant_staging_buffer.data();
   }
 
-  auto& geometry_shader_manager = system.GetGeometryShaderManager();
-  if (geometry_shader_manager.dirty)
+  const D3D11_BOX box = {0, 0, 0, aligned_size, 1, 1};
+  m_context1->UpdateSubresource1(buffer, 0, &box, data, 0, 0, D3D11_COPY_DISCARD);
+  ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, data_size);
+}
+
+void VertexManager::UpdateConstantBufferRanges(ID3D11Buffer* buffer, const void* data,
+                                               u32 data_size,
+                                               std::span<const ConstantBufferRange> ranges)
+{
+  if (ranges.empty())
+    return;
+
+  // Every partial update is a separate copy for the driver, so a lot of small ranges are better
+  // written at once.
+  if (!m_context1 || ranges.size() > MAX_PARTIAL_CONSTANT_BUFFER_UPDATES)
   {
-    UpdateConstantBuffer(m_geometry_constant_buffer.Get(), &geometry_shader_manager.constants,
-                         sizeof(GeometryShaderConstants));
-    geometry_shader_manager.dirty = false;
+    WriteConstantBuffer(buffer, data, data_size);
+    return;
   }
 
-  auto& pixel_shader_manager = system.GetPixelShaderManager();
-  if (pixel_shader_manager.dirty)
+  for (const ConstantBufferRange& range : ranges)
   {
-    UpdateConstantBuffer(m_pixel_constant_buffer.Get(), &pixel_shader_manager.constants,
-                         sizeof(PixelShaderConstants));
-    pixel_shader_manager.dirty = false;
+    const D3D11_BOX box = {range.offset, 0, 0, range.offset + range.size, 1, 1};
+    m_context1->UpdateSubresource1(buffer, 0, &box, static_cast<const u8*>(data) + range.offset,
+                                   0, 0, 0);
+    ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, range.size);
   }
+}
+
+void VertexManager::UploadUniforms()
+{
+  auto& system = Core::System::GetInstance();
+
+  UpdateConstantBufferRanges(m_vertex_constant_buffer.Get(),
+                             &system.GetVertexShaderManager().constants,
+                             sizeof(VertexShaderConstants), GetChangedVertexConstants());
+  UpdateConstantBufferRanges(m_geometry_constant_buffer.Get(),
+                             &system.GetGeometryShaderManager().constants,
+                             sizeof(GeometryShaderConstants), GetChangedGeometryConstants());
+  UpdateConstantBufferRanges(m_pixel_constant_buffer.Get(),
+                             &system.GetPixelShaderManager().constants,
+                             sizeof(PixelShaderConstants), GetChangedPixelConstants());
 
   D3D::stateman->SetPixelConstants(
       m_pixel_constant_buffer.Get(),
@@ -6,6 +6,7 @@
 #include <array>
 #include <atomic>
 #include <memory>
+#include <span>
 #include <vector>
 
 #include "VideoBackends/D3D/D3DBase.h"
@@ -58,8 +59,14 @@ private:
   static constexpr u32 BUFFER_SIZE =
       (VERTEX_STREAM_BUFFER_SIZE + INDEX_STREAM_BUFFER_SIZE) / BUFFER_COUNT;
 
+  static constexpr u32 MAX_PARTIAL_CONSTANT_BUFFER_UPDATES = 8;
+
   bool MapTexelBuffer(u32 required_size, D3D11_MAPPED_SUBRESOURCE& sr);
 
+  void WriteConstantBuffer(ID3D11Buffer* buffer, const void* data, u32 data_size);
+  void UpdateConstantBufferRanges(ID3D11Buffer* buffer, const void* data, u32 data_size,
+                                  std::span<const ConstantBufferRange> ranges);
+
   ComPtr<ID3D11Buffer> m_buffers[BUFFER_COUNT] = {};
   u32 m_current_buffer = 0;
   u32 m_buffer_cursor = 0;
@@ -68,6 +75,10 @@ private:
   ComPtr<ID3D11Buffer> m_geometry_constant_buffer = nullptr;
   ComPtr<ID3D11Buffer> m_pixel_constant_buffer = nullptr;
 
+  // Only set if the driver supports partial constant buffer updates
+  ComPtr<ID3D11DeviceContext1> m_context1;
+  std::vector<u8> m_constant_staging_buffer;
+
   ComPtr<ID3D11Buffer> m_texel_buffer = nullptr;
   std::array<ComPtr<ID3D11ShaderResourceView>, NUM_TEXEL_BUFFER_FORMATS> m_texel_buffer_views;
   u32 m_texel_buffer_offset = 0;
@@ -151,12 +151,16 @@ void VertexManager::UpdateVertexShaderConstants()
   if (!vertex_shader_manager.dirty || !ReserveConstantStorage())
     return;
 
+  // Skip the upload if the dirty flag was set without changing any values. Previous copies can
+  // still be in use by the GPU, so otherwise the whole block is written to new memory.
+  if (GetChangedVertexConstants().empty())
+    return;
+
   Gfx::GetInstance()->SetConstantBuffer(1, m_uniform_stream_buffer.GetCurrentGPUPointer());
   std::memcpy(m_uniform_stream_buffer.GetCurrentHostPointer(), &vertex_shader_manager.constants,
               sizeof(VertexShaderConstants));
   m_uniform_stream_buffer.CommitMemory(sizeof(VertexShaderConstants));
   ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, sizeof(VertexShaderConstants));
-  vertex_shader_manager.dirty = false;
 }
 
 void VertexManager::UpdateGeometryShaderConstants()
@@ -167,12 +171,14 @@ void VertexManager::UpdateGeometryShaderConstants()
   if (!geometry_shader_manager.dirty || !ReserveConstantStorage())
     return;
 
+  if (GetChangedGeometryConstants().empty())
+    return;
+
   Gfx::GetInstance()->SetConstantBuffer(2, m_uniform_stream_buffer.GetCurrentGPUPointer());
   std::memcpy(m_uniform_stream_buffer.GetCurrentHostPointer(), &geometry_shader_manager.constants,
               sizeof(GeometryShaderConstants));
   m_uniform_stream_buffer.CommitMemory(sizeof(GeometryShaderConstants));
   ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, sizeof(GeometryShaderConstants));
-  geometry_shader_manager.dirty = false;
 }
 
 void VertexManager::UpdatePixelShaderConstants()
@@ -183,12 +189,14 @@ void VertexManager::UpdatePixelShaderConstants()
   if (!pixel_shader_manager.dirty || !ReserveConstantStorage())
     return;
 
+  if (GetChangedPixelConstants().empty())
+    return;
+
   Gfx::GetInstance()->SetConstantBuffer(0, m_uniform_stream_buffer.GetCurrentGPUPointer());
   std::memcpy(m_uniform_stream_buffer.GetCurrentHostPointer(), &pixel_shader_manager.constants,
               sizeof(PixelShaderConstants));
   m_uniform_stream_buffer.CommitMemory(sizeof(PixelShaderConstants));
   ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, sizeof(PixelShaderConstants));
-  pixel_shader_manager.dirty = false;
 }
 
 bool VertexManager::ReserveConstantStorage()
@@ -258,10 +266,7 @@ void VertexManager::UploadAllConstants()
   m_uniform_stream_buffer.CommitMemory(allocation_size);
   ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, allocation_size);
 
-  // Clear dirty flags
-  vertex_shader_manager.dirty = false;
-  geometry_shader_manager.dirty = false;
-  pixel_shader_manager.dirty = false;
+  OnAllConstantsUploaded();
 }
 
 void VertexManager::UploadUtilityUniforms(const void* data, u32 data_size)
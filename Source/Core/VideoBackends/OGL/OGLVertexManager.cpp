@@ -191,6 +191,8 @@ void VertexManager::CommitBuffer(u32 num_vertices, u32 vertex_stride, u32 num_in
 
 void VertexManager::UploadUniforms()
 {
-  ProgramShaderCache::UploadConstants();
+  ProgramShaderCache::UploadConstants(!GetChangedPixelConstants().empty(),
+                                      !GetChangedVertexConstants().empty(),
+                                      !GetChangedGeometryConstants().empty());
 }
 }  // namespace OGL
@@ -39,7 +39,6 @@
 
 namespace OGL
 {
-u32 ProgramShaderCache::s_ubo_buffer_size;
 s32 ProgramShaderCache::s_ubo_align = 1;
 GLuint ProgramShaderCache::s_attributeless_VBO = 0;
 GLuint ProgramShaderCache::s_attributeless_VAO = 0;
@@ -226,42 +225,58 @@ u32 ProgramShaderCache::GetUniformBufferAlignment()
   return s_ubo_align;
 }
 
-void ProgramShaderCache::UploadConstants()
+void ProgramShaderCache::UploadConstants(bool pixel, bool vertex, bool geometry)
 {
+  if (!pixel && !vertex && !geometry)
+    return;
+
+  const u32 pixel_size =
+      pixel ? static_cast<u32>(Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align)) : 0;
+  const u32 vertex_size =
+      vertex ? static_cast<u32>(Common::AlignUp(sizeof(VertexShaderConstants), s_ubo_align)) : 0;
+  const u32 geometry_size =
+      geometry ? static_cast<u32>(Common::AlignUp(sizeof(GeometryShaderConstants), s_ubo_align)) :
+                 0;
+  const u32 upload_size = pixel_size + vertex_size + geometry_size;
+
   auto& system = Core::System::GetInstance();
   auto& pixel_shader_manager = system.GetPixelShaderManager();
   auto& vertex_shader_manager = system.GetVertexShaderManager();
   auto& geometry_shader_manager = system.GetGeometryShaderManager();
-  if (pixel_shader_manager.dirty || vertex_shader_manager.dirty || geometry_shader_manager.dirty)
-  {
-    auto buffer = s_buffer->Map(s_ubo_buffer_size, s_ubo_align);
 
+  // Only the blocks which changed are written, the others stay bound to their previous copy
+  auto buffer = s_buffer->Map(upload_size, s_ubo_align);
+  if (pixel)
     memcpy(buffer.first, &pixel_shader_manager.constants, sizeof(PixelShaderConstants));
+  if (vertex)
+  {
+    memcpy(buffer.first + pixel_size, &vertex_shader_manager.constants,
+           sizeof(VertexShaderConstants));
+  }
+  if (geometry)
+  {
+    memcpy(buffer.first + pixel_size + vertex_size, &geometry_shader_manager.constants,
+           sizeof(GeometryShaderConstants));
+  }
+  s_buffer->Unmap(upload_size);
 
-    memcpy(buffer.first + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align),
-           &vertex_shader_manager.constants, sizeof(VertexShaderConstants));
-
-    memcpy(buffer.first + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align) +
-               Common::AlignUp(sizeof(VertexShaderConstants), s_ubo_align),
-           &geometry_shader_manager.constants, sizeof(GeometryShaderConstants));
-
-    s_buffer->Unmap(s_ubo_buffer_size);
+  if (pixel)
+  {
     glBindBufferRange(GL_UNIFORM_BUFFER, 1, s_buffer->m_buffer, buffer.second,
                       sizeof(PixelShaderConstants));
-    glBindBufferRange(GL_UNIFORM_BUFFER, 2, s_buffer->m_buffer,
-                      buffer.second + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align),
+  }
+  if (vertex)
+  {
+    glBindBufferRange(GL_UNIFORM_BUFFER, 2, s_buffer->m_buffer, buffer.second + pixel_size,
                       sizeof(VertexShaderConstants));
+  }
+  if (geometry)
+  {
     glBindBufferRange(GL_UNIFORM_BUFFER, 3, s_buffer->m_buffer,
-                      buffer.second + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align) +
-                          Common::AlignUp(sizeof(VertexShaderConstants), s_ubo_align),
-                      sizeof(GeometryShaderConstants));
-
-    pixel_shader_manager.dirty = false;
-    vertex_shader_manager.dirty = false;
-    geometry_shader_manager.dirty = false;
-
-    ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, s_ubo_buffer_size);
+                      buffer.second + pixel_size + vertex_size, sizeof(GeometryShaderConstants));
   }
+
+  ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, upload_size);
 }
 
 void ProgramShaderCache::UploadConstants(const void* data, u32 data_size)
@@ -448,11 +463,6 @@ void ProgramShaderCache::Init()
   // then the UBO will fail.
   glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &s_ubo_align);
 
-  s_ubo_buffer_size =
-      static_cast<u32>(Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align) +
-                       Common::AlignUp(sizeof(VertexShaderConstants), s_ubo_align) +
-                       Common::AlignUp(sizeof(GeometryShaderConstants), s_ubo_align));
-
   // We multiply by *4*4 because we need to get down to basic machine units.
   // So multiply by four to get how many floats we have from vec4s
   // Then once more to get bytes
@@ -82,7 +82,7 @@ public:
                                      std::string_view gcode);
   static StreamBuffer* GetUniformBuffer();
   static u32 GetUniformBufferAlignment();
-  static void UploadConstants();
+  static void UploadConstants(bool pixel, bool vertex, bool geometry);
   static void UploadConstants(const void* data, u32 data_size);
 
   static void Init();
@@ -114,7 +114,6 @@ private:
   static PipelineProgramMap s_pipeline_programs;
   static std::mutex s_pipeline_program_lock;
 
-  static u32 s_ubo_buffer_size;
   static s32 s_ubo_align;
 
   static GLuint s_attributeless_VBO;
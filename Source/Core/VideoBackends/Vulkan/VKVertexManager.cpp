@@ -210,6 +210,11 @@ void VertexManager::UpdateVertexShaderConstants()
   if (!vertex_shader_manager.dirty || !ReserveConstantStorage())
     return;
 
+  // Skip the upload if the dirty flag was set without changing any values. Previous copies can
+  // still be in use by the GPU, so otherwise the whole block is written to new memory.
+  if (GetChangedVertexConstants().empty())
+    return;
+
   StateTracker::GetInstance()->SetGXUniformBuffer(
       UBO_DESCRIPTOR_SET_BINDING_VS, m_uniform_stream_buffer->GetBuffer(),
       m_uniform_stream_buffer->GetCurrentOffset(), sizeof(VertexShaderConstants));
@@ -217,7 +222,6 @@ void VertexManager::UpdateVertexShaderConstants()
               sizeof(VertexShaderConstants));
   m_uniform_stream_buffer->CommitMemory(sizeof(VertexShaderConstants));
   ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, sizeof(VertexShaderConstants));
-  vertex_shader_manager.dirty = false;
 }
 
 void VertexManager::UpdateGeometryShaderConstants()
@@ -228,6 +232,9 @@ void VertexManager::UpdateGeometryShaderConstants()
   if (!geometry_shader_manager.dirty || !ReserveConstantStorage())
     return;
 
+  if (GetChangedGeometryConstants().empty())
+    return;
+
   StateTracker::GetInstance()->SetGXUniformBuffer(
       UBO_DESCRIPTOR_SET_BINDING_GS, m_uniform_stream_buffer->GetBuffer(),
       m_uniform_stream_buffer->GetCurrentOffset(), sizeof(GeometryShaderConstants));
@@ -235,7 +242,6 @@ void VertexManager::UpdateGeometryShaderConstants()
               sizeof(GeometryShaderConstants));
   m_uniform_stream_buffer->CommitMemory(sizeof(GeometryShaderConstants));
   ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, sizeof(GeometryShaderConstants));
-  geometry_shader_manager.dirty = false;
 }
 
 void VertexManager::UpdatePixelShaderConstants()
@@ -246,6 +252,9 @@ void VertexManager::UpdatePixelShaderConstants()
   if (!pixel_shader_manager.dirty || !ReserveConstantStorage())
     return;
 
+  if (GetChangedPixelConstants().empty())
+    return;
+
   StateTracker::GetInstance()->SetGXUniformBuffer(
       UBO_DESCRIPTOR_SET_BINDING_PS, m_uniform_stream_buffer->GetBuffer(),
       m_uniform_stream_buffer->GetCurrentOffset(), sizeof(PixelShaderConstants));
@@ -253,7 +262,6 @@ void VertexManager::UpdatePixelShaderConstants()
               sizeof(PixelShaderConstants));
   m_uniform_stream_buffer->CommitMemory(sizeof(PixelShaderConstants));
   ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, sizeof(PixelShaderConstants));
-  pixel_shader_manager.dirty = false;
 }
 
 bool VertexManager::ReserveConstantStorage()
@@ -324,10 +332,7 @@ void VertexManager::UploadAllConstants()
   m_uniform_stream_buffer->CommitMemory(allocation_size);
   ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, allocation_size);
 
-  // Clear dirty flags
-  vertex_shader_manager.dirty = false;
-  geometry_shader_manager.dirty = false;
-  pixel_shader_manager.dirty = false;
+  OnAllConstantsUploaded();
 }
 
 void VertexManager::UploadUtilityUniforms(const void* data, u32 data_size)
@@ -46,30 +46,53 @@ void CustomAssetLoader::Init()
   });
 
   m_asset_load_thread.Reset("Custom Asset Loader", [this](std::weak_ptr<CustomAsset> asset) {
-    if (auto ptr = asset.lock())
+    while (true)
     {
-      if (ptr->Load())
+      std::weak_ptr<CustomAsset> demanded_asset;
       {
-        std::lock_guard lk(m_asset_load_lock);
-        const std::size_t asset_memory_size = ptr->GetByteSizeInMemory();
-        if (m_max_memory_available >= m_total_bytes_loaded + asset_memory_size)
-        {
-          m_total_bytes_loaded += asset_memory_size;
-          m_assets_to_monitor.try_emplace(ptr->GetAssetId(), ptr);
-        }
-        else
-        {
-          ERROR_LOG_FMT(VIDEO, "Failed to load asset {} because there was not enough memory.",
-                        ptr->GetAssetId());
-        }
+        std::lock_guard lk(m_demand_lock);
+        if (m_demand_loads.empty())
+          break;
+        demanded_asset = std::move(m_demand_loads.front());
+        m_demand_loads.pop_front();
       }
+      LoadAsset(demanded_asset);
     }
+
+    LoadAsset(asset);
   });
 }
 
+void CustomAssetLoader::LoadAsset(const std::weak_ptr<CustomAsset>& asset)
+{
+  if (auto ptr = asset.lock())
+  {
+    // The asset may have been queued again after being prioritized
+    if (ptr->GetLastLoadedTime() != CustomAssetLibrary::TimeType{})
+      return;
+
+    if (ptr->Load())
+    {
+      std::lock_guard lk(m_asset_load_lock);
+      const std::size_t asset_memory_size = ptr->GetByteSizeInMemory();
+      if (m_max_memory_available >= m_total_bytes_loaded + asset_memory_size)
+      {
+        m_total_bytes_loaded += asset_memory_size;
+        m_assets_to_monitor.try_emplace(ptr->GetAssetId(), ptr);
+      }
+      else
+      {
+        ERROR_LOG_FMT(VIDEO, "Failed to load asset {} because there was not enough memory.",
+                      ptr->GetAssetId());
+      }
+    }
+  }
+}
+
 void CustomAssetLoader ::Shutdown()
 {
   m_asset_load_thread.Shutdown(true);
+  m_demand_loads.clear();
 
   m_asset_monitor_thread_shutdown.Set();
   m_asset_monitor_thread.join();
@@ -86,9 +109,11 @@ CustomAssetLoader::LoadTexture(const CustomAssetLibrary::AssetID& asset_id,
 
 std::shared_ptr<GameTextureAsset>
 CustomAssetLoader::LoadGameTexture(const CustomAssetLibrary::AssetID& asset_id,
-                                   std::shared_ptr<CustomAssetLibrary> library)
+                                   std::shared_ptr<CustomAssetLibrary> library,
+                                   LoadPriority priority)
 {
-  return LoadOrCreateAsset<GameTextureAsset>(asset_id, m_game_textures, std::move(library));
+  return LoadOrCreateAsset<GameTextureAsset>(asset_id, m_game_textures, std::move(library),
+                                             priority);
 }
 
 std::shared_ptr<PixelShaderAsset>
@@ -104,4 +129,19 @@ CustomAssetLoader::LoadMaterial(const CustomAssetLibrary::AssetID& asset_id,
 {
   return LoadOrCreateAsset<MaterialAsset>(asset_id, m_materials, std::move(library));
 }
+
+void CustomAssetLoader::PrioritizeAsset(const std::shared_ptr<CustomAsset>& asset)
+{
+  if (asset->GetLastLoadedTime() != CustomAssetLibrary::TimeType{})
+    return;
+
+  {
+    std::lock_guard lk(m_demand_lock);
+    m_demand_loads.push_back(asset);
+  }
+
+  // The load thread checks for prioritized assets before each queued item, this just wakes it up in
+  // case it is idle
+  m_asset_load_thread.Push(std::weak_ptr<CustomAsset>{});
+}
 }  // namespace VideoCommon
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <chrono>
+#include <deque>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -30,6 +31,14 @@ public:
   CustomAssetLoader& operator=(const CustomAssetLoader&) = delete;
   CustomAssetLoader& operator=(CustomAssetLoader&&) = delete;
 
+  enum class LoadPriority
+  {
+    // Assets which are loaded ahead of time and may not be needed for a while
+    Background,
+    // Assets which are needed right away, these skip ahead of any background loads
+    Demand,
+  };
+
   void Init();
   void Shutdown();
 
@@ -41,8 +50,10 @@ public:
   std::shared_ptr<RawTextureAsset> LoadTexture(const CustomAssetLibrary::AssetID& asset_id,
                                                std::shared_ptr<CustomAssetLibrary> library);
 
-  std::shared_ptr<GameTextureAsset> LoadGameTexture(const CustomAssetLibrary::AssetID& asset_id,
-                                                    std::shared_ptr<CustomAssetLibrary> library);
+  std::shared_ptr<GameTextureAsset>
+  LoadGameTexture(const CustomAssetLibrary::AssetID& asset_id,
+                  std::shared_ptr<CustomAssetLibrary> library,
+                  LoadPriority priority = LoadPriority::Background);
 
   std::shared_ptr<PixelShaderAsset> LoadPixelShader(const CustomAssetLibrary::AssetID& asset_id,
                                                     std::shared_ptr<CustomAssetLibrary> library);
@@ -50,20 +61,28 @@ public:
   std::shared_ptr<MaterialAsset> LoadMaterial(const CustomAssetLibrary::AssetID& asset_id,
                                               std::shared_ptr<CustomAssetLibrary> library);
 
+  // Moves an asset which is still waiting to be loaded ahead of any background loads
+  void PrioritizeAsset(const std::shared_ptr<CustomAsset>& asset);
+
 private:
   // TODO C++20: use a 'derived_from' concept against 'CustomAsset' when available
   template <typename AssetType>
   std::shared_ptr<AssetType>
   LoadOrCreateAsset(const CustomAssetLibrary::AssetID& asset_id,
                     std::map<CustomAssetLibrary::AssetID, std::weak_ptr<AssetType>>& asset_map,
-                    std::shared_ptr<CustomAssetLibrary> library)
+                    std::shared_ptr<CustomAssetLibrary> library,
+                    LoadPriority priority = LoadPriority::Background)
   {
     auto [it, inserted] = asset_map.try_emplace(asset_id);
     if (!inserted)
     {
       auto shared = it->second.lock();
       if (shared)
+      {
+        if (priority == LoadPriority::Demand)
+          PrioritizeAsset(shared);
         return shared;
+      }
     }
     std::shared_ptr<AssetType> ptr(new AssetType(std::move(library), asset_id), [&](AssetType* a) {
       {
@@ -74,10 +93,15 @@ private:
       delete a;
     });
     it->second = ptr;
-    m_asset_load_thread.Push(it->second);
+    if (priority == LoadPriority::Demand)
+      PrioritizeAsset(ptr);
+    else
+      m_asset_load_thread.Push(it->second);
     return ptr;
   }
 
+  void LoadAsset(const std::weak_ptr<CustomAsset>& asset);
+
   static constexpr auto TIME_BETWEEN_ASSET_MONITOR_CHECKS = std::chrono::milliseconds{500};
 
   std::map<CustomAssetLibrary::AssetID, std::weak_ptr<RawTextureAsset>> m_textures;
@@ -96,5 +120,9 @@ private:
   // iterating over the assets to monitor which calls the lock above in 'LoadOrCreateAsset'
   std::recursive_mutex m_asset_load_lock;
   Common::WorkQueueThread<std::weak_ptr<CustomAsset>> m_asset_load_thread;
+
+  // Assets to load before the next item of the load thread's queue
+  std::mutex m_demand_lock;
+  std::deque<std::weak_ptr<CustomAsset>> m_demand_loads;
 };
 }  // namespace VideoCommon
@@ -0,0 +1,405 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/Assets/TexturePackArchive.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include <xxhash.h>
+
+#include "Common/Align.h"
+#include "Common/Logging/Log.h"
+#include "VideoCommon/AbstractTexture.h"
+#include "VideoCommon/Assets/CustomTextureData.h"
+#include "VideoCommon/TextureConfig.h"
+
+namespace VideoCommon
+{
+namespace
+{
+// Level data is aligned so that it can be handed to APIs which expect aligned uploads
+constexpr u64 DATA_ALIGNMENT = 16;
+
+template <typename T>
+T ReadRecord(const std::vector<u8>& data, size_t offset)
+{
+  T record;
+  std::memcpy(&record, data.data() + offset, sizeof(T));
+  return record;
+}
+
+bool IsSupportedFormat(u32 format)
+{
+  switch (static_cast<AbstractTextureFormat>(format))
+  {
+  case AbstractTextureFormat::RGBA8:
+  case AbstractTextureFormat::BGRA8:
+  case AbstractTextureFormat::DXT1:
+  case AbstractTextureFormat::DXT3:
+  case AbstractTextureFormat::DXT5:
+  case AbstractTextureFormat::BPTC:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Checks that the level's data is exactly as large as uploading a texture of its dimensions needs
+bool IsValidLevel(u32 format, u32 width, u32 height, u32 row_length, u64 data_size)
+{
+  if (!IsSupportedFormat(format) || width == 0 || height == 0 || row_length < width)
+    return false;
+
+  const auto texture_format = static_cast<AbstractTextureFormat>(format);
+  const u32 block_size = AbstractTexture::GetBlockSizeForFormat(texture_format);
+  if (row_length % block_size != 0)
+    return false;
+
+  // Compared by dividing, as the multiplication could overflow for corrupted dimensions
+  const u64 row_size =
+      u64(row_length / block_size) * AbstractTexture::GetTexelSizeForFormat(texture_format);
+  const u64 blocks_high = (u64(height) + block_size - 1) / block_size;
+  return data_size % row_size == 0 && data_size / row_size == blocks_high;
+}
+}  // namespace
+
+u64 TexturePackArchive::HashName(std::string_view name)
+{
+  return XXH64(name.data(), name.size(), 0);
+}
+
+std::shared_ptr<TexturePackArchiveLibrary> TexturePackArchiveLibrary::Open(const std::string& path)
+{
+  using namespace TexturePackArchive;
+
+  std::shared_ptr<TexturePackArchiveLibrary> library(new TexturePackArchiveLibrary);
+  library->m_path = path;
+  library->m_open_time = std::chrono::system_clock::now();
+
+  File::IOFile& file = library->m_file;
+  if (!file.Open(path, "rb"))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to open texture pack archive '{}'", path);
+    return nullptr;
+  }
+
+  const u64 file_size = file.GetSize();
+  Header& header = library->m_header;
+  if (!file.ReadArray(&header, 1) || header.magic != MAGIC || header.version != VERSION ||
+      header.index_offset < sizeof(Header) || header.index_offset > file_size)
+  {
+    ERROR_LOG_FMT(VIDEO, "'{}' is not a supported texture pack archive", path);
+    return nullptr;
+  }
+
+  library->m_levels_offset = u64(header.texture_count) * sizeof(TextureRecord);
+  library->m_strings_offset =
+      library->m_levels_offset + u64(header.level_count) * sizeof(LevelRecord);
+  if (header.index_offset + library->m_strings_offset + header.strings_size != file_size)
+  {
+    ERROR_LOG_FMT(VIDEO, "Texture pack archive '{}' is truncated", path);
+    return nullptr;
+  }
+
+  library->m_index.resize(file_size - header.index_offset);
+  if (!file.Seek(header.index_offset, File::SeekOrigin::Begin) ||
+      !file.ReadBytes(library->m_index.data(), library->m_index.size()))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to read the index of texture pack archive '{}'", path);
+    return nullptr;
+  }
+
+  // Validate all the records once here so that loads don't have to
+  for (size_t i = 0; i < header.level_count; ++i)
+  {
+    const LevelRecord level = library->GetLevelRecord(i);
+    if (level.data_offset < sizeof(Header) || level.data_size > header.index_offset ||
+        level.data_offset > header.index_offset - level.data_size ||
+        !IsValidLevel(level.format, level.width, level.height, level.row_length, level.data_size))
+    {
+      ERROR_LOG_FMT(VIDEO, "Texture pack archive '{}' is corrupted", path);
+      return nullptr;
+    }
+  }
+  for (size_t i = 0; i < header.texture_count; ++i)
+  {
+    const TextureRecord texture = library->GetTextureRecord(i);
+    if (u64(texture.name_offset) + texture.name_size > header.strings_size ||
+        texture.level_count == 0 ||
+        u64(texture.first_level) + texture.level_count > header.level_count)
+    {
+      ERROR_LOG_FMT(VIDEO, "Texture pack archive '{}' is corrupted", path);
+      return nullptr;
+    }
+
+    // Loads read all the levels of a texture at once
+    for (u32 j = 1; j < texture.level_count; ++j)
+    {
+      const LevelRecord previous = library->GetLevelRecord(texture.first_level + j - 1);
+      if (library->GetLevelRecord(texture.first_level + j).data_offset !=
+          previous.data_offset + previous.data_size)
+      {
+        ERROR_LOG_FMT(VIDEO, "Texture pack archive '{}' is corrupted", path);
+        return nullptr;
+      }
+    }
+  }
+
+  return library;
+}
+
+CustomAssetLibrary::LoadInfo TexturePackArchiveLibrary::LoadTexture(const AssetID& asset_id,
+                                                                    CustomTextureData* data)
+{
+  const std::optional<size_t> index = FindTextureIndex(asset_id);
+  if (!index)
+  {
+    ERROR_LOG_FMT(VIDEO, "Asset '{}' error - not found in texture pack archive '{}'!", asset_id,
+                  m_path);
+    return {};
+  }
+
+  const TexturePackArchive::TextureRecord texture = GetTextureRecord(*index);
+
+  data->m_slices.resize(1);
+  auto& levels = data->m_slices[0].m_levels;
+  levels.resize(texture.level_count);
+
+  // Open has checked that the levels of each texture are stored back to back, so they can be read
+  // straight into the texture data with a single seek
+  std::lock_guard lk(m_file_lock);
+  if (!m_file.Seek(GetLevelRecord(texture.first_level).data_offset, File::SeekOrigin::Begin))
+  {
+    ERROR_LOG_FMT(VIDEO, "Asset '{}' error - failed to seek in texture pack archive '{}'!",
+                  asset_id, m_path);
+    return {};
+  }
+
+  std::size_t bytes_loaded = 0;
+  for (u32 i = 0; i < texture.level_count; ++i)
+  {
+    const TexturePackArchive::LevelRecord record = GetLevelRecord(texture.first_level + i);
+    auto& level = levels[i];
+    level.format = static_cast<AbstractTextureFormat>(record.format);
+    level.width = record.width;
+    level.height = record.height;
+    level.row_length = record.row_length;
+    level.data.resize(record.data_size);
+    if (!m_file.ReadBytes(level.data.data(), level.data.size()))
+    {
+      ERROR_LOG_FMT(VIDEO, "Asset '{}' error - failed to read from texture pack archive '{}'!",
+                    asset_id, m_path);
+      return {};
+    }
+    bytes_loaded += level.data.size();
+  }
+
+  return LoadInfo{bytes_loaded, m_open_time};
+}
+
+CustomAssetLibrary::LoadInfo TexturePackArchiveLibrary::LoadPixelShader(const AssetID& asset_id,
+                                                                        PixelShaderData*)
+{
+  ERROR_LOG_FMT(VIDEO, "Asset '{}' error - texture pack archives can't contain pixel shaders!",
+                asset_id);
+  return {};
+}
+
+CustomAssetLibrary::LoadInfo TexturePackArchiveLibrary::LoadMaterial(const AssetID& asset_id,
+                                                                     MaterialData*)
+{
+  ERROR_LOG_FMT(VIDEO, "Asset '{}' error - texture pack archives can't contain materials!",
+                asset_id);
+  return {};
+}
+
+CustomAssetLibrary::TimeType
+TexturePackArchiveLibrary::GetLastAssetWriteTime(const AssetID& asset_id) const
+{
+  return m_open_time;
+}
+
+std::optional<TexturePackArchiveLibrary::TextureEntry>
+TexturePackArchiveLibrary::FindTexture(std::string_view name) const
+{
+  const std::optional<size_t> index = FindTextureIndex(name);
+  if (!index)
+    return std::nullopt;
+  return GetTexture(*index);
+}
+
+TexturePackArchiveLibrary::TextureEntry TexturePackArchiveLibrary::GetTexture(size_t index) const
+{
+  const TexturePackArchive::TextureRecord texture = GetTextureRecord(index);
+
+  u64 size = 0;
+  for (u32 i = 0; i < texture.level_count; ++i)
+    size += GetLevelRecord(texture.first_level + i).data_size;
+
+  return TextureEntry{GetString(texture.name_offset, texture.name_size),
+                      (texture.flags & TexturePackArchive::TEXTURE_FLAG_ARBITRARY_MIPMAPS) != 0,
+                      size};
+}
+
+std::optional<size_t> TexturePackArchiveLibrary::FindTextureIndex(std::string_view name) const
+{
+  const u64 name_hash = TexturePackArchive::HashName(name);
+
+  // Binary search for the first texture with the hash
+  size_t first = 0;
+  size_t count = m_header.texture_count;
+  while (count > 0)
+  {
+    const size_t step = count / 2;
+    if (GetTextureRecord(first + step).name_hash < name_hash)
+    {
+      first += step + 1;
+      count -= step + 1;
+    }
+    else
+    {
+      count = step;
+    }
+  }
+
+  for (size_t i = first; i < m_header.texture_count; ++i)
+  {
+    const TexturePackArchive::TextureRecord texture = GetTextureRecord(i);
+    if (texture.name_hash != name_hash)
+      break;
+    if (GetString(texture.name_offset, texture.name_size) == name)
+      return i;
+  }
+
+  return std::nullopt;
+}
+
+TexturePackArchive::TextureRecord TexturePackArchiveLibrary::GetTextureRecord(size_t index) const
+{
+  return ReadRecord<TexturePackArchive::TextureRecord>(
+      m_index, index * sizeof(TexturePackArchive::TextureRecord));
+}
+
+TexturePackArchive::LevelRecord TexturePackArchiveLibrary::GetLevelRecord(size_t index) const
+{
+  return ReadRecord<TexturePackArchive::LevelRecord>(
+      m_index, m_levels_offset + index * sizeof(TexturePackArchive::LevelRecord));
+}
+
+std::string_view TexturePackArchiveLibrary::GetString(u32 offset, u32 size) const
+{
+  return std::string_view(reinterpret_cast<const char*>(m_index.data() + m_strings_offset + offset),
+                          size);
+}
+
+bool TexturePackArchiveWriter::Open(const std::string& path)
+{
+  m_textures.clear();
+  m_levels.clear();
+  m_strings.clear();
+
+  if (!m_file.Open(path, "wb"))
+    return false;
+
+  // The header is written by Finish once the index offset is known
+  const TexturePackArchive::Header header{};
+  if (!m_file.WriteArray(&header, 1))
+    return false;
+
+  m_position = sizeof(header);
+  return true;
+}
+
+bool TexturePackArchiveWriter::AddTexture(std::string_view name, bool has_arbitrary_mipmaps,
+                                          const CustomTextureData& data)
+{
+  if (data.m_slices.size() != 1 || data.m_slices[0].m_levels.empty())
+    return false;
+
+  // Archives with levels which don't match their dimensions are rejected when they're opened
+  const auto& levels = data.m_slices[0].m_levels;
+  if (std::any_of(levels.begin(), levels.end(), [](const auto& level) {
+        return !IsValidLevel(static_cast<u32>(level.format), level.width, level.height,
+                             level.row_length, level.data.size());
+      }))
+  {
+    return false;
+  }
+
+  if (!WritePadding())
+    return false;
+
+  TexturePackArchive::TextureRecord texture{};
+  texture.name_hash = TexturePackArchive::HashName(name);
+  texture.name_offset = static_cast<u32>(m_strings.size());
+  texture.name_size = static_cast<u32>(name.size());
+  texture.first_level = static_cast<u32>(m_levels.size());
+  texture.level_count = static_cast<u32>(levels.size());
+  texture.flags = has_arbitrary_mipmaps ? TexturePackArchive::TEXTURE_FLAG_ARBITRARY_MIPMAPS : 0;
+
+  for (const auto& level : levels)
+  {
+    if (!m_file.WriteBytes(level.data.data(), level.data.size()))
+      return false;
+
+    m_levels.push_back(TexturePackArchive::LevelRecord{
+        m_position, level.data.size(), static_cast<u32>(level.format), level.width, level.height,
+        level.row_length});
+    m_position += level.data.size();
+  }
+
+  m_strings.append(name);
+  m_textures.push_back(texture);
+  return true;
+}
+
+bool TexturePackArchiveWriter::Finish()
+{
+  std::sort(m_textures.begin(), m_textures.end(),
+            [this](const TexturePackArchive::TextureRecord& a,
+                   const TexturePackArchive::TextureRecord& b) {
+              if (a.name_hash != b.name_hash)
+                return a.name_hash < b.name_hash;
+              return std::string_view(m_strings).substr(a.name_offset, a.name_size) <
+                     std::string_view(m_strings).substr(b.name_offset, b.name_size);
+            });
+
+  if (!WritePadding())
+    return false;
+
+  const u64 index_offset = m_position;
+  if (!m_file.WriteArray(m_textures.data(), m_textures.size()) ||
+      !m_file.WriteArray(m_levels.data(), m_levels.size()) ||
+      !m_file.WriteBytes(m_strings.data(), m_strings.size()))
+  {
+    return false;
+  }
+
+  const TexturePackArchive::Header header{
+      TexturePackArchive::MAGIC,
+      TexturePackArchive::VERSION,
+      static_cast<u32>(m_textures.size()),
+      static_cast<u32>(m_levels.size()),
+      index_offset,
+      static_cast<u32>(m_strings.size()),
+      0};
+  if (!m_file.Seek(0, File::SeekOrigin::Begin) || !m_file.WriteArray(&header, 1))
+    return false;
+
+  return m_file.Close();
+}
+
+bool TexturePackArchiveWriter::WritePadding()
+{
+  static constexpr std::array<u8, DATA_ALIGNMENT> padding{};
+
+  const u64 aligned_position = Common::AlignUp(m_position, DATA_ALIGNMENT);
+  if (!m_file.WriteBytes(padding.data(), aligned_position - m_position))
+    return false;
+
+  m_position = aligned_position;
+  return true;
+}
+}  // namespace VideoCommon
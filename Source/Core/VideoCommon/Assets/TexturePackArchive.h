@@ -0,0 +1,140 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "VideoCommon/Assets/CustomAssetLibrary.h"
+
+namespace VideoCommon
+{
+class CustomTextureData;
+
+// A texture pack archive holds the already decoded textures of a texture pack in a single file, so
+// loading a texture is one read of data which can be uploaded as is. Textures keep the format they
+// were provided in, which means DDS textures stay block compressed.
+//
+// An archive starts with a Header, followed by the data of every mip level of every texture, and
+// ends with the index: the texture records sorted by the hash of their name, the level records and
+// finally the texture names.
+namespace TexturePackArchive
+{
+constexpr u32 MAGIC = 0x41505444;  // "DTPA"
+constexpr u32 VERSION = 1;
+
+constexpr u32 TEXTURE_FLAG_ARBITRARY_MIPMAPS = 1;
+
+struct Header
+{
+  u32 magic;
+  u32 version;
+  u32 texture_count;
+  u32 level_count;
+  u64 index_offset;
+  u32 strings_size;
+  u32 padding;
+};
+
+struct TextureRecord
+{
+  u64 name_hash;
+  u32 name_offset;
+  u32 name_size;
+  u32 first_level;
+  u32 level_count;
+  u32 flags;
+  u32 padding;
+};
+
+struct LevelRecord
+{
+  u64 data_offset;
+  u64 data_size;
+  u32 format;
+  u32 width;
+  u32 height;
+  u32 row_length;
+};
+
+u64 HashName(std::string_view name);
+}  // namespace TexturePackArchive
+
+// This class implements 'CustomAssetLibrary' and loads textures from a texture pack archive
+class TexturePackArchiveLibrary final : public CustomAssetLibrary
+{
+public:
+  struct TextureEntry
+  {
+    std::string_view name;
+    bool has_arbitrary_mipmaps;
+    // Total size of the texture's levels in memory
+    u64 size;
+  };
+
+  static std::shared_ptr<TexturePackArchiveLibrary> Open(const std::string& path);
+
+  LoadInfo LoadTexture(const AssetID& asset_id, CustomTextureData* data) override;
+  LoadInfo LoadPixelShader(const AssetID& asset_id, PixelShaderData* data) override;
+  LoadInfo LoadMaterial(const AssetID& asset_id, MaterialData* data) override;
+
+  // Archives aren't watched for changes, this is the time the archive was opened
+  TimeType GetLastAssetWriteTime(const AssetID& asset_id) const override;
+
+  std::optional<TextureEntry> FindTexture(std::string_view name) const;
+  size_t GetTextureCount() const { return m_header.texture_count; }
+  TextureEntry GetTexture(size_t index) const;
+
+  const std::string& GetPath() const { return m_path; }
+
+private:
+  TexturePackArchiveLibrary() = default;
+
+  std::optional<size_t> FindTextureIndex(std::string_view name) const;
+  TexturePackArchive::TextureRecord GetTextureRecord(size_t index) const;
+  TexturePackArchive::LevelRecord GetLevelRecord(size_t index) const;
+  std::string_view GetString(u32 offset, u32 size) const;
+
+  std::string m_path;
+  TexturePackArchive::Header m_header{};
+  // Everything from the index offset to the end of the file
+  std::vector<u8> m_index;
+  size_t m_levels_offset = 0;
+  size_t m_strings_offset = 0;
+  TimeType m_open_time = {};
+
+  std::mutex m_file_lock;
+  File::IOFile m_file;
+};
+
+class TexturePackArchiveWriter
+{
+public:
+  // Creates the archive, replacing any existing file
+  bool Open(const std::string& path);
+
+  // The texture must have exactly one slice, and its name must not have been added before
+  bool AddTexture(std::string_view name, bool has_arbitrary_mipmaps, const CustomTextureData& data);
+
+  // Writes the index, the archive can't be read before this succeeds
+  bool Finish();
+
+  u64 GetDataSize() const { return m_position; }
+
+private:
+  bool WritePadding();
+
+  File::IOFile m_file;
+  u64 m_position = 0;
+  std::vector<TexturePackArchive::TextureRecord> m_textures;
+  std::vector<TexturePackArchive::LevelRecord> m_levels;
+  std::string m_strings;
+};
+}  // namespace VideoCommon
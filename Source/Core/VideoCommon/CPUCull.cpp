@@ -120,6 +120,52 @@ static Common::EnumMap<CPUCull::CullFunction, CullMode::All> GetCullFunction1()
   };
 }
 
+template <OpcodeDecoder::Primitive Primitive, CullMode Mode>
+static CPUCull::CullTrianglesFunction GetCullTrianglesFunction0()
+{
+#if defined(USE_SSE)
+  if (MIN_SSE >= 50 || cpu_info.bAVX)
+    return CPUCull_AVX::CullTriangles<Primitive, Mode>;
+  else if (MIN_SSE >= 30 || cpu_info.bSSE3)
+    return CPUCull_SSE3::CullTriangles<Primitive, Mode>;
+  else
+    return CPUCull_SSE::CullTriangles<Primitive, Mode>;
+#elif defined(USE_NEON)
+  return CPUCull_NEON::CullTriangles<Primitive, Mode>;
+#else
+  return CPUCull_Scalar::CullTriangles<Primitive, Mode>;
+#endif
+}
+
+template <OpcodeDecoder::Primitive Primitive>
+static Common::EnumMap<CPUCull::CullTrianglesFunction, CullMode::All> GetCullTrianglesFunction1()
+{
+  return {
+      GetCullTrianglesFunction0<Primitive, CullMode::None>(),
+      GetCullTrianglesFunction0<Primitive, CullMode::Back>(),
+      GetCullTrianglesFunction0<Primitive, CullMode::Front>(),
+      GetCullTrianglesFunction0<Primitive, CullMode::All>(),
+  };
+}
+
+// Number of triangles IndexGenerator emits for a draw
+static u32 GetTriangleCount(OpcodeDecoder::Primitive primitive, u32 count)
+{
+  switch (primitive)
+  {
+  case OpcodeDecoder::Primitive::GX_DRAW_QUADS:
+  case OpcodeDecoder::Primitive::GX_DRAW_QUADS_2:
+    return count / 4 * 2 + (count % 4 == 3 ? 1 : 0);
+  case OpcodeDecoder::Primitive::GX_DRAW_TRIANGLES:
+    return count / 3;
+  case OpcodeDecoder::Primitive::GX_DRAW_TRIANGLE_STRIP:
+  case OpcodeDecoder::Primitive::GX_DRAW_TRIANGLE_FAN:
+    return count < 3 ? 0 : count - 2;
+  default:
+    return 0;
+  }
+}
+
 CPUCull::~CPUCull() = default;
 
 void CPUCull::Init()
@@ -134,13 +180,18 @@ void CPUCull::Init()
   m_cull_table[Prim::GX_DRAW_TRIANGLES] = GetCullFunction1<Prim::GX_DRAW_TRIANGLES>();
   m_cull_table[Prim::GX_DRAW_TRIANGLE_STRIP] = GetCullFunction1<Prim::GX_DRAW_TRIANGLE_STRIP>();
   m_cull_table[Prim::GX_DRAW_TRIANGLE_FAN] = GetCullFunction1<Prim::GX_DRAW_TRIANGLE_FAN>();
+  m_cull_triangles_table[Prim::GX_DRAW_QUADS] = GetCullTrianglesFunction1<Prim::GX_DRAW_QUADS>();
+  m_cull_triangles_table[Prim::GX_DRAW_QUADS_2] = GetCullTrianglesFunction1<Prim::GX_DRAW_QUADS>();
+  m_cull_triangles_table[Prim::GX_DRAW_TRIANGLES] =
+      GetCullTrianglesFunction1<Prim::GX_DRAW_TRIANGLES>();
+  m_cull_triangles_table[Prim::GX_DRAW_TRIANGLE_STRIP] =
+      GetCullTrianglesFunction1<Prim::GX_DRAW_TRIANGLE_STRIP>();
+  m_cull_triangles_table[Prim::GX_DRAW_TRIANGLE_FAN] =
+      GetCullTrianglesFunction1<Prim::GX_DRAW_TRIANGLE_FAN>();
 }
 
-bool CPUCull::AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive,
-                                   const u8* src, u32 count)
+CullMode CPUCull::TransformVertices(VertexLoaderBase* loader, const u8* src, u32 count)
 {
-  ASSERT_MSG(VIDEO, primitive < OpcodeDecoder::Primitive::GX_DRAW_LINES,
-             "CPUCull should not be called on lines or points");
   const u32 stride = loader->m_native_vtx_decl.stride;
   const bool posHas3Elems = loader->m_native_vtx_decl.position.components >= 3;
   const bool perVertexPosMtx = loader->m_native_vtx_decl.posmtx.enable;
@@ -163,10 +214,37 @@ bool CPUCull::AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Prim
     cullmode = cullmode_invert[cullmode];
   const TransformFunction transform = m_transform_table[posHas3Elems][perVertexPosMtx];
   transform(m_transform_buffer.get(), src, stride, count);
+  return cullmode;
+}
+
+bool CPUCull::AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive,
+                                   const u8* src, u32 count)
+{
+  ASSERT_MSG(VIDEO, primitive < OpcodeDecoder::Primitive::GX_DRAW_LINES,
+             "CPUCull should not be called on lines or points");
+  const CullMode cullmode = TransformVertices(loader, src, count);
   const CullFunction cull = m_cull_table[primitive][cullmode];
   return cull(m_transform_buffer.get(), count);
 }
 
+u32 CPUCull::CullTriangles(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive,
+                           const u8* src, u32 count)
+{
+  ASSERT_MSG(VIDEO, primitive < OpcodeDecoder::Primitive::GX_DRAW_LINES,
+             "CPUCull should not be called on lines or points");
+  // No primitive produces more than one triangle per vertex
+  if (m_kept_indices_size < count * 3) [[unlikely]]
+  {
+    m_kept_indices_size = MathUtil::NextPowerOf2(count * 3);
+    m_kept_indices = std::make_unique<u16[]>(m_kept_indices_size);
+  }
+
+  const CullMode cullmode = TransformVertices(loader, src, count);
+  const CullTrianglesFunction cull = m_cull_triangles_table[primitive][cullmode];
+  m_kept_index_count = cull(m_transform_buffer.get(), count, m_kept_indices.get());
+  return GetTriangleCount(primitive, count) - m_kept_index_count / 3;
+}
+
 template <typename T>
 void CPUCull::BufferDeleter<T>::operator()(T* ptr)
 {
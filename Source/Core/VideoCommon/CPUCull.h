@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <span>
+
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/OpcodeDecoding.h"
@@ -14,6 +16,11 @@ public:
   void Init();
   bool AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive,
                             const u8* src, u32 count);
+  // Culls the individual triangles of a draw, returns the number of triangles which were culled.
+  // The indices of the remaining triangles are available from GetKeptIndices until the next call.
+  u32 CullTriangles(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive, const u8* src,
+                    u32 count);
+  std::span<const u16> GetKeptIndices() const { return {m_kept_indices.get(), m_kept_index_count}; }
 
   struct alignas(16) TransformedVertex
   {
@@ -22,8 +29,11 @@ public:
 
   using TransformFunction = void (*)(void*, const void*, u32, int);
   using CullFunction = bool (*)(const CPUCull::TransformedVertex*, int);
+  using CullTrianglesFunction = u32 (*)(const CPUCull::TransformedVertex*, int, u16*);
 
 private:
+  CullMode TransformVertices(VertexLoaderBase* loader, const u8* src, u32 count);
+
   template <typename T>
   struct BufferDeleter
   {
@@ -35,4 +45,10 @@ private:
   Common::EnumMap<Common::EnumMap<CullFunction, CullMode::All>,
                   OpcodeDecoder::Primitive::GX_DRAW_TRIANGLE_FAN>
       m_cull_table{};
+  Common::EnumMap<Common::EnumMap<CullTrianglesFunction, CullMode::All>,
+                  OpcodeDecoder::Primitive::GX_DRAW_TRIANGLE_FAN>
+      m_cull_triangles_table{};
+  std::unique_ptr<u16[]> m_kept_indices{};
+  u32 m_kept_indices_size = 0;
+  u32 m_kept_index_count = 0;
 };
@@ -708,6 +708,64 @@ ATTR_TARGET static bool AreAllVerticesCulled(const CPUCull::TransformedVertex* t
   return true;
 }
 
+template <CullMode Mode>
+ATTR_TARGET DOLPHIN_FORCE_INLINE static u16*
+KeepTriangle(const CPUCull::TransformedVertex* transformed, u16* index_ptr, int a, int b, int c)
+{
+  if (CullTriangle<Mode>(transformed[a], transformed[b], transformed[c]))
+    return index_ptr;
+  *index_ptr++ = static_cast<u16>(a);
+  *index_ptr++ = static_cast<u16>(b);
+  *index_ptr++ = static_cast<u16>(c);
+  return index_ptr;
+}
+
+template <OpcodeDecoder::Primitive Primitive, CullMode Mode>
+ATTR_TARGET static u32 CullTriangles(const CPUCull::TransformedVertex* transformed, int count,
+                                     u16* indices)
+{
+  // Triangles are visited in the same order and with the same winding as IndexGenerator uses
+  u16* index_ptr = indices;
+
+  switch (Primitive)
+  {
+  case OpcodeDecoder::Primitive::GX_DRAW_QUADS:
+  case OpcodeDecoder::Primitive::GX_DRAW_QUADS_2:
+  {
+    int i = 3;
+    for (; i < count; i += 4)
+    {
+      index_ptr = KeepTriangle<Mode>(transformed, index_ptr, i - 3, i - 2, i - 1);
+      index_ptr = KeepTriangle<Mode>(transformed, index_ptr, i - 3, i - 1, i - 0);
+    }
+    // three vertices remaining, so render a triangle
+    if (i == count)
+      index_ptr = KeepTriangle<Mode>(transformed, index_ptr, i - 3, i - 2, i - 1);
+    break;
+  }
+  case OpcodeDecoder::Primitive::GX_DRAW_TRIANGLES:
+    for (int i = 2; i < count; i += 3)
+      index_ptr = KeepTriangle<Mode>(transformed, index_ptr, i - 2, i - 1, i - 0);
+    break;
+  case OpcodeDecoder::Primitive::GX_DRAW_TRIANGLE_STRIP:
+  {
+    bool wind = false;
+    for (int i = 2; i < count; ++i)
+    {
+      index_ptr = KeepTriangle<Mode>(transformed, index_ptr, i - 2, i - !wind, i - wind);
+      wind = !wind;
+    }
+    break;
+  }
+  case OpcodeDecoder::Primitive::GX_DRAW_TRIANGLE_FAN:
+    for (int i = 2; i < count; ++i)
+      index_ptr = KeepTriangle<Mode>(transformed, index_ptr, 0, i - 1, i);
+    break;
+  }
+
+  return static_cast<u32>(index_ptr - indices);
+}
+
 }  // namespace VECTOR_NAMESPACE
 
 #undef ATTR_TARGET
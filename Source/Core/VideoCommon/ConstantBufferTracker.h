@@ -0,0 +1,77 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+struct ConstantBufferRange
+{
+  u32 offset;
+  u32 size;
+};
+
+// Keeps a copy of the last uploaded contents of a constant buffer, so that the parts which really
+// changed can be found. The shader managers set their dirty flag on every register write, even if
+// the value stays the same, and most draws only change a light or a matrix.
+template <typename T>
+class ConstantBufferTracker
+{
+public:
+  // Constants are compared in rows of one float4, which is also the unit that partial constant
+  // buffer updates work with.
+  static constexpr u32 ROW_SIZE = 16;
+
+  static_assert(std::is_trivially_copyable_v<T>);
+  static_assert(sizeof(T) % ROW_SIZE == 0);
+
+  // Returns the byte ranges in which the constants differ from the ones passed to the previous
+  // call, sorted and with neighbouring rows merged. Everything is returned after Invalidate.
+  std::span<const ConstantBufferRange> Update(const T& constants)
+  {
+    m_ranges.clear();
+
+    if (!m_valid)
+    {
+      m_ranges.push_back({0, sizeof(T)});
+      Store(constants);
+      return m_ranges;
+    }
+
+    const u8* new_data = reinterpret_cast<const u8*>(&constants);
+    u8* old_data = reinterpret_cast<u8*>(&m_uploaded);
+    for (u32 offset = 0; offset < sizeof(T); offset += ROW_SIZE)
+    {
+      if (std::memcmp(new_data + offset, old_data + offset, ROW_SIZE) == 0)
+        continue;
+
+      std::memcpy(old_data + offset, new_data + offset, ROW_SIZE);
+      if (!m_ranges.empty() && m_ranges.back().offset + m_ranges.back().size == offset)
+        m_ranges.back().size += ROW_SIZE;
+      else
+        m_ranges.push_back({offset, ROW_SIZE});
+    }
+
+    return m_ranges;
+  }
+
+  // Records constants which were uploaded without asking for the changed ranges
+  void Store(const T& constants)
+  {
+    std::memcpy(&m_uploaded, &constants, sizeof(T));
+    m_valid = true;
+  }
+
+  // Call when the buffer's contents or binding were replaced by something else
+  void Invalidate() { m_valid = false; }
+
+private:
+  T m_uploaded{};
+  bool m_valid = false;
+  std::vector<ConstantBufferRange> m_ranges;
+};
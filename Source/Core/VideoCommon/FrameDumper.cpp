@@ -3,6 +3,9 @@
 
 #include "VideoCommon/FrameDumper.h"
 
+#include <algorithm>
+#include <utility>
+
 #include "Common/Assert.h"
 #include "Common/FileUtil.h"
 #include "Common/Image.h"
@@ -27,7 +30,8 @@ static bool DumpFrameToPNG(const FrameData& frame, const std::string& file_name)
 
 FrameDumper::FrameDumper()
 {
-  m_frame_end_handle = AfterFrameEvent::Register([this] { FlushFrameDump(); }, "FrameDumper");
+  m_frame_end_handle =
+      AfterFrameEvent::Register([this] { QueueCompletedReadbacks(); }, "FrameDumper");
 }
 
 FrameDumper::~FrameDumper()
@@ -58,13 +62,18 @@ void FrameDumper::DumpCurrentFrame(const AbstractTexture* src_texture,
     copy_rect = src_texture->GetRect();
   }
 
-  if (!CheckFrameDumpReadbackTexture(target_width, target_height))
+  ReadbackSlot* const slot = AcquireReadbackSlot(target_width, target_height);
+  if (!slot)
+  {
+    m_dropped_frames++;
     return;
+  }
 
-  m_frame_dump_readback_texture->CopyFromTexture(src_texture, copy_rect, 0, 0,
-                                                 m_frame_dump_readback_texture->GetRect());
-  m_last_frame_state = m_ffmpeg_dump.FetchState(ticks, frame_number);
-  m_frame_dump_needs_flush = true;
+  slot->texture->CopyFromTexture(src_texture, copy_rect, 0, 0, slot->texture->GetRect());
+  slot->state = m_ffmpeg_dump.FetchState(ticks, frame_number);
+  slot->readback_state.store(ReadbackState::Copied, std::memory_order_relaxed);
+  m_copied_readbacks.push_back(m_next_readback_slot);
+  m_next_readback_slot = (m_next_readback_slot + 1) % NUM_READBACK_SLOTS;
 }
 
 bool FrameDumper::CheckFrameDumpRenderTexture(u32 target_width, u32 target_height)
@@ -95,62 +104,146 @@ bool FrameDumper::CheckFrameDumpRenderTexture(u32 target_width, u32 target_heigh
   return true;
 }
 
-bool FrameDumper::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height)
+FrameDumper::ReadbackSlot* FrameDumper::AcquireReadbackSlot(u32 target_width, u32 target_height)
 {
-  std::unique_ptr<AbstractStagingTexture>& rbtex = m_frame_dump_readback_texture;
+  ReadbackSlot& slot = m_readback_slots[m_next_readback_slot];
+
+  // The ring has wrapped around onto a frame which was never queued. This only happens if frames
+  // are dumped without the frame end event in between, so it's already late enough to map.
+  if (slot.readback_state.load(std::memory_order_relaxed) == ReadbackState::Copied)
+  {
+    std::erase(m_copied_readbacks, m_next_readback_slot);
+    QueueReadback(m_next_readback_slot);
+  }
+
+  if (slot.readback_state.load(std::memory_order_acquire) == ReadbackState::Encoding)
+  {
+    // The dump thread can't keep up, so the emulation has to wait for it.
+    m_late_frames++;
+    while (slot.readback_state.load(std::memory_order_acquire) == ReadbackState::Encoding)
+      m_frame_dump_done.Wait();
+  }
+
+  ReleaseEncodedReadbacks();
+
+  std::unique_ptr<AbstractStagingTexture>& rbtex = slot.texture;
   if (rbtex && rbtex->GetWidth() == target_width && rbtex->GetHeight() == target_height)
-    return true;
+    return &slot;
 
   rbtex.reset();
   rbtex = g_gfx->CreateStagingTexture(
       StagingTextureType::Readback,
       TextureConfig(target_width, target_height, 1, 1, 1, AbstractTextureFormat::RGBA8, 0));
   if (!rbtex)
-    return false;
+    return nullptr;
 
-  return true;
+  return &slot;
 }
 
-void FrameDumper::FlushFrameDump()
+void FrameDumper::ReleaseEncodedReadbacks()
+{
+  for (ReadbackSlot& slot : m_readback_slots)
+  {
+    if (slot.readback_state.load(std::memory_order_acquire) != ReadbackState::Encoded)
+      continue;
+
+    slot.texture->Unmap();
+    slot.readback_state.store(ReadbackState::Free, std::memory_order_relaxed);
+  }
+}
+
+void FrameDumper::QueueCompletedReadbacks()
 {
-  if (!m_frame_dump_needs_flush)
+  ReleaseEncodedReadbacks();
+
+  if (!IsFrameDumping())
+  {
+    // Shutdown frame dumping if it is no longer active.
+    ShutdownFrameDumping();
     return;
+  }
 
-  // Ensure dumping thread is done with output texture before swapping.
-  FinishFrameData();
+  // A screenshot only needs a single frame, and there might not be another frame to queue it with
+  // (e.g. if emulation is paused right after the screenshot was requested).
+  if (!Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES))
+  {
+    FlushFrameDump();
+    return;
+  }
 
-  std::swap(m_frame_dump_output_texture, m_frame_dump_readback_texture);
+  while (m_copied_readbacks.size() > 1)
+  {
+    QueueReadback(m_copied_readbacks.front());
+    m_copied_readbacks.pop_front();
+  }
+}
 
-  // Queue encoding of the last frame dumped.
-  auto& output = m_frame_dump_output_texture;
-  output->Flush();
-  if (output->Map())
+void FrameDumper::FlushFrameDump()
+{
+  while (!m_copied_readbacks.empty())
   {
-    DumpFrameData(reinterpret_cast<u8*>(output->GetMappedPointer()), output->GetConfig().width,
-                  output->GetConfig().height, static_cast<int>(output->GetMappedStride()));
+    QueueReadback(m_copied_readbacks.front());
+    m_copied_readbacks.pop_front();
   }
-  else
+}
+
+void FrameDumper::QueueReadback(size_t slot_index)
+{
+  ReadbackSlot& slot = m_readback_slots[slot_index];
+  AbstractStagingTexture* const texture = slot.texture.get();
+
+  texture->Flush();
+  if (!texture->Map())
   {
     ERROR_LOG_FMT(VIDEO, "Failed to map texture for dumping.");
+    slot.readback_state.store(ReadbackState::Free, std::memory_order_relaxed);
+    m_dropped_frames++;
+    return;
+  }
+
+  const FrameData data{reinterpret_cast<const u8*>(texture->GetMappedPointer()),
+                       static_cast<int>(texture->GetConfig().width),
+                       static_cast<int>(texture->GetConfig().height),
+                       static_cast<int>(texture->GetMappedStride()), slot.state};
+  slot.readback_state.store(ReadbackState::Encoding, std::memory_order_relaxed);
+  {
+    std::lock_guard lk(m_frame_queue_lock);
+    m_frame_queue.push_back({slot_index, data});
   }
 
-  m_frame_dump_needs_flush = false;
+  if (!m_frame_dump_thread_running.IsSet())
+  {
+    if (m_frame_dump_thread.joinable())
+      m_frame_dump_thread.join();
+    m_frame_dump_thread_running.Set();
+    m_frame_dump_thread = std::thread(&FrameDumper::FrameDumpThreadFunc, this);
+  }
 
-  // Shutdown frame dumping if it is no longer active.
-  if (!IsFrameDumping())
-    ShutdownFrameDumping();
+  // Wake worker thread up.
+  m_frame_dump_start.Set();
+}
+
+void FrameDumper::WaitForQueuedFrames()
+{
+  const auto is_encoding = [](const ReadbackSlot& slot) {
+    return slot.readback_state.load(std::memory_order_acquire) == ReadbackState::Encoding;
+  };
+  while (std::any_of(m_readback_slots.begin(), m_readback_slots.end(), is_encoding))
+    m_frame_dump_done.Wait();
+
+  ReleaseEncodedReadbacks();
 }
 
 void FrameDumper::ShutdownFrameDumping()
 {
-  // Ensure the last queued readback has been sent to the encoder.
+  // Ensure the queued readbacks have been sent to the encoder.
   FlushFrameDump();
 
   if (!m_frame_dump_thread_running.IsSet())
     return;
 
-  // Ensure previous frame has been encoded.
-  FinishFrameData();
+  // Ensure previous frames have been encoded.
+  WaitForQueuedFrames();
 
   // Wake thread up, and wait for it to exit.
   m_frame_dump_thread_running.Clear();
@@ -160,36 +253,28 @@ void FrameDumper::ShutdownFrameDumping()
   m_frame_dump_render_framebuffer.reset();
   m_frame_dump_render_texture.reset();
 
-  m_frame_dump_readback_texture.reset();
-  m_frame_dump_output_texture.reset();
+  for (ReadbackSlot& slot : m_readback_slots)
+    slot.texture.reset();
+  m_next_readback_slot = 0;
+
+  ReportFrameDumpStatistics();
 }
 
-void FrameDumper::DumpFrameData(const u8* data, int w, int h, int stride)
+void FrameDumper::ReportFrameDumpStatistics()
 {
-  m_frame_dump_data = FrameData{data, w, h, stride, m_last_frame_state};
-
-  if (!m_frame_dump_thread_running.IsSet())
+  if (m_dropped_frames != 0 || m_late_frames != 0)
   {
-    if (m_frame_dump_thread.joinable())
-      m_frame_dump_thread.join();
-    m_frame_dump_thread_running.Set();
-    m_frame_dump_thread = std::thread(&FrameDumper::FrameDumpThreadFunc, this);
+    WARN_LOG_FMT(VIDEO,
+                 "FrameDump: {} frame(s) could not be read back and were dropped, emulation had to "
+                 "wait for the encoder on {} frame(s).",
+                 m_dropped_frames, m_late_frames);
+    OSD::AddMessage(fmt::format("Frame dump: {} dropped, {} late frame(s)", m_dropped_frames,
+                                m_late_frames),
+                    OSD::Duration::VERY_LONG, OSD::Color::YELLOW);
   }
 
-  // Wake worker thread up.
-  m_frame_dump_start.Set();
-  m_frame_dump_frame_running = true;
-}
-
-void FrameDumper::FinishFrameData()
-{
-  if (!m_frame_dump_frame_running)
-    return;
-
-  m_frame_dump_done.Wait();
-  m_frame_dump_frame_running = false;
-
-  m_frame_dump_output_texture->Unmap();
+  m_dropped_frames = 0;
+  m_late_frames = 0;
 }
 
 void FrameDumper::FrameDumpThreadFunc()
@@ -215,14 +300,26 @@ void FrameDumper::FrameDumpThreadFunc()
     if (!m_frame_dump_thread_running.IsSet())
       break;
 
-    auto frame = m_frame_dump_data;
+    std::vector<QueuedFrame> queued_frames;
+    {
+      std::lock_guard lk(m_frame_queue_lock);
+      queued_frames.assign(m_frame_queue.begin(), m_frame_queue.end());
+      m_frame_queue.clear();
+    }
+    if (queued_frames.empty())
+      continue;
+
+    std::vector<FrameData> frames;
+    frames.reserve(queued_frames.size());
+    for (const QueuedFrame& queued_frame : queued_frames)
+      frames.push_back(queued_frame.data);
 
     // Save screenshot
     if (m_screenshot_request.TestAndClear())
     {
       std::lock_guard<std::mutex> lk(m_screenshot_lock);
 
-      if (DumpFrameToPNG(frame, m_screenshot_name))
+      if (DumpFrameToPNG(frames.front(), m_screenshot_name))
         OSD::AddMessage("Screenshot saved to " + m_screenshot_name);
 
       // Reset settings
@@ -235,9 +332,9 @@ void FrameDumper::FrameDumpThreadFunc()
       if (!frame_dump_started)
       {
         if (dump_to_ffmpeg)
-          frame_dump_started = StartFrameDumpToFFMPEG(frame);
+          frame_dump_started = StartFrameDumpToFFMPEG(frames.front());
         else
-          frame_dump_started = StartFrameDumpToImage(frame);
+          frame_dump_started = StartFrameDumpToImage(frames.front());
 
         // Stop frame dumping if we fail to start.
         if (!frame_dump_started)
@@ -248,12 +345,22 @@ void FrameDumper::FrameDumpThreadFunc()
       if (frame_dump_started)
       {
         if (dump_to_ffmpeg)
-          DumpFrameToFFMPEG(frame);
+        {
+          for (const FrameData& frame : frames)
+            DumpFrameToFFMPEG(frame);
+        }
         else
-          DumpFrameToImage(frame);
+        {
+          DumpFramesToImage(frames);
+        }
       }
     }
 
+    for (const QueuedFrame& queued_frame : queued_frames)
+    {
+      m_readback_slots[queued_frame.slot].readback_state.store(ReadbackState::Encoded,
+                                                                std::memory_order_release);
+    }
     m_frame_dump_done.Set();
   }
 
@@ -263,6 +370,8 @@ void FrameDumper::FrameDumpThreadFunc()
     if (dump_to_ffmpeg)
       StopFrameDumpToFFMPEG();
   }
+
+  m_image_encode_threads.Shutdown();
 }
 
 #if defined(HAVE_FFMPEG)
@@ -303,10 +412,9 @@ void FrameDumper::StopFrameDumpToFFMPEG()
 
 #endif  // defined(HAVE_FFMPEG)
 
-std::string FrameDumper::GetFrameDumpNextImageFileName() const
+std::string FrameDumper::GetFrameDumpImageFileName(u32 index) const
 {
-  return fmt::format("{}framedump_{}.png", File::GetUserPath(D_DUMPFRAMES_IDX),
-                     m_frame_dump_image_counter);
+  return fmt::format("{}framedump_{}.png", File::GetUserPath(D_DUMPFRAMES_IDX), index);
 }
 
 bool FrameDumper::StartFrameDumpToImage(const FrameData&)
@@ -317,7 +425,7 @@ bool FrameDumper::StartFrameDumpToImage(const FrameData&)
     // Only check for the presence of the first image to confirm overwriting.
     // A previous run will always have at least one image, and it's safe to assume that if the user
     // has allowed the first image to be overwritten, this will apply any remaining images as well.
-    std::string filename = GetFrameDumpNextImageFileName();
+    std::string filename = GetFrameDumpImageFileName(m_frame_dump_image_counter);
     if (File::Exists(filename))
     {
       if (!AskYesNoFmtT("Frame dump image(s) '{0}' already exists. Overwrite?", filename))
@@ -325,13 +433,23 @@ bool FrameDumper::StartFrameDumpToImage(const FrameData&)
     }
   }
 
+  // PNG compression is by far the slowest part of dumping images, and the dump thread can receive
+  // up to a full readback ring of frames at once when it falls behind.
+  const size_t thread_count = std::min<size_t>(
+      std::max(std::thread::hardware_concurrency(), 1u), NUM_READBACK_SLOTS);
+  m_image_encode_threads.Reset("Frame Dump Encoder", thread_count - 1);
+
   return true;
 }
 
-void FrameDumper::DumpFrameToImage(const FrameData& frame)
+void FrameDumper::DumpFramesToImage(const std::vector<FrameData>& frames)
 {
-  DumpFrameToPNG(frame, GetFrameDumpNextImageFileName());
-  m_frame_dump_image_counter++;
+  const u32 first_index = m_frame_dump_image_counter;
+  m_frame_dump_image_counter += static_cast<u32>(frames.size());
+
+  m_image_encode_threads.ParallelFor(frames.size(), [&](size_t i, size_t) {
+    DumpFrameToPNG(frames[i], GetFrameDumpImageFileName(first_index + static_cast<u32>(i)));
+  });
 }
 
 void FrameDumper::SaveScreenshot(std::string filename)
@@ -3,11 +3,18 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <vector>
+
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/Flag.h"
 #include "Common/MathUtil.h"
 #include "Common/Thread.h"
+#include "Common/ThreadPool.h"
 
 #include "VideoCommon/FrameDumpFFMpeg.h"
 #include "VideoCommon/VideoEvents.h"
@@ -25,7 +32,7 @@ public:
   // Ensures all rendered frames are queued for encoding.
   void FlushFrameDump();
 
-  // Fills the frame dump staging texture with the current XFB texture.
+  // Queues a readback of the current XFB texture into the next frame dump staging texture.
   void DumpCurrentFrame(const AbstractTexture* src_texture,
                         const MathUtil::Rectangle<int>& src_rect,
                         const MathUtil::Rectangle<int>& target_rect, u64 ticks, int frame_number);
@@ -37,28 +44,68 @@ public:
   void DoState(PointerWrap& p);
 
 private:
+  // Number of staging textures frames are read back into. The dump thread can hold on to all but
+  // one of them while it encodes, so short encoding stalls don't hold up the video thread.
+  static constexpr size_t NUM_READBACK_SLOTS = 4;
+
+  enum class ReadbackState
+  {
+    // The staging texture can be reused.
+    Free,
+    // A copy into the staging texture has been queued on the GPU.
+    Copied,
+    // The staging texture is mapped and being encoded by the dump thread.
+    Encoding,
+    // The dump thread is done with the staging texture, but it still needs to be unmapped.
+    Encoded,
+  };
+
+  struct ReadbackSlot
+  {
+    std::unique_ptr<AbstractStagingTexture> texture;
+    FrameState state;
+    std::atomic<ReadbackState> readback_state = ReadbackState::Free;
+  };
+
+  struct QueuedFrame
+  {
+    size_t slot;
+    FrameData data;
+  };
+
   // NOTE: The methods below are called on the framedumping thread.
   void FrameDumpThreadFunc();
   bool StartFrameDumpToFFMPEG(const FrameData&);
   void DumpFrameToFFMPEG(const FrameData&);
   void StopFrameDumpToFFMPEG();
-  std::string GetFrameDumpNextImageFileName() const;
+  std::string GetFrameDumpImageFileName(u32 index) const;
   bool StartFrameDumpToImage(const FrameData&);
-  void DumpFrameToImage(const FrameData&);
+  void DumpFramesToImage(const std::vector<FrameData>& frames);
+
+  // Queues the readbacks of every frame but the most recent one. The most recent frame was copied
+  // this frame, so mapping it now would likely stall until the GPU has caught up. Screenshots are
+  // queued right away, as there is no following frame to overlap their readback with.
+  void QueueCompletedReadbacks();
 
   void ShutdownFrameDumping();
 
   // Checks that the frame dump render texture exists and is the correct size.
   bool CheckFrameDumpRenderTexture(u32 target_width, u32 target_height);
 
-  // Checks that the frame dump readback texture exists and is the correct size.
-  bool CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height);
+  // Returns the next readback slot, making sure its staging texture exists and is the correct size.
+  // Waits for the dump thread if it is still encoding the frame in the slot.
+  ReadbackSlot* AcquireReadbackSlot(u32 target_width, u32 target_height);
+
+  // Unmaps the staging textures the dump thread is done with.
+  void ReleaseEncodedReadbacks();
 
-  // Asynchronously encodes the specified pointer of frame data to the frame dump.
-  void DumpFrameData(const u8* data, int w, int h, int stride);
+  // Maps the slot's staging texture and asynchronously encodes it to the frame dump.
+  void QueueReadback(size_t slot_index);
 
-  // Ensures all encoded frames have been written to the output file.
-  void FinishFrameData();
+  // Waits for the dump thread to finish encoding every queued frame.
+  void WaitForQueuedFrames();
+
+  void ReportFrameDumpStatistics();
 
   std::thread m_frame_dump_thread;
   Common::Flag m_frame_dump_thread_running;
@@ -66,26 +113,30 @@ private:
   // Used to kick frame dump thread.
   Common::Event m_frame_dump_start;
 
-  // Set by frame dump thread on frame completion.
+  // Set by frame dump thread whenever it finishes encoding frames.
   Common::Event m_frame_dump_done;
 
-  // Holds emulation state during the last swap when dumping.
-  FrameState m_last_frame_state;
-
-  // Communication of frame between video and dump threads.
-  FrameData m_frame_dump_data;
+  // Frames waiting to be encoded, oldest first. Guarded by m_frame_queue_lock.
+  std::mutex m_frame_queue_lock;
+  std::deque<QueuedFrame> m_frame_queue;
 
   // Texture used for screenshot/frame dumping
   std::unique_ptr<AbstractTexture> m_frame_dump_render_texture;
   std::unique_ptr<AbstractFramebuffer> m_frame_dump_render_framebuffer;
 
-  // Double buffer:
-  std::unique_ptr<AbstractStagingTexture> m_frame_dump_readback_texture;
-  std::unique_ptr<AbstractStagingTexture> m_frame_dump_output_texture;
-  // Set when readback texture holds a frame that needs to be dumped.
-  bool m_frame_dump_needs_flush = false;
-  // Set when thread is processing output texture.
-  bool m_frame_dump_frame_running = false;
+  // Readback ring. Slots are used in order, and m_copied_readbacks holds the indices of the slots
+  // which have been copied to but not queued yet, oldest first.
+  std::array<ReadbackSlot, NUM_READBACK_SLOTS> m_readback_slots;
+  size_t m_next_readback_slot = 0;
+  std::deque<size_t> m_copied_readbacks;
+
+  // Frames which couldn't be read back, and frames for which the video thread had to wait for the
+  // dump thread to free up a readback slot.
+  u32 m_dropped_frames = 0;
+  u32 m_late_frames = 0;
+
+  // Used to compress image dumps in parallel. Only used by the dump thread.
+  Common::ThreadPool m_image_encode_threads;
 
   // Used to generate screenshot names.
   u32 m_frame_dump_image_counter = 0;
@@ -0,0 +1,63 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/FrameTimeHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+void FrameTimeHistogram::Reset()
+{
+  m_buckets.fill(0);
+  m_count = 0;
+  m_total = DT::zero();
+  m_max = DT::zero();
+}
+
+void FrameTimeHistogram::Add(DT frame_time)
+{
+  frame_time = std::max(frame_time, DT::zero());
+  const size_t bucket = std::min<size_t>(frame_time / BUCKET_WIDTH, BUCKET_COUNT - 1);
+  ++m_buckets[bucket];
+  ++m_count;
+  m_total += frame_time;
+  m_max = std::max(m_max, frame_time);
+}
+
+DT FrameTimeHistogram::GetAverage() const
+{
+  if (m_count == 0)
+    return DT::zero();
+
+  return m_total / m_count;
+}
+
+DT FrameTimeHistogram::GetPercentile(double percentile) const
+{
+  if (m_count == 0)
+    return DT::zero();
+
+  const double clamped = std::clamp(percentile, 0.0, 100.0);
+  const u64 target = std::max<u64>(static_cast<u64>(std::ceil(clamped / 100.0 * m_count)), 1);
+
+  u64 seen = 0;
+  for (size_t i = 0; i < BUCKET_COUNT; ++i)
+  {
+    seen += m_buckets[i];
+    if (seen >= target)
+      return BUCKET_WIDTH * (i + 1);
+  }
+
+  return BUCKET_WIDTH * BUCKET_COUNT;
+}
+
+FrameTimeHistogram FrameTimeHistogram::Since(const FrameTimeHistogram& earlier) const
+{
+  FrameTimeHistogram result;
+  for (size_t i = 0; i < BUCKET_COUNT; ++i)
+    result.m_buckets[i] = m_buckets[i] - earlier.m_buckets[i];
+  result.m_count = m_count - earlier.m_count;
+  result.m_total = m_total - earlier.m_total;
+  result.m_max = m_max;
+  return result;
+}
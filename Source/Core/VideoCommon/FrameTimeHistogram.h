@@ -0,0 +1,45 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <chrono>
+
+#include "Common/CommonTypes.h"
+
+// Counts frame times in buckets of a tenth of a millisecond, which is enough to tell percentiles
+// apart at any frame rate that matters. Frame times past the last bucket are counted in it, the
+// longest frame time is tracked separately so that it isn't limited by that.
+class FrameTimeHistogram
+{
+public:
+  static constexpr DT BUCKET_WIDTH = std::chrono::microseconds(100);
+  static constexpr size_t BUCKET_COUNT = 2500;
+
+  void Reset();
+  void Add(DT frame_time);
+
+  u64 GetCount() const { return m_count; }
+  DT GetTotal() const { return m_total; }
+  DT GetAverage() const;
+
+  // Returns the upper end of the bucket which contains the given percentile (0 to 100) of frame
+  // times, or zero if nothing was counted.
+  DT GetPercentile(double percentile) const;
+
+  // Returns the longest frame time counted since Reset or the last call to ResetMax.
+  DT GetMax() const { return m_max; }
+  void ResetMax() { m_max = DT::zero(); }
+
+  // Returns the frame times which were counted after earlier was copied from this histogram. The
+  // longest frame time can't be recovered from the difference, so for it to only cover those frames
+  // ResetMax has to be called whenever such a copy is made.
+  FrameTimeHistogram Since(const FrameTimeHistogram& earlier) const;
+
+private:
+  std::array<u32, BUCKET_COUNT> m_buckets{};
+  u64 m_count = 0;
+  DT m_total = DT::zero();
+  DT m_max = DT::zero();
+};
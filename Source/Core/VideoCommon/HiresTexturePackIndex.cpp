@@ -0,0 +1,393 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/HiresTexturePackIndex.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+#include <unordered_set>
+#include <utility>
+
+#include <fmt/format.h>
+#include <xxhash.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+
+namespace
+{
+constexpr u32 INDEX_MAGIC = 0x49544844;  // "DHTI"
+constexpr u32 INDEX_VERSION = 1;
+
+constexpr std::string_view TEXTURE_PREFIX = "tex1_";
+constexpr std::string_view ARBITRARY_MIPMAPS_SUFFIX = "_arb";
+
+struct IndexHeader
+{
+  u32 magic;
+  u32 version;
+  u32 directory_count;
+  u32 entry_count;
+  u32 strings_size;
+  u32 padding;
+};
+
+struct DirectoryRecord
+{
+  s64 write_time;
+  u32 path_offset;
+  u32 path_size;
+};
+
+struct EntryRecord
+{
+  u64 name_hash;
+  u64 file_size;
+  u32 name_offset;
+  u32 name_size;
+  u32 path_offset;
+  u32 path_size;
+  u32 flags;
+  u32 padding;
+};
+
+constexpr u32 ENTRY_FLAG_ARBITRARY_MIPMAPS = 1;
+
+template <typename T>
+T ReadRecord(const std::vector<u8>& data, size_t offset)
+{
+  T record;
+  std::memcpy(&record, data.data() + offset, sizeof(T));
+  return record;
+}
+
+template <typename T>
+void AppendRecord(std::vector<u8>* data, const T& record)
+{
+  const u8* const bytes = reinterpret_cast<const u8*>(&record);
+  data->insert(data->end(), bytes, bytes + sizeof(T));
+}
+
+std::optional<s64> GetWriteTime(const std::filesystem::path& path)
+{
+  std::error_code error;
+  const auto write_time = std::filesystem::last_write_time(path, error);
+  if (error)
+    return std::nullopt;
+  return static_cast<s64>(write_time.time_since_epoch().count());
+}
+
+bool IsTextureFile(const std::filesystem::path& path)
+{
+  const std::string extension = PathToString(path.extension());
+  return Common::CaseInsensitiveEquals(extension, ".png") ||
+         Common::CaseInsensitiveEquals(extension, ".dds");
+}
+
+std::string GetRelativePath(const std::filesystem::path& path, const std::filesystem::path& root)
+{
+  std::string relative_path = PathToString(path.lexically_relative(root));
+  if constexpr (std::filesystem::path::preferred_separator != '/')
+    std::replace(relative_path.begin(), relative_path.end(), '\\', '/');
+  if (relative_path == ".")
+    relative_path.clear();
+  return relative_path;
+}
+}  // namespace
+
+std::optional<HiresTexturePackIndex> HiresTexturePackIndex::Open(const std::string& pack_directory)
+{
+  const std::string index_path = GetIndexPath(pack_directory);
+
+  if (auto index = Read(pack_directory, index_path); index && index->IsUpToDate())
+    return index;
+
+  INFO_LOG_FMT(VIDEO, "Building custom texture index for '{}'", pack_directory);
+  if (!Build(pack_directory, index_path))
+    return std::nullopt;
+
+  return Read(pack_directory, index_path);
+}
+
+u64 HiresTexturePackIndex::HashName(std::string_view name)
+{
+  return XXH64(name.data(), name.size(), 0);
+}
+
+std::string HiresTexturePackIndex::GetIndexPath(const std::string& pack_directory)
+{
+  return fmt::format("{}HiresTextures" DIR_SEP "{:016x}.idx", File::GetUserPath(D_CACHE_IDX),
+                     HashName(pack_directory));
+}
+
+bool HiresTexturePackIndex::Build(const std::string& pack_directory, const std::string& index_path)
+{
+  const std::filesystem::path root = StringToPath(pack_directory);
+
+  struct TextureFile
+  {
+    std::string relative_path;
+    std::string name;
+    u64 file_size;
+    bool has_arbitrary_mipmaps;
+  };
+
+  std::vector<DirectoryRecord> directories;
+  std::vector<TextureFile> texture_files;
+  std::string strings;
+
+  const auto add_string = [&strings](std::string_view string) {
+    const auto offset = static_cast<u32>(strings.size());
+    strings.append(string);
+    return std::make_pair(offset, static_cast<u32>(string.size()));
+  };
+
+  const auto add_directory = [&](const std::filesystem::path& path) {
+    const std::optional<s64> write_time = GetWriteTime(path);
+    if (!write_time)
+      return false;
+
+    const auto [path_offset, path_size] = add_string(GetRelativePath(path, root));
+    directories.push_back(DirectoryRecord{*write_time, path_offset, path_size});
+    return true;
+  };
+
+  if (!add_directory(root))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to access custom texture directory '{}'", pack_directory);
+    return false;
+  }
+
+  std::error_code error;
+  for (auto it = std::filesystem::recursive_directory_iterator(root, error);
+       !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error))
+  {
+    const std::filesystem::directory_entry& directory_entry = *it;
+    std::error_code status_error;
+
+    if (directory_entry.is_directory(status_error))
+    {
+      add_directory(directory_entry.path());
+      continue;
+    }
+
+    if (!directory_entry.is_regular_file(status_error) || !IsTextureFile(directory_entry.path()))
+      continue;
+
+    std::string name = PathToString(directory_entry.path().stem());
+    if (!name.starts_with(TEXTURE_PREFIX))
+      continue;
+
+    const size_t arb_index = name.rfind(ARBITRARY_MIPMAPS_SUFFIX);
+    const bool has_arbitrary_mipmaps = arb_index != std::string::npos;
+    if (has_arbitrary_mipmaps)
+      name.erase(arb_index, ARBITRARY_MIPMAPS_SUFFIX.size());
+
+    const u64 file_size = directory_entry.file_size(status_error);
+    texture_files.push_back(TextureFile{GetRelativePath(directory_entry.path(), root),
+                                        std::move(name), status_error ? 0 : file_size,
+                                        has_arbitrary_mipmaps});
+  }
+
+  if (error)
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to scan custom texture directory '{}': {}", pack_directory,
+                  error.message());
+    return false;
+  }
+
+  // When several files map to the same texture, the first one in path order wins, no matter what
+  // order the filesystem lists them in.
+  std::sort(texture_files.begin(), texture_files.end(),
+            [](const TextureFile& a, const TextureFile& b) {
+              return a.relative_path < b.relative_path;
+            });
+
+  std::vector<EntryRecord> entries;
+  std::unordered_set<std::string_view> names;
+  bool has_duplicates = false;
+  for (const TextureFile& texture_file : texture_files)
+  {
+    if (!names.insert(texture_file.name).second)
+    {
+      has_duplicates = true;
+      continue;
+    }
+
+    const auto [name_offset, name_size] = add_string(texture_file.name);
+    const auto [path_offset, path_size] = add_string(texture_file.relative_path);
+    entries.push_back(EntryRecord{
+        HashName(texture_file.name), texture_file.file_size, name_offset, name_size, path_offset,
+        path_size, texture_file.has_arbitrary_mipmaps ? ENTRY_FLAG_ARBITRARY_MIPMAPS : 0, 0});
+  }
+
+  if (has_duplicates)
+  {
+    ERROR_LOG_FMT(VIDEO, "One or more textures at path '{}' were already inserted",
+                  pack_directory);
+  }
+
+  std::sort(entries.begin(), entries.end(), [&strings](const EntryRecord& a, const EntryRecord& b) {
+    if (a.name_hash != b.name_hash)
+      return a.name_hash < b.name_hash;
+    return std::string_view(strings).substr(a.name_offset, a.name_size) <
+           std::string_view(strings).substr(b.name_offset, b.name_size);
+  });
+
+  std::vector<u8> data;
+  data.reserve(sizeof(IndexHeader) + directories.size() * sizeof(DirectoryRecord) +
+               entries.size() * sizeof(EntryRecord) + strings.size());
+  AppendRecord(&data, IndexHeader{INDEX_MAGIC, INDEX_VERSION, static_cast<u32>(directories.size()),
+                                  static_cast<u32>(entries.size()),
+                                  static_cast<u32>(strings.size()), 0});
+  for (const DirectoryRecord& directory : directories)
+    AppendRecord(&data, directory);
+  for (const EntryRecord& entry : entries)
+    AppendRecord(&data, entry);
+  data.insert(data.end(), strings.begin(), strings.end());
+
+  // Write to a temporary file first so that an interrupted write can't leave a broken index behind.
+  const std::string temp_path = index_path + ".tmp";
+  File::CreateFullPath(index_path);
+  {
+    File::IOFile file(temp_path, "wb");
+    if (!file.WriteBytes(data.data(), data.size()))
+    {
+      ERROR_LOG_FMT(VIDEO, "Failed to write custom texture index '{}'", temp_path);
+      return false;
+    }
+  }
+
+  return File::Rename(temp_path, index_path);
+}
+
+std::optional<HiresTexturePackIndex> HiresTexturePackIndex::Read(const std::string& pack_directory,
+                                                                 const std::string& index_path)
+{
+  File::IOFile file(index_path, "rb");
+  if (!file)
+    return std::nullopt;
+
+  HiresTexturePackIndex index;
+  index.m_pack_directory = pack_directory;
+  index.m_data.resize(file.GetSize());
+  if (index.m_data.size() < sizeof(IndexHeader) ||
+      !file.ReadBytes(index.m_data.data(), index.m_data.size()))
+  {
+    return std::nullopt;
+  }
+
+  const auto header = ReadRecord<IndexHeader>(index.m_data, 0);
+  if (header.magic != INDEX_MAGIC || header.version != INDEX_VERSION)
+    return std::nullopt;
+
+  index.m_directory_count = header.directory_count;
+  index.m_entry_count = header.entry_count;
+  index.m_entries_offset =
+      sizeof(IndexHeader) + index.m_directory_count * sizeof(DirectoryRecord);
+  index.m_strings_offset = index.m_entries_offset + index.m_entry_count * sizeof(EntryRecord);
+  if (index.m_strings_offset + header.strings_size != index.m_data.size())
+    return std::nullopt;
+
+  // Validate the string references once here so that lookups don't have to.
+  const auto is_valid_string = [&header](u32 offset, u32 size) {
+    return u64(offset) + size <= header.strings_size;
+  };
+  for (size_t i = 0; i < index.m_directory_count; ++i)
+  {
+    const auto record = ReadRecord<DirectoryRecord>(
+        index.m_data, sizeof(IndexHeader) + i * sizeof(DirectoryRecord));
+    if (!is_valid_string(record.path_offset, record.path_size))
+      return std::nullopt;
+  }
+  for (size_t i = 0; i < index.m_entry_count; ++i)
+  {
+    const auto record =
+        ReadRecord<EntryRecord>(index.m_data, index.m_entries_offset + i * sizeof(EntryRecord));
+    if (!is_valid_string(record.name_offset, record.name_size) ||
+        !is_valid_string(record.path_offset, record.path_size))
+    {
+      return std::nullopt;
+    }
+  }
+
+  return index;
+}
+
+bool HiresTexturePackIndex::IsUpToDate() const
+{
+  // Adding, removing or renaming a file changes the modification time of its directory.
+  for (size_t i = 0; i < m_directory_count; ++i)
+  {
+    const auto record =
+        ReadRecord<DirectoryRecord>(m_data, sizeof(IndexHeader) + i * sizeof(DirectoryRecord));
+    const std::string_view relative_path = GetString(record.path_offset, record.path_size);
+    const std::string path = relative_path.empty() ?
+                                 m_pack_directory :
+                                 fmt::format("{}/{}", m_pack_directory, relative_path);
+    if (GetWriteTime(StringToPath(path)) != record.write_time)
+      return false;
+  }
+
+  return true;
+}
+
+std::string_view HiresTexturePackIndex::GetString(u32 offset, u32 size) const
+{
+  return std::string_view(reinterpret_cast<const char*>(m_data.data() + m_strings_offset + offset),
+                          size);
+}
+
+HiresTexturePackIndex::Entry HiresTexturePackIndex::GetEntry(size_t index) const
+{
+  const auto record =
+      ReadRecord<EntryRecord>(m_data, m_entries_offset + index * sizeof(EntryRecord));
+  return Entry{GetString(record.name_offset, record.name_size),
+               GetString(record.path_offset, record.path_size), record.file_size,
+               (record.flags & ENTRY_FLAG_ARBITRARY_MIPMAPS) != 0};
+}
+
+std::optional<HiresTexturePackIndex::Entry> HiresTexturePackIndex::Find(std::string_view name) const
+{
+  return Find(name, HashName(name));
+}
+
+std::optional<HiresTexturePackIndex::Entry> HiresTexturePackIndex::Find(std::string_view name,
+                                                                         u64 name_hash) const
+{
+  const auto get_hash = [this](size_t index) {
+    return ReadRecord<EntryRecord>(m_data, m_entries_offset + index * sizeof(EntryRecord))
+        .name_hash;
+  };
+
+  // Binary search for the first entry with the hash.
+  size_t first = 0;
+  size_t count = m_entry_count;
+  while (count > 0)
+  {
+    const size_t step = count / 2;
+    if (get_hash(first + step) < name_hash)
+    {
+      first += step + 1;
+      count -= step + 1;
+    }
+    else
+    {
+      count = step;
+    }
+  }
+
+  for (size_t i = first; i < m_entry_count && get_hash(i) == name_hash; ++i)
+  {
+    const Entry entry = GetEntry(i);
+    if (entry.name == name)
+      return entry;
+  }
+
+  return std::nullopt;
+}
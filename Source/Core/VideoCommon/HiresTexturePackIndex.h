@@ -0,0 +1,65 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// An index of the custom textures in a texture pack directory, so that large packs don't have to be
+// scanned every time a game is started.
+//
+// The index is built the first time a pack is used and kept in the cache directory. It's a flat
+// file which is used as is once it has been read: a header, the pack's directories along with their
+// modification times (which are checked to notice textures being added or removed), the textures
+// sorted by the hash of their name, and finally the strings referenced by the other records.
+class HiresTexturePackIndex
+{
+public:
+  struct Entry
+  {
+    // The texture name without the "_arb" suffix, e.g. "tex1_64x64_0123456789abcdef_5".
+    std::string_view name;
+    // Relative to the pack directory, using '/' as the separator.
+    std::string_view path;
+    u64 file_size;
+    bool has_arbitrary_mipmaps;
+  };
+
+  // Loads the index of the given pack directory, (re)building it if needed.
+  static std::optional<HiresTexturePackIndex> Open(const std::string& pack_directory);
+
+  static u64 HashName(std::string_view name);
+
+  std::optional<Entry> Find(std::string_view name) const;
+  std::optional<Entry> Find(std::string_view name, u64 name_hash) const;
+
+  size_t GetEntryCount() const { return m_entry_count; }
+  Entry GetEntry(size_t index) const;
+
+  const std::string& GetPackDirectory() const { return m_pack_directory; }
+
+private:
+  HiresTexturePackIndex() = default;
+
+  static std::string GetIndexPath(const std::string& pack_directory);
+  static bool Build(const std::string& pack_directory, const std::string& index_path);
+  static std::optional<HiresTexturePackIndex> Read(const std::string& pack_directory,
+                                                   const std::string& index_path);
+
+  // Checks that none of the pack's directories have changed since the index was built.
+  bool IsUpToDate() const;
+
+  std::string_view GetString(u32 offset, u32 size) const;
+
+  std::string m_pack_directory;
+  std::vector<u8> m_data;
+  size_t m_directory_count = 0;
+  size_t m_entry_count = 0;
+  size_t m_entries_offset = 0;
+  size_t m_strings_offset = 0;
+};
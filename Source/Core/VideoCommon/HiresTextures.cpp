@@ -4,15 +4,17 @@
 #include "VideoCommon/HiresTextures.h"
 
 #include <algorithm>
+#include <list>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
-#include <xxhash.h>
 
 #include <fmt/format.h>
 
@@ -20,6 +22,7 @@
 #include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
+#include "Common/MemoryUtil.h"
 #include "Common/StringUtil.h"
 #include "Core/Config/GraphicsSettings.h"
 #include "Core/ConfigManager.h"
@@ -27,53 +30,174 @@
 #include "VideoCommon/Assets/CustomAsset.h"
 #include "VideoCommon/Assets/CustomAssetLoader.h"
 #include "VideoCommon/Assets/DirectFilesystemAssetLibrary.h"
+#include "VideoCommon/Assets/TexturePackArchive.h"
+#include "VideoCommon/HiresTexturePackIndex.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoConfig.h"
 
-constexpr std::string_view s_format_prefix{"tex1_"};
+namespace
+{
+struct CachedHiresTexture
+{
+  std::shared_ptr<HiresTexture> texture;
+  // Loaded size of the texture, or the size of its file until it's been loaded.
+  size_t size;
+  // Set once the texture has been requested and its load has been moved ahead of prefetches.
+  bool prioritized;
+  std::list<std::string>::iterator lru_position;
+};
+
+struct TextureMatch
+{
+  std::string name;
+  bool has_arbitrary_mipmaps;
+  // Size of the texture's file, or of the decoded texture if it's from an archive.
+  u64 size;
+  // Set for textures which are loaded from their own file.
+  const HiresTexturePackIndex* index;
+  std::string_view path;
+  // Set for textures which are loaded from a texture pack archive.
+  std::shared_ptr<VideoCommon::TexturePackArchiveLibrary> archive;
+};
+}  // namespace
 
-static std::unordered_map<std::string, std::shared_ptr<HiresTexture>> s_hires_texture_cache;
-static std::unordered_map<std::string, bool> s_hires_texture_id_to_arbmipmap;
+// One index per texture directory, in order of precedence.
+static std::vector<HiresTexturePackIndex> s_pack_indices;
+// Texture pack archives found in the texture directories. Textures in their own files take
+// precedence over those in archives, so that archived packs can still be patched.
+static std::vector<std::shared_ptr<VideoCommon::TexturePackArchiveLibrary>> s_pack_archives;
+
+// Textures which have been requested or prefetched, limited by the memory budget.
+static std::unordered_map<std::string, CachedHiresTexture> s_hires_texture_cache;
+// Names of the cached textures, most recently used first.
+static std::list<std::string> s_hires_texture_lru;
+static size_t s_hires_texture_cache_size = 0;
 
 static auto s_file_library = std::make_shared<VideoCommon::DirectFilesystemAssetLibrary>();
 
 namespace
 {
-std::pair<std::string, bool> GetNameArbPair(const TextureInfo& texture_info)
+TextureMatch MakeMatch(const HiresTexturePackIndex& index,
+                       const HiresTexturePackIndex::Entry& entry)
 {
-  if (s_hires_texture_id_to_arbmipmap.empty())
-    return {"", false};
+  return TextureMatch{std::string(entry.name), entry.has_arbitrary_mipmaps, entry.file_size,
+                      &index, entry.path, nullptr};
+}
 
-  const auto texture_name_details = texture_info.CalculateTextureName();
-  // look for an exact match first
-  const std::string full_name = texture_name_details.GetFullName();
-  if (auto iter = s_hires_texture_id_to_arbmipmap.find(full_name);
-      iter != s_hires_texture_id_to_arbmipmap.end())
+TextureMatch MakeMatch(const std::shared_ptr<VideoCommon::TexturePackArchiveLibrary>& archive,
+                       const VideoCommon::TexturePackArchiveLibrary::TextureEntry& entry)
+{
+  return TextureMatch{std::string(entry.name), entry.has_arbitrary_mipmaps, entry.size, nullptr,
+                      {}, archive};
+}
+
+std::optional<TextureMatch> FindTexture(const std::string& name)
+{
+  const u64 name_hash = HiresTexturePackIndex::HashName(name);
+  for (const HiresTexturePackIndex& index : s_pack_indices)
+  {
+    if (const auto entry = index.Find(name, name_hash))
+      return MakeMatch(index, *entry);
+  }
+  for (const auto& archive : s_pack_archives)
   {
-    return {full_name, iter->second};
+    if (const auto entry = archive->FindTexture(name))
+      return MakeMatch(archive, *entry);
   }
+  return std::nullopt;
+}
+
+std::optional<TextureMatch> FindTexture(const TextureInfo& texture_info)
+{
+  if (s_pack_indices.empty() && s_pack_archives.empty())
+    return std::nullopt;
+
+  const auto texture_name_details = texture_info.CalculateTextureName();
+  // look for an exact match first
+  if (auto match = FindTexture(texture_name_details.GetFullName()))
+    return match;
 
   // Single wildcard ignoring the tlut hash
-  const std::string texture_name_single_wildcard_tlut =
-      fmt::format("{}_{}_$_{}", texture_name_details.base_name, texture_name_details.texture_name,
-                  texture_name_details.format_name);
-  if (auto iter = s_hires_texture_id_to_arbmipmap.find(texture_name_single_wildcard_tlut);
-      iter != s_hires_texture_id_to_arbmipmap.end())
+  if (auto match = FindTexture(fmt::format("{}_{}_$_{}", texture_name_details.base_name,
+                                           texture_name_details.texture_name,
+                                           texture_name_details.format_name)))
   {
-    return {texture_name_single_wildcard_tlut, iter->second};
+    return match;
   }
 
   // Single wildcard ignoring the texture hash
-  const std::string texture_name_single_wildcard_tex =
-      fmt::format("{}_${}_{}", texture_name_details.base_name, texture_name_details.tlut_name,
-                  texture_name_details.format_name);
-  if (auto iter = s_hires_texture_id_to_arbmipmap.find(texture_name_single_wildcard_tex);
-      iter != s_hires_texture_id_to_arbmipmap.end())
+  return FindTexture(fmt::format("{}_${}_{}", texture_name_details.base_name,
+                                 texture_name_details.tlut_name,
+                                 texture_name_details.format_name));
+}
+
+size_t GetMemoryBudget()
+{
+  if (g_ActiveConfig.iHiresTextureMemoryBudgetMB > 0)
+    return static_cast<size_t>(g_ActiveConfig.iHiresTextureMemoryBudgetMB) * 1024 * 1024;
+
+  // Leave plenty of room for the emulator and the textures which are actually on the GPU.
+  return Common::MemPhysical() / 4;
+}
+
+std::shared_ptr<HiresTexture> LoadTexture(const TextureMatch& match,
+                                          VideoCommon::CustomAssetLoader::LoadPriority priority)
+{
+  auto& loader = Core::System::GetInstance().GetCustomAssetLoader();
+  if (match.archive)
+  {
+    return std::make_shared<HiresTexture>(
+        match.has_arbitrary_mipmaps, loader.LoadGameTexture(match.name, match.archive, priority));
+  }
+
+  // Assets are only mapped to their files once they're used, since large packs contain a lot of
+  // textures which a game session never needs.
+  // Since this is just a texture (single file) the mapper doesn't really matter
+  // just provide a string
+  s_file_library->SetAssetIDMapData(
+      match.name, std::map<std::string, std::filesystem::path>{
+                      {"", StringToPath(fmt::format("{}/{}", match.index->GetPackDirectory(),
+                                                    match.path))}});
+
+  return std::make_shared<HiresTexture>(
+      match.has_arbitrary_mipmaps, loader.LoadGameTexture(match.name, s_file_library, priority));
+}
+
+void TouchCachedTexture(CachedHiresTexture* cached)
+{
+  s_hires_texture_lru.splice(s_hires_texture_lru.begin(), s_hires_texture_lru,
+                             cached->lru_position);
+
+  const size_t loaded_size = cached->texture->GetAsset()->GetByteSizeInMemory();
+  if (loaded_size != 0 && loaded_size != cached->size)
+  {
+    s_hires_texture_cache_size = s_hires_texture_cache_size - cached->size + loaded_size;
+    cached->size = loaded_size;
+  }
+}
+
+void EvictCachedTextures(size_t budget)
+{
+  // Textures still in use by the texture cache stay alive through their entries, evicting them
+  // only means that they have to be loaded again once nothing references them anymore.
+  while (s_hires_texture_cache_size > budget && s_hires_texture_lru.size() > 1)
   {
-    return {texture_name_single_wildcard_tex, iter->second};
+    const auto iter = s_hires_texture_cache.find(s_hires_texture_lru.back());
+    s_hires_texture_cache_size -= iter->second.size;
+    s_hires_texture_cache.erase(iter);
+    s_hires_texture_lru.pop_back();
   }
+}
+
+void InsertCachedTexture(const TextureMatch& match, std::shared_ptr<HiresTexture> texture,
+                         bool prioritized)
+{
+  s_hires_texture_lru.push_front(match.name);
 
-  return {"", false};
+  CachedHiresTexture cached{std::move(texture), match.size, prioritized,
+                            s_hires_texture_lru.begin()};
+  s_hires_texture_cache_size += cached.size;
+  s_hires_texture_cache.try_emplace(match.name, std::move(cached));
 }
 }  // namespace
 
@@ -89,109 +213,124 @@ void HiresTexture::Shutdown()
 
 void HiresTexture::Update()
 {
+  Clear();
+
   if (!g_ActiveConfig.bHiresTextures)
-  {
-    Clear();
     return;
-  }
 
   const std::string& game_id = SConfig::GetInstance().GetGameID();
   const std::set<std::string> texture_directories =
       GetTextureDirectoriesWithGameId(File::GetUserPath(D_HIRESTEXTURES_IDX), game_id);
-  const std::vector<std::string> extensions{".png", ".dds"};
-
-  auto& system = Core::System::GetInstance();
 
+  size_t texture_count = 0;
   for (const auto& texture_directory : texture_directories)
   {
-    const auto texture_paths =
-        Common::DoFileSearch({texture_directory}, extensions, /*recursive*/ true);
+    auto index = HiresTexturePackIndex::Open(texture_directory);
+    if (!index)
+      continue;
 
-    bool failed_insert = false;
-    for (auto& path : texture_paths)
+    texture_count += index->GetEntryCount();
+    s_pack_indices.push_back(std::move(*index));
+  }
+
+  for (const auto& texture_directory : texture_directories)
+  {
+    for (const std::string& path :
+         Common::DoFileSearch({texture_directory}, {".dtp"}, /*recursive*/ false))
     {
-      std::string filename;
-      SplitPath(path, nullptr, &filename, nullptr);
-
-      if (filename.substr(0, s_format_prefix.length()) == s_format_prefix)
-      {
-        const size_t arb_index = filename.rfind("_arb");
-        const bool has_arbitrary_mipmaps = arb_index != std::string::npos;
-        if (has_arbitrary_mipmaps)
-          filename.erase(arb_index, 4);
-
-        const auto [it, inserted] =
-            s_hires_texture_id_to_arbmipmap.try_emplace(filename, has_arbitrary_mipmaps);
-        if (!inserted)
-        {
-          failed_insert = true;
-        }
-        else
-        {
-          // Since this is just a texture (single file) the mapper doesn't really matter
-          // just provide a string
-          s_file_library->SetAssetIDMapData(
-              filename, std::map<std::string, std::filesystem::path>{{"", StringToPath(path)}});
-
-          if (g_ActiveConfig.bCacheHiresTextures)
-          {
-            auto hires_texture = std::make_shared<HiresTexture>(
-                has_arbitrary_mipmaps,
-                system.GetCustomAssetLoader().LoadGameTexture(filename, s_file_library));
-            s_hires_texture_cache.try_emplace(filename, std::move(hires_texture));
-          }
-        }
-      }
+      auto archive = VideoCommon::TexturePackArchiveLibrary::Open(path);
+      if (!archive)
+        continue;
+
+      texture_count += archive->GetTextureCount();
+      s_pack_archives.push_back(std::move(archive));
     }
+  }
+
+  if (!g_ActiveConfig.bCacheHiresTextures)
+  {
+    OSD::AddMessage(fmt::format("Found '{}' custom textures", texture_count), 10000);
+    return;
+  }
 
-    if (failed_insert)
+  // Prefetch textures until their files alone fill the memory budget. Decoded textures are
+  // usually larger than their files, the cache is trimmed as their real sizes become known.
+  const size_t budget = GetMemoryBudget();
+  bool failed_insert = false;
+  const auto prefetch = [&](const TextureMatch& match) {
+    if (s_hires_texture_cache.contains(match.name))
     {
-      ERROR_LOG_FMT(VIDEO, "One or more textures at path '{}' were already inserted",
-                    texture_directory);
+      failed_insert = true;
+      return;
     }
-  }
 
-  if (g_ActiveConfig.bCacheHiresTextures)
+    InsertCachedTexture(
+        match, LoadTexture(match, VideoCommon::CustomAssetLoader::LoadPriority::Background), false);
+  };
+  for (const HiresTexturePackIndex& index : s_pack_indices)
   {
-    OSD::AddMessage(fmt::format("Loading '{}' custom textures", s_hires_texture_cache.size()),
-                    10000);
+    for (size_t i = 0; i < index.GetEntryCount() && s_hires_texture_cache_size < budget; ++i)
+      prefetch(MakeMatch(index, index.GetEntry(i)));
   }
-  else
+  for (const auto& archive : s_pack_archives)
   {
-    OSD::AddMessage(
-        fmt::format("Found '{}' custom textures", s_hires_texture_id_to_arbmipmap.size()), 10000);
+    for (size_t i = 0; i < archive->GetTextureCount() && s_hires_texture_cache_size < budget; ++i)
+      prefetch(MakeMatch(archive, archive->GetTexture(i)));
   }
+
+  if (failed_insert)
+    ERROR_LOG_FMT(VIDEO, "One or more textures were provided by multiple texture directories");
+
+  if (s_hires_texture_cache.size() < texture_count)
+  {
+    WARN_LOG_FMT(VIDEO, "Only prefetching {} of {} custom textures because of the memory budget",
+                 s_hires_texture_cache.size(), texture_count);
+  }
+
+  OSD::AddMessage(fmt::format("Loading '{}' custom textures", s_hires_texture_cache.size()),
+                  10000);
 }
 
 void HiresTexture::Clear()
 {
   s_hires_texture_cache.clear();
-  s_hires_texture_id_to_arbmipmap.clear();
+  s_hires_texture_lru.clear();
+  s_hires_texture_cache_size = 0;
+  s_pack_indices.clear();
+  s_pack_archives.clear();
   s_file_library = std::make_shared<VideoCommon::DirectFilesystemAssetLibrary>();
 }
 
 std::shared_ptr<HiresTexture> HiresTexture::Search(const TextureInfo& texture_info)
 {
-  const auto [base_filename, has_arb_mipmaps] = GetNameArbPair(texture_info);
-  if (base_filename == "")
+  const std::optional<TextureMatch> match = FindTexture(texture_info);
+  if (!match)
     return nullptr;
 
-  if (auto iter = s_hires_texture_cache.find(base_filename); iter != s_hires_texture_cache.end())
+  if (auto iter = s_hires_texture_cache.find(match->name); iter != s_hires_texture_cache.end())
   {
-    return iter->second;
-  }
-  else
-  {
-    auto& system = Core::System::GetInstance();
-    auto hires_texture = std::make_shared<HiresTexture>(
-        has_arb_mipmaps,
-        system.GetCustomAssetLoader().LoadGameTexture(base_filename, s_file_library));
-    if (g_ActiveConfig.bCacheHiresTextures)
+    CachedHiresTexture& cached = iter->second;
+    TouchCachedTexture(&cached);
+
+    // A prefetched texture which hasn't been loaded yet is needed now.
+    if (!cached.prioritized)
     {
-      s_hires_texture_cache.try_emplace(base_filename, hires_texture);
+      auto& system = Core::System::GetInstance();
+      system.GetCustomAssetLoader().PrioritizeAsset(cached.texture->GetAsset());
+      cached.prioritized = true;
     }
-    return hires_texture;
+
+    EvictCachedTextures(GetMemoryBudget());
+    return cached.texture;
+  }
+
+  auto hires_texture = LoadTexture(*match, VideoCommon::CustomAssetLoader::LoadPriority::Demand);
+  if (g_ActiveConfig.bCacheHiresTextures)
+  {
+    InsertCachedTexture(*match, hires_texture, true);
+    EvictCachedTextures(GetMemoryBudget());
   }
+  return hires_texture;
 }
 
 HiresTexture::HiresTexture(bool has_arbitrary_mipmaps,
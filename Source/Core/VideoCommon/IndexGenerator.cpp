@@ -61,6 +61,17 @@ u16* AddStrip(u16* index_ptr, u32 num_verts, u32 index)
   return index_ptr;
 }
 
+template <bool pr>
+u16* AddTriangles(u16* index_ptr, const u16* indices, u32 num_triangles, u32 index)
+{
+  for (u32 i = 0; i < num_triangles; ++i, indices += 3)
+  {
+    index_ptr = WriteTriangle<pr>(index_ptr, index + indices[0], index + indices[1],
+                                  index + indices[2]);
+  }
+  return index_ptr;
+}
+
 /**
  * FAN simulator:
  *
@@ -273,6 +284,8 @@ void IndexGenerator::Init()
     m_primitive_table[Primitive::GX_DRAW_TRIANGLES] = AddList<true>;
     m_primitive_table[Primitive::GX_DRAW_TRIANGLE_STRIP] = AddStrip<true>;
     m_primitive_table[Primitive::GX_DRAW_TRIANGLE_FAN] = AddFan<true>;
+    m_triangle_list_function = AddTriangles<true>;
+    m_triangle_list_index_stride = 4;
   }
   else
   {
@@ -281,6 +294,8 @@ void IndexGenerator::Init()
     m_primitive_table[Primitive::GX_DRAW_TRIANGLES] = AddList<false>;
     m_primitive_table[Primitive::GX_DRAW_TRIANGLE_STRIP] = AddStrip<false>;
     m_primitive_table[Primitive::GX_DRAW_TRIANGLE_FAN] = AddFan<false>;
+    m_triangle_list_function = AddTriangles<false>;
+    m_triangle_list_index_stride = 3;
   }
   if (g_Config.UseVSForLinePointExpand())
   {
@@ -326,6 +341,13 @@ void IndexGenerator::AddExternalIndices(const u16* indices, u32 num_indices, u32
   m_base_index += num_vertices;
 }
 
+void IndexGenerator::AddTriangleList(const u16* indices, u32 num_triangles, u32 num_vertices)
+{
+  m_index_buffer_current =
+      m_triangle_list_function(m_index_buffer_current, indices, num_triangles, m_base_index);
+  m_base_index += num_vertices;
+}
+
 u32 IndexGenerator::GetRemainingIndices(OpcodeDecoder::Primitive primitive) const
 {
   u32 max_index = UINT16_MAX;
@@ -20,6 +20,13 @@ public:
 
   void AddExternalIndices(const u16* indices, u32 num_indices, u32 num_vertices);
 
+  // Adds a list of triangles whose indices are relative to the first of the added vertices
+  void AddTriangleList(const u16* indices, u32 num_triangles, u32 num_vertices);
+  u32 GetTriangleListLength(u32 num_triangles) const
+  {
+    return num_triangles * m_triangle_list_index_stride;
+  }
+
   // returns numprimitives
   u32 GetNumVerts() const { return m_base_index; }
   u32 GetIndexLen() const { return static_cast<u32>(m_index_buffer_current - m_base_index_ptr); }
@@ -32,4 +39,8 @@ private:
 
   using PrimitiveFunction = u16* (*)(u16*, u32, u32);
   Common::EnumMap<PrimitiveFunction, OpcodeDecoder::Primitive::GX_DRAW_POINTS> m_primitive_table{};
+
+  using TriangleListFunction = u16* (*)(u16*, const u16*, u32, u32);
+  TriangleListFunction m_triangle_list_function = nullptr;
+  u32 m_triangle_list_index_stride = 3;
 };
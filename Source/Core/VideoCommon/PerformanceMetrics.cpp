@@ -15,20 +15,45 @@
 
 PerformanceMetrics g_perf_metrics;
 
+PerformanceMetrics::BusyScope::BusyScope(PerformanceMetrics& metrics, BusyThread thread)
+    : m_metrics(metrics), m_thread(thread)
+{
+  if (m_metrics.IsBusyTimeEnabled())
+    m_start = Clock::now();
+}
+
+PerformanceMetrics::BusyScope::~BusyScope()
+{
+  if (m_start)
+    m_metrics.CountBusyTime(m_thread, Clock::now() - *m_start);
+}
+
 void PerformanceMetrics::Reset()
 {
   m_fps_counter.Reset();
   m_vps_counter.Reset();
   m_speed_counter.Reset();
 
+  std::unique_lock lock(m_time_lock);
   m_time_sleeping = DT::zero();
   m_real_times.fill(Clock::now());
   m_cpu_times.fill(Core::System::GetInstance().GetCoreTiming().GetCPUTimePoint(0));
+
+  m_frame_times.Reset();
+  m_shader_compile_stall = DT::zero();
+  m_shader_compile_stall_count = 0;
+  for (std::atomic<DT::rep>& busy_time : m_busy_time)
+    busy_time.store(0, std::memory_order_relaxed);
 }
 
 void PerformanceMetrics::CountFrame()
 {
-  m_fps_counter.Count();
+  const std::optional<DT> frame_time = m_fps_counter.Count();
+  if (!frame_time)
+    return;
+
+  std::unique_lock lock(m_time_lock);
+  m_frame_times.Add(*frame_time);
 }
 
 void PerformanceMetrics::CountVBlank()
@@ -42,6 +67,23 @@ void PerformanceMetrics::CountThrottleSleep(DT sleep)
   m_time_sleeping += sleep;
 }
 
+void PerformanceMetrics::CountShaderCompileStall(DT stall)
+{
+  std::unique_lock lock(m_time_lock);
+  m_shader_compile_stall += stall;
+  ++m_shader_compile_stall_count;
+}
+
+void PerformanceMetrics::SetBusyTimeEnabled(bool enabled)
+{
+  m_busy_time_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void PerformanceMetrics::CountBusyTime(BusyThread thread, DT time)
+{
+  m_busy_time[static_cast<size_t>(thread)].fetch_add(time.count(), std::memory_order_relaxed);
+}
+
 void PerformanceMetrics::CountPerformanceMarker(Core::System& system, s64 cyclesLate)
 {
   std::unique_lock lock(m_time_lock);
@@ -80,6 +122,22 @@ double PerformanceMetrics::GetLastSpeedDenominator() const
          Core::System::GetInstance().GetVideoInterface().GetTargetRefreshRate();
 }
 
+PerformanceMetrics::Counters PerformanceMetrics::GetCounters()
+{
+  Counters counters;
+  counters.time = Clock::now();
+  for (size_t i = 0; i < m_busy_time.size(); ++i)
+    counters.busy_time[i] = DT(m_busy_time[i].load(std::memory_order_relaxed));
+
+  std::unique_lock lock(m_time_lock);
+  counters.frame_times = m_frame_times;
+  m_frame_times.ResetMax();
+  counters.throttle_sleep = m_time_sleeping;
+  counters.shader_compile_stall = m_shader_compile_stall;
+  counters.shader_compile_stall_count = m_shader_compile_stall_count;
+  return counters;
+}
+
 void PerformanceMetrics::DrawImGuiStats(const float backbuffer_scale)
 {
   const float bg_alpha = 0.7f;
@@ -4,9 +4,12 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <optional>
 #include <shared_mutex>
 
 #include "Common/CommonTypes.h"
+#include "VideoCommon/FrameTimeHistogram.h"
 #include "VideoCommon/PerformanceTracker.h"
 
 namespace Core
@@ -17,6 +20,44 @@ class System;
 class PerformanceMetrics
 {
 public:
+  // Threads whose busy time is measured while SetBusyTimeEnabled(true). The GPU thread only
+  // exists in dual core mode and the DSP thread only with DSP LLE on a separate thread.
+  enum class BusyThread
+  {
+    GPU,
+    DSP,
+    Count,
+  };
+
+  // Totals since the last Reset. Rates and ratios are computed from the difference between two
+  // of these, see PerformanceMetricsExporter. The longest frame time in frame_times only covers the
+  // frames since the previous call to GetCounters.
+  struct Counters
+  {
+    TimePoint time;
+    FrameTimeHistogram frame_times;
+    DT throttle_sleep;
+    std::array<DT, static_cast<size_t>(BusyThread::Count)> busy_time;
+    DT shader_compile_stall;
+    u64 shader_compile_stall_count;
+  };
+
+  // Adds the time until the end of the scope to the busy time of a thread
+  class BusyScope
+  {
+  public:
+    BusyScope(PerformanceMetrics& metrics, BusyThread thread);
+    ~BusyScope();
+
+    BusyScope(const BusyScope&) = delete;
+    BusyScope& operator=(const BusyScope&) = delete;
+
+  private:
+    PerformanceMetrics& m_metrics;
+    BusyThread m_thread;
+    std::optional<TimePoint> m_start;
+  };
+
   PerformanceMetrics() = default;
   ~PerformanceMetrics() = default;
 
@@ -32,6 +73,12 @@ public:
 
   void CountThrottleSleep(DT sleep);
   void CountPerformanceMarker(Core::System& system, s64 cyclesLate);
+  void CountShaderCompileStall(DT stall);
+
+  // Measuring busy time costs a clock read around every piece of work, so it's off by default
+  void SetBusyTimeEnabled(bool enabled);
+  bool IsBusyTimeEnabled() const { return m_busy_time_enabled.load(std::memory_order_relaxed); }
+  void CountBusyTime(BusyThread thread, DT time);
 
   // Getter Functions
   double GetFPS() const;
@@ -41,6 +88,8 @@ public:
 
   double GetLastSpeedDenominator() const;
 
+  Counters GetCounters();
+
   // ImGui Functions
   void DrawImGuiStats(const float backbuffer_scale);
 
@@ -57,6 +106,13 @@ private:
   std::array<TimePoint, 256> m_real_times{};
   std::array<TimePoint, 256> m_cpu_times{};
   DT m_time_sleeping{};
+
+  FrameTimeHistogram m_frame_times;
+  DT m_shader_compile_stall{};
+  u64 m_shader_compile_stall_count = 0;
+
+  std::atomic_bool m_busy_time_enabled = false;
+  std::array<std::atomic<DT::rep>, static_cast<size_t>(BusyThread::Count)> m_busy_time{};
 };
 
 extern PerformanceMetrics g_perf_metrics;
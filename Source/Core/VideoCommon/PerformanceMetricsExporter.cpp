@@ -0,0 +1,223 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/PerformanceMetricsExporter.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include <fmt/format.h>
+
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+#include "Common/Thread.h"
+#include "Core/Config/MainSettings.h"
+
+namespace
+{
+double ToMs(DT time)
+{
+  return DT_ms(time).count();
+}
+
+double GetBusyRatio(DT busy, DT interval)
+{
+  if (interval <= DT::zero())
+    return 0.0;
+
+  return std::clamp(DT_s(busy) / DT_s(interval), 0.0, 1.0);
+}
+}  // namespace
+
+PerformanceMetricsExporter::PerformanceMetricsExporter(const std::string& file_path,
+                                                       const std::string& socket_path,
+                                                       std::chrono::milliseconds interval)
+    : m_interval(interval), m_start_time(Clock::now()), m_previous(g_perf_metrics.GetCounters())
+{
+  if (!file_path.empty())
+    OpenFile(file_path);
+  if (!socket_path.empty())
+    OpenSocket(socket_path);
+
+  g_perf_metrics.SetBusyTimeEnabled(true);
+  m_thread = std::thread(&PerformanceMetricsExporter::ThreadFunc, this);
+}
+
+PerformanceMetricsExporter::~PerformanceMetricsExporter()
+{
+  m_stop_event.Set();
+  m_thread.join();
+
+  g_perf_metrics.SetBusyTimeEnabled(false);
+
+#ifndef _WIN32
+  if (m_socket >= 0)
+    close(m_socket);
+#endif
+}
+
+std::unique_ptr<PerformanceMetricsExporter> PerformanceMetricsExporter::CreateFromConfig()
+{
+  const std::string file_path = Config::Get(Config::MAIN_PERF_METRICS_EXPORT_PATH);
+#ifndef _WIN32
+  const std::string socket_path = Config::Get(Config::MAIN_PERF_METRICS_EXPORT_SOCKET);
+#else
+  const std::string socket_path;
+#endif
+  if (file_path.empty() && socket_path.empty())
+    return nullptr;
+
+  const int interval_ms = std::max(Config::Get(Config::MAIN_PERF_METRICS_EXPORT_INTERVAL), 10);
+  return std::make_unique<PerformanceMetricsExporter>(file_path, socket_path,
+                                                      std::chrono::milliseconds(interval_ms));
+}
+
+bool PerformanceMetricsExporter::OpenFile(const std::string& path)
+{
+  if (!m_file.Open(path, "ab"))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to open performance metrics file {}", path);
+    return false;
+  }
+
+  std::string lower_path = path;
+  Common::ToLower(&lower_path);
+  m_csv = lower_path.ends_with(".csv");
+  if (m_csv && m_file.GetSize() == 0)
+    m_file.WriteString(GetCSVHeader());
+
+  return true;
+}
+
+bool PerformanceMetricsExporter::OpenSocket(const std::string& path)
+{
+#ifndef _WIN32
+  sockaddr_un addr{};
+  if (path.size() >= sizeof(addr.sun_path))
+  {
+    ERROR_LOG_FMT(VIDEO, "Performance metrics socket path {} is too long", path);
+    return false;
+  }
+
+  m_socket = socket(AF_UNIX, SOCK_DGRAM, 0);
+  if (m_socket < 0)
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to create performance metrics socket");
+    return false;
+  }
+
+  m_socket_path = path;
+  return true;
+#else
+  return false;
+#endif
+}
+
+void PerformanceMetricsExporter::ThreadFunc()
+{
+  Common::SetCurrentThreadName("Performance metrics exporter");
+
+  while (!m_stop_event.WaitFor(m_interval))
+    Export();
+}
+
+void PerformanceMetricsExporter::Export()
+{
+  const PerformanceMetrics::Counters current = g_perf_metrics.GetCounters();
+  const Sample sample = MakeSample(m_previous, current, m_start_time);
+  m_previous = current;
+
+  if (m_file.IsOpen())
+  {
+    m_file.WriteString(m_csv ? FormatCSV(sample) : FormatJSON(sample));
+    m_file.Flush();
+  }
+
+#ifndef _WIN32
+  if (m_socket >= 0)
+  {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, m_socket_path.c_str(), m_socket_path.size());
+
+    // Samples are dropped rather than delaying the next ones if nobody is reading them
+    const std::string message = FormatJSON(sample);
+    sendto(m_socket, message.data(), message.size(), MSG_DONTWAIT,
+           reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+  }
+#endif
+}
+
+PerformanceMetricsExporter::Sample
+PerformanceMetricsExporter::MakeSample(const PerformanceMetrics::Counters& previous,
+                                       const PerformanceMetrics::Counters& current,
+                                       TimePoint start_time)
+{
+  const DT interval = current.time - previous.time;
+  const FrameTimeHistogram frame_times = current.frame_times.Since(previous.frame_times);
+  const DT throttle_sleep = current.throttle_sleep - previous.throttle_sleep;
+  const auto get_busy_time = [&](PerformanceMetrics::BusyThread thread) {
+    const size_t index = static_cast<size_t>(thread);
+    return current.busy_time[index] - previous.busy_time[index];
+  };
+
+  Sample sample;
+  sample.time_ms = ToMs(current.time - start_time);
+  sample.interval_ms = ToMs(interval);
+  sample.fps = g_perf_metrics.GetFPS();
+  sample.vps = g_perf_metrics.GetVPS();
+  sample.speed = g_perf_metrics.GetSpeed();
+  sample.frames = frame_times.GetCount();
+  sample.frame_time_avg_ms = ToMs(frame_times.GetAverage());
+  sample.frame_time_p50_ms = ToMs(frame_times.GetPercentile(50));
+  sample.frame_time_p90_ms = ToMs(frame_times.GetPercentile(90));
+  sample.frame_time_p99_ms = ToMs(frame_times.GetPercentile(99));
+  sample.frame_time_max_ms = ToMs(frame_times.GetMax());
+  sample.cpu_busy = 1.0 - GetBusyRatio(throttle_sleep, interval);
+  sample.gpu_busy = GetBusyRatio(get_busy_time(PerformanceMetrics::BusyThread::GPU), interval);
+  sample.dsp_busy = GetBusyRatio(get_busy_time(PerformanceMetrics::BusyThread::DSP), interval);
+  sample.throttle_sleep_ms = ToMs(throttle_sleep);
+  sample.shader_compile_stall_ms =
+      ToMs(current.shader_compile_stall - previous.shader_compile_stall);
+  sample.shader_compile_stalls =
+      current.shader_compile_stall_count - previous.shader_compile_stall_count;
+  return sample;
+}
+
+std::string PerformanceMetricsExporter::FormatJSON(const Sample& s)
+{
+  return fmt::format(
+      "{{\"time_ms\":{:.3f},\"interval_ms\":{:.3f},\"fps\":{:.3f},\"vps\":{:.3f},"
+      "\"speed\":{:.4f},\"frames\":{},\"frame_time_ms\":{{\"avg\":{:.3f},\"p50\":{:.3f},"
+      "\"p90\":{:.3f},\"p99\":{:.3f},\"max\":{:.3f}}},\"busy\":{{\"cpu\":{:.4f},\"gpu\":{:.4f},"
+      "\"dsp\":{:.4f}}},\"throttle_sleep_ms\":{:.3f},\"shader_compile_stall_ms\":{:.3f},"
+      "\"shader_compile_stalls\":{}}}\n",
+      s.time_ms, s.interval_ms, s.fps, s.vps, s.speed, s.frames, s.frame_time_avg_ms,
+      s.frame_time_p50_ms, s.frame_time_p90_ms, s.frame_time_p99_ms, s.frame_time_max_ms,
+      s.cpu_busy, s.gpu_busy, s.dsp_busy, s.throttle_sleep_ms, s.shader_compile_stall_ms,
+      s.shader_compile_stalls);
+}
+
+std::string PerformanceMetricsExporter::GetCSVHeader()
+{
+  return "time_ms,interval_ms,fps,vps,speed,frames,frame_time_avg_ms,frame_time_p50_ms,"
+         "frame_time_p90_ms,frame_time_p99_ms,frame_time_max_ms,cpu_busy,gpu_busy,dsp_busy,"
+         "throttle_sleep_ms,shader_compile_stall_ms,shader_compile_stalls\n";
+}
+
+std::string PerformanceMetricsExporter::FormatCSV(const Sample& s)
+{
+  return fmt::format("{:.3f},{:.3f},{:.3f},{:.3f},{:.4f},{},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},"
+                     "{:.4f},{:.4f},{:.4f},{:.3f},{:.3f},{}\n",
+                     s.time_ms, s.interval_ms, s.fps, s.vps, s.speed, s.frames,
+                     s.frame_time_avg_ms, s.frame_time_p50_ms, s.frame_time_p90_ms,
+                     s.frame_time_p99_ms, s.frame_time_max_ms, s.cpu_busy, s.gpu_busy,
+                     s.dsp_busy, s.throttle_sleep_ms, s.shader_compile_stall_ms,
+                     s.shader_compile_stalls);
+}
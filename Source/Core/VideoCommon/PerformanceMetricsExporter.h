@@ -0,0 +1,83 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "Common/Event.h"
+#include "Common/IOFile.h"
+#include "VideoCommon/PerformanceMetrics.h"
+
+// Periodically samples g_perf_metrics, for collecting them from instances without a window to
+// show the statistics in. Every sample covers the time since the previous one.
+//
+// Samples are appended to a file, as one JSON object per line, or as CSV if the file name ends in
+// ".csv". Where Unix domain sockets are available, every sample can also be sent as a JSON
+// datagram to a socket which another process is listening on.
+class PerformanceMetricsExporter final
+{
+public:
+  struct Sample
+  {
+    double time_ms;
+    double interval_ms;
+    double fps;
+    double vps;
+    double speed;
+    u64 frames;
+    double frame_time_avg_ms;
+    double frame_time_p50_ms;
+    double frame_time_p90_ms;
+    double frame_time_p99_ms;
+    double frame_time_max_ms;
+    // Share of the interval which the thread spent working. The CPU thread counts as busy except
+    // while it's sleeping to limit the emulation speed.
+    double cpu_busy;
+    double gpu_busy;
+    double dsp_busy;
+    double throttle_sleep_ms;
+    double shader_compile_stall_ms;
+    u64 shader_compile_stalls;
+  };
+
+  PerformanceMetricsExporter(const std::string& file_path, const std::string& socket_path,
+                             std::chrono::milliseconds interval);
+  ~PerformanceMetricsExporter();
+
+  PerformanceMetricsExporter(const PerformanceMetricsExporter&) = delete;
+  PerformanceMetricsExporter& operator=(const PerformanceMetricsExporter&) = delete;
+
+  // Returns nullptr if exporting isn't configured
+  static std::unique_ptr<PerformanceMetricsExporter> CreateFromConfig();
+
+  static Sample MakeSample(const PerformanceMetrics::Counters& previous,
+                           const PerformanceMetrics::Counters& current, TimePoint start_time);
+  static std::string FormatJSON(const Sample& sample);
+  static std::string FormatCSV(const Sample& sample);
+  static std::string GetCSVHeader();
+
+private:
+  bool OpenFile(const std::string& path);
+  bool OpenSocket(const std::string& path);
+  void ThreadFunc();
+  void Export();
+
+  std::chrono::milliseconds m_interval;
+  TimePoint m_start_time;
+  PerformanceMetrics::Counters m_previous;
+
+  File::IOFile m_file;
+  bool m_csv = false;
+
+#ifndef _WIN32
+  int m_socket = -1;
+  std::string m_socket_path;
+#endif
+
+  Common::Event m_stop_event;
+  std::thread m_thread;
+};
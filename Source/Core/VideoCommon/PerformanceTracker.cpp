@@ -47,12 +47,12 @@ void PerformanceTracker::Reset()
   m_dt_std = std::nullopt;
 }
 
-void PerformanceTracker::Count()
+std::optional<DT> PerformanceTracker::Count()
 {
   std::unique_lock lock{m_mutex};
 
   if (m_paused)
-    return;
+    return std::nullopt;
 
   const DT window{GetSampleWindow()};
 
@@ -87,6 +87,8 @@ void PerformanceTracker::Count()
   m_dt_std = std::nullopt;
 
   LogRenderTimeToFile(diff);
+
+  return diff;
 }
 
 DT PerformanceTracker::GetSampleWindow() const
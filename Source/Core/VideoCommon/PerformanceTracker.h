@@ -45,7 +45,8 @@ public:
 
   // Functions for recording performance information
   void Reset();
-  void Count();
+  // Returns the time since the previous call, or nothing while paused
+  std::optional<DT> Count();
 
   // Functions for reading performance information
   DT GetSampleWindow() const;
@@ -99,6 +99,7 @@ void Statistics::Display() const
   draw_statistic("Draw calls", "%d", this_frame.num_draw_calls);
   draw_statistic("Primitives", "%d", this_frame.num_prims);
   draw_statistic("Primitives (DL)", "%d", this_frame.num_dl_prims);
+  draw_statistic("Triangles CPU culled", "%d", this_frame.num_triangles_cpu_culled);
   draw_statistic("XF loads", "%d", this_frame.num_xf_loads);
   draw_statistic("XF loads (DL)", "%d", this_frame.num_xf_loads_in_dl);
   draw_statistic("CP loads", "%d", this_frame.num_cp_loads);
@@ -108,6 +109,7 @@ void Statistics::Display() const
   draw_statistic("Vertex streamed", "%i kB", this_frame.bytes_vertex_streamed / 1024);
   draw_statistic("Index streamed", "%i kB", this_frame.bytes_index_streamed / 1024);
   draw_statistic("Uniform streamed", "%i kB", this_frame.bytes_uniform_streamed / 1024);
+  draw_statistic("Uniform changed", "%i kB", this_frame.bytes_uniform_changed / 1024);
   draw_statistic("Vertex Loaders", "%d", num_vertex_loaders);
   draw_statistic("EFB peeks:", "%d", this_frame.num_efb_peeks);
   draw_statistic("EFB pokes:", "%d", this_frame.num_efb_pokes);
@@ -57,11 +57,13 @@ struct Statistics
     int bytes_vertex_streamed = 0;
     int bytes_index_streamed = 0;
     int bytes_uniform_streamed = 0;
+    int bytes_uniform_changed = 0;
 
     int num_triangles_clipped = 0;
     int num_triangles_in = 0;
     int num_triangles_rejected = 0;
     int num_triangles_culled = 0;
+    int num_triangles_cpu_culled = 0;
     int num_drawn_objects = 0;
     int rasterized_pixels = 0;
     int num_triangles_drawn = 0;
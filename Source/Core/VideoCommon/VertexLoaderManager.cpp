@@ -381,22 +381,34 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
     const bool cullall = (bpmem.genMode.cullmode == CullMode::All &&
                           primitive < OpcodeDecoder::Primitive::GX_DRAW_LINES);
 
+    // Culling individual triangles doesn't save draw calls, but the GPU doesn't have to set up
+    // triangles which are invisible anyway
+    const bool cull_triangles = g_ActiveConfig.bCPUCullTriangles &&
+                                primitive < OpcodeDecoder::Primitive::GX_DRAW_LINES && !cullall;
+
     const int stride = loader->m_native_vtx_decl.stride;
     DataReader dst = g_vertex_manager->PrepareForAdditionalData(primitive, count, stride,
                                                                 cullall || can_cpu_cull);
 
     count = loader->RunVertices(src, dst.GetPointer(), count);
 
-    if (can_cpu_cull && !cullall)
+    const u8* vertices = dst.GetPointer();
+    bool all_culled = false;
+    if (cull_triangles)
+      all_culled = g_vertex_manager->CullTriangles(loader, primitive, vertices, count);
+    else if (can_cpu_cull && !cullall)
+      all_culled = g_vertex_manager->AreAllVerticesCulled(loader, primitive, vertices, count);
+
+    if (can_cpu_cull && !cullall && !all_culled)
     {
-      if (!g_vertex_manager->AreAllVerticesCulled(loader, primitive, dst.GetPointer(), count))
-      {
-        DataReader new_dst = g_vertex_manager->DisableCullAll(stride);
-        memmove(new_dst.GetPointer(), dst.GetPointer(), count * stride);
-      }
+      DataReader new_dst = g_vertex_manager->DisableCullAll(stride);
+      memmove(new_dst.GetPointer(), dst.GetPointer(), count * stride);
     }
 
-    g_vertex_manager->AddIndices(primitive, count);
+    if (cull_triangles)
+      g_vertex_manager->AddCulledIndices(primitive, count);
+    else
+      g_vertex_manager->AddIndices(primitive, count);
     g_vertex_manager->FlushData(count, loader->m_native_vtx_decl.stride);
 
     ADDSTAT(g_stats.this_frame.num_prims, count);
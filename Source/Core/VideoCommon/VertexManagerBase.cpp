@@ -6,6 +6,7 @@
 #include <array>
 #include <cmath>
 #include <memory>
+#include <span>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -141,6 +142,32 @@ bool VertexManagerBase::AreAllVerticesCulled(VertexLoaderBase* loader,
   return m_cpu_cull.AreAllVerticesCulled(loader, primitive, src, count);
 }
 
+bool VertexManagerBase::CullTriangles(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive,
+                                      const u8* src, u32 count)
+{
+  m_cpu_culled_triangle_count = m_cpu_cull.CullTriangles(loader, primitive, src, count);
+  return m_cpu_cull.GetKeptIndices().empty();
+}
+
+void VertexManagerBase::AddCulledIndices(OpcodeDecoder::Primitive primitive, u32 num_vertices)
+{
+  const std::span<const u16> indices = m_cpu_cull.GetKeptIndices();
+  const u32 num_triangles = static_cast<u32>(indices.size() / 3);
+
+  // With primitive restart, a list of separate triangles can take more indices than the strip it
+  // came from. PrepareForAdditionalData only made sure that the uncompacted indices fit.
+  const u32 remaining_index_space = MAXIBUFFERSIZE - m_index_generator.GetIndexLen();
+  if (m_cpu_culled_triangle_count == 0 ||
+      m_index_generator.GetTriangleListLength(num_triangles) > remaining_index_space)
+  {
+    m_index_generator.AddIndices(primitive, num_vertices);
+    return;
+  }
+
+  m_index_generator.AddTriangleList(indices.data(), num_triangles, num_vertices);
+  ADDSTAT(g_stats.this_frame.num_triangles_cpu_culled, m_cpu_culled_triangle_count);
+}
+
 DataReader VertexManagerBase::PrepareForAdditionalData(OpcodeDecoder::Primitive primitive,
                                                        u32 count, u32 stride, bool cullall)
 {
@@ -365,6 +392,58 @@ void VertexManagerBase::InvalidateConstants()
   vertex_shader_manager.dirty = true;
   geometry_shader_manager.dirty = true;
   pixel_shader_manager.dirty = true;
+  m_vertex_constants_tracker.Invalidate();
+  m_geometry_constants_tracker.Invalidate();
+  m_pixel_constants_tracker.Invalidate();
+}
+
+template <typename T>
+static std::span<const ConstantBufferRange>
+GetChangedConstants(ConstantBufferTracker<T>& tracker, const T& constants, bool* dirty)
+{
+  if (!*dirty)
+    return {};
+
+  *dirty = false;
+  const std::span<const ConstantBufferRange> ranges = tracker.Update(constants);
+  for (const ConstantBufferRange& range : ranges)
+    ADDSTAT(g_stats.this_frame.bytes_uniform_changed, range.size);
+  return ranges;
+}
+
+std::span<const ConstantBufferRange> VertexManagerBase::GetChangedVertexConstants()
+{
+  auto& vertex_shader_manager = Core::System::GetInstance().GetVertexShaderManager();
+  return GetChangedConstants(m_vertex_constants_tracker, vertex_shader_manager.constants,
+                             &vertex_shader_manager.dirty);
+}
+
+std::span<const ConstantBufferRange> VertexManagerBase::GetChangedGeometryConstants()
+{
+  auto& geometry_shader_manager = Core::System::GetInstance().GetGeometryShaderManager();
+  return GetChangedConstants(m_geometry_constants_tracker, geometry_shader_manager.constants,
+                             &geometry_shader_manager.dirty);
+}
+
+std::span<const ConstantBufferRange> VertexManagerBase::GetChangedPixelConstants()
+{
+  auto& pixel_shader_manager = Core::System::GetInstance().GetPixelShaderManager();
+  return GetChangedConstants(m_pixel_constants_tracker, pixel_shader_manager.constants,
+                             &pixel_shader_manager.dirty);
+}
+
+void VertexManagerBase::OnAllConstantsUploaded()
+{
+  auto& system = Core::System::GetInstance();
+  auto& vertex_shader_manager = system.GetVertexShaderManager();
+  auto& geometry_shader_manager = system.GetGeometryShaderManager();
+  auto& pixel_shader_manager = system.GetPixelShaderManager();
+  m_vertex_constants_tracker.Store(vertex_shader_manager.constants);
+  m_geometry_constants_tracker.Store(geometry_shader_manager.constants);
+  m_pixel_constants_tracker.Store(pixel_shader_manager.constants);
+  vertex_shader_manager.dirty = false;
+  geometry_shader_manager.dirty = false;
+  pixel_shader_manager.dirty = false;
 }
 
 void VertexManagerBase::UploadUtilityUniforms(const void* uniforms, u32 uniforms_size)
@@ -4,12 +4,15 @@
 #pragma once
 
 #include <memory>
+#include <span>
 #include <vector>
 
 #include "Common/BitSet.h"
 #include "Common/CommonTypes.h"
 #include "Common/MathUtil.h"
 #include "VideoCommon/CPUCull.h"
+#include "VideoCommon/ConstantBufferTracker.h"
+#include "VideoCommon/ConstantManager.h"
 #include "VideoCommon/IndexGenerator.h"
 #include "VideoCommon/RenderState.h"
 #include "VideoCommon/ShaderCache.h"
@@ -105,6 +108,11 @@ public:
   void AddIndices(OpcodeDecoder::Primitive primitive, u32 num_vertices);
   bool AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive,
                             const u8* src, u32 count);
+  /// Culls the individual triangles of a draw, returns whether every triangle was culled.
+  /// The indices of the remaining triangles are added with AddCulledIndices.
+  bool CullTriangles(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive, const u8* src,
+                     u32 count);
+  void AddCulledIndices(OpcodeDecoder::Primitive primitive, u32 num_vertices);
   virtual DataReader PrepareForAdditionalData(OpcodeDecoder::Primitive primitive, u32 count,
                                               u32 stride, bool cullall);
   /// Switch cullall off after a call to PrepareForAdditionalData with cullall true
@@ -168,7 +176,16 @@ public:
 
 protected:
   // When utility uniforms are used, the GX uniforms need to be re-written afterwards.
-  static void InvalidateConstants();
+  void InvalidateConstants();
+
+  // Return the byte ranges of a stage's constants which changed since they were last uploaded,
+  // and clear the stage's dirty flag. Nothing has to be uploaded if the result is empty.
+  std::span<const ConstantBufferRange> GetChangedVertexConstants();
+  std::span<const ConstantBufferRange> GetChangedGeometryConstants();
+  std::span<const ConstantBufferRange> GetChangedPixelConstants();
+
+  // Call after uploading the constants of all stages, regardless of what changed
+  void OnAllConstantsUploaded();
 
   // Prepares the buffer for the next batch of vertices.
   virtual void ResetBuffer(u32 vertex_stride);
@@ -213,6 +230,11 @@ protected:
 
   IndexGenerator m_index_generator;
   CPUCull m_cpu_cull;
+  u32 m_cpu_culled_triangle_count = 0;
+
+  ConstantBufferTracker<VertexShaderConstants> m_vertex_constants_tracker;
+  ConstantBufferTracker<GeometryShaderConstants> m_geometry_constants_tracker;
+  ConstantBufferTracker<PixelShaderConstants> m_pixel_constants_tracker;
 
 private:
   // Minimum number of draws per command buffer when attempting to preempt a readback operation.
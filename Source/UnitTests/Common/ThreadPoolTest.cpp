@@ -0,0 +1,88 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/ThreadPool.h"
+
+TEST(ThreadPool, NoWorkersRunsOnCaller)
+{
+  Common::ThreadPool pool;
+  EXPECT_EQ(pool.GetThreadCount(), 1u);
+
+  std::vector<size_t> order;
+  pool.ParallelFor(5, [&](size_t index, size_t thread_index) {
+    EXPECT_EQ(thread_index, 0u);
+    order.push_back(index);
+  });
+  EXPECT_EQ(order, (std::vector<size_t>{0, 1, 2, 3, 4}));
+}
+
+TEST(ThreadPool, EveryIndexRunsOnce)
+{
+  Common::ThreadPool pool("ThreadPoolTest", 3);
+  ASSERT_EQ(pool.GetThreadCount(), 4u);
+
+  for (int iteration = 0; iteration < 1000; ++iteration)
+  {
+    constexpr size_t COUNT = 64;
+    std::array<std::atomic<int>, COUNT> calls{};
+    std::array<std::atomic<int>, 4> busy{};
+
+    pool.ParallelFor(COUNT, [&](size_t index, size_t thread_index) {
+      ASSERT_LT(thread_index, 4u);
+      // No other call may be using this thread index right now.
+      EXPECT_EQ(busy[thread_index].fetch_add(1), 0);
+      calls[index].fetch_add(1);
+      busy[thread_index].fetch_sub(1);
+    });
+
+    for (const auto& count : calls)
+      EXPECT_EQ(count.load(), 1);
+  }
+}
+
+TEST(ThreadPool, ResetChangesWorkerCount)
+{
+  Common::ThreadPool pool("ThreadPoolTest", 2);
+  pool.Reset("ThreadPoolTest", 5);
+  EXPECT_EQ(pool.GetThreadCount(), 6u);
+
+  std::atomic<size_t> sum = 0;
+  pool.ParallelFor(100, [&](size_t index, size_t) { sum += index; });
+  EXPECT_EQ(sum.load(), 4950u);
+
+  pool.Shutdown();
+  EXPECT_EQ(pool.GetThreadCount(), 1u);
+  pool.ParallelFor(3, [&](size_t index, size_t) { sum += index; });
+  EXPECT_EQ(sum.load(), 4953u);
+}
+
+TEST(ThreadPool, ResetAfterParallelFor)
+{
+  Common::ThreadPool pool("ThreadPoolTest", 3);
+
+  for (int iteration = 0; iteration < 200; ++iteration)
+  {
+    std::atomic<int> running = 0;
+    std::atomic<size_t> sum = 0;
+    const auto function = [&](size_t index, size_t) {
+      running.fetch_add(1);
+      sum += index;
+      running.fetch_sub(1);
+    };
+
+    pool.ParallelFor(16, function);
+    EXPECT_EQ(running.load(), 0);
+
+    // New workers must not run the work which was submitted before they were started
+    pool.Reset("ThreadPoolTest", 3);
+    pool.ParallelFor(16, function);
+    EXPECT_EQ(running.load(), 0);
+    EXPECT_EQ(sum.load(), 240u);
+  }
+}
@@ -0,0 +1,51 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/ZoneProfiler.h"
+
+namespace ZoneProfiler = Common::ZoneProfiler;
+
+TEST(ZoneProfiler, KeepsNewestZonesOnceBufferIsFull)
+{
+  const std::string temp_dir = File::CreateTempDir();
+  ASSERT_FALSE(temp_dir.empty());
+  const std::string path = temp_dir + "/trace.json";
+
+  ASSERT_TRUE(ZoneProfiler::StartRecording(path));
+  EXPECT_TRUE(ZoneProfiler::IsRecording());
+
+  // A thread buffer holds 1 << 18 zones, so the first ones are overwritten
+  constexpr u32 ZONE_COUNT = (1 << 18) + 5;
+  for (u32 i = 0; i < ZONE_COUNT; ++i)
+  {
+    const u64 start = ZoneProfiler::GetTimestamp();
+    ZoneProfiler::RecordZone(i < 5 ? "Oldest" : "Newest", start, start);
+  }
+
+  EXPECT_TRUE(ZoneProfiler::StopRecording());
+  EXPECT_FALSE(ZoneProfiler::IsRecording());
+
+  std::string trace;
+  ASSERT_TRUE(File::ReadFileToString(path, trace));
+  EXPECT_EQ(trace.find("Oldest"), std::string::npos);
+  EXPECT_NE(trace.find("Newest"), std::string::npos);
+  EXPECT_NE(trace.find("\"otherData\":{\"droppedZones\":5}"), std::string::npos);
+
+  // The next recording starts over
+  ASSERT_TRUE(ZoneProfiler::StartRecording(path));
+  const u64 start = ZoneProfiler::GetTimestamp();
+  ZoneProfiler::RecordZone("Oldest", start, start);
+  EXPECT_TRUE(ZoneProfiler::StopRecording());
+
+  ASSERT_TRUE(File::ReadFileToString(path, trace));
+  EXPECT_NE(trace.find("Oldest"), std::string::npos);
+  EXPECT_NE(trace.find("\"otherData\":{\"droppedZones\":0}"), std::string::npos);
+
+  File::DeleteDirRecursively(temp_dir);
+}
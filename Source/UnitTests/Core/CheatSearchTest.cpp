@@ -0,0 +1,324 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <cstring>
+#include <optional>
+#include <random>
+#include <span>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/Align.h"
+#include "Common/CommonTypes.h"
+#include "Common/Swap.h"
+#include "Core/CheatSearch.h"
+
+using namespace Cheats;
+
+namespace
+{
+// Starts in the middle of a page, so that the pages at both ends of the buffer can't be accessed
+// directly.
+constexpr u32 BASE_ADDRESS = 0x80000800;
+constexpr u32 BUFFER_SIZE = 3 * 0x1000;
+
+constexpr std::array<CompareType, 6> COMPARE_TYPES{
+    CompareType::Equal,       CompareType::NotEqual, CompareType::Less,
+    CompareType::LessOrEqual, CompareType::Greater,  CompareType::GreaterOrEqual,
+};
+
+// Bytes from a small set, so that equal values are common.
+std::vector<u8> MakeBuffer(u32 seed)
+{
+  constexpr std::array<u8, 4> bytes{0x00, 0x01, 0x80, 0xff};
+  std::mt19937 generator(seed);
+  std::vector<u8> buffer(BUFFER_SIZE);
+  for (u8& byte : buffer)
+    byte = bytes[generator() % bytes.size()];
+  return buffer;
+}
+
+template <typename T>
+std::optional<T> ReadValue(std::span<const u8> buffer, u32 address)
+{
+  if (address < BASE_ADDRESS || u64(address - BASE_ADDRESS) + sizeof(T) > buffer.size())
+    return std::nullopt;
+
+  T value;
+  std::memcpy(&value, buffer.data() + (address - BASE_ADDRESS), sizeof(T));
+  return Common::FromBigEndian(value);
+}
+
+template <typename T>
+bool Compare(CompareType compare_type, const T& value, const T& other)
+{
+  switch (compare_type)
+  {
+  case CompareType::Equal:
+    return value == other;
+  case CompareType::NotEqual:
+    return value != other;
+  case CompareType::Less:
+    return value < other;
+  case CompareType::LessOrEqual:
+    return value <= other;
+  case CompareType::Greater:
+    return value > other;
+  case CompareType::GreaterOrEqual:
+    return value >= other;
+  }
+  return false;
+}
+
+template <typename T>
+bool Matches(const SearchFilter<T>& filter, const T& value, const T& old_value)
+{
+  switch (filter.m_filter_type)
+  {
+  case FilterType::CompareAgainstSpecificValue:
+    return Compare(filter.m_compare_type, value, filter.m_value);
+  case FilterType::CompareAgainstLastValue:
+    return Compare(filter.m_compare_type, value, old_value);
+  case FilterType::DoNotFilter:
+    return true;
+  }
+  return false;
+}
+
+// The searches as they were implemented before results were stored per page.
+template <typename T>
+std::vector<SearchResult<T>> ReferenceNewSearch(std::span<const u8> buffer,
+                                                const std::vector<MemoryRange>& memory_ranges,
+                                                bool aligned, const SearchFilter<T>& filter)
+{
+  const u32 data_size = sizeof(T);
+  std::vector<SearchResult<T>> results;
+  for (const MemoryRange& range : memory_ranges)
+  {
+    if (range.m_length < data_size)
+      continue;
+
+    const u32 increment_per_loop = aligned ? data_size : 1;
+    const u32 start_address = aligned ? Common::AlignUp(range.m_start, data_size) : range.m_start;
+    const u64 aligned_length = range.m_length - (start_address - range.m_start);
+
+    if (aligned_length < data_size)
+      continue;
+
+    const u64 length = aligned_length - (data_size - 1);
+    for (u64 i = 0; i < length; i += increment_per_loop)
+    {
+      const u32 addr = start_address + static_cast<u32>(i);
+      const std::optional<T> current_value = ReadValue<T>(buffer, addr);
+      if (!current_value || !Matches(filter, *current_value, *current_value))
+        continue;
+
+      auto& r = results.emplace_back();
+      r.m_value = *current_value;
+      r.m_value_state = SearchResultValueState::ValueFromPhysicalMemory;
+      r.m_address = addr;
+    }
+  }
+  return results;
+}
+
+template <typename T>
+std::vector<SearchResult<T>> ReferenceNextSearch(std::span<const u8> buffer,
+                                                 const std::vector<SearchResult<T>>& previous,
+                                                 const SearchFilter<T>& filter)
+{
+  std::vector<SearchResult<T>> results;
+  for (const auto& previous_result : previous)
+  {
+    const u32 addr = previous_result.m_address;
+    const std::optional<T> current_value = ReadValue<T>(buffer, addr);
+    if (!current_value)
+    {
+      auto& r = results.emplace_back();
+      r.m_value = T{};
+      r.m_address = addr;
+      r.m_value_state = SearchResultValueState::AddressNotAccessible;
+      continue;
+    }
+
+    if (!previous_result.IsValueValid() ||
+        Matches(filter, *current_value, previous_result.m_value))
+    {
+      auto& r = results.emplace_back();
+      r.m_value = *current_value;
+      r.m_value_state = SearchResultValueState::ValueFromPhysicalMemory;
+      r.m_address = addr;
+    }
+  }
+  return results;
+}
+
+template <typename T>
+void ExpectSameResults(const SearchResults<T>& results,
+                       const std::vector<SearchResult<T>>& expected)
+{
+  ASSERT_EQ(results.GetCount(), expected.size());
+  size_t valid_count = 0;
+  for (size_t i = 0; i < expected.size(); ++i)
+  {
+    const SearchResult<T> result = results.Get(i);
+    ASSERT_EQ(result.m_address, expected[i].m_address) << "result " << i;
+    ASSERT_EQ(result.m_value_state, expected[i].m_value_state) << "result " << i;
+    if (!expected[i].IsValueValid())
+      continue;
+
+    // Compare the bits, as NaN is not equal to itself
+    ++valid_count;
+    EXPECT_EQ(0, std::memcmp(&result.m_value, &expected[i].m_value, sizeof(T)))
+        << "result " << i << " at " << result.m_address;
+  }
+  EXPECT_EQ(results.GetValidValueCount(), valid_count);
+}
+
+template <typename T>
+std::vector<SearchFilter<T>> MakeFilters(std::span<const u8> buffer, bool next_search)
+{
+  // A value which is actually in memory, so that searching for it finds something
+  const T value = *ReadValue<T>(buffer, BASE_ADDRESS + 0x1234);
+
+  std::vector<SearchFilter<T>> filters;
+  filters.push_back({FilterType::DoNotFilter, CompareType::Equal, T{}});
+  for (CompareType compare_type : COMPARE_TYPES)
+  {
+    filters.push_back({FilterType::CompareAgainstSpecificValue, compare_type, value});
+    if (next_search)
+      filters.push_back({FilterType::CompareAgainstLastValue, compare_type, T{}});
+  }
+  return filters;
+}
+
+template <typename T>
+void CheckAgainstReference()
+{
+  const std::vector<u8> buffer = MakeBuffer(sizeof(T));
+
+  // Changes some of the memory, and drops the last page so that results in it become inaccessible
+  std::vector<u8> next_buffer = buffer;
+  std::mt19937 generator(1);
+  for (size_t i = 0; i < next_buffer.size(); i += 1 + generator() % 8)
+    next_buffer[i] = static_cast<u8>(generator());
+  next_buffer.resize(BUFFER_SIZE - 0x800);
+
+  const std::vector<MemoryRange> memory_ranges{
+      // Begins and ends outside of the buffer
+      {BASE_ADDRESS - 0x100, BUFFER_SIZE + 0x200},
+      // Neither the start nor the length are aligned
+      {BASE_ADDRESS + 0x1001, 0x37},
+  };
+
+  for (const bool aligned : {true, false})
+  {
+    SCOPED_TRACE(aligned ? "aligned" : "unaligned");
+
+    for (const SearchFilter<T>& filter : MakeFilters<T>(buffer, false))
+    {
+      SCOPED_TRACE(testing::Message() << "new search with filter " << int(filter.m_filter_type)
+                                      << ", comparison " << int(filter.m_compare_type));
+      const SearchResults<T> results =
+          NewSearchInBuffer<T>(buffer, BASE_ADDRESS, memory_ranges, aligned, filter);
+      const std::vector<SearchResult<T>> expected =
+          ReferenceNewSearch<T>(buffer, memory_ranges, aligned, filter);
+      ExpectSameResults(results, expected);
+    }
+
+    const SearchFilter<T> all_values{FilterType::DoNotFilter, CompareType::Equal, T{}};
+    const SearchResults<T> previous_results =
+        NewSearchInBuffer<T>(buffer, BASE_ADDRESS, memory_ranges, aligned, all_values);
+    const std::vector<SearchResult<T>> previous_expected =
+        ReferenceNewSearch<T>(buffer, memory_ranges, aligned, all_values);
+
+    for (const SearchFilter<T>& filter : MakeFilters<T>(next_buffer, true))
+    {
+      SCOPED_TRACE(testing::Message() << "next search with filter " << int(filter.m_filter_type)
+                                      << ", comparison " << int(filter.m_compare_type));
+      const SearchResults<T> results =
+          NextSearchInBuffer<T>(next_buffer, BASE_ADDRESS, previous_results, filter);
+      const std::vector<SearchResult<T>> expected =
+          ReferenceNextSearch<T>(next_buffer, previous_expected, filter);
+      ExpectSameResults(results, expected);
+
+      // Results which became inaccessible are kept, and get their value back once they can be
+      // read again.
+      const SearchResults<T> recovered_results =
+          NextSearchInBuffer<T>(buffer, BASE_ADDRESS, results, filter);
+      ExpectSameResults(recovered_results, ReferenceNextSearch<T>(buffer, expected, filter));
+    }
+  }
+}
+}  // namespace
+
+TEST(CheatSearch, U8)
+{
+  CheckAgainstReference<u8>();
+}
+
+TEST(CheatSearch, U16)
+{
+  CheckAgainstReference<u16>();
+}
+
+TEST(CheatSearch, U32)
+{
+  CheckAgainstReference<u32>();
+}
+
+TEST(CheatSearch, U64)
+{
+  CheckAgainstReference<u64>();
+}
+
+TEST(CheatSearch, S8)
+{
+  CheckAgainstReference<s8>();
+}
+
+TEST(CheatSearch, S16)
+{
+  CheckAgainstReference<s16>();
+}
+
+TEST(CheatSearch, S32)
+{
+  CheckAgainstReference<s32>();
+}
+
+TEST(CheatSearch, S64)
+{
+  CheckAgainstReference<s64>();
+}
+
+TEST(CheatSearch, F32)
+{
+  CheckAgainstReference<float>();
+}
+
+TEST(CheatSearch, F64)
+{
+  CheckAgainstReference<double>();
+}
+
+TEST(CheatSearch, SelectKeepsChosenResults)
+{
+  const std::vector<u8> buffer = MakeBuffer(0);
+  const std::vector<MemoryRange> memory_ranges{{BASE_ADDRESS, BUFFER_SIZE}};
+  const SearchFilter<u16> filter{FilterType::DoNotFilter, CompareType::Equal, 0};
+  const SearchResults<u16> results =
+      NewSearchInBuffer<u16>(buffer, BASE_ADDRESS, memory_ranges, false, filter);
+
+  const std::vector<size_t> indices{5000, 3, 3, 0x7ff, 0x800, results.GetCount() - 1};
+  const SearchResults<u16> selection = results.Select(indices);
+  ASSERT_EQ(selection.GetCount(), 5u);
+  EXPECT_EQ(selection.Get(0).m_address, results.Get(3).m_address);
+  EXPECT_EQ(selection.Get(1).m_address, results.Get(0x7ff).m_address);
+  EXPECT_EQ(selection.Get(2).m_address, results.Get(0x800).m_address);
+  EXPECT_EQ(selection.Get(3).m_address, results.Get(5000).m_address);
+  EXPECT_EQ(selection.Get(4).m_address, results.Get(results.GetCount() - 1).m_address);
+  EXPECT_EQ(selection.Get(4).m_value, results.Get(results.GetCount() - 1).m_value);
+}
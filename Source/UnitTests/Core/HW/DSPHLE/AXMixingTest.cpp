@@ -0,0 +1,127 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/HW/DSPHLE/UCodes/AXMixing.h"
+
+// Reference implementations, matching the scalar loops AXMixing replaced in AXVoice.h.
+static s16 ReferenceMixAdd(int* out, const s16* input, u32 count, u16* volume, u16 volume_delta)
+{
+  s16 dpop = 0;
+  for (u32 i = 0; i < count; ++i)
+  {
+    s64 sample = input[i];
+    sample *= *volume;
+    sample >>= 15;
+    sample = std::clamp((s32)sample, -32767, 32767);
+
+    out[i] += (s16)sample;
+    *volume += volume_delta;
+
+    dpop = (s16)sample;
+  }
+  return dpop;
+}
+
+static void ReferenceApplyVolume(s16* samples, u32 count, u16* volume, s16 volume_delta)
+{
+  for (u32 i = 0; i < count; ++i)
+  {
+    const s32 sample = ((s32)samples[i] * *volume) >> 15;
+    samples[i] = std::clamp(sample, -32767, 32767);
+    *volume += volume_delta;
+  }
+}
+
+// Covers the frame sizes used by AX GC (32), AX Wii (96) and the Wii remote mixing (6 and 18), as
+// well as sizes which exercise every vector tail length.
+static constexpr std::array<u32, 12> COUNTS = {1, 3, 4, 6, 7, 8, 9, 15, 18, 32, 95, 96};
+
+// Volumes and deltas which hit the saturation and wraparound edge cases.
+static constexpr std::array<u16, 8> VOLUMES = {0,      1,      0x7FFF, 0x8000,
+                                               0x8001, 0xFFFE, 0xFFFF, 0x1234};
+
+class AXMixingTest : public testing::Test
+{
+protected:
+  std::array<s16, 96> RandomSamples()
+  {
+    std::array<s16, 96> samples;
+    for (s16& sample : samples)
+      sample = static_cast<s16>(m_distribution(m_rng));
+
+    // Always include the extremes.
+    samples[0] = -32768;
+    samples[samples.size() - 1] = 32767;
+    return samples;
+  }
+
+  u16 RandomU16() { return static_cast<u16>(m_distribution(m_rng)); }
+
+private:
+  std::mt19937 m_rng{0xA7};
+  std::uniform_int_distribution<int> m_distribution{-32768, 32767};
+};
+
+TEST_F(AXMixingTest, MixAddMatchesReference)
+{
+  for (u32 count : COUNTS)
+  {
+    for (u16 start_volume : VOLUMES)
+    {
+      for (u16 volume_delta : {u16(0), u16(1), u16(0xFFFF), RandomU16(), RandomU16()})
+      {
+        std::array<s16, 96> input = RandomSamples();
+        std::rotate(input.begin(), input.begin() + 96 - count, input.end());
+
+        std::array<int, 96> expected_out;
+        for (int& value : expected_out)
+          value = RandomU16();
+        std::array<int, 96> out = expected_out;
+
+        u16 expected_volume = start_volume;
+        u16 volume = start_volume;
+        const s16 expected_dpop = ReferenceMixAdd(expected_out.data(), input.data(), count,
+                                                  &expected_volume, volume_delta);
+        const s16 dpop = DSP::HLE::AXMixing::MixAdd(out.data(), input.data(), count, &volume,
+                                                    volume_delta);
+
+        EXPECT_EQ(out, expected_out) << "count " << count << " volume " << start_volume
+                                     << " delta " << volume_delta;
+        EXPECT_EQ(volume, expected_volume);
+        EXPECT_EQ(dpop, expected_dpop);
+      }
+    }
+  }
+}
+
+TEST_F(AXMixingTest, ApplyVolumeMatchesReference)
+{
+  for (u32 count : COUNTS)
+  {
+    for (u16 start_volume : VOLUMES)
+    {
+      for (s16 volume_delta : {s16(0), s16(1), s16(-1), s16(-32768), s16(RandomU16())})
+      {
+        std::array<s16, 96> expected_samples = RandomSamples();
+        std::array<s16, 96> samples = expected_samples;
+
+        u16 expected_volume = start_volume;
+        u16 volume = start_volume;
+        ReferenceApplyVolume(expected_samples.data(), count, &expected_volume, volume_delta);
+        DSP::HLE::AXMixing::ApplyVolume(samples.data(), count, &volume,
+                                        static_cast<u16>(volume_delta));
+
+        EXPECT_EQ(samples, expected_samples) << "count " << count << " volume " << start_volume
+                                             << " delta " << volume_delta;
+        EXPECT_EQ(volume, expected_volume);
+      }
+    }
+  }
+}
@@ -3,15 +3,26 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
+#include <filesystem>
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
+#include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/Crypto/SHA1.h"
 #include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/StringUtil.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/IOS/FS/FileSystem.h"
+#include "Core/IOS/FS/HostBackend/FS.h"
+#include "Core/IOS/FS/HostBackend/SnapshotBlobs.h"
 #include "Core/IOS/IOS.h"
 #include "UICommon/UICommon.h"
 
@@ -272,6 +283,224 @@ TEST_F(FileSystemTest, GetDirectoryStats)
   check_stats(1u, 2u);
 }
 
+TEST_F(FileSystemTest, GetDirectoryStatsAfterChanges)
+{
+  auto check_stats = [this](const std::string& path, u32 clusters, u32 inodes) {
+    const Result<DirectoryStats> stats = m_fs->GetDirectoryStats(path);
+    ASSERT_TRUE(stats.Succeeded());
+    EXPECT_EQ(stats->used_clusters, clusters);
+    EXPECT_EQ(stats->used_inodes, inodes);
+  };
+
+  check_stats("/tmp", 0u, 1u);
+
+  ASSERT_EQ(m_fs->CreateDirectory(Uid{0}, Gid{0}, "/tmp/d", 0, modes), ResultCode::Success);
+  ASSERT_EQ(m_fs->CreateFile(Uid{0}, Gid{0}, "/tmp/d/f", 0, modes), ResultCode::Success);
+  check_stats("/tmp/d", 0u, 2u);
+  {
+    const Result<FileHandle> file = m_fs->OpenFile(Uid{0}, Gid{0}, "/tmp/d/f", Mode::Write);
+    file->Write(std::vector<u8>(20000).data(), 20000);
+  }
+  check_stats("/tmp", 2u, 3u);
+  check_stats("/tmp/d", 2u, 2u);
+
+  ASSERT_EQ(m_fs->Rename(Uid{0}, Gid{0}, "/tmp/d", "/tmp/e"), ResultCode::Success);
+  check_stats("/tmp", 2u, 3u);
+  check_stats("/tmp/e", 2u, 2u);
+  EXPECT_EQ(m_fs->GetDirectoryStats("/tmp/d").Error(), ResultCode::NotFound);
+
+  ASSERT_EQ(m_fs->Delete(Uid{0}, Gid{0}, "/tmp/e/f"), ResultCode::Success);
+  check_stats("/tmp", 0u, 2u);
+  ASSERT_EQ(m_fs->Delete(Uid{0}, Gid{0}, "/tmp/e"), ResultCode::Success);
+  check_stats("/tmp", 0u, 1u);
+}
+
+TEST_F(FileSystemTest, SaveStateRestoresChangedFiles)
+{
+  const auto write_file = [this](const std::string& path, const std::vector<u8>& data) {
+    const Result<FileHandle> file = m_fs->OpenFile(Uid{0}, Gid{0}, path, Mode::Write);
+    ASSERT_TRUE(file.Succeeded());
+    ASSERT_TRUE(file->Write(data.data(), data.size()).Succeeded());
+  };
+  const auto read_file = [this](const std::string& path) {
+    const Result<FileHandle> file = m_fs->OpenFile(Uid{0}, Gid{0}, path, Mode::Read);
+    std::vector<u8> data(file.Succeeded() ? file->GetStatus()->size : 0);
+    if (file.Succeeded())
+      file->Read(data.data(), data.size());
+    return data;
+  };
+
+  ASSERT_EQ(m_fs->CreateFile(Uid{0}, Gid{0}, "/tmp/keep", 0, modes), ResultCode::Success);
+  ASSERT_EQ(m_fs->CreateFile(Uid{0}, Gid{0}, "/tmp/change", 0, modes), ResultCode::Success);
+  write_file("/tmp/keep", {1, 2, 3});
+  write_file("/tmp/change", {4, 5, 6});
+
+  std::vector<u8> state;
+  {
+    u8* ptr = nullptr;
+    PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+    m_fs->DoState(p_measure);
+    state.resize(reinterpret_cast<size_t>(ptr));
+    ptr = state.data();
+    PointerWrap p(&ptr, state.size(), PointerWrap::Mode::Write);
+    m_fs->DoState(p);
+    ASSERT_TRUE(p.IsWriteMode());
+  }
+
+  write_file("/tmp/change", {7, 8, 9, 10});
+  ASSERT_EQ(m_fs->Delete(Uid{0}, Gid{0}, "/tmp/keep"), ResultCode::Success);
+  ASSERT_EQ(m_fs->CreateDirectory(Uid{0}, Gid{0}, "/tmp/new", 0, modes), ResultCode::Success);
+
+  {
+    u8* ptr = state.data();
+    PointerWrap p(&ptr, state.size(), PointerWrap::Mode::Read);
+    m_fs->DoState(p);
+    ASSERT_TRUE(p.IsReadMode());
+  }
+
+  EXPECT_EQ(read_file("/tmp/keep"), (std::vector<u8>{1, 2, 3}));
+  EXPECT_EQ(read_file("/tmp/change"), (std::vector<u8>{4, 5, 6}));
+  EXPECT_EQ(m_fs->ReadDirectory(Uid{0}, Gid{0}, "/tmp/new").Error(), ResultCode::NotFound);
+}
+
+TEST_F(FileSystemTest, SaveStateNoticesChangesFromOutside)
+{
+  ASSERT_EQ(m_fs->CreateFile(Uid{0}, Gid{0}, "/tmp/file", 0, modes), ResultCode::Success);
+  {
+    const Result<FileHandle> file = m_fs->OpenFile(Uid{0}, Gid{0}, "/tmp/file", Mode::Write);
+    ASSERT_TRUE(file.Succeeded());
+    ASSERT_TRUE(file->Write(std::array<u8, 3>{1, 2, 3}.data(), 3).Succeeded());
+  }
+
+  std::vector<u8> state;
+  {
+    u8* ptr = nullptr;
+    PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+    m_fs->DoState(p_measure);
+    state.resize(reinterpret_cast<size_t>(ptr));
+    ptr = state.data();
+    PointerWrap p(&ptr, state.size(), PointerWrap::Mode::Write);
+    m_fs->DoState(p);
+    ASSERT_TRUE(p.IsWriteMode());
+  }
+
+  // Something else overwrites the file with contents of the same size
+  const std::string host_path = File::GetUserPath(D_SESSION_WIIROOT_IDX) + "/tmp/file";
+  ASSERT_TRUE(File::WriteStringToFile(host_path, "abc"));
+  const std::filesystem::path fs_path = StringToPath(host_path);
+  std::filesystem::last_write_time(fs_path, std::filesystem::last_write_time(fs_path) +
+                                                std::chrono::seconds(10));
+
+  {
+    u8* ptr = state.data();
+    PointerWrap p(&ptr, state.size(), PointerWrap::Mode::Read);
+    m_fs->DoState(p);
+    ASSERT_TRUE(p.IsReadMode());
+  }
+
+  std::string contents;
+  ASSERT_TRUE(File::ReadFileToString(host_path, contents));
+  EXPECT_EQ(contents, "\x01\x02\x03");
+}
+
+TEST_F(FileSystemTest, SaveStateWithEmbeddedContents)
+{
+  ASSERT_EQ(m_fs->CreateFile(Uid{0}, Gid{0}, "/tmp/file", 0, modes), ResultCode::Success);
+  const std::string host_path = File::GetUserPath(D_SESSION_WIIROOT_IDX) + "/tmp/file";
+  ASSERT_TRUE(File::WriteStringToFile(host_path, "abc"));
+
+  std::vector<u8> state;
+  {
+    Config::Init();
+    Config::SetCurrent(Config::MAIN_EMBED_NAND_IN_SAVESTATES, true);
+    u8* ptr = nullptr;
+    PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+    m_fs->DoState(p_measure);
+    state.resize(reinterpret_cast<size_t>(ptr));
+    ptr = state.data();
+    PointerWrap p(&ptr, state.size(), PointerWrap::Mode::Write);
+    m_fs->DoState(p);
+    // Also drops the cached value, which Config::Shutdown() doesn't
+    Config::SetCurrent(Config::MAIN_EMBED_NAND_IN_SAVESTATES, false);
+    Config::Shutdown();
+    ASSERT_TRUE(p.IsWriteMode());
+  }
+
+  // The savestate doesn't need the blob store
+  EXPECT_FALSE(File::Exists(File::GetUserPath(D_STATESAVES_IDX) + "NAND"));
+  EXPECT_TRUE(SnapshotBlobs::TakeReferences().empty());
+
+  ASSERT_TRUE(File::WriteStringToFile(host_path, "defg"));
+  {
+    u8* ptr = state.data();
+    PointerWrap p(&ptr, state.size(), PointerWrap::Mode::Read);
+    m_fs->DoState(p);
+    ASSERT_TRUE(p.IsReadMode());
+  }
+
+  std::string contents;
+  ASSERT_TRUE(File::ReadFileToString(host_path, contents));
+  EXPECT_EQ(contents, "abc");
+}
+
+TEST_F(FileSystemTest, SnapshotBlobsOfDeletedSaveStatesAreCollected)
+{
+  ASSERT_EQ(m_fs->CreateFile(Uid{0}, Gid{0}, "/tmp/file", 0, modes), ResultCode::Success);
+  const std::string host_path = File::GetUserPath(D_SESSION_WIIROOT_IDX) + "/tmp/file";
+  ASSERT_TRUE(File::WriteStringToFile(host_path, "abc"));
+
+  std::vector<u8> state;
+  {
+    u8* ptr = nullptr;
+    PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+    m_fs->DoState(p_measure);
+    state.resize(reinterpret_cast<size_t>(ptr));
+    ptr = state.data();
+    PointerWrap p(&ptr, state.size(), PointerWrap::Mode::Write);
+    m_fs->DoState(p);
+    ASSERT_TRUE(p.IsWriteMode());
+  }
+
+  std::vector<Common::SHA1::Digest> blobs = SnapshotBlobs::TakeReferences();
+  ASSERT_EQ(blobs.size(), 1u);
+  const std::string blob_path = SnapshotBlobs::GetBlobPath(blobs[0]);
+  EXPECT_TRUE(File::IsFile(blob_path));
+
+  const std::string state_path = File::GetUserPath(D_STATESAVES_IDX) + "test.s01";
+  const std::string backup_path = File::GetUserPath(D_STATESAVES_IDX) + "lastState.sav";
+  ASSERT_TRUE(File::WriteStringToFile(state_path, "state"));
+  SnapshotBlobs::RecordReferences(state_path, std::move(blobs));
+  SnapshotBlobs::CollectGarbage();
+  EXPECT_TRUE(File::IsFile(blob_path));
+
+  ASSERT_TRUE(File::Rename(state_path, backup_path));
+  SnapshotBlobs::MoveReferences(state_path, backup_path);
+  SnapshotBlobs::CollectGarbage();
+  EXPECT_TRUE(File::IsFile(blob_path));
+
+  ASSERT_TRUE(File::Delete(backup_path));
+  SnapshotBlobs::CollectGarbage();
+  EXPECT_FALSE(File::Exists(blob_path));
+}
+
+TEST_F(FileSystemTest, MetadataPersistence)
+{
+  ASSERT_EQ(m_fs->CreateFile(Uid{0}, Gid{0}, "/tmp/file", 1, modes), ResultCode::Success);
+  ASSERT_EQ(m_fs->SetMetadata(Uid{0}, "/tmp/file", Uid{0x1000}, Gid{1}, 2, modes),
+            ResultCode::Success);
+
+  // The FST changes must survive the file system being recreated (e.g. when IOS is reloaded).
+  m_fs.reset();
+  m_fs = IOS::HLE::Kernel{}.GetFS();
+
+  const Result<Metadata> metadata = m_fs->GetMetadata(Uid{0}, Gid{0}, "/tmp/file");
+  ASSERT_TRUE(metadata.Succeeded());
+  EXPECT_EQ(metadata->uid, 0x1000u);
+  EXPECT_EQ(metadata->gid, 1);
+  EXPECT_EQ(metadata->attribute, 2);
+  EXPECT_EQ(metadata->modes, modes);
+}
+
 // Files need to be explicitly created using CreateFile or CreateDirectory.
 // Automatically creating them on first use would be a bug.
 TEST_F(FileSystemTest, NonExistingFiles)
@@ -468,3 +697,138 @@ TEST_F(FileSystemTest, CreateFullPath)
   EXPECT_EQ(m_fs->CreateFullPath(Uid{0x1000}, Gid{1}, "/shared2/wc24/mbox/Readme.txt", 0, modes),
             ResultCode::Success);
 }
+
+class FstJournalTest : public testing::Test
+{
+protected:
+  FstJournalTest() : m_root{File::CreateTempDir()} {}
+
+  ~FstJournalTest() override
+  {
+    if (!m_root.empty())
+      File::DeleteDirRecursively(m_root);
+  }
+
+  void SetUp() override { ASSERT_FALSE(m_root.empty()); }
+
+  std::string FstPath() const { return m_root + "/fst.bin"; }
+  std::string JournalPath() const { return m_root + "/fst.journal"; }
+
+  // Runs a session which leaves its changes in the journal, then brings back the FST and journal
+  // as they were before the session ended, as if Dolphin had crashed.
+  template <typename Function>
+  void RunCrashingSession(Function function)
+  {
+    // A new NAND doesn't have an FST until it is first folded
+    std::optional<std::string> fst;
+    std::string journal;
+    {
+      HostFileSystem fs{m_root};
+      function(fs);
+      if (std::string contents; File::ReadFileToString(FstPath(), contents))
+        fst = std::move(contents);
+      ASSERT_TRUE(File::ReadFileToString(JournalPath(), journal));
+    }
+    EXPECT_FALSE(File::Exists(JournalPath()));
+    if (fst)
+      ASSERT_TRUE(File::WriteStringToFile(FstPath(), *fst));
+    else
+      ASSERT_TRUE(File::Delete(FstPath()));
+    ASSERT_TRUE(File::WriteStringToFile(JournalPath(), journal));
+  }
+
+  static void SetUid(FileSystem& fs, const std::string& path, Uid uid)
+  {
+    ASSERT_EQ(fs.SetMetadata(Uid{0}, path, uid, Gid{1}, 0, modes), ResultCode::Success);
+  }
+
+  static std::optional<Uid> GetUid(FileSystem& fs, const std::string& path)
+  {
+    const Result<Metadata> metadata = fs.GetMetadata(Uid{0}, Gid{0}, path);
+    if (!metadata.Succeeded())
+      return std::nullopt;
+    return metadata->uid;
+  }
+
+  std::string m_root;
+};
+
+TEST_F(FstJournalTest, ReplaysJournalLeftBehind)
+{
+  RunCrashingSession([](HostFileSystem& fs) {
+    ASSERT_EQ(fs.CreateDirectory(Uid{0}, Gid{0}, "/tmp", 0, modes), ResultCode::Success);
+    ASSERT_EQ(fs.CreateFile(Uid{0}, Gid{0}, "/tmp/a", 0, modes), ResultCode::Success);
+    ASSERT_EQ(fs.CreateFile(Uid{0}, Gid{0}, "/tmp/b", 0, modes), ResultCode::Success);
+    ASSERT_EQ(fs.CreateDirectory(Uid{0}, Gid{0}, "/tmp/c", 0, modes), ResultCode::Success);
+    ASSERT_EQ(fs.Rename(Uid{0}, Gid{0}, "/tmp/a", "/tmp/c/a"), ResultCode::Success);
+    ASSERT_EQ(fs.Delete(Uid{0}, Gid{0}, "/tmp/b"), ResultCode::Success);
+    SetUid(fs, "/tmp/c/a", 0x1000);
+  });
+
+  HostFileSystem fs{m_root};
+  EXPECT_FALSE(File::Exists(JournalPath()));
+  EXPECT_EQ(GetUid(fs, "/tmp/c/a"), Uid{0x1000});
+  EXPECT_FALSE(GetUid(fs, "/tmp/a"));
+  EXPECT_FALSE(GetUid(fs, "/tmp/b"));
+}
+
+TEST_F(FstJournalTest, DiscardsTornRecord)
+{
+  RunCrashingSession([](HostFileSystem& fs) {
+    ASSERT_EQ(fs.CreateDirectory(Uid{0}, Gid{0}, "/tmp", 0, modes), ResultCode::Success);
+    ASSERT_EQ(fs.CreateFile(Uid{0}, Gid{0}, "/tmp/a", 0, modes), ResultCode::Success);
+    SetUid(fs, "/tmp/a", 0x1000);
+    SetUid(fs, "/tmp/a", 0x2000);
+  });
+
+  // Cut off the end of the last record
+  ASSERT_TRUE(File::IOFile(JournalPath(), "r+b").Resize(File::GetSize(JournalPath()) - 3));
+
+  HostFileSystem fs{m_root};
+  EXPECT_EQ(GetUid(fs, "/tmp/a"), Uid{0x1000});
+}
+
+TEST_F(FstJournalTest, DiscardsRecordWithChecksumMismatch)
+{
+  u64 journal_size = 0;
+  RunCrashingSession([&](HostFileSystem& fs) {
+    ASSERT_EQ(fs.CreateDirectory(Uid{0}, Gid{0}, "/tmp", 0, modes), ResultCode::Success);
+    ASSERT_EQ(fs.CreateFile(Uid{0}, Gid{0}, "/tmp/a", 0, modes), ResultCode::Success);
+    SetUid(fs, "/tmp/a", 0x1000);
+    journal_size = File::GetSize(JournalPath());
+    SetUid(fs, "/tmp/a", 0x2000);
+    SetUid(fs, "/tmp/a", 0x3000);
+  });
+
+  // Corrupt the second to last record. Nothing after it is applied either.
+  std::string journal;
+  ASSERT_TRUE(File::ReadFileToString(JournalPath(), journal));
+  journal[journal_size + 12] ^= 0xff;
+  ASSERT_TRUE(File::WriteStringToFile(JournalPath(), journal));
+
+  HostFileSystem fs{m_root};
+  EXPECT_EQ(GetUid(fs, "/tmp/a"), Uid{0x1000});
+}
+
+TEST_F(FstJournalTest, IgnoresJournalOfDifferentFst)
+{
+  std::string old_journal;
+  {
+    HostFileSystem fs{m_root};
+    ASSERT_EQ(fs.CreateDirectory(Uid{0}, Gid{0}, "/tmp", 0, modes), ResultCode::Success);
+    ASSERT_EQ(fs.CreateFile(Uid{0}, Gid{0}, "/tmp/a", 0, modes), ResultCode::Success);
+    SetUid(fs, "/tmp/a", 0x1000);
+    ASSERT_TRUE(File::ReadFileToString(JournalPath(), old_journal));
+  }
+  {
+    HostFileSystem fs{m_root};
+    SetUid(fs, "/tmp/a", 0x2000);
+  }
+
+  // This journal was already folded into an older FST, so replaying it would undo changes
+  ASSERT_TRUE(File::WriteStringToFile(JournalPath(), old_journal));
+
+  HostFileSystem fs{m_root};
+  EXPECT_FALSE(File::Exists(JournalPath()));
+  EXPECT_EQ(GetUid(fs, "/tmp/a"), Uid{0x2000});
+}
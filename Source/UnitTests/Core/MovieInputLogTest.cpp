@@ -0,0 +1,277 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <cstring>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Core/Movie.h"
+#include "Core/MovieInputLog.h"
+
+using Movie::InputLog;
+
+class MovieInputLogTest : public testing::Test
+{
+protected:
+  MovieInputLogTest() : m_temp_dir{File::CreateTempDir()}, m_path{m_temp_dir + "/input.dtm"} {}
+
+  ~MovieInputLogTest() override
+  {
+    if (!m_temp_dir.empty())
+      File::DeleteDirRecursively(m_temp_dir);
+  }
+
+  static Movie::DTMHeader MakeHeader(u64 frame_count)
+  {
+    Movie::DTMHeader header{};
+    header.filetype = {'D', 'T', 'M', 0x1A};
+    header.frameCount = frame_count;
+    return header;
+  }
+
+  std::string m_temp_dir;
+  std::string m_path;
+};
+
+TEST_F(MovieInputLogTest, MemoryWrites)
+{
+  InputLog log;
+  const std::array<u8, 4> input{1, 2, 3, 4};
+
+  log.Write(0, input.data(), input.size());
+  log.Write(2, input.data(), input.size());
+  ASSERT_EQ(log.size(), 6u);
+  EXPECT_EQ(std::vector<u8>(log.data(), log.data() + log.size()),
+            (std::vector<u8>{1, 2, 1, 2, 3, 4}));
+
+  log.Resize(3);
+  EXPECT_EQ(log.size(), 3u);
+  EXPECT_FALSE(log.IsStreaming());
+  EXPECT_FALSE(log.GetFrameOffset(0));
+}
+
+TEST_F(MovieInputLogTest, StreamedRecordingPlaysBack)
+{
+  ASSERT_FALSE(m_temp_dir.empty());
+
+  std::vector<u8> expected;
+  {
+    InputLog log;
+    ASSERT_TRUE(log.CreateStream(m_path, MakeHeader(0)));
+    ASSERT_TRUE(log.IsStreaming());
+
+    for (u8 frame = 0; frame < 10; ++frame)
+    {
+      log.MarkFrame(frame, log.size());
+      const std::array<u8, 8> input{frame, frame, frame, frame, frame, frame, frame, frame};
+      log.Write(log.size(), input.data(), input.size());
+      expected.insert(expected.end(), input.begin(), input.end());
+    }
+
+    // Reading the input back while streaming sees everything written so far
+    ASSERT_EQ(log.size(), expected.size());
+    EXPECT_EQ(0, std::memcmp(log.data(), expected.data(), expected.size()));
+
+    // Record the last two frames again, as if an earlier savestate was loaded
+    log.Resize(8 * 8);
+    expected.resize(8 * 8);
+    for (u8 frame = 8; frame < 10; ++frame)
+    {
+      log.MarkFrame(frame, log.size());
+      const std::array<u8, 8> input{};
+      log.Write(log.size(), input.data(), input.size());
+      expected.insert(expected.end(), input.begin(), input.end());
+    }
+
+    log.Checkpoint(MakeHeader(10));
+  }
+
+  File::IOFile file(m_path, "rb");
+  Movie::DTMHeader header;
+  ASSERT_TRUE(file.ReadArray(&header, 1));
+  EXPECT_EQ(header.frameCount, 10u);
+  file.Close();
+
+  InputLog log;
+  ASSERT_TRUE(log.OpenForPlayback(m_path));
+  EXPECT_FALSE(log.IsStreaming());
+  ASSERT_EQ(log.size(), expected.size());
+  EXPECT_EQ(0, std::memcmp(log.data(), expected.data(), expected.size()));
+
+  for (u64 frame = 0; frame < 10; ++frame)
+    EXPECT_EQ(log.GetFrameOffset(frame), frame * 8);
+  EXPECT_FALSE(log.GetFrameOffset(10));
+}
+
+TEST_F(MovieInputLogTest, SavedRecordingKeepsFrameIndex)
+{
+  ASSERT_FALSE(m_temp_dir.empty());
+
+  InputLog log;
+  const std::array<u8, 4> input{};
+  for (u64 frame = 0; frame < 4; ++frame)
+  {
+    log.MarkFrame(frame, log.size());
+    // A lag frame doesn't have any input
+    if (frame != 2)
+      log.Write(log.size(), input.data(), input.size());
+  }
+  ASSERT_TRUE(log.SaveAs(m_path, MakeHeader(4)));
+
+  InputLog saved;
+  ASSERT_TRUE(saved.OpenForPlayback(m_path));
+  EXPECT_EQ(saved.GetFrameOffset(1), 4u);
+  EXPECT_EQ(saved.GetFrameOffset(2), 8u);
+  EXPECT_EQ(saved.GetFrameOffset(3), 8u);
+
+  // Like loading a savestate whose movie has no index, and recording from its frame on
+  File::IOFile file(m_path, "rb");
+  file.Seek(sizeof(Movie::DTMHeader), File::SeekOrigin::Begin);
+  ASSERT_TRUE(log.ReadFrom(file, 8));
+  log.ReadFrameIndex(m_temp_dir + "/missing.dtm");
+  EXPECT_FALSE(log.GetFrameOffset(0));
+  log.MarkFrame(2, 8);
+  EXPECT_FALSE(log.GetFrameOffset(1));
+  EXPECT_EQ(log.GetFrameOffset(2), 8u);
+
+  // An index which doesn't fit the movie isn't used
+  ASSERT_TRUE(log.SaveAs(m_path, MakeHeader(3)));
+  log.MarkFrame(3, 64);
+  ASSERT_TRUE(log.SaveAs(m_temp_dir + "/other.dtm", MakeHeader(4)));
+  ASSERT_TRUE(File::CopyRegularFile(m_temp_dir + "/other.dtm.idx", m_path + ".idx"));
+  ASSERT_TRUE(saved.OpenForPlayback(m_path));
+  EXPECT_FALSE(saved.GetFrameOffset(2));
+}
+
+TEST_F(MovieInputLogTest, WritingToPlayedBackMovieLeavesFileAlone)
+{
+  ASSERT_FALSE(m_temp_dir.empty());
+
+  std::vector<u8> input(64);
+  std::iota(input.begin(), input.end(), u8(0));
+  {
+    File::IOFile file(m_path, "wb");
+    const Movie::DTMHeader header = MakeHeader(1);
+    ASSERT_TRUE(file.WriteArray(&header, 1));
+    ASSERT_TRUE(file.WriteBytes(input.data(), input.size()));
+  }
+
+  InputLog log;
+  ASSERT_TRUE(log.OpenForPlayback(m_path));
+  ASSERT_EQ(log.size(), input.size());
+
+  const u8 value = 0xff;
+  log.Write(4, &value, 1);
+  log.Resize(32);
+  ASSERT_EQ(log.size(), 32u);
+  EXPECT_EQ(log.data()[3], 3);
+  EXPECT_EQ(log.data()[4], 0xff);
+  EXPECT_EQ(log.data()[5], 5);
+
+  EXPECT_EQ(File::GetSize(m_path), sizeof(Movie::DTMHeader) + input.size());
+  InputLog original;
+  ASSERT_TRUE(original.OpenForPlayback(m_path));
+  EXPECT_EQ(0, std::memcmp(original.data(), input.data(), input.size()));
+}
+
+TEST_F(MovieInputLogTest, SavingOverPlayedBackMovie)
+{
+  ASSERT_FALSE(m_temp_dir.empty());
+
+  std::vector<u8> input(64);
+  std::iota(input.begin(), input.end(), u8(0));
+  {
+    File::IOFile file(m_path, "wb");
+    const Movie::DTMHeader header = MakeHeader(1);
+    ASSERT_TRUE(file.WriteArray(&header, 1));
+    ASSERT_TRUE(file.WriteBytes(input.data(), input.size()));
+  }
+
+  InputLog log;
+  ASSERT_TRUE(log.OpenForPlayback(m_path));
+  ASSERT_TRUE(log.SaveAs(m_path, MakeHeader(2)));
+
+  // The mapping can still be read after the file was replaced
+  EXPECT_EQ(0, std::memcmp(log.data(), input.data(), input.size()));
+
+  InputLog saved;
+  ASSERT_TRUE(saved.OpenForPlayback(m_path));
+  ASSERT_EQ(saved.size(), input.size());
+  EXPECT_EQ(0, std::memcmp(saved.data(), input.data(), input.size()));
+
+  File::IOFile file(m_path, "rb");
+  Movie::DTMHeader header;
+  ASSERT_TRUE(file.ReadArray(&header, 1));
+  EXPECT_EQ(header.frameCount, 2u);
+}
+
+TEST_F(MovieInputLogTest, SavingStreamedRecording)
+{
+  ASSERT_FALSE(m_temp_dir.empty());
+
+  InputLog log;
+  ASSERT_TRUE(log.CreateStream(m_path, MakeHeader(0)));
+  const std::array<u8, 8> input{1, 2, 3, 4, 5, 6, 7, 8};
+  log.Write(0, input.data(), input.size());
+  // Maps the file which is streamed to
+  ASSERT_EQ(log.data()[7], 8);
+
+  // Saving to the file which is streamed to only updates its header
+  ASSERT_TRUE(log.SaveAs(m_path, MakeHeader(1)));
+  const std::string copy_path = m_temp_dir + "/copy.dtm";
+  ASSERT_TRUE(log.SaveAs(copy_path, MakeHeader(1)));
+
+  log.Write(input.size(), input.data(), input.size());
+  ASSERT_TRUE(log.SaveAs(m_path, MakeHeader(2)));
+  EXPECT_EQ(File::GetSize(m_path), sizeof(Movie::DTMHeader) + 2 * input.size());
+  EXPECT_EQ(File::GetSize(copy_path), sizeof(Movie::DTMHeader) + input.size());
+
+  InputLog copy;
+  ASSERT_TRUE(copy.OpenForPlayback(copy_path));
+  ASSERT_EQ(copy.size(), input.size());
+  EXPECT_EQ(0, std::memcmp(copy.data(), input.data(), input.size()));
+}
+
+TEST_F(MovieInputLogTest, SavingWhileRecording)
+{
+  ASSERT_FALSE(m_temp_dir.empty());
+
+  // Like a savestate which is written on its worker thread while the CPU thread keeps recording
+  InputLog log;
+  ASSERT_TRUE(log.CreateStream(m_path, MakeHeader(0)));
+  std::thread save_thread([&] {
+    for (int i = 0; i < 200; ++i)
+      EXPECT_TRUE(log.SaveAs(m_temp_dir + "/copy.dtm", MakeHeader(i)));
+  });
+
+  for (u32 frame = 0; frame < 2000; ++frame)
+  {
+    const u64 offset = log.size();
+    log.Write(offset, &frame, sizeof(frame));
+    u32 value;
+    std::memcpy(&value, log.data() + offset, sizeof(value));
+    ASSERT_EQ(value, frame);
+  }
+  save_thread.join();
+
+  ASSERT_TRUE(log.SaveAs(m_temp_dir + "/copy.dtm", MakeHeader(2000)));
+  InputLog copy;
+  ASSERT_TRUE(copy.OpenForPlayback(m_temp_dir + "/copy.dtm"));
+  ASSERT_EQ(copy.size(), 2000 * sizeof(u32));
+  EXPECT_EQ(0, std::memcmp(copy.data(), log.data(), copy.size()));
+}
+
+TEST_F(MovieInputLogTest, OpeningMissingMovieFails)
+{
+  InputLog log;
+  EXPECT_FALSE(log.OpenForPlayback(m_temp_dir + "/missing.dtm"));
+  EXPECT_TRUE(log.empty());
+}
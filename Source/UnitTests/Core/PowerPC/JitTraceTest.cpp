@@ -0,0 +1,157 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Core/PowerPC/JitCommon/JitTrace.h"
+
+using namespace JitTrace;
+
+class JitTraceTest : public testing::Test
+{
+protected:
+  JitTraceTest() : m_temp_dir{File::CreateTempDir()}, m_path{m_temp_dir + "/trace.djtr"} {}
+
+  ~JitTraceTest() override
+  {
+    if (!m_temp_dir.empty())
+      File::DeleteDirRecursively(m_temp_dir);
+  }
+
+  static void DefineBlock(Writer& writer, u32 address, u32 instruction_count)
+  {
+    writer.BeginBlockDefinition(address, instruction_count);
+    for (u32 i = 0; i < instruction_count; ++i)
+      writer.AddBlockInstruction(address + i * 4, 0x38600000 | i);
+  }
+
+  static void ExpectBlockDefinition(const Reader::Entry& entry, u32 address, u32 instruction_count)
+  {
+    EXPECT_EQ(entry.type, EntryType::BlockDefinition);
+    EXPECT_EQ(entry.address, address);
+    ASSERT_EQ(entry.instructions.size(), instruction_count);
+    for (u32 i = 0; i < instruction_count; ++i)
+    {
+      EXPECT_EQ(entry.instructions[i].address, address + i * 4);
+      EXPECT_EQ(entry.instructions[i].hex, 0x38600000 | i);
+    }
+  }
+
+  std::string m_temp_dir;
+  std::string m_path;
+};
+
+TEST_F(JitTraceTest, RoundTrip)
+{
+  {
+    Writer writer;
+    ASSERT_TRUE(writer.Open(m_path));
+    DefineBlock(writer, 0x80003100, 3);
+    Writer::RecordBlockExecuted(writer, 0x80003100);
+    DefineBlock(writer, 0x80003200, 1);
+    Writer::RecordBlockExecuted(writer, 0x80003200);
+    Writer::RecordBlockExecuted(writer, 0x80003100);
+    // Redefined after being invalidated
+    DefineBlock(writer, 0x80003100, 2);
+    Writer::RecordBlockExecuted(writer, 0x80003100);
+    writer.Close();
+  }
+
+  Reader reader;
+  ASSERT_TRUE(reader.Open(m_path));
+  Reader::Entry entry;
+
+  ASSERT_TRUE(reader.ReadEntry(&entry));
+  ExpectBlockDefinition(entry, 0x80003100, 3);
+  ASSERT_TRUE(reader.ReadEntry(&entry));
+  EXPECT_EQ(entry.type, EntryType::BlockExecuted);
+  EXPECT_EQ(entry.address, 0x80003100u);
+  EXPECT_TRUE(entry.instructions.empty());
+  ASSERT_TRUE(reader.ReadEntry(&entry));
+  ExpectBlockDefinition(entry, 0x80003200, 1);
+  for (const u32 address : {0x80003200u, 0x80003100u})
+  {
+    ASSERT_TRUE(reader.ReadEntry(&entry));
+    EXPECT_EQ(entry.type, EntryType::BlockExecuted);
+    EXPECT_EQ(entry.address, address);
+  }
+  ASSERT_TRUE(reader.ReadEntry(&entry));
+  ExpectBlockDefinition(entry, 0x80003100, 2);
+  ASSERT_TRUE(reader.ReadEntry(&entry));
+  EXPECT_EQ(entry.type, EntryType::BlockExecuted);
+  EXPECT_EQ(entry.address, 0x80003100u);
+
+  EXPECT_FALSE(reader.ReadEntry(&entry));
+  EXPECT_FALSE(reader.IsCorrupted());
+}
+
+TEST_F(JitTraceTest, LongTraceWrapsAroundTheRing)
+{
+  // Several times the size of the ring buffer, so that the CPU thread has to wait for the writer
+  constexpr u32 EXECUTION_COUNT = 5'000'000;
+  {
+    Writer writer;
+    ASSERT_TRUE(writer.Open(m_path));
+    DefineBlock(writer, 0x80000000, 8);
+    DefineBlock(writer, 0x80001000, 8);
+    for (u32 i = 0; i < EXECUTION_COUNT; ++i)
+      Writer::RecordBlockExecuted(writer, (i & 1) ? 0x80001000 : 0x80000000);
+    writer.Close();
+  }
+
+  Reader reader;
+  ASSERT_TRUE(reader.Open(m_path));
+  Reader::Entry entry;
+  ASSERT_TRUE(reader.ReadEntry(&entry));
+  ExpectBlockDefinition(entry, 0x80000000, 8);
+  ASSERT_TRUE(reader.ReadEntry(&entry));
+  ExpectBlockDefinition(entry, 0x80001000, 8);
+
+  u32 count = 0;
+  while (reader.ReadEntry(&entry))
+  {
+    ASSERT_EQ(entry.type, EntryType::BlockExecuted);
+    ASSERT_EQ(entry.address, (count & 1) ? 0x80001000u : 0x80000000u) << "entry " << count;
+    ++count;
+  }
+  EXPECT_EQ(count, EXECUTION_COUNT);
+  EXPECT_FALSE(reader.IsCorrupted());
+}
+
+TEST_F(JitTraceTest, TruncatedTraceIsReadableUpToTheCut)
+{
+  {
+    Writer writer;
+    ASSERT_TRUE(writer.Open(m_path));
+    DefineBlock(writer, 0x80003100, 4);
+    for (u32 i = 0; i < 100'000; ++i)
+      Writer::RecordBlockExecuted(writer, 0x80003100);
+    writer.Close();
+  }
+
+  std::string contents;
+  ASSERT_TRUE(File::ReadFileToString(m_path, contents));
+  contents.resize(contents.size() - 4);
+  ASSERT_TRUE(File::WriteStringToFile(m_path, contents));
+
+  Reader reader;
+  ASSERT_TRUE(reader.Open(m_path));
+  Reader::Entry entry;
+  ASSERT_TRUE(reader.ReadEntry(&entry));
+  ExpectBlockDefinition(entry, 0x80003100, 4);
+  while (reader.ReadEntry(&entry))
+    ASSERT_EQ(entry.address, 0x80003100u);
+  EXPECT_TRUE(reader.IsCorrupted());
+}
+
+TEST_F(JitTraceTest, RejectsOtherFiles)
+{
+  ASSERT_TRUE(File::WriteStringToFile(m_path, "not a trace"));
+  Reader reader;
+  EXPECT_FALSE(reader.Open(m_path));
+}
@@ -0,0 +1,299 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "InputCommon/ControlReference/CompiledExpression.h"
+#include "InputCommon/ControlReference/ExpressionParser.h"
+#include "InputCommon/ControllerInterface/CoreDevice.h"
+
+using namespace ciface::ExpressionParser;
+using ciface::Core::Device;
+using ciface::Core::DeviceContainer;
+using ciface::Core::DeviceQualifier;
+using Op = CompiledExpression::Op;
+
+namespace
+{
+constexpr std::array<const char*, 4> INPUT_NAMES{"A", "B", "C", "D"};
+
+using InputStates = std::array<ControlState, INPUT_NAMES.size()>;
+
+// Presses and releases the inputs in various combinations, including values which are in between
+// and out of the usual range.
+const std::vector<InputStates> INPUT_SEQUENCE{
+    {0, 0, 0, 0}, {1, 0, 0, 0}, {1, 1, 0, 0}, {1, 1, 1, 0}, {0, 1, 1, 0}, {0, 0, 1, 0},
+    {0, 1, 0, 1}, {1, 1, 0, 1}, {1, 0, 0, 1}, {0.25, 0.75, 0.5, 1}, {0.5, 0.5, 0, 0},
+    {-1, 2, 0.1, 0}, {0, 1, 0, 0}, {1, 1, 1, 1}, {0, 0, 0, 0}, {1, 0, 1, 0}, {1, 1, 1, 0},
+    {0, 1, 1, 0}, {0, 0, 0, 0}, {0, 1, 0, 0},
+};
+
+class TestDevice final : public Device
+{
+public:
+  class TestInput final : public Input
+  {
+  public:
+    explicit TestInput(std::string name) : m_name(std::move(name)) {}
+    std::string GetName() const override { return m_name; }
+    ControlState GetState() const override { return m_state; }
+
+    ControlState m_state = 0;
+
+  private:
+    std::string m_name;
+  };
+
+  TestDevice()
+  {
+    for (const char* name : INPUT_NAMES)
+    {
+      m_test_inputs.push_back(new TestInput(name));
+      AddInput(m_test_inputs.back());
+    }
+  }
+
+  std::string GetName() const override { return "Device"; }
+  std::string GetSource() const override { return "Test"; }
+
+  void SetStates(const InputStates& states)
+  {
+    for (size_t i = 0; i < states.size(); ++i)
+      m_test_inputs[i]->m_state = states[i];
+  }
+
+private:
+  std::vector<TestInput*> m_test_inputs;
+};
+
+class TestDeviceContainer final : public DeviceContainer
+{
+public:
+  void AddDevice(std::shared_ptr<Device> device) { m_devices.push_back(std::move(device)); }
+};
+
+bool IsSameValue(ControlState a, ControlState b)
+{
+  return a == b || (std::isnan(a) && std::isnan(b));
+}
+}  // namespace
+
+// Checks that CompiledExpression gives exactly the same results as Expression::GetValue, including
+// for expressions with state and side effects.
+class CompiledExpressionTest : public testing::Test
+{
+protected:
+  CompiledExpressionTest() : m_device{std::make_shared<TestDevice>()}
+  {
+    m_container.AddDevice(m_device);
+    m_default_device.FromDevice(m_device.get());
+  }
+
+  // Evaluates all of the expressions in order for each state of the inputs, either through the
+  // tree or through the compiled program. Everything is parsed from scratch, so that the state of
+  // the expressions, their variables and the hotkey suppressions of one run can't leak into the
+  // other.
+  std::vector<ControlState> Evaluate(const std::vector<std::string>& expressions,
+                                     const std::vector<InputStates>& sequence, bool compiled)
+  {
+    ControlEnvironment::VariableContainer variables;
+    ControlEnvironment env(m_container, m_default_device, variables);
+
+    std::vector<std::unique_ptr<Expression>> parsed_expressions;
+    std::vector<CompiledExpression> compiled_expressions;
+    for (const std::string& expression : expressions)
+    {
+      ParseResult result = ParseExpression(expression);
+      EXPECT_EQ(result.status, ParseStatus::Successful) << expression;
+      if (!result.expr)
+        return {};
+
+      result.expr->UpdateReferences(env);
+      compiled_expressions.emplace_back(*result.expr);
+      parsed_expressions.push_back(std::move(result.expr));
+    }
+
+    std::vector<ControlState> values;
+    for (const InputStates& states : sequence)
+    {
+      m_device->SetStates(states);
+      for (size_t i = 0; i < parsed_expressions.size(); ++i)
+      {
+        values.push_back(compiled ? compiled_expressions[i].GetValue() :
+                                    parsed_expressions[i]->GetValue());
+      }
+    }
+    return values;
+  }
+
+  void ExpectSameValues(const std::vector<std::string>& expressions,
+                        const std::vector<InputStates>& sequence = INPUT_SEQUENCE)
+  {
+    const std::vector<ControlState> expected = Evaluate(expressions, sequence, false);
+    const std::vector<ControlState> actual = Evaluate(expressions, sequence, true);
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+      EXPECT_PRED2(IsSameValue, actual[i], expected[i])
+          << expressions[i % expressions.size()] << " at step " << i / expressions.size();
+    }
+  }
+
+  std::vector<Op> GetOps(const std::string& expression)
+  {
+    ControlEnvironment::VariableContainer variables;
+    ControlEnvironment env(m_container, m_default_device, variables);
+    const ParseResult result = ParseExpression(expression);
+    EXPECT_EQ(result.status, ParseStatus::Successful) << expression;
+    if (!result.expr)
+      return {};
+
+    result.expr->UpdateReferences(env);
+    const CompiledExpression compiled(*result.expr);
+    std::vector<Op> ops;
+    for (const CompiledExpression::Instruction& instruction : compiled.GetInstructions())
+      ops.push_back(instruction.op);
+    return ops;
+  }
+
+  bool HasCalls(const std::string& expression)
+  {
+    const std::vector<Op> ops = GetOps(expression);
+    return std::find(ops.begin(), ops.end(), Op::Call) != ops.end();
+  }
+
+  TestDeviceContainer m_container;
+  std::shared_ptr<TestDevice> m_device;
+  DeviceQualifier m_default_device;
+};
+
+TEST_F(CompiledExpressionTest, ConstantFolding)
+{
+  const std::vector<std::string> expressions{
+      "1 + 2 * 3 - 4 / 8",
+      "min(3, pow(2, 0.5)) + sqrt(2) % 1",
+      "clamp(-2, -1, 1) ^ 0.25",
+      "deadzone(-0.5, 0.2) | abs(-0.3) & !0.4",
+      "atan2(1, 2) + asin(0.5) + acos(0.5) + atan(2) + sin(1) * cos(1) - tan(1)",
+      "if(0.6, 2, 3) + if(0.4, 2, 3) + (1 < 2) + (1 > 2)",
+      // Division by zero gives 0, and so does modulo by zero
+      "1 / 0 + 5 % 0",
+      "asin(2)",
+      "1, 2",
+  };
+
+  for (const std::string& expression : expressions)
+  {
+    EXPECT_EQ(GetOps(expression), std::vector<Op>{Op::Constant}) << expression;
+    ExpectSameValues({expression});
+  }
+
+  // Only the constant parts of an expression are folded
+  EXPECT_EQ(GetOps("`A` * (2 + 3)"), (std::vector<Op>{Op::Input, Op::Constant, Op::Mul}));
+  ExpectSameValues({"`A` * (2 + 3)"});
+  EXPECT_EQ(GetOps("`Missing` + 1"), std::vector<Op>{Op::Constant});
+  ExpectSameValues({"`Missing` + 1"});
+}
+
+TEST_F(CompiledExpressionTest, Operators)
+{
+  const std::vector<std::string> expressions{
+      "`A` + `B` * `C` - `D` / `A` % `B`",
+      "`A` & `B` | `C`",
+      "`A` ^ `B`",
+      "!`A`",
+      "-`B`",
+      "(`A` < `B`) + (`C` > 0.5)",
+      "clamp(`A` - `B`, -0.5, 0.5)",
+      "min(`A`, `B`) + max(`C`, `D`)",
+      "atan2(`A`, `B`) + pow(`C`, `D`) + sqrt(`A`) + abs(`B` - 1)",
+      "sin(`A`) + cos(`B`) + tan(`C`) + asin(`D`) + acos(`A`) + atan(`B`)",
+      "deadzone(`A` - `B`, 0.25)",
+      "if(`A`, `B`, `C`)",
+      "`A`, `B`",
+  };
+
+  for (const std::string& expression : expressions)
+  {
+    EXPECT_FALSE(HasCalls(expression)) << expression;
+    ExpectSameValues({expression});
+  }
+
+  // The value of the left side of a comma isn't needed
+  EXPECT_EQ(GetOps("`A`, `B`"), std::vector<Op>{Op::Input});
+}
+
+TEST_F(CompiledExpressionTest, IfWithCalls)
+{
+  // Only the branch which is taken may update its toggle
+  EXPECT_EQ(GetOps("if(`A`, toggle(`B`), toggle(`C`))"), std::vector<Op>{Op::Call});
+  ExpectSameValues({"if(`A`, toggle(`B`), toggle(`C`))"});
+  ExpectSameValues({"if(toggle(`A`), `B`, `C`)"});
+  ExpectSameValues({"if(`A` > 0.5, toggle(`B`, `C`), 2) * 3"});
+}
+
+TEST_F(CompiledExpressionTest, CommaWithSideEffects)
+{
+  // The left side is only needed for its side effects, which have to happen anyway
+  EXPECT_EQ(GetOps("toggle(`A`), 1"), (std::vector<Op>{Op::Call, Op::Constant, Op::Comma}));
+  ExpectSameValues({"toggle(`A`), 1"});
+  // A call could change what the other side reads, so the order of both has to be kept
+  EXPECT_EQ(GetOps("toggle(`A`), `B`"), std::vector<Op>{Op::Call});
+  ExpectSameValues({"toggle(`A`), `B`"});
+
+  ExpectSameValues({"$x = `A`, $x + `B`"});
+  ExpectSameValues({"$x = `A` + `B`, $y = $x * 2, $y - `C`"});
+  ExpectSameValues({"toggle(`A`) + 1, $x = toggle(`B`)", "$x"});
+}
+
+TEST_F(CompiledExpressionTest, HotkeySuppression)
+{
+  // A hotkey suppresses its final input for the expressions which come after it, so the order in
+  // which the hotkey and the input are read has to be kept within an expression, too.
+  ExpectSameValues({"@(`A`+`B`)", "`B`", "`B` + 0.5"});
+  ExpectSameValues({"`B` + @(`A`+`B`)", "@(`A`+`B`) + `B`", "`B`"});
+  ExpectSameValues({"@(`A`+`B`) | @(`A`+`C`+`B`)", "`B` * 2", "@(`C`+`B`)", "`B`, `C`"});
+  ExpectSameValues({"if(`A`, @(`C`+`B`), `B`)", "`B` - `C`"});
+}
+
+TEST_F(CompiledExpressionTest, VariablesAndAssignments)
+{
+  EXPECT_EQ(GetOps("$x + 1"), (std::vector<Op>{Op::Variable, Op::Constant, Op::Add}));
+
+  // Every evaluation of a counter increments it, and the order of evaluation is visible
+  ExpectSameValues({"$x = `A` * 2", "$x + 1", "$count = $count + 1", "$count * $x"});
+  ExpectSameValues({"$count = $count + `A`", "($count = $count * 2) + $count", "$count"});
+  ExpectSameValues({"$unset", "$unset + `A`"});
+}
+
+TEST_F(CompiledExpressionTest, DeepExpressionsFallBackToTheTree)
+{
+  // Each input is pushed before any of the additions, so the stack needs one entry per input
+  const auto make_expression = [](u32 input_count) {
+    std::string expression = "`A`";
+    for (u32 i = 1; i < input_count; ++i)
+    {
+      const std::string input = INPUT_NAMES[i % INPUT_NAMES.size()];
+      expression = "`" + input + "` + (" + expression + ")";
+    }
+    return expression;
+  };
+
+  const std::string deepest_compiled = make_expression(CompiledExpression::MAX_STACK_DEPTH);
+  EXPECT_FALSE(HasCalls(deepest_compiled));
+  ExpectSameValues({deepest_compiled});
+
+  const std::string too_deep = make_expression(CompiledExpression::MAX_STACK_DEPTH + 1);
+  EXPECT_EQ(GetOps(too_deep), std::vector<Op>{Op::Call});
+  ExpectSameValues({too_deep});
+
+  ExpectSameValues({too_deep + ", $x = toggle(`B`)", "$x"});
+}
@@ -0,0 +1,81 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include "VideoCommon/FrameTimeHistogram.h"
+
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+TEST(FrameTimeHistogram, Empty)
+{
+  FrameTimeHistogram histogram;
+  EXPECT_EQ(histogram.GetCount(), 0u);
+  EXPECT_EQ(histogram.GetAverage(), DT::zero());
+  EXPECT_EQ(histogram.GetPercentile(50), DT::zero());
+}
+
+TEST(FrameTimeHistogram, Percentiles)
+{
+  FrameTimeHistogram histogram;
+  for (int i = 0; i < 99; ++i)
+    histogram.Add(microseconds(16650));
+  histogram.Add(milliseconds(50));
+
+  EXPECT_EQ(histogram.GetCount(), 100u);
+  EXPECT_EQ(histogram.GetPercentile(0), microseconds(16700));
+  EXPECT_EQ(histogram.GetPercentile(50), microseconds(16700));
+  EXPECT_EQ(histogram.GetPercentile(99), microseconds(16700));
+  EXPECT_EQ(histogram.GetPercentile(100), microseconds(50100));
+  EXPECT_EQ(histogram.GetMax(), milliseconds(50));
+  EXPECT_EQ(histogram.GetTotal(), microseconds(16650) * 99 + milliseconds(50));
+}
+
+TEST(FrameTimeHistogram, LongFramesGoIntoLastBucket)
+{
+  FrameTimeHistogram histogram;
+  histogram.Add(std::chrono::seconds(10));
+  histogram.Add(std::chrono::seconds(2));
+
+  // Only the percentiles are limited by the range of the buckets
+  EXPECT_EQ(histogram.GetPercentile(50),
+            FrameTimeHistogram::BUCKET_WIDTH * FrameTimeHistogram::BUCKET_COUNT);
+  EXPECT_EQ(histogram.GetPercentile(100),
+            FrameTimeHistogram::BUCKET_WIDTH * FrameTimeHistogram::BUCKET_COUNT);
+  EXPECT_EQ(histogram.GetMax(), std::chrono::seconds(10));
+  EXPECT_EQ(histogram.GetAverage(), std::chrono::seconds(6));
+}
+
+TEST(FrameTimeHistogram, Since)
+{
+  FrameTimeHistogram histogram;
+  histogram.Add(milliseconds(100));
+  const FrameTimeHistogram earlier = histogram;
+  histogram.ResetMax();
+  histogram.Add(milliseconds(10));
+  histogram.Add(milliseconds(20));
+
+  const FrameTimeHistogram difference = histogram.Since(earlier);
+  EXPECT_EQ(difference.GetCount(), 2u);
+  EXPECT_EQ(difference.GetTotal(), milliseconds(30));
+  EXPECT_EQ(difference.GetPercentile(100), microseconds(20100));
+  EXPECT_EQ(difference.GetMax(), milliseconds(20));
+}
+
+TEST(FrameTimeHistogram, MaxIsntClampedInIntervals)
+{
+  FrameTimeHistogram histogram;
+  histogram.Add(std::chrono::seconds(3));
+  const FrameTimeHistogram first = histogram;
+  histogram.ResetMax();
+  histogram.Add(std::chrono::seconds(1));
+  const FrameTimeHistogram second = histogram;
+  histogram.ResetMax();
+
+  EXPECT_EQ(first.GetMax(), std::chrono::seconds(3));
+  EXPECT_EQ(second.Since(first).GetMax(), std::chrono::seconds(1));
+  EXPECT_EQ(histogram.Since(second).GetMax(), DT::zero());
+}
@@ -0,0 +1,183 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <set>
+#include <string>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+#include "VideoCommon/HiresTexturePackIndex.h"
+
+class HiresTexturePackIndexTest : public testing::Test
+{
+protected:
+  HiresTexturePackIndexTest()
+      : m_temp_dir{File::CreateTempDir()}, m_pack_directory{m_temp_dir + "/GAMEID"}
+  {
+    File::SetUserPath(D_CACHE_IDX, m_temp_dir + "/Cache");
+    File::CreateDir(m_pack_directory);
+  }
+
+  ~HiresTexturePackIndexTest() override
+  {
+    if (!m_temp_dir.empty())
+      File::DeleteDirRecursively(m_temp_dir);
+  }
+
+  void AddFile(const std::string& relative_path, const std::string& contents = "png")
+  {
+    const std::string path = m_pack_directory + "/" + relative_path;
+    File::CreateFullPath(path);
+    ASSERT_TRUE(File::WriteStringToFile(path, contents));
+  }
+
+  // Directory modification times can have a coarse resolution, so make sure that changes to the
+  // pack are noticed even if they happen within the same tick as building the index.
+  void TouchDirectory(const std::string& relative_path)
+  {
+    const std::filesystem::path path = StringToPath(m_pack_directory + "/" + relative_path);
+    const auto write_time = std::filesystem::last_write_time(path);
+    std::filesystem::last_write_time(path, write_time + std::chrono::hours(1));
+  }
+
+  std::string m_temp_dir;
+  std::string m_pack_directory;
+};
+
+TEST_F(HiresTexturePackIndexTest, FindsTextures)
+{
+  AddFile("tex1_64x64_0123456789abcdef_5.png", "12345");
+  AddFile("sub/dir/tex1_32x32_fedcba9876543210_14_arb.dds");
+  AddFile("tex1_not_a_texture.txt");
+  AddFile("readme.png");
+
+  const std::optional<HiresTexturePackIndex> index = HiresTexturePackIndex::Open(m_pack_directory);
+  ASSERT_TRUE(index);
+  EXPECT_EQ(index->GetPackDirectory(), m_pack_directory);
+  ASSERT_EQ(index->GetEntryCount(), 2u);
+
+  const auto entry = index->Find("tex1_64x64_0123456789abcdef_5");
+  ASSERT_TRUE(entry);
+  EXPECT_EQ(entry->name, "tex1_64x64_0123456789abcdef_5");
+  EXPECT_EQ(entry->path, "tex1_64x64_0123456789abcdef_5.png");
+  EXPECT_EQ(entry->file_size, 5u);
+  EXPECT_FALSE(entry->has_arbitrary_mipmaps);
+
+  // The "_arb" suffix is not part of the name.
+  const std::string arb_name = "tex1_32x32_fedcba9876543210_14";
+  const auto arb_entry = index->Find(arb_name, HiresTexturePackIndex::HashName(arb_name));
+  ASSERT_TRUE(arb_entry);
+  EXPECT_EQ(arb_entry->path, "sub/dir/tex1_32x32_fedcba9876543210_14_arb.dds");
+  EXPECT_TRUE(arb_entry->has_arbitrary_mipmaps);
+  EXPECT_FALSE(index->Find("tex1_32x32_fedcba9876543210_14_arb"));
+
+  EXPECT_FALSE(index->Find("tex1_64x64_0123456789abcdef_6"));
+  EXPECT_FALSE(index->Find("readme"));
+
+  std::set<std::string> names;
+  for (size_t i = 0; i < index->GetEntryCount(); ++i)
+    names.emplace(index->GetEntry(i).name);
+  EXPECT_EQ(names, (std::set<std::string>{"tex1_32x32_fedcba9876543210_14",
+                                          "tex1_64x64_0123456789abcdef_5"}));
+}
+
+TEST_F(HiresTexturePackIndexTest, ManyTextures)
+{
+  for (int i = 0; i < 1000; ++i)
+    AddFile(fmt::format("tex1_8x8_{:016x}_0.png", i * 7919));
+
+  const std::optional<HiresTexturePackIndex> index = HiresTexturePackIndex::Open(m_pack_directory);
+  ASSERT_TRUE(index);
+  ASSERT_EQ(index->GetEntryCount(), 1000u);
+  for (int i = 0; i < 1000; ++i)
+  {
+    const std::string name = fmt::format("tex1_8x8_{:016x}_0", i * 7919);
+    const auto entry = index->Find(name);
+    ASSERT_TRUE(entry) << name;
+    EXPECT_EQ(entry->name, name);
+  }
+  EXPECT_FALSE(index->Find("tex1_8x8_0000000000000001_0"));
+}
+
+TEST_F(HiresTexturePackIndexTest, FirstPathWinsForDuplicates)
+{
+  AddFile("b/tex1_64x64_0123456789abcdef_5.png", "b");
+  AddFile("a/tex1_64x64_0123456789abcdef_5_arb.dds", "a");
+
+  const std::optional<HiresTexturePackIndex> index = HiresTexturePackIndex::Open(m_pack_directory);
+  ASSERT_TRUE(index);
+  ASSERT_EQ(index->GetEntryCount(), 1u);
+  const auto entry = index->Find("tex1_64x64_0123456789abcdef_5");
+  ASSERT_TRUE(entry);
+  EXPECT_EQ(entry->path, "a/tex1_64x64_0123456789abcdef_5_arb.dds");
+  EXPECT_TRUE(entry->has_arbitrary_mipmaps);
+}
+
+TEST_F(HiresTexturePackIndexTest, RebuildsWhenThePackChanges)
+{
+  AddFile("sub/tex1_64x64_0123456789abcdef_5.png");
+  ASSERT_TRUE(HiresTexturePackIndex::Open(m_pack_directory));
+
+  // The cached index is used as long as nothing changed.
+  {
+    const std::optional<HiresTexturePackIndex> index =
+        HiresTexturePackIndex::Open(m_pack_directory);
+    ASSERT_TRUE(index);
+    EXPECT_EQ(index->GetEntryCount(), 1u);
+  }
+
+  AddFile("sub/tex1_64x64_0123456789abcdef_6.png");
+  TouchDirectory("sub");
+  {
+    const std::optional<HiresTexturePackIndex> index =
+        HiresTexturePackIndex::Open(m_pack_directory);
+    ASSERT_TRUE(index);
+    EXPECT_EQ(index->GetEntryCount(), 2u);
+    EXPECT_TRUE(index->Find("tex1_64x64_0123456789abcdef_6"));
+  }
+
+  ASSERT_TRUE(File::Delete(m_pack_directory + "/sub/tex1_64x64_0123456789abcdef_5.png"));
+  TouchDirectory("sub");
+  {
+    const std::optional<HiresTexturePackIndex> index =
+        HiresTexturePackIndex::Open(m_pack_directory);
+    ASSERT_TRUE(index);
+    EXPECT_EQ(index->GetEntryCount(), 1u);
+    EXPECT_FALSE(index->Find("tex1_64x64_0123456789abcdef_5"));
+  }
+}
+
+TEST_F(HiresTexturePackIndexTest, RebuildsCorruptedIndex)
+{
+  AddFile("tex1_64x64_0123456789abcdef_5.png");
+  ASSERT_TRUE(HiresTexturePackIndex::Open(m_pack_directory));
+
+  for (const File::FSTEntry& entry :
+       File::ScanDirectoryTree(File::GetUserPath(D_CACHE_IDX), true).children)
+  {
+    for (const File::FSTEntry& index_file : entry.children)
+    {
+      std::string contents;
+      ASSERT_TRUE(File::ReadFileToString(index_file.physicalName, contents));
+      contents.resize(contents.size() - 3);
+      ASSERT_TRUE(File::WriteStringToFile(index_file.physicalName, contents));
+    }
+  }
+
+  const std::optional<HiresTexturePackIndex> index = HiresTexturePackIndex::Open(m_pack_directory);
+  ASSERT_TRUE(index);
+  EXPECT_EQ(index->GetEntryCount(), 1u);
+  EXPECT_TRUE(index->Find("tex1_64x64_0123456789abcdef_5"));
+}
+
+TEST_F(HiresTexturePackIndexTest, MissingDirectory)
+{
+  EXPECT_FALSE(HiresTexturePackIndex::Open(m_temp_dir + "/missing"));
+}
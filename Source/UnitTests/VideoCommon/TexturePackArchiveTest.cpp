@@ -0,0 +1,209 @@
+// Copyright 2023 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "VideoCommon/Assets/CustomTextureData.h"
+#include "VideoCommon/Assets/TexturePackArchive.h"
+#include "VideoCommon/TextureConfig.h"
+
+using namespace VideoCommon;
+
+namespace
+{
+CustomTextureData::ArraySlice::Level MakeLevel(AbstractTextureFormat format, u32 width, u32 height,
+                                               u32 row_length, size_t size)
+{
+  CustomTextureData::ArraySlice::Level level;
+  level.format = format;
+  level.width = width;
+  level.height = height;
+  level.row_length = row_length;
+  level.data.resize(size);
+  for (size_t i = 0; i < size; ++i)
+    level.data[i] = static_cast<u8>(i * 7 + width);
+  return level;
+}
+
+CustomTextureData MakeTexture(std::vector<CustomTextureData::ArraySlice::Level> levels)
+{
+  CustomTextureData data;
+  data.m_slices.resize(1);
+  data.m_slices[0].m_levels = std::move(levels);
+  return data;
+}
+
+// A 16x16 RGBA8 texture with a full mip chain
+CustomTextureData MakeRGBATexture()
+{
+  std::vector<CustomTextureData::ArraySlice::Level> levels;
+  for (u32 size = 16; size != 0; size /= 2)
+    levels.push_back(MakeLevel(AbstractTextureFormat::RGBA8, size, size, size, size * size * 4));
+  return MakeTexture(std::move(levels));
+}
+
+// A 12x8 DXT1 texture with a padded first row, whose smaller levels are less than a block wide
+CustomTextureData MakeDXT1Texture()
+{
+  return MakeTexture({MakeLevel(AbstractTextureFormat::DXT1, 12, 8, 16, 4 * 2 * 8),
+                      MakeLevel(AbstractTextureFormat::DXT1, 6, 4, 8, 2 * 1 * 8),
+                      MakeLevel(AbstractTextureFormat::DXT1, 3, 2, 4, 1 * 1 * 8),
+                      MakeLevel(AbstractTextureFormat::DXT1, 1, 1, 4, 1 * 1 * 8)});
+}
+
+void ExpectSameLevels(const CustomTextureData& actual, const CustomTextureData& expected)
+{
+  ASSERT_EQ(actual.m_slices.size(), 1u);
+  const auto& actual_levels = actual.m_slices[0].m_levels;
+  const auto& expected_levels = expected.m_slices[0].m_levels;
+  ASSERT_EQ(actual_levels.size(), expected_levels.size());
+  for (size_t i = 0; i < expected_levels.size(); ++i)
+  {
+    EXPECT_EQ(actual_levels[i].format, expected_levels[i].format);
+    EXPECT_EQ(actual_levels[i].width, expected_levels[i].width);
+    EXPECT_EQ(actual_levels[i].height, expected_levels[i].height);
+    EXPECT_EQ(actual_levels[i].row_length, expected_levels[i].row_length);
+    EXPECT_EQ(actual_levels[i].data, expected_levels[i].data) << "level " << i;
+  }
+}
+}  // namespace
+
+class TexturePackArchiveTest : public testing::Test
+{
+protected:
+  TexturePackArchiveTest() : m_temp_dir{File::CreateTempDir()}, m_path{m_temp_dir + "/pack.dtp"}
+  {
+  }
+
+  ~TexturePackArchiveTest() override
+  {
+    if (!m_temp_dir.empty())
+      File::DeleteDirRecursively(m_temp_dir);
+  }
+
+  void WriteArchive()
+  {
+    TexturePackArchiveWriter writer;
+    ASSERT_TRUE(writer.Open(m_path));
+    ASSERT_TRUE(writer.AddTexture("tex1_16x16_0000000000000001_6", true, MakeRGBATexture()));
+    ASSERT_TRUE(writer.AddTexture("tex1_12x8_0000000000000002_14", false, MakeDXT1Texture()));
+    ASSERT_TRUE(writer.Finish());
+  }
+
+  // Applies a change to one of the level records of the archive
+  void ModifyLevel(size_t index, const std::function<void(TexturePackArchive::LevelRecord*)>& f)
+  {
+    File::IOFile file(m_path, "r+b");
+    TexturePackArchive::Header header;
+    ASSERT_TRUE(file.ReadArray(&header, 1));
+    ASSERT_LT(index, header.level_count);
+
+    const u64 offset = header.index_offset +
+                       header.texture_count * sizeof(TexturePackArchive::TextureRecord) +
+                       index * sizeof(TexturePackArchive::LevelRecord);
+    TexturePackArchive::LevelRecord level;
+    ASSERT_TRUE(file.Seek(offset, File::SeekOrigin::Begin));
+    ASSERT_TRUE(file.ReadArray(&level, 1));
+    f(&level);
+    ASSERT_TRUE(file.Seek(offset, File::SeekOrigin::Begin));
+    ASSERT_TRUE(file.WriteArray(&level, 1));
+  }
+
+  std::string m_temp_dir;
+  std::string m_path;
+};
+
+TEST_F(TexturePackArchiveTest, RoundTrip)
+{
+  WriteArchive();
+
+  const auto archive = TexturePackArchiveLibrary::Open(m_path);
+  ASSERT_TRUE(archive);
+  EXPECT_EQ(archive->GetTextureCount(), 2u);
+
+  const auto rgba_entry = archive->FindTexture("tex1_16x16_0000000000000001_6");
+  ASSERT_TRUE(rgba_entry);
+  EXPECT_TRUE(rgba_entry->has_arbitrary_mipmaps);
+  EXPECT_EQ(rgba_entry->size, (16 * 16 + 8 * 8 + 4 * 4 + 2 * 2 + 1) * 4u);
+
+  const auto dxt1_entry = archive->FindTexture("tex1_12x8_0000000000000002_14");
+  ASSERT_TRUE(dxt1_entry);
+  EXPECT_FALSE(dxt1_entry->has_arbitrary_mipmaps);
+
+  EXPECT_FALSE(archive->FindTexture("tex1_16x16_0000000000000003_6"));
+
+  CustomTextureData rgba_data;
+  EXPECT_NE(archive->LoadTexture("tex1_16x16_0000000000000001_6", &rgba_data).m_bytes_loaded, 0u);
+  ExpectSameLevels(rgba_data, MakeRGBATexture());
+
+  CustomTextureData dxt1_data;
+  EXPECT_NE(archive->LoadTexture("tex1_12x8_0000000000000002_14", &dxt1_data).m_bytes_loaded, 0u);
+  ExpectSameLevels(dxt1_data, MakeDXT1Texture());
+}
+
+TEST_F(TexturePackArchiveTest, WriterRejectsMismatchedLevels)
+{
+  TexturePackArchiveWriter writer;
+  ASSERT_TRUE(writer.Open(m_path));
+
+  // Too little data
+  EXPECT_FALSE(writer.AddTexture(
+      "a", false, MakeTexture({MakeLevel(AbstractTextureFormat::RGBA8, 4, 4, 4, 60)})));
+  // Row length shorter than the width
+  EXPECT_FALSE(writer.AddTexture(
+      "b", false, MakeTexture({MakeLevel(AbstractTextureFormat::RGBA8, 4, 4, 3, 48)})));
+  // Block compressed row length which isn't a whole number of blocks
+  EXPECT_FALSE(writer.AddTexture(
+      "c", false, MakeTexture({MakeLevel(AbstractTextureFormat::DXT5, 6, 4, 6, 32)})));
+  // Unsupported format
+  EXPECT_FALSE(writer.AddTexture(
+      "d", false, MakeTexture({MakeLevel(AbstractTextureFormat::R32F, 4, 4, 4, 64)})));
+
+  EXPECT_TRUE(writer.AddTexture(
+      "e", false, MakeTexture({MakeLevel(AbstractTextureFormat::DXT5, 6, 4, 8, 32)})));
+  ASSERT_TRUE(writer.Finish());
+
+  const auto archive = TexturePackArchiveLibrary::Open(m_path);
+  ASSERT_TRUE(archive);
+  EXPECT_EQ(archive->GetTextureCount(), 1u);
+}
+
+TEST_F(TexturePackArchiveTest, RejectsLevelsWhichDontMatchTheirDimensions)
+{
+  WriteArchive();
+  ModifyLevel(0, [](TexturePackArchive::LevelRecord* level) { level->height = 32; });
+  EXPECT_FALSE(TexturePackArchiveLibrary::Open(m_path));
+
+  WriteArchive();
+  ModifyLevel(1, [](TexturePackArchive::LevelRecord* level) { level->row_length = 4; });
+  EXPECT_FALSE(TexturePackArchiveLibrary::Open(m_path));
+
+  WriteArchive();
+  ModifyLevel(5, [](TexturePackArchive::LevelRecord* level) {
+    level->format = static_cast<u32>(AbstractTextureFormat::BPTC);
+  });
+  EXPECT_FALSE(TexturePackArchiveLibrary::Open(m_path));
+
+  WriteArchive();
+  ModifyLevel(6, [](TexturePackArchive::LevelRecord* level) {
+    level->width = 0xfffffffc;
+    level->row_length = 0xfffffffc;
+  });
+  EXPECT_FALSE(TexturePackArchiveLibrary::Open(m_path));
+}
+
+TEST_F(TexturePackArchiveTest, RejectsLevelsWhichArentBackToBack)
+{
+  WriteArchive();
+  // Still within the data of the archive, but one byte past the end of the previous level
+  ModifyLevel(2, [](TexturePackArchive::LevelRecord* level) { ++level->data_offset; });
+  EXPECT_FALSE(TexturePackArchiveLibrary::Open(m_path));
+}